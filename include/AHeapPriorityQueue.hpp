@@ -0,0 +1,82 @@
+/** @file AHeapPriorityQueue.hpp
+ * @brief Concrete array based binary heap implementation of Priority
+ *   Queue ADT.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement the Queue abstraction but maintain the queue as a
+ * priority queue using a binary heap.  This is an array based
+ * implementation.  We inherit from the AQueue class to reuse its
+ * block of values and growth policy, but the values are kept in heap
+ * order starting at index 0 of the array instead of as a circular
+ * buffer.  Both enqueue() and dequeue() are O(log n) operations.  As
+ * with the APriorityQueue, we assume that operator>() is defined for
+ * the type T being managed, and that it returns true when the lhs T
+ * value is higher priority than the rhs T value.
+ */
+#ifndef _AHEAPPRIORITYQUEUE_HPP_
+#define _AHEAPPRIORITYQUEUE_HPP_
+#include "AQueue.hpp"
+using namespace std;
+
+/** @class AHeapPriorityQueue
+ * @brief The AHeapPriorityQueue concrete array based binary heap
+ *   implemention of the Queue interface that dequeues items in order
+ *   of priority.
+ *
+ * Concrete implementation of Queue abstraction using an array based
+ * binary heap.  The front() of the queue is always the highest
+ * priority item, and items of equal priority are dequeued in the
+ * order they were enqueued (first-in-first-out), the same as for the
+ * APriorityQueue.  To keep equal priorities stable, every item is
+ * tagged with an enqueue sequence number held in a block of memory
+ * parallel to the values.  Be aware that the indexing operator and
+ * str() show the values in heap order, which is not the order in
+ * which they will be dequeued.  A snapshot of the heap saves its
+ * items in the order they will be dequeued, and a restored heap
+ * numbers its items in the order they were saved, so equal priority
+ * items are still dequeued in the order they were first enqueued.
+ */
+template<class T>
+class AHeapPriorityQueue : public AQueue<T>
+{
+public:
+  // constructors and destructors
+  AHeapPriorityQueue();                                        // default constructor
+  AHeapPriorityQueue(int initSize, T initValues[]);            // array based constructor
+  AHeapPriorityQueue(const AHeapPriorityQueue<T>& otherQueue); // copy constructor
+  ~AHeapPriorityQueue();                                       // destructor
+
+  // adding, accessing and removing values from the queue
+  void clear();
+  void dequeue();
+  void enqueue(const T& newItem);
+  void enqueue(T&& newItem);
+  void enqueueArray(const T* items, int count);
+  int dequeueInto(T* out, int count);
+
+protected:
+  void reallocate(int newAllocationSize);
+  bool visitSnapshotOrder(const function<bool(const T*, int)>& visitor) const;
+  void restoreOrder();
+
+private:
+  /// @brief the sequence number to assign to the next item enqueued,
+  ///   used to break ties between items of equal priority
+  unsigned long nextSequence;
+
+  /// @brief block of sequence numbers parallel to the values, the
+  ///   item at values[index] was enqueued with sequence[index]
+  unsigned long* sequence;
+
+  // private member methods for maintaining the heap
+  bool isBefore(const T& lhs, unsigned long lhsSequence, const T& rhs, unsigned long rhsSequence) const;
+  void siftUp(int index);
+  void siftDown(int index);
+};
+
+#endif // define _AHEAPPRIORITYQUEUE_HPP_
@@ -27,8 +27,13 @@ using namespace std;
  *
  * Concrete implementation of Queue abstraction using an array based
  * implementation.  We inherit from the array based AQueue implementation.
- * we only override the enqueue() method so that we insert new values into
+ * we only override the enqueue() methods so that we insert new values into
  * the queue in priority order.
+ *
+ * The insertion point of a new value is found with a binary search of
+ * the sorted circular buffer, and the values on the shorter side of it
+ * are shifted over by one as a block, towards the front of the buffer
+ * if it is closer to the front of the queue, or else towards the back.
  */
 template<class T>
 class APriorityQueue : public AQueue<T>
@@ -40,9 +45,17 @@ public:
 
   // adding, accessing and removing values from the queue
   void enqueue(const T& newItem);
+  void enqueue(T&& newItem);
+  void enqueueArray(const T* items, int count);
+
+protected:
+  void restoreOrder();
 
 private:
-  int modulo(int index, int bufferSize);
+  int findInsertionIndex(const T& newItem) const;
+  void moveRun(int from, int to, int count);
+  void openFrontGap(int index);
+  void openBackGap(int index);
 };
 
 #endif // define _APRIORITYQUEUE_HPP_
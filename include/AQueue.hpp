@@ -15,14 +15,34 @@
  * memory allocation if it needs to grow.  In order to make
  * queue operations efficient for both enqueue on the back and dequeue
  * on the front of the queue, we have to now treat the array ov
- * values as a circular buffer.
+ * values as a circular buffer.  Optionally the allocation can be kept
+ * to a power of two in size, so that wrapping indexes around the
+ * circular buffer only needs a bit mask instead of an integer division.
  */
 #ifndef _AQUEUE_HPP_
 #define _AQUEUE_HPP_
 #include "Queue.hpp"
+#include <cstddef>
+#include <iterator>
 #include <string>
+#include <type_traits>
 using namespace std;
 
+/** @enum CapacityPolicy
+ * @brief How an AQueue chooses the size of its allocation, and so
+ *   how it wraps indexes around its circular buffer.
+ */
+enum CapacityPolicy
+{
+  /// @brief allocations start at 10 and double in size when full, indexes
+  ///   are wrapped with the modulo of the allocation size
+  DOUBLING_CAPACITY,
+
+  /// @brief allocations are always rounded up to a power of two, indexes
+  ///   are wrapped by masking off the high bits
+  POWER_OF_TWO_CAPACITY
+};
+
 /** @class AQueue
  * @brief The AQueue concrete array based implemention of the
  *   Queue interface.
@@ -33,38 +53,102 @@ using namespace std;
  * operations efficient, we treat the array as a circular buffer of items,
  * so both putting items on the end of the queue and taking items from the
  * front can be constant time O(1) operations.
+ *
+ * The allocation doubles when the queue is full, and is halved again
+ * when dequeues leave it less than a quarter full, so a queue that
+ * drains after a burst of items gives back the memory it grew to.  The
+ * gap between the two thresholds keeps a queue whose size hovers
+ * around one of them from growing and shrinking over and over.
+ *
+ * The queue can be walked from front to back with forward iterators,
+ * for example with a range based for loop or with the STL algorithms.
+ * The values of the circular buffer are in at most two linear
+ * segments, the front of the queue up to the end of the allocation,
+ * and then the beginning of the allocation up to the back of the
+ * queue, and the iterator simply steps a pointer through each of them
+ * in turn, with no bounds checks or index wrapping.  Any enqueue or
+ * dequeue invalidates all iterators of the queue.
+ *
+ * Searching for values with find(), count() and contains(), and
+ * comparing queues, works directly on the segments of the circular
+ * buffer rather than indexing each value, and for a queue of int
+ * values uses SIMD instructions to compare several values at a time.
+ *
+ * A queue of a trivially copyable type, or of Job, can be saved to
+ * and restored from a compact binary snapshot.  The two segments of
+ * the circular buffer are written as they are, and a snapshot is
+ * restored with a single read straight into the new allocation.
  */
 template<class T>
 class AQueue : public Queue<T>
 {
 public:
+  // iterator types
+  template<class Value>
+  class BasicIterator;
+  typedef BasicIterator<T> iterator;
+  typedef BasicIterator<const T> const_iterator;
+
   // constructors and destructors
-  AQueue();                            // default constructor
-  AQueue(int size, T values[]);        // array based constructor
-  AQueue(const AQueue<T>& otherQueue); // copy constructor
-  ~AQueue();                           // destructor
+  AQueue();                                       // default constructor
+  explicit AQueue(CapacityPolicy capacityPolicy); // capacity policy constructor
+  AQueue(int size, T values[]);                   // array based constructor
+  AQueue(const AQueue<T>& otherQueue);            // copy constructor
+  ~AQueue();                                      // destructor
 
   // accessors and information methods
   int getAllocationSize() const;
-  string str() const;
+  int getReservedSize() const;
+  CapacityPolicy getCapacityPolicy() const;
   bool operator==(const Queue<T>& rhs) const;
   T& operator[](int index) const;
+  bool visitSegments(const function<bool(const T*, int)>& visitor) const;
+  int find(const T& value) const;
+  int count(const T& value) const;
+  bool contains(const T& value) const;
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+  const_iterator cbegin() const;
+  const_iterator cend() const;
 
   // adding, accessing and removing values from the queue
   void clear();
   T front() const;
   void dequeue();
+  T dequeueValue();
   void enqueue(const T& newItem);
+  void enqueue(T&& newItem);
+  void enqueueArray(const T* items, int count);
+  int dequeueInto(T* out, int count);
+  void reserve(int minimumAllocation);
+  void shrinkToFit();
+
+  // saving and restoring binary snapshots of the queue
+  void saveSnapshot(ostream& out) const;
+  void loadSnapshot(istream& in);
 
 protected:
   /// @brief private constant, initial allocation size for empty queues
   ///   to grow to
   const int INITIAL_ALLOCATION_SIZE = 10;
 
+  /// @brief the largest allocation a queue with the POWER_OF_TWO_CAPACITY
+  ///   policy can have, the largest power of two an int can hold
+  static constexpr int MAXIMUM_CAPACITY = 1 << 30;
+
+  /// @brief the policy for choosing allocation sizes and wrapping indexes
+  CapacityPolicy capacityPolicy;
+
   /// @brief the current amount of allocated memory being
   ///   managed by/for this queue of values
   int allocationSize;
 
+  /// @brief the allocation size asked for by reserve(), the allocation
+  ///   is never automatically shrunk below this size
+  int reservedSize;
+
   /// @brief the current index of the front item of the queue in
   ///   our array of values
   int frontIndex;
@@ -83,6 +167,129 @@ protected:
 
   // private member methods for managing the Queue internally
   void growQueueIfNeeded();
+  void growQueueToFit(int minimumSize);
+  void shrinkQueueIfNeeded();
+  int roundAllocationSize(int minimumSize) const;
+  int wrapIndex(int index) const;
+  virtual void reallocate(int newAllocationSize);
+  virtual bool visitSnapshotOrder(const function<bool(const T*, int)>& visitor) const;
+  virtual void restoreOrder();
+
+private:
+  template<class Iterator>
+  Iterator makeBegin() const;
+  template<class Iterator>
+  Iterator makeEnd() const;
+};
+
+/** @class AQueue::BasicIterator
+ * @brief Forward iterator over the values of an AQueue, from the front
+ *   of the queue to the back.
+ *
+ * The Value is T for an iterator, and const T for a const_iterator.
+ * The iterator walks the current segment of the circular buffer, and
+ * remembers the second segment, if the values wrap around the end of
+ * the buffer, to jump to when the first one runs out.  An iterator at
+ * the end of the first segment and one at the end of the second can
+ * point to the same place when the buffer is full, so they are only
+ * equal if neither has a segment still to come.  The iterator is so
+ * small and used so often that it is defined here in the header, so
+ * it can be inlined into the loops using it.
+ */
+template<class T>
+template<class Value>
+class AQueue<T>::BasicIterator
+{
+public:
+  typedef forward_iterator_tag iterator_category;
+  typedef remove_const_t<Value> value_type;
+  typedef ptrdiff_t difference_type;
+  typedef Value* pointer;
+  typedef Value& reference;
+
+  /// @brief construct an iterator that does not refer to any queue
+  BasicIterator()
+    : current(nullptr), segmentEnd(nullptr), nextSegment(nullptr), nextSegmentEnd(nullptr)
+  {
+  }
+
+  /// @brief construct an iterator at current in the segment ending at
+  ///   segmentEnd, followed by the segment from nextSegment up to
+  ///   nextSegmentEnd, or by no segment if nextSegment is nullptr
+  BasicIterator(Value* current, Value* segmentEnd, Value* nextSegment, Value* nextSegmentEnd)
+    : current(current), segmentEnd(segmentEnd), nextSegment(nextSegment), nextSegmentEnd(nextSegmentEnd)
+  {
+  }
+
+  /// @brief convert an iterator to a const_iterator
+  template<class OtherValue, class = enable_if_t<is_same<const OtherValue, Value>::value>>
+  BasicIterator(const BasicIterator<OtherValue>& other)
+    : current(other.current), segmentEnd(other.segmentEnd), nextSegment(other.nextSegment), nextSegmentEnd(other.nextSegmentEnd)
+  {
+  }
+
+  /// @brief access the value the iterator is at
+  reference operator*() const
+  {
+    return *current;
+  }
+
+  /// @brief access a member of the value the iterator is at
+  pointer operator->() const
+  {
+    return current;
+  }
+
+  /// @brief advance to the next value, moving on to the second segment
+  ///   when the first one runs out
+  BasicIterator& operator++()
+  {
+    ++current;
+    if ((current == segmentEnd) and (nextSegment != nullptr))
+    {
+      current = nextSegment;
+      segmentEnd = nextSegmentEnd;
+      nextSegment = nullptr;
+    }
+    return *this;
+  }
+
+  /// @brief advance to the next value, returning the iterator as it was
+  BasicIterator operator++(int)
+  {
+    BasicIterator previous = *this;
+    ++(*this);
+    return previous;
+  }
+
+  /// @brief iterators are equal if they are at the same value
+  bool operator==(const BasicIterator& rhs) const
+  {
+    return (current == rhs.current) and (nextSegment == rhs.nextSegment);
+  }
+
+  /// @brief iterators are not equal if they are at different values
+  bool operator!=(const BasicIterator& rhs) const
+  {
+    return not(*this == rhs);
+  }
+
+private:
+  template<class OtherValue>
+  friend class BasicIterator;
+
+  /// @brief the value the iterator is at
+  Value* current;
+
+  /// @brief the end of the segment current is in
+  Value* segmentEnd;
+
+  /// @brief the start of the segment following this one, or nullptr if
+  ///   this is the last segment
+  Value* nextSegment;
+
+  /// @brief the end of the segment following this one
+  Value* nextSegmentEnd;
 };
 
 #endif // define _AQUEUE_HPP_
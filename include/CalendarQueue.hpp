@@ -0,0 +1,144 @@
+/** @file CalendarQueue.hpp
+ * @brief Concrete calendar queue implementation of a Queue ADT that
+ *   dequeues items in order of an integer timestamp.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement a queue of timed events, such as the arrivals and
+ * completions of a job scheduling simulation, as a calendar queue
+ * (R. Brown, "Calendar Queues", CACM 31(10), 1988).  Like a desk
+ * calendar with a page for each day of the year, the queue is an array
+ * of buckets, each holding the items whose timestamps fall on its day,
+ * in order of time.  Items whose timestamps are a whole year apart
+ * share a bucket, so the calendar wraps around to hold events any
+ * distance into the future.  The next item is found by turning the
+ * pages from the current day until a bucket has an item for this year.
+ * The number of buckets and the width of a day are adjusted as the
+ * queue grows and shrinks, so that there are only a few items in each
+ * bucket and the next item is usually only a page or two away, which
+ * makes enqueue and dequeue constant time O(1) on average.
+ */
+#ifndef _CALENDARQUEUE_HPP_
+#define _CALENDARQUEUE_HPP_
+#include "Job.hpp"
+#include "Queue.hpp"
+#include <vector>
+using namespace std;
+
+/** @struct CalendarTime
+ * @brief The timestamp a CalendarQueue orders an item type by.
+ *
+ * Specialized for each type of item a CalendarQueue can hold.  An int
+ * is its own timestamp, and a Job is scheduled at its start time.
+ */
+template<class T>
+struct CalendarTime;
+
+/** @struct CalendarTime
+ * @brief An int item is its own timestamp.
+ */
+template<>
+struct CalendarTime<int>
+{
+  static int of(const int& item)
+  {
+    return item;
+  }
+};
+
+/** @struct CalendarTime
+ * @brief A Job item is scheduled at its start time.
+ */
+template<>
+struct CalendarTime<Job>
+{
+  static int of(const Job& job)
+  {
+    return job.getStartTime();
+  }
+};
+
+/** @class CalendarQueue
+ * @brief The CalendarQueue concrete calendar queue implementation of
+ *   the Queue interface, dequeuing items earliest timestamp first.
+ *
+ * The front() of the queue is always the item with the earliest
+ * timestamp, and items with equal timestamps are dequeued in the order
+ * they were enqueued (first-in-first-out).  The items of each bucket
+ * are kept in a block sorted from the latest timestamp to the earliest,
+ * so the next item of a bucket is removed from the end of its block.
+ *
+ * The number of buckets is a power of two, and is doubled when there
+ * are more than two items per bucket and halved when there are less
+ * than one for every two buckets.  Each time, the width of a day is
+ * set to three times the average gap between the timestamps of the
+ * next few items to be dequeued, and the items are redistributed, an
+ * O(n) step that happens rarely enough that it is O(1) per item on
+ * average.  As for the heap based queues, the indexing operator and
+ * str() show the items bucket by bucket, which is not the order in
+ * which they will be dequeued.
+ */
+template<class T>
+class CalendarQueue : public Queue<T>
+{
+public:
+  // constructors and destructors
+  CalendarQueue();                                   // default constructor
+  CalendarQueue(int initSize, T initValues[]);       // array based constructor
+  CalendarQueue(const CalendarQueue<T>& otherQueue); // copy constructor
+  ~CalendarQueue();                                  // destructor
+
+  // accessors and information methods
+  int getBucketCount() const;
+  int getBucketWidth() const;
+  T front() const;
+  bool operator==(const Queue<T>& rhs) const;
+  T& operator[](int index) const;
+  bool visitSegments(const function<bool(const T*, int)>& visitor) const;
+
+  // adding, accessing and removing values from the queue
+  void clear();
+  void enqueue(const T& newItem);
+  void enqueue(T&& newItem);
+  void dequeue();
+  T dequeueValue();
+
+private:
+  /// @brief private constant, the fewest buckets a calendar has
+  static constexpr int MINIMUM_BUCKET_COUNT = 2;
+
+  /// @brief private constant, the number of items at the front of the
+  ///   queue sampled to choose the width of a day
+  static constexpr int WIDTH_SAMPLE_SIZE = 25;
+
+  /// @brief the number of buckets, a power of two
+  int bucketCount;
+
+  /// @brief the span of timestamps held by each bucket in one year
+  int bucketWidth;
+
+  /// @brief the buckets, each sorted from latest to earliest timestamp
+  vector<T>* buckets;
+
+  /// @brief the bucket holding the front item of a non empty queue
+  int currentBucket;
+
+  /// @brief the timestamp at which the day of the current bucket ends,
+  ///   the front item is before it
+  long long bucketTop;
+
+  // private member methods for managing the calendar
+  long long dayOf(int time) const;
+  void placeItem(T&& item);
+  void setCurrentDay(int time);
+  void findFront();
+  void findEarliest();
+  void resize(int newBucketCount);
+  int sampleBucketWidth() const;
+};
+
+#endif // define _CALENDARQUEUE_HPP_
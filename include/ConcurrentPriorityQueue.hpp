@@ -0,0 +1,133 @@
+/** @file ConcurrentPriorityQueue.hpp
+ * @brief Concrete thread safe sharded implementation of Priority
+ *   Queue ADT.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement the Queue abstraction as a priority queue that many
+ * threads can enqueue to and dequeue from at the same time.  A single
+ * heap guarded by a single lock makes every thread wait on every
+ * other thread, so instead the items are spread over several shards,
+ * each a binary heap with its own lock (a multi-queue).  An enqueue
+ * locks only one shard, and a dequeue looks at the front of a few
+ * sampled shards and takes the highest priority of those.  The item
+ * dequeued is then not always the highest priority item in the whole
+ * queue, but it is always close to it, and how close can be traded
+ * off against throughput by choosing how many shards are sampled.
+ */
+#ifndef _CONCURRENTPRIORITYQUEUE_HPP_
+#define _CONCURRENTPRIORITYQUEUE_HPP_
+#include "AHeapPriorityQueue.hpp"
+#include "Queue.hpp"
+#include <atomic>
+#include <mutex>
+#include <string>
+using namespace std;
+
+/** @class ConcurrentPriorityQueue
+ * @brief The ConcurrentPriorityQueue concrete thread safe sharded
+ *   implementation of the Queue interface that dequeues items in
+ *   approximate order of priority.
+ *
+ * The sample count is the strictness knob of the queue.  Each dequeue
+ * locks the given number of shards and takes the highest priority
+ * front item among them.  A sample count of 1 dequeues from a single
+ * shard and is the fastest but least strict, while a sample count of
+ * 2 is the usual multi-queue choice, where the rank of the dequeued
+ * item stays within a small multiple of the number of shards.  When
+ * the sample count is the same as the shard count every dequeue
+ * looks at every shard, and the queue is a strict priority queue.
+ *
+ * As with the other priority queues, we assume that operator>() is
+ * defined for the type T being managed, and that it returns true when
+ * the lhs T value is higher priority than the rhs T value.  Items of
+ * equal priority are only first in first out when they land in the
+ * same shard.
+ *
+ * All of the enqueue and dequeue methods, front(), clear(), getSize()
+ * and isEmpty() may be called from any thread.  The indexing operator,
+ * str() and operator== should only be used when no thread is
+ * changing the queue, and they show the values shard by shard in
+ * heap order, which is not the order in which they will be dequeued.
+ */
+template<class T>
+class ConcurrentPriorityQueue : public Queue<T>
+{
+public:
+  // constructors and destructors
+  ConcurrentPriorityQueue(int shardCount = DEFAULT_SHARD_COUNT, int sampleCount = DEFAULT_SAMPLE_COUNT);
+  ConcurrentPriorityQueue(const ConcurrentPriorityQueue<T>& otherQueue) = delete;
+  ~ConcurrentPriorityQueue(); // destructor
+
+  // accessors and information methods
+  int getSize() const;
+  bool isEmpty() const;
+  int getShardCount() const;
+  int getSampleCount() const;
+  bool isStrict() const;
+  T front() const;
+  bool operator==(const Queue<T>& rhs) const;
+  T& operator[](int index) const;
+  bool visitSegments(const function<bool(const T*, int)>& visitor) const;
+
+  // adding, accessing and removing values from the queue
+  void clear();
+  void enqueue(const T& newItem);
+  void enqueue(T&& newItem);
+  void dequeue();
+  T dequeueValue();
+  bool tryDequeue(T& item);
+  int dequeueInto(T* out, int count);
+
+  /// @brief the number of shards used if no shard count is asked for
+  static const int DEFAULT_SHARD_COUNT = 8;
+
+  /// @brief the number of shards sampled by each dequeue if no sample
+  ///   count is asked for
+  static const int DEFAULT_SAMPLE_COUNT = 2;
+
+  /// @brief the assumed size of a cache line, each shard starts on its
+  ///   own cache line so that the locks do not share lines
+  static const int CACHE_LINE_SIZE = 64;
+
+private:
+  // iterates over the items shard by shard, for comparing queues
+  class ItemIterator;
+
+  /** @brief one heap of the queue together with the lock guarding it
+   */
+  struct Shard
+  {
+    /// @brief the lock that must be held to use the heap
+    alignas(CACHE_LINE_SIZE) mutable mutex lock;
+
+    /// @brief the items of this shard in priority order
+    AHeapPriorityQueue<T> heap;
+  };
+
+  /// @brief the number of shards the items are spread over
+  int shardCount;
+
+  /// @brief the number of shards looked at by each dequeue
+  int sampleCount;
+
+  /// @brief the block of shards of this queue
+  Shard* shards;
+
+  /// @brief the number of items in all of the shards, updated while
+  ///   the shard the item is added to or removed from is locked
+  atomic<int> itemCount;
+
+  // private member methods for picking and searching shards
+  int randomShard() const;
+  int lockBestShard(int firstShard, int windowSize) const;
+  void unlockShards(int firstShard, int windowSize) const;
+  bool isInWindow(int shard, int firstShard, int windowSize) const;
+  bool dequeueFromShards(T& item, int firstShard, int windowSize);
+};
+
+#endif // define _CONCURRENTPRIORITYQUEUE_HPP_
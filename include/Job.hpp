@@ -13,6 +13,7 @@
  */
 #ifndef _JOB_HPP_
 #define _JOB_HPP_
+#include <atomic>
 #include <string>
 
 using namespace std;
@@ -43,9 +44,12 @@ public:
   Job(int priority, int serviceTime, int startTime, int id);
 
   void setEndTime(int endTime);
+  void setPriority(int priority);
   int getId() const;
   int getServiceTime() const;
   int getPriority() const;
+  int getStartTime() const;
+  int getEndTime() const;
   int getWaitTime() const;
   int getCost() const;
 
@@ -60,8 +64,9 @@ public:
 
 private:
   /// @brief nextListId A static int variable, used to assign unique ids
-  ///   when processes are created, for identification purposes.
-  static int nextListId;
+  ///   when processes are created, for identification purposes.  It is
+  ///   atomic so that jobs can be created by several threads at once.
+  static atomic<int> nextListId;
 
   /// @brief id The actual unique id assigned to a job object.
   int id;
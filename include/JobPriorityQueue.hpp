@@ -0,0 +1,156 @@
+/** @file JobPriorityQueue.hpp
+ * @brief Concrete structure of arrays binary heap implementation of
+ *   Priority Queue ADT specialized for Job items.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement a priority queue of Job items as a binary heap, but
+ * instead of moving whole Job objects around the heap, the heap only
+ * holds a small key for each job, with the jobs themselves held in a
+ * separate block of memory that the heap refers to by index.  The
+ * ordering of the heap only depends on the priority of the jobs, and
+ * the order they were enqueued in, so both are packed into a single
+ * 64 bit integer key, and sifting an item up or down the heap only
+ * compares and moves the keys, which are packed densely together in
+ * memory, instead of calling Job::operator>() and moving the five
+ * ints of a Job at every level.
+ */
+#ifndef _JOBPRIORITYQUEUE_HPP_
+#define _JOBPRIORITYQUEUE_HPP_
+#include "Job.hpp"
+#include "Queue.hpp"
+#include <cstdint>
+#include <string>
+using namespace std;
+
+/** @class JobPriorityQueue
+ * @brief The JobPriorityQueue concrete structure of arrays binary heap
+ *   implementation of the Queue interface for Job items.
+ *
+ * Jobs are dequeued in priority order, higher priority first, and
+ * jobs of equal priority in the order they were enqueued, the same as
+ * for the APriorityQueue<Job> and AHeapPriorityQueue<Job>.
+ *
+ * The heap is kept as two parallel arrays, the packed keys and the
+ * slot of the payload array holding the job of each key.  A job stays
+ * in its payload slot from when it is enqueued until it is dequeued,
+ * and the slots of dequeued jobs are reused by later enqueues.  The
+ * high 32 bits of a key are the priority of the job, and the low 32
+ * bits are the complement of its enqueue sequence number, so a job
+ * comes before another exactly when its key is larger.  When the 32
+ * bit sequence numbers run out, the items in the heap are renumbered
+ * in the order they will be dequeued.
+ *
+ * The queue is also indexed by the ids of its jobs, so the priority of
+ * a queued job can be changed, or the job removed, in O(log n) time
+ * without rebuilding the queue.  An open addressing hash table from
+ * job id to payload slot, and an array of the heap position of the key
+ * of the job in each slot, find the key of a job, and the positions
+ * are kept up to date as keys move through the heap.  The ids of the
+ * jobs in the queue must be unique.
+ *
+ * As for the AHeapPriorityQueue, the indexing operator and str() show
+ * the jobs in heap order, which is not the order in which they will be
+ * dequeued.
+ */
+class JobPriorityQueue : public Queue<Job>
+{
+public:
+  // constructors and destructors
+  JobPriorityQueue();                                      // default constructor
+  JobPriorityQueue(int initSize, Job initValues[]);        // array based constructor
+  JobPriorityQueue(const JobPriorityQueue& otherQueue);    // copy constructor
+  ~JobPriorityQueue();                                     // destructor
+
+  // accessors and information methods
+  int getAllocationSize() const;
+  Job front() const;
+  bool operator==(const Queue<Job>& rhs) const;
+  Job& operator[](int index) const;
+
+  // adding, accessing and removing values from the queue
+  void clear();
+  void enqueue(const Job& newItem);
+  void enqueue(Job&& newItem);
+  void enqueueArray(const Job* items, int count);
+  void dequeue();
+  Job dequeueValue();
+
+  // indexed access to the jobs of the queue by their id
+  bool contains(int id) const;
+  void updatePriority(int id, int priority);
+  void erase(int id);
+
+private:
+  /// @brief private constant, initial allocation size for empty queues
+  ///   to grow to
+  static const int INITIAL_ALLOCATION_SIZE = 16;
+
+  /// @brief the largest sequence number that fits in the low bits of a
+  ///   key, sequence numbers are renumbered when they pass it
+  static const uint64_t MAXIMUM_SEQUENCE = 0xffffffff;
+
+  /// @brief the number of jobs the arrays have room for
+  int allocationSize;
+
+  /// @brief the heap of packed priority and sequence number keys
+  uint64_t* keys;
+
+  /// @brief the payload slot of the job of each key, parallel to keys
+  int* slots;
+
+  /// @brief the payload array of jobs, indexed by slot
+  Job* jobs;
+
+  /// @brief the heap index of the key of the job in each slot,
+  ///   parallel to jobs
+  int* positions;
+
+  /// @brief an entry of the id table, the id of a job and its payload
+  ///   slot, or a slot of -1 for an empty entry
+  struct IdEntry
+  {
+    int id;
+    int slot;
+  };
+
+  /// @brief linear probing hash table of the payload slot of each job
+  ///   in the queue, by job id, kept at most half full
+  IdEntry* idTable;
+
+  /// @brief the number of bits of the hash of an id used to index the
+  ///   id table, which has 2^idTableBits entries
+  int idTableBits;
+
+  /// @brief stack of the payload slots not holding a job
+  int* freeSlots;
+
+  /// @brief the number of slots on the freeSlots stack
+  int freeCount;
+
+  /// @brief the sequence number to assign to the next item enqueued
+  uint64_t nextSequence;
+
+  // private member methods for managing the heap
+  static uint64_t makeKey(int priority, uint64_t sequence);
+  void growQueueToFit(int minimumSize);
+  void reallocate(int newAllocationSize);
+  void renumberSequences();
+  int idHome(int id) const;
+  int findIdEntry(int id) const;
+  void insertIdEntry(int id, int slot);
+  void removeIdEntry(int entry);
+  void rebuildIdTable();
+  int findSlot(int id, const string& method) const;
+  void placeJob(int index, const Job& job);
+  void restoreHeap(int firstNew);
+  void removeAt(int index);
+  void siftUp(int index);
+  void siftDown(int index);
+};
+
+#endif // define _JOBPRIORITYQUEUE_HPP_
@@ -0,0 +1,240 @@
+/** @file JobSchedulerSimulator.hpp
+ * @brief Discrete event simulation of a job scheduling system, driven
+ *   by any Queue of jobs.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Simulate a system that runs jobs on one or more servers.  Jobs
+ * arrive at random on a Poisson basis, wait on a job queue until a
+ * server is free, and then run for their service time.  The queue
+ * decides which waiting job runs next, so comparing the results of
+ * simulations with different kinds of queues compares scheduling
+ * policies, first come first served for the plain queues and highest
+ * priority first for the priority queues, and the time the simulation
+ * takes compares the speed of the queue implementations under load.
+ *
+ * Independent simulations, replications of the same configuration with
+ * different random number streams or a sweep over configurations, can
+ * be run in parallel, one simulation at a time on each thread of a
+ * pool, each with its own queue, and their results summarized.
+ */
+#ifndef _JOBSCHEDULERSIMULATOR_HPP_
+#define _JOBSCHEDULERSIMULATOR_HPP_
+#include "Job.hpp"
+#include "Queue.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+using namespace std;
+
+/** @enum ServiceDistribution
+ * @brief How the service times of the jobs of a simulation are chosen.
+ */
+enum ServiceDistribution
+{
+  /// @brief every job needs the mean service time
+  CONSTANT_SERVICE,
+
+  /// @brief service times are uniformly distributed between the
+  ///   minimum and maximum service time
+  UNIFORM_SERVICE,
+
+  /// @brief service times are exponentially distributed around the mean
+  ///   service time, rounded up to whole time units
+  EXPONENTIAL_SERVICE
+};
+
+/** @struct SimulationConfig
+ * @brief The parameters of a job scheduling simulation.
+ *
+ * The default configuration is a single server kept about 90% busy by
+ * jobs of ten equally likely priorities with exponentially distributed
+ * service times.
+ */
+struct SimulationConfig
+{
+  /// @brief the number of jobs to generate and run
+  long numJobs = 100000;
+
+  /// @brief the mean number of jobs arriving per unit of time
+  double arrivalRate = 0.09;
+
+  /// @brief the number of servers that run jobs at the same time
+  int numServers = 1;
+
+  /// @brief how service times are chosen
+  ServiceDistribution serviceDistribution = EXPONENTIAL_SERVICE;
+
+  /// @brief the mean service time, for constant and exponential
+  ///   service times
+  double meanServiceTime = 10.0;
+
+  /// @brief the shortest service time, for uniform service times
+  int minServiceTime = 1;
+
+  /// @brief the longest service time, for uniform service times
+  int maxServiceTime = 19;
+
+  /// @brief the relative weight of each priority, priorityMix[0] is the
+  ///   weight of priority 1, priorityMix[1] of priority 2, and so on
+  vector<double> priorityMix = vector<double>(10, 1.0);
+
+  /// @brief the seed of the random number generator, simulations with
+  ///   the same configuration generate the same jobs
+  unsigned int seed = 42;
+};
+
+/** @struct SimulationResult
+ * @brief The measurements of a job scheduling simulation.
+ *
+ * Wait times are measured from when a job arrives until it starts to
+ * run, and the cost of a job is its priority times its wait time, as
+ * for Job::getCost().
+ */
+struct SimulationResult
+{
+  /// @brief the number of jobs run
+  long jobs = 0;
+
+  /// @brief the number of arrival, dispatch and completion events
+  long events = 0;
+
+  /// @brief the time the last job completed
+  long long simulatedTime = 0;
+
+  /// @brief the wall clock time the simulation took, in seconds
+  double elapsedSeconds = 0.0;
+
+  /// @brief events simulated per wall clock second
+  double eventsPerSecond = 0.0;
+
+  /// @brief the fraction of the server time spent running jobs
+  double utilization = 0.0;
+
+  /// @brief the largest number of jobs waiting on the queue at once
+  int maxQueueSize = 0;
+
+  /// @brief the sum of the costs of all jobs
+  long long totalCost = 0;
+
+  /// @brief the mean cost of a job
+  double meanCost = 0.0;
+
+  /// @brief the mean wait time of a job
+  double meanWaitTime = 0.0;
+
+  /// @brief the median wait time
+  int medianWaitTime = 0;
+
+  /// @brief the 90th percentile wait time
+  int p90WaitTime = 0;
+
+  /// @brief the 99th percentile wait time
+  int p99WaitTime = 0;
+
+  /// @brief the longest wait time
+  int maxWaitTime = 0;
+};
+
+/** @struct SimulationSummary
+ * @brief The measurements of a set of independent simulations, such
+ *   as replications of one configuration, aggregated together.
+ *
+ * The mean cost and mean wait time are averaged over the simulations,
+ * with the half width of their 95% confidence interval, which only
+ * makes sense for replications.  The wait time percentiles are the
+ * averages of those of the simulations.
+ */
+struct SimulationSummary
+{
+  /// @brief the number of simulations summarized
+  int runs = 0;
+
+  /// @brief the number of jobs run by all of the simulations
+  long jobs = 0;
+
+  /// @brief the number of events of all of the simulations
+  long events = 0;
+
+  /// @brief the sum of the wall clock times of the simulations, in
+  ///   seconds, more than the elapsed time when they ran in parallel
+  double simulationSeconds = 0.0;
+
+  /// @brief the sum of the costs of all jobs of all simulations
+  long long totalCost = 0;
+
+  /// @brief the mean over the simulations of their mean job cost
+  double meanCost = 0.0;
+
+  /// @brief the half width of the 95% confidence interval of meanCost
+  double meanCostHalfWidth = 0.0;
+
+  /// @brief the mean over the simulations of their mean wait time
+  double meanWaitTime = 0.0;
+
+  /// @brief the half width of the 95% confidence interval of
+  ///   meanWaitTime
+  double meanWaitTimeHalfWidth = 0.0;
+
+  /// @brief the mean of the median wait times
+  double medianWaitTime = 0.0;
+
+  /// @brief the mean of the 90th percentile wait times
+  double p90WaitTime = 0.0;
+
+  /// @brief the mean of the 99th percentile wait times
+  double p99WaitTime = 0.0;
+
+  /// @brief the longest wait time of any simulation
+  int maxWaitTime = 0;
+
+  /// @brief the largest queue size of any simulation
+  int maxQueueSize = 0;
+};
+
+/** @class JobSchedulerSimulator
+ * @brief Discrete event simulator of a job scheduling system.
+ *
+ * The simulator steps from one event to the next, the arrival of a
+ * job or the completion of a job by a server, rather than through
+ * every unit of time, so quiet periods cost nothing to simulate.  At
+ * each event time completed jobs free their servers, arriving jobs are
+ * enqueued, and then jobs are dequeued onto the free servers for as
+ * long as there are both.  Times are whole time units, as for a Job.
+ *
+ * A single simulation is one event loop on one thread.  Many
+ * simulations are run in parallel by simulateReplications() and
+ * simulateSweep(), with the kind of job queue to use given as a
+ * template parameter, so that each simulation constructs its own queue
+ * on the thread running it.
+ */
+class JobSchedulerSimulator
+{
+public:
+  // constructors
+  JobSchedulerSimulator(const SimulationConfig& config);
+
+  // running simulations
+  const SimulationConfig& getConfig() const;
+  SimulationResult simulate(Queue<Job>& jobQueue) const;
+
+  // running independent simulations in parallel
+  SimulationConfig replicationConfig(int replication) const;
+  template<class JobQueue>
+  vector<SimulationResult> simulateReplications(int replications, int numThreads = 0) const;
+  template<class JobQueue>
+  static vector<SimulationResult> simulateSweep(const vector<SimulationConfig>& configs, int numThreads = 0);
+  static SimulationSummary summarize(const vector<SimulationResult>& results);
+
+private:
+  static void runInParallel(int taskCount, int numThreads, const function<void(int)>& task);
+
+  /// @brief the parameters of the simulations to run
+  SimulationConfig config;
+};
+
+#endif // _JOBSCHEDULERSIMULATOR_HPP_
@@ -28,15 +28,76 @@ using namespace std;
  *
  * Concrete implementation of Queue abstraction using a linked list based
  * implementation.  We inherit from the linked list based LQueue implementation.
- * we only override the enqueue() method so that we insert new values into
- * the queue in priority order.
+ * we override the enqueue() methods so that we insert new values into
+ * the queue in priority order.  The sorted list of nodes is indexed by a
+ * skip list, levels of sparser and sparser linked lists of index nodes
+ * that point into the list of nodes, so the insertion point of a new
+ * value is found in O(log n) expected time instead of by walking the
+ * whole list.  The dequeue() and clear() methods are overridden to keep
+ * the index up to date as nodes leave the front of the list.
  */
 template<class T>
 class LPriorityQueue : public LQueue<T>
 {
 public:
+  // constructors and destructors
+  LPriorityQueue();                                    // default constructor
+  LPriorityQueue(NodePool<T>& sharedPool);             // shared node pool constructor
+  LPriorityQueue(const LPriorityQueue<T>& otherQueue); // copy constructor
+  ~LPriorityQueue();                                   // destructor
+
   // adding, accessing and removing values from the queue
+  void clear();
   void enqueue(const T& newItem);
+  void enqueue(T&& newItem);
+  void enqueueArray(const T* items, int count);
+  void dequeue();
+  int dequeueInto(T* out, int count);
+
+  /// @brief the largest number of index levels above the list of nodes,
+  ///   enough for about 4^16 items
+  static const int MAX_INDEX_LEVEL = 16;
+
+private:
+  /// @brief An entry of one level of the skip list index, pointing to a
+  ///   node of the list
+  struct IndexNode
+  {
+    /// @brief the node of the list this entry indexes
+    Node<T>* node;
+
+    /// @brief the next entry on the same level, or nullptr at the back
+    IndexNode* next;
+
+    /// @brief the entry for the same node one level down, or nullptr
+    ///   on the lowest level
+    IndexNode* down;
+  };
+
+  /// @brief the front entry of each level of the index, lowest level
+  ///   first, nullptr for empty levels
+  IndexNode* indexFront[MAX_INDEX_LEVEL];
+
+  /// @brief the back entry of each level of the index, nullptr for
+  ///   empty levels
+  IndexNode* indexBack[MAX_INDEX_LEVEL];
+
+  /// @brief the number of levels of the index that are not empty
+  int indexLevels;
+
+  /// @brief released index entries waiting to be reused, linked through
+  ///   their next pointers
+  IndexNode* freeIndexNodes;
+
+  /// @brief state of the generator of random index levels
+  unsigned int randomState;
+
+  // private member methods for managing the index
+  void initializeIndex();
+  void clearIndex();
+  int randomIndexLevel();
+  void indexNode(Node<T>* node, IndexNode* previousIndex[]);
+  void unindexFrontNode(Node<T>* node);
 };
 
 #endif // define _LPRIORITYQUEUE_HPP_
\ No newline at end of file
@@ -12,7 +12,9 @@
  * new nodes dynamically when items are pushed onto the queue, and
  * deletes these nodes when the value is dequeued back off the front.
  * The Node structure defined in the Node.hpp header file is used by
- * this queue and is private to this queue member functions.  We use
+ * this queue and is private to this queue member functions.  Nodes are
+ * allocated from and released back to a NodePool, which recycles them
+ * rather than going to the heap for every enqueue and dequeue.  We use
  * the back of the linked list to enqueue items onto the queue, and
  * the front of the list to dequeue items from.  This is the
  * natural interpretation of the queue, and since we are only removing
@@ -22,8 +24,12 @@
 #ifndef _LQUEUE_HPP_
 #define _LQUEUE_HPP_
 #include "Node.hpp"
+#include "NodePool.hpp"
 #include "Queue.hpp"
+#include <cstddef>
+#include <iterator>
 #include <string>
+#include <type_traits>
 using namespace std;
 
 /** @class LQueue
@@ -33,27 +39,54 @@ using namespace std;
  * Concrete implementation of Queue abstraction using a dynamic
  * link listed of nodes.  We enqueue items onto the back of the
  * linked list, and dequeue them from the front of the linked list.
+ * By default each queue has its own private pool of nodes, but a pool
+ * can be shared by several queues that are given the same pool when
+ * they are constructed.
+ *
+ * The queue can be walked from front to back with forward iterators,
+ * for example with a range based for loop, which follow the links
+ * from node to node instead of searching from the front node for
+ * every index.  Enqueue does not invalidate iterators, but dequeue
+ * invalidates iterators to the items that are dequeued.
  */
 template<class T>
 class LQueue : public Queue<T>
 {
 public:
+  // iterator types
+  template<class Value>
+  class BasicIterator;
+  typedef BasicIterator<T> iterator;
+  typedef BasicIterator<const T> const_iterator;
+
   // constructors and destructors
   LQueue();                            // default constructor
+  LQueue(NodePool<T>& sharedPool);     // shared node pool constructor
   LQueue(int size, T values[]);        // array based constructor
   LQueue(const LQueue<T>& otherQueue); // copy constructor
   ~LQueue();                           // destructor
 
   // accessors and information methods
+  NodePool<T>& getNodePool() const;
   T front() const;
-  string str() const;
   bool operator==(const Queue<T>& rhs) const;
   T& operator[](int index) const;
+  bool visitSegments(const function<bool(const T*, int)>& visitor) const;
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+  const_iterator cbegin() const;
+  const_iterator cend() const;
 
   // adding, accessing and removing values from the queue
   void clear();
   void enqueue(const T& value);
+  void enqueue(T&& value);
+  void enqueueArray(const T* items, int count);
   void dequeue();
+  T dequeueValue();
+  int dequeueInto(T* out, int count);
 
 protected: // private to all except this class and its children
   /// @brief pointer to the front node of the linked list of
@@ -63,6 +96,96 @@ protected: // private to all except this class and its children
   /// @brief pointer to the back node of the linked list of
   ///   nodes that we manage for the LQueue.
   Node<T>* backNode;
+
+  /// @brief the pool that nodes of this queue are allocated from and
+  ///   released back to.
+  NodePool<T>* pool;
+
+  /// @brief true if the pool is private to this queue and should be
+  ///   destroyed with it, false if the pool is shared.
+  bool ownsPool;
+};
+
+/** @class LQueue::BasicIterator
+ * @brief Forward iterator over the values of an LQueue, from the front
+ *   of the queue to the back.
+ *
+ * The Value is T for an iterator, and const T for a const_iterator.
+ * The iterator is at a node of the list, and the end iterator is at
+ * nullptr, past the back node.  The iterator is so small and used so
+ * often that it is defined here in the header, so it can be inlined
+ * into the loops using it.
+ */
+template<class T>
+template<class Value>
+class LQueue<T>::BasicIterator
+{
+public:
+  typedef forward_iterator_tag iterator_category;
+  typedef remove_const_t<Value> value_type;
+  typedef ptrdiff_t difference_type;
+  typedef Value* pointer;
+  typedef Value& reference;
+
+  /// @brief construct an iterator at the given node, or at the end if
+  ///   the node is nullptr
+  explicit BasicIterator(Node<T>* node = nullptr)
+    : node(node)
+  {
+  }
+
+  /// @brief convert an iterator to a const_iterator
+  template<class OtherValue, class = enable_if_t<is_same<const OtherValue, Value>::value>>
+  BasicIterator(const BasicIterator<OtherValue>& other)
+    : node(other.node)
+  {
+  }
+
+  /// @brief access the value the iterator is at
+  reference operator*() const
+  {
+    return node->value;
+  }
+
+  /// @brief access a member of the value the iterator is at
+  pointer operator->() const
+  {
+    return &node->value;
+  }
+
+  /// @brief advance to the value in the next node
+  BasicIterator& operator++()
+  {
+    node = node->next;
+    return *this;
+  }
+
+  /// @brief advance to the next value, returning the iterator as it was
+  BasicIterator operator++(int)
+  {
+    BasicIterator previous = *this;
+    node = node->next;
+    return previous;
+  }
+
+  /// @brief iterators are equal if they are at the same node
+  bool operator==(const BasicIterator& rhs) const
+  {
+    return node == rhs.node;
+  }
+
+  /// @brief iterators are not equal if they are at different nodes
+  bool operator!=(const BasicIterator& rhs) const
+  {
+    return node != rhs.node;
+  }
+
+private:
+  template<class OtherValue>
+  friend class BasicIterator;
+
+  /// @brief the node the iterator is at, or nullptr at the end
+  Node<T>* node;
 };
 
 #endif // define _LQUEUE_HPP_
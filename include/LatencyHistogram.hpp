@@ -0,0 +1,95 @@
+/** @file LatencyHistogram.hpp
+ * @brief Fixed memory histogram of operation latencies, for finding
+ *   percentiles such as the median and the 99.9th percentile.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Declare a histogram of latencies in nanoseconds in the style of the
+ * HdrHistogram.  Latencies are counted in buckets whose width grows
+ * with the latency, so that every latency is counted to within about
+ * 1.6% of its value, whether it is a few nanoseconds or many seconds,
+ * using a fixed block of counters.  Recording a latency is a few
+ * instructions and never allocates, so it can be done on every
+ * operation of a queue, and percentiles of any number of recorded
+ * latencies are found in a single pass over the counters.
+ */
+#ifndef _LATENCY_HISTOGRAM_HPP_
+#define _LATENCY_HISTOGRAM_HPP_
+#include <iostream>
+#include <string>
+using namespace std;
+
+/** @class LatencyHistogram
+ * @brief A histogram of latencies with a fixed relative precision.
+ *
+ * Latencies below 64 nanoseconds each have their own bucket.  Above
+ * that, each doubling of the latency, 64 to 127, 128 to 255 and so
+ * on, is split into 64 buckets of equal width, so the width of a
+ * bucket is never more than 1/64 of the latencies it holds.
+ * Latencies of 2^40 nanoseconds, about 18 minutes, or more are counted
+ * in the last bucket.  The exact minimum, maximum and mean of the
+ * recorded latencies are kept as well.
+ */
+class LatencyHistogram
+{
+public:
+  // constructors
+  LatencyHistogram();
+
+  // accessors and information methods
+  long long getCount() const;
+  long long getMinimum() const;
+  long long getMaximum() const;
+  double getMean() const;
+  long long percentile(double percent) const;
+  void write(ostream& out) const;
+  string str() const;
+
+  // recording latencies
+  void record(long long nanoseconds);
+  void reset();
+  LatencyHistogram& operator+=(const LatencyHistogram& rhs);
+
+private:
+  /// @brief private constant, the number of bits of a latency that
+  ///   select its bucket within a doubling of latencies
+  static const int SUB_BUCKET_BITS = 6;
+
+  /// @brief private constant, the number of buckets each doubling of
+  ///   latencies is split into
+  static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+
+  /// @brief private constant, latencies of 2 to this power or more
+  ///   are counted in the last bucket
+  static const int MAXIMUM_EXPONENT = 40;
+
+  /// @brief private constant, the number of buckets
+  static const int BUCKET_COUNT = (MAXIMUM_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+  /// @brief the number of latencies counted in each bucket
+  long long counts[BUCKET_COUNT];
+
+  /// @brief the number of latencies recorded
+  long long count;
+
+  /// @brief the smallest latency recorded
+  long long minimum;
+
+  /// @brief the largest latency recorded
+  long long maximum;
+
+  /// @brief the sum of the latencies recorded, for their mean
+  long long total;
+
+  // private member methods for finding buckets
+  static int bucketOf(long long nanoseconds);
+  static long long highestIn(int bucket);
+};
+
+ostream& operator<<(ostream& out, const LatencyHistogram& rhs);
+
+#endif // _LATENCY_HISTOGRAM_HPP_
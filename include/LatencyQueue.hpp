@@ -0,0 +1,87 @@
+/** @file LatencyQueue.hpp
+ * @brief Wrapper around any Queue that records the latencies of its
+ *   enqueue and dequeue operations.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Measure how long each enqueue and dequeue of a queue takes, so that
+ * the slow operations in the tail of the latency distribution, such
+ * as those that have to grow an array queue or reorder a priority
+ * queue, can be seen in its percentiles rather than averaged away.
+ * The LatencyQueue is itself a Queue, so it can be used in place of
+ * the queue it wraps, and recording can be turned on and off for each
+ * instance while the program runs.
+ */
+#ifndef _LATENCY_QUEUE_HPP_
+#define _LATENCY_QUEUE_HPP_
+#include "LatencyHistogram.hpp"
+#include "Queue.hpp"
+#include <chrono>
+using namespace std;
+
+/** @class LatencyQueue
+ * @brief The LatencyQueue times the operations of another Queue.
+ *
+ * Every operation is passed on to the wrapped queue, which must
+ * outlive this wrapper and is not owned by it.  While recording, the
+ * time taken by each enqueue is recorded in one LatencyHistogram and
+ * the time taken by each dequeue in another, measured with the
+ * steady clock, which costs a few tens of nanoseconds to read.  A
+ * batch operation, enqueueArray() or dequeueInto(), is recorded as a
+ * single latency.  When not recording, the only overhead is the test
+ * of the recording flag and one virtual call.
+ */
+template<class T>
+class LatencyQueue : public Queue<T>
+{
+public:
+  // constructors
+  explicit LatencyQueue(Queue<T>& queue, bool recording = true);
+
+  // accessors and information methods
+  int getSize() const;
+  bool isEmpty() const;
+  T front() const;
+  bool operator==(const Queue<T>& rhs) const;
+  T& operator[](int index) const;
+  bool visitSegments(const function<bool(const T*, int)>& visitor) const;
+
+  // latency recording
+  bool isRecording() const;
+  void setRecording(bool recording);
+  const LatencyHistogram& getEnqueueLatency() const;
+  const LatencyHistogram& getDequeueLatency() const;
+  void resetLatency();
+
+  // adding, accessing and removing values from the queue
+  void clear();
+  void enqueue(const T& newItem);
+  void enqueue(T&& newItem);
+  void enqueueArray(const T* items, int count);
+  void dequeue();
+  T dequeueValue();
+  int dequeueInto(T* out, int count);
+
+private:
+  /// @brief the queue whose operations are timed
+  Queue<T>& queue;
+
+  /// @brief true while latencies are being recorded
+  bool recording;
+
+  /// @brief the latencies of enqueue operations
+  LatencyHistogram enqueueLatency;
+
+  /// @brief the latencies of dequeue operations
+  LatencyHistogram dequeueLatency;
+
+  // private member methods for timing operations
+  static chrono::steady_clock::time_point now();
+  static long long nanosecondsSince(chrono::steady_clock::time_point start);
+};
+
+#endif // _LATENCY_QUEUE_HPP_
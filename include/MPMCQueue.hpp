@@ -0,0 +1,127 @@
+/** @file MPMCQueue.hpp
+ * @brief Concrete lock-free multi-producer/multi-consumer bounded
+ *   implementation of Queue ADT.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement the Queue abstraction as a fixed size circular buffer that
+ * any number of threads can enqueue to and dequeue from at the same
+ * time without any locks.  This is the bounded array queue described
+ * by Dmitry Vyukov: every cell of the buffer has its own sequence
+ * number, which tells a producer when the cell is free to be filled
+ * and a consumer when the cell holds a value ready to be taken.
+ * Threads claim a cell by advancing a shared enqueue or dequeue
+ * position with a compare and swap, and then fill or empty the cell
+ * without interference from any other thread.
+ */
+#ifndef _MPMCQUEUE_HPP_
+#define _MPMCQUEUE_HPP_
+#include "Queue.hpp"
+#include <atomic>
+#include <string>
+using namespace std;
+
+/** @class MPMCQueue
+ * @brief The MPMCQueue concrete lock-free bounded implementation of
+ *   the Queue interface for any number of producer and consumer
+ *   threads.
+ *
+ * The capacity is rounded up to a power of two when the queue is
+ * constructed and the buffer never grows.  The enqueue() method waits
+ * for room when the queue is full, and waitDequeue() waits for an
+ * item when the queue is empty, while tryEnqueue() and tryDequeue()
+ * return immediately.  As for every other Queue, dequeue(),
+ * dequeueValue() and front() throw if the queue is empty.
+ *
+ * getSize() and isEmpty() may be called from any thread, but are only
+ * an approximation while other threads are changing the queue.
+ * front(), the indexing operator, str() and operator== should only be
+ * used when no thread is changing the queue.
+ */
+template<class T>
+class MPMCQueue : public Queue<T>
+{
+public:
+  // constructors and destructors
+  MPMCQueue(int capacity = DEFAULT_CAPACITY);    // bounded capacity constructor
+  MPMCQueue(const MPMCQueue<T>& otherQueue) = delete;
+  ~MPMCQueue();                                  // destructor
+
+  // accessors and information methods
+  int getSize() const;
+  bool isEmpty() const;
+  int getCapacity() const;
+  T front() const;
+  bool operator==(const Queue<T>& rhs) const;
+  T& operator[](int index) const;
+
+  // adding, accessing and removing values from the queue
+  void clear();
+  void enqueue(const T& newItem);
+  void enqueue(T&& newItem);
+  bool tryEnqueue(const T& newItem);
+  bool tryEnqueue(T&& newItem);
+  void dequeue();
+  T dequeueValue();
+  bool tryDequeue(T& item);
+  int dequeueInto(T* out, int count);
+  void waitDequeue(T& item);
+
+  /// @brief the capacity of a queue if no capacity is asked for
+  static const int DEFAULT_CAPACITY = 1024;
+
+  /// @brief the largest capacity a queue can have, the largest power
+  ///   of two an int can hold
+  static constexpr int MAXIMUM_CAPACITY = 1 << 30;
+
+  /// @brief the assumed size of a cache line, the positions written
+  ///   by producers and consumers are kept this far apart
+  static const int CACHE_LINE_SIZE = 64;
+
+private:
+  /** @brief one slot of the circular buffer
+   *
+   * A cell whose sequence equals an enqueue position is free for the
+   * producer that claims that position, and a cell whose sequence is
+   * one past a dequeue position holds a value for the consumer that
+   * claims that position.
+   */
+  struct Cell
+  {
+    /// @brief the position this cell is next waiting to be claimed at
+    atomic<unsigned long> sequence;
+
+    /// @brief the value held in this cell
+    T value;
+  };
+
+  /// @brief the position of the next cell to be filled, shared by all
+  ///   of the producer threads.
+  alignas(CACHE_LINE_SIZE) atomic<unsigned long> enqueuePosition;
+
+  /// @brief the position of the next cell to be emptied, shared by all
+  ///   of the consumer threads.
+  alignas(CACHE_LINE_SIZE) atomic<unsigned long> dequeuePosition;
+
+  /// @brief the fixed number of items the buffer can hold, always
+  ///   a power of two.
+  alignas(CACHE_LINE_SIZE) int capacity;
+
+  /// @brief the mask that maps a position to its index in the circular
+  ///   buffer of cells.
+  unsigned long indexMask;
+
+  /// @brief the fixed block of memory holding the circular buffer of
+  ///   cells.
+  Cell* cells;
+
+  // private member methods for claiming cells
+  Cell* claimEnqueueCell(unsigned long& position);
+  Cell* claimDequeueCell(unsigned long& position);
+};
+
+#endif // define _MPMCQUEUE_HPP_
@@ -0,0 +1,91 @@
+/** @file NodePool.hpp
+ * @brief Pooled allocator of Node items used by the linked list
+ *   queues.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * A NodePool hands out Node items to the linked list queues, and takes
+ * them back again when values are dequeued.  Instead of going to the
+ * heap for every single node, nodes are allocated in contiguous chunks,
+ * and nodes that are given back are kept on a free list to be recycled
+ * by the next enqueue.
+ */
+#ifndef _NODEPOOL_HPP_
+#define _NODEPOOL_HPP_
+#include "Node.hpp"
+#include <vector>
+using namespace std;
+
+/** @class NodePool
+ * @brief A slab and free list allocator of Node<T> items.
+ *
+ * Nodes are carved out of chunks of chunkSize nodes that are allocated
+ * together in one block of memory, so nodes allocated one after another
+ * are near each other in memory.  Nodes that are released are pushed
+ * on a free list, linked through their next pointers, and handed back
+ * out before any new chunk is carved.  Chunks are raw memory: the value
+ * of a node is constructed when the node is allocated, and destroyed
+ * when it is released.  Released nodes keep their
+ * chunks allocated for reuse, the chunks are returned to the heap by
+ * freeChunks() once no node of the pool is in use, for example when
+ * the queues using it are cleared, or when the pool itself is
+ * destroyed.  A pool can be private to a
+ * single queue, or shared by several queues of the same type, in which
+ * case the pool must outlive all of the queues using it.
+ */
+template<class T>
+class NodePool
+{
+public:
+  // constructors and destructors
+  NodePool(int chunkSize = DEFAULT_CHUNK_SIZE);
+  NodePool(const NodePool<T>& otherPool) = delete;
+  ~NodePool();
+
+  // accessors and information methods
+  int getChunkSize() const;
+  int getChunksAllocated() const;
+  long getNodesRecycled() const;
+  long getNodesInUse() const;
+
+  // allocating and releasing nodes
+  Node<T>* allocate(const T& value);
+  Node<T>* allocate(T&& value);
+  void release(Node<T>* node);
+  void release(Node<T>* firstNode, Node<T>* lastNode, long count);
+  void freeChunks();
+
+  /// @brief the number of nodes allocated together in each chunk
+  ///   if no chunk size is asked for
+  static const int DEFAULT_CHUNK_SIZE = 256;
+
+private:
+  /// @brief the number of nodes allocated in each chunk
+  int chunkSize;
+
+  /// @brief the chunks of nodes allocated by this pool so far
+  vector<Node<T>*> chunks;
+
+  /// @brief the index of the next never used node in the most
+  ///   recently allocated chunk
+  int nextFreshNode;
+
+  /// @brief the list of released nodes waiting to be recycled, linked
+  ///   through their next pointers
+  Node<T>* freeList;
+
+  /// @brief count of the allocations that were given a recycled node
+  long nodesRecycled;
+
+  /// @brief the number of nodes allocated and not yet released
+  long nodesInUse;
+
+  // private member methods for managing the chunks
+  Node<T>* allocateNode();
+};
+
+#endif // define _NODEPOOL_HPP_
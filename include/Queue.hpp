@@ -15,7 +15,12 @@
  */
 #ifndef _QUEUE_HPP_
 #define _QUEUE_HPP_
+#include "QueueStatistics.hpp"
+#include <functional>
 #include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
 using namespace std;
 
 /** @class Queue
@@ -25,23 +30,42 @@ using namespace std;
  * provides the ability to perform the most common tasks we want to
  * perform with queues, such as enqueue and dequeue items from the
  * queue and retrieve the item now at the front of the queue.
+ *
+ * Every queue is shown the same way, as its size and its values from
+ * front to back.  write() streams this straight to an output stream,
+ * and optionally shows only the first few values, while str() and the
+ * output stream operator are built on top of it.
  */
 template<class T>
 class Queue
 {
 public:
   // accessor and information methods
-  int getSize() const;
-  bool isEmpty() const;
+  virtual int getSize() const;
+  virtual bool isEmpty() const;
   virtual T front() const = 0;
-  virtual string str() const = 0;
+  virtual string str() const;
+  void write(ostream& out, int maxElements = -1) const;
   virtual bool operator==(const Queue<T>& rhs) const = 0;
   virtual T& operator[](int index) const = 0;
+  virtual bool visitSegments(const function<bool(const T*, int)>& visitor) const;
 
   // adding, accessing and removing values from the queue
   virtual void clear() = 0;
   virtual void enqueue(const T& newItem) = 0;
+  virtual void enqueue(T&& newItem) = 0;
+  template<typename... Args>
+  void emplace(Args&&... args);
+  virtual void enqueueArray(const T* items, int count);
+  template<typename Iterator>
+  void enqueueRange(Iterator first, Iterator last);
   virtual void dequeue() = 0;
+  virtual T dequeueValue() = 0;
+  virtual int dequeueInto(T* out, int count);
+
+  // instrumentation of the work done by the queue operations
+  QueueStatistics getStatistics() const;
+  void resetStatistics();
 
   // friend functions and friend operators
   template<typename U>
@@ -51,6 +75,114 @@ protected: // private to this class and its children
   /// @brief the current size of the queue of values, this is
   ///   protected so derived classes can access it
   int size;
+
+#ifdef QUEUE_STATISTICS
+  /// @brief the counts of the work done by the operations of this
+  ///   queue, mutable so they can also be counted by const methods
+  mutable QueueStatistics statistics;
+#endif
+
+  template<typename Iterator>
+  bool equalsInOrder(Iterator first, const Queue<T>& rhs) const;
+  bool equalsInOrder(const Queue<T>& rhs) const;
 };
 
+/**
+ * @brief Construct value on back of queue
+ *
+ * Construct a new value of type T from the given constructor arguments
+ * and enqueue it, moving the new value into the queue instead of
+ * copying it.  This is a member template, so unlike the rest of the
+ * Queue member functions it has to be defined here in the header.
+ *
+ * @param args The arguments to pass to the constructor of type T.
+ */
+template<class T>
+template<typename... Args>
+void Queue<T>::emplace(Args&&... args)
+{
+  enqueue(T(std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Enqueue range of values on back of queue
+ *
+ * Enqueue copies of all of the values in the range from first up to
+ * but not including last, in order, as a single batch.  A range of
+ * values that are contiguous in memory, given by pointers into an
+ * array or by iterators of a vector<T>, is handed straight to
+ * enqueueArray(), any other range is first copied into a contiguous
+ * block.  This is a member template, so it has to be defined here in
+ * the header.
+ *
+ * @param first An iterator to the first value to enqueue.
+ * @param last An iterator just past the last value to enqueue.
+ */
+template<class T>
+template<typename Iterator>
+void Queue<T>::enqueueRange(Iterator first, Iterator last)
+{
+  if constexpr (is_convertible<Iterator, const T*>::value)
+  {
+    enqueueArray(first, last - first);
+  }
+  else if constexpr (is_same<Iterator, typename vector<T>::iterator>::value or
+                     is_same<Iterator, typename vector<T>::const_iterator>::value)
+  {
+    if (first != last)
+    {
+      enqueueArray(&*first, last - first);
+    }
+  }
+  else
+  {
+    vector<T> items(first, last);
+    enqueueArray(items.data(), items.size());
+  }
+}
+
+/**
+ * @brief Compare values in order with another queue
+ *
+ * Check if the values starting from the given iterator over this queue
+ * are equal to the values of the rhs queue, in order from front to
+ * back.  The rhs queue is walked once with visitSegments(), so the
+ * comparison is linear time whatever kind of queue rhs is, and there
+ * is only one virtual call for each segment of rhs rather than for
+ * each value.  This is the common part of the operator== of concrete
+ * queues that can iterate over their own values.  This is a member
+ * template, so it has to be defined here in the header.
+ *
+ * @param first An iterator to the front value of this queue.
+ * @param rhs The other queue on the right hand side of the
+ *   boolean comparison that we are comparing this Queue to.
+ *
+ * @returns bool true if the queues are equal, false if the are not.
+ */
+template<class T>
+template<typename Iterator>
+bool Queue<T>::equalsInOrder(Iterator first, const Queue<T>& rhs) const
+{
+  // first the queues have to be of the same size, or else they
+  // cannot be equal
+  if (getSize() != rhs.getSize())
+  {
+    return false;
+  }
+
+  // then compare each segment of rhs with the next values of this
+  // queue, stopping the visit at the first pair that is not equal
+  return rhs.visitSegments([&first](const T* segment, int count) {
+    for (int index = 0; index < count; index++)
+    {
+      if (*first != segment[index])
+      {
+        return false;
+      }
+      ++first;
+    }
+    return true;
+  });
+}
+
 #endif // _QUEUE_HPP_
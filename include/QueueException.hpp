@@ -55,4 +55,65 @@ private:
   string message;
 };
 
+/** @class QueueSnapshotException
+ * @brief Snapshot Exception for the Queue class.
+ *
+ * Exception to be thrown by our Queue class if a snapshot of a queue
+ * can not be saved or restored, because the stream failed, the
+ * snapshot is not a valid snapshot of a queue of this item type, or
+ * the item type can not be saved in a binary snapshot.
+ *
+ */
+class QueueSnapshotException : public exception
+{
+public:
+  explicit QueueSnapshotException(const string& message);
+  ~QueueSnapshotException();
+  virtual const char* what() const throw();
+
+private:
+  /// Stores the particular message describing what caused the exception.
+  string message;
+};
+
+/** @class QueueSpillException
+ * @brief Spill Exception for the Queue class.
+ *
+ * Exception to be thrown by our SpillQueue class if the segment files
+ * holding the items spilled to disk can not be created, written or
+ * read.
+ *
+ */
+class QueueSpillException : public exception
+{
+public:
+  explicit QueueSpillException(const string& message);
+  ~QueueSpillException();
+  virtual const char* what() const throw();
+
+private:
+  /// Stores the particular message describing what caused the exception.
+  string message;
+};
+
+/** @class QueueKeyException
+ * @brief Key Exception for the Queue class.
+ *
+ * Exception to be thrown by our indexed Queue classes if an item is
+ * looked up by a key that no item in the queue has, or an item is
+ * enqueued with a key that another item in the queue already has.
+ *
+ */
+class QueueKeyException : public exception
+{
+public:
+  explicit QueueKeyException(const string& message);
+  ~QueueKeyException();
+  virtual const char* what() const throw();
+
+private:
+  /// Stores the particular message describing what caused the exception.
+  string message;
+};
+
 #endif // _QUEUE_EXCEPTION_HPP_
\ No newline at end of file
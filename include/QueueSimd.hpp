@@ -0,0 +1,31 @@
+/** @file QueueSimd.hpp
+ * @brief Vectorized search and comparison of blocks of integer values,
+ *   used by the array based queues.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Search and compare contiguous blocks of int values several values at
+ * a time with SIMD instructions.  On x86 processors that support AVX2
+ * eight values are compared with each instruction, on other x86
+ * processors the SSE2 instructions, which every 64 bit x86 processor
+ * has, compare four at a time, and on other processors the values are
+ * compared one at a time.  The instruction set is picked once, the
+ * first time one of the functions is called, by asking the processor
+ * what it supports, so the same program runs on any x86 processor.
+ */
+#ifndef _QUEUE_SIMD_HPP_
+#define _QUEUE_SIMD_HPP_
+#include <string>
+using namespace std;
+
+// searching and comparing blocks of int values
+int simdFind(const int* values, int count, int value);
+int simdCount(const int* values, int count, int value);
+bool simdEqual(const int* lhs, const int* rhs, int count);
+string simdInstructionSet();
+
+#endif // _QUEUE_SIMD_HPP_
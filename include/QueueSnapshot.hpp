@@ -0,0 +1,161 @@
+/** @file QueueSnapshot.hpp
+ * @brief Binary snapshot format for saving and restoring array based
+ *   queues.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * A snapshot is a small fixed size header followed by one fixed size
+ * record for every item of the queue, from the front of the queue to
+ * the back.  The codec for the item type decides what a record looks
+ * like.  A trivially copyable type is simply written out byte for
+ * byte, so a whole block of items can be written or read with a
+ * single stream operation, and the Job has its own codec that writes
+ * each of its fields as a fixed width integer.  A type without a
+ * codec, like string, can not be saved in a snapshot.
+ */
+#ifndef _QUEUE_SNAPSHOT_HPP_
+#define _QUEUE_SNAPSHOT_HPP_
+#include "Job.hpp"
+#include <cstdint>
+#include <type_traits>
+using namespace std;
+
+/// @brief the magic bytes at the start of every queue snapshot
+const char QUEUE_SNAPSHOT_MAGIC[8] = {'Q', 'S', 'N', 'A', 'P', 'S', 'H', 'T'};
+
+/// @brief the version of the snapshot format written by this code
+const uint32_t QUEUE_SNAPSHOT_VERSION = 1;
+
+/** @struct QueueSnapshotHeader
+ * @brief The header written at the start of a queue snapshot.
+ *
+ * The record size is checked when a snapshot is restored, so a
+ * snapshot of one item type can not be restored into a queue of
+ * another item type of a different size.
+ */
+struct QueueSnapshotHeader
+{
+  /// @brief always QUEUE_SNAPSHOT_MAGIC
+  char magic[8];
+
+  /// @brief the version of the snapshot format
+  uint32_t version;
+
+  /// @brief the size in bytes of each item record
+  uint32_t recordSize;
+
+  /// @brief the number of item records following the header
+  uint64_t count;
+};
+
+/** @struct QueueSnapshotCodec
+ * @brief Converts items to and from the records of a snapshot.
+ *
+ * This general template is for item types that can not be saved in a
+ * snapshot.  A codec that can has SUPPORTED true, a Record type, and
+ * static encode() and decode() methods converting a T to and from a
+ * Record.  The IDENTITY flag tells the queue the Record is the T
+ * itself, so a block of items can be written and read as is.
+ */
+template<class T, class Enable = void>
+struct QueueSnapshotCodec
+{
+  /// @brief this item type can not be saved in a snapshot
+  static const bool SUPPORTED = false;
+
+  /// @brief the records are not the items themselves
+  static const bool IDENTITY = false;
+};
+
+/** @struct QueueSnapshotCodec
+ * @brief Codec for trivially copyable item types, which are their own
+ *   record.
+ */
+template<class T>
+struct QueueSnapshotCodec<T, enable_if_t<is_trivially_copyable<T>::value>>
+{
+  /// @brief a record is the bytes of the item itself
+  typedef T Record;
+
+  /// @brief this item type can be saved in a snapshot
+  static const bool SUPPORTED = true;
+
+  /// @brief the records are the items themselves
+  static const bool IDENTITY = true;
+
+  /// @brief the record for an item is a copy of it
+  static Record encode(const T& item)
+  {
+    return item;
+  }
+
+  /// @brief the item for a record is a copy of it
+  static T decode(const Record& record)
+  {
+    return record;
+  }
+};
+
+/** @struct QueueSnapshotCodec
+ * @brief Codec for Job items.
+ *
+ * Each field of the Job is written as a fixed width 32 bit integer,
+ * so the snapshot does not depend on the size of an int or on how
+ * the compiler lays out the Job.  Decoding does not use the default
+ * Job constructor, so restoring jobs does not use up job ids.
+ */
+template<>
+struct QueueSnapshotCodec<Job>
+{
+  /** @brief the fields of a Job as they are saved in a snapshot
+   */
+  struct Record
+  {
+    /// @brief the id of the job
+    int32_t id;
+
+    /// @brief the priority of the job
+    int32_t priority;
+
+    /// @brief the service time of the job
+    int32_t serviceTime;
+
+    /// @brief the time the job was created
+    int32_t startTime;
+
+    /// @brief the time the job stopped waiting
+    int32_t endTime;
+  };
+
+  /// @brief jobs can be saved in a snapshot
+  static const bool SUPPORTED = true;
+
+  /// @brief the records are not the jobs themselves
+  static const bool IDENTITY = false;
+
+  /// @brief the record of the fields of a job
+  static Record encode(const Job& job)
+  {
+    Record record;
+    record.id = job.getId();
+    record.priority = job.getPriority();
+    record.serviceTime = job.getServiceTime();
+    record.startTime = job.getStartTime();
+    record.endTime = job.getEndTime();
+    return record;
+  }
+
+  /// @brief the job with the fields of a record
+  static Job decode(const Record& record)
+  {
+    Job job(record.priority, record.serviceTime, record.startTime, record.id);
+    job.setEndTime(record.endTime);
+    return job;
+  }
+};
+
+#endif // _QUEUE_SNAPSHOT_HPP_
@@ -0,0 +1,91 @@
+/** @file QueueStatistics.hpp
+ * @brief Counters of the work done by the operations of a Queue,
+ *   compiled in only when QUEUE_STATISTICS is defined.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Declare the counters kept by a queue of how many items it enqueued
+ * and dequeued, how often it reallocated its memory, how many bytes
+ * it copied doing so, and how many comparisons and swaps it needed
+ * to keep its items in order.  The queues only keep the counters when
+ * the whole program is built with QUEUE_STATISTICS defined, for
+ * example with
+ *
+ *   $ make STATISTICS=1 bench
+ *
+ * Otherwise the QUEUE_COUNT() macro the queues count with expands to
+ * nothing, queues have no counters to keep, and getStatistics() always
+ * returns all zero counters, so there is no cost at all.  Every file
+ * has to be built the same way, since the counters change the size of
+ * a Queue.
+ */
+#ifndef _QUEUE_STATISTICS_HPP_
+#define _QUEUE_STATISTICS_HPP_
+#include <iostream>
+#include <string>
+using namespace std;
+
+#ifdef QUEUE_STATISTICS
+/// @brief add amount to the named counter of the statistics of this queue
+#define QUEUE_COUNT(counter, amount) (this->statistics.counter += (amount))
+#else
+/// @brief counters are not kept, and the amount is not even evaluated
+#define QUEUE_COUNT(counter, amount) ((void)0)
+#endif
+
+/** @struct QueueStatistics
+ * @brief The counts of the work done by the operations of a queue.
+ *
+ * A swap is an item moved one place, or one level of a heap, to make
+ * room for an item or to keep the items in order, whether it is done
+ * as a swap or as a shift into a hole.  A comparison is a comparison
+ * of the priorities of two items.  Grows and shrinks are reallocations
+ * of the memory of the queue to a larger or smaller block, and the
+ * bytes copied are those of the items, and their bookkeeping, moved
+ * by reallocations and shifts.  The concurrent queues do not keep
+ * statistics, since the counters are not safe to update from more than
+ * one thread.
+ */
+struct QueueStatistics
+{
+  /// @brief true if the program was built to keep statistics
+#ifdef QUEUE_STATISTICS
+  static constexpr bool ENABLED = true;
+#else
+  static constexpr bool ENABLED = false;
+#endif
+
+  /// @brief the number of items enqueued
+  long enqueues = 0;
+
+  /// @brief the number of items dequeued
+  long dequeues = 0;
+
+  /// @brief the number of times the memory of the queue was grown
+  long grows = 0;
+
+  /// @brief the number of times the memory of the queue was shrunk
+  long shrinks = 0;
+
+  /// @brief the number of bytes copied by reallocations and shifts
+  long long bytesCopied = 0;
+
+  /// @brief the number of comparisons of item priorities
+  long comparisons = 0;
+
+  /// @brief the number of items swapped or shifted into place
+  long swaps = 0;
+
+  void reset();
+  QueueStatistics& operator+=(const QueueStatistics& rhs);
+  void write(ostream& out) const;
+  string str() const;
+};
+
+ostream& operator<<(ostream& out, const QueueStatistics& rhs);
+
+#endif // _QUEUE_STATISTICS_HPP_
@@ -0,0 +1,121 @@
+/** @file SPSCQueue.hpp
+ * @brief Concrete lock-free single-producer/single-consumer bounded
+ *   implementation of Queue ADT.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement the Queue abstraction as a fixed size circular buffer that
+ * can be safely shared by two threads, one thread that only enqueues
+ * (the producer) and one thread that only dequeues (the consumer),
+ * without any locks.  Like the AQueue, the values are held in a
+ * circular buffer, but the front and back of the queue are kept as
+ * atomic counters so that each thread can see the progress of the
+ * other.  The buffer never grows, a producer that finds the buffer
+ * full has to wait for the consumer to make room.
+ */
+#ifndef _SPSCQUEUE_HPP_
+#define _SPSCQUEUE_HPP_
+#include "Queue.hpp"
+#include <atomic>
+#include <string>
+using namespace std;
+
+/** @class SPSCQueue
+ * @brief The SPSCQueue concrete lock-free bounded implementation of
+ *   the Queue interface for one producer and one consumer thread.
+ *
+ * The capacity is rounded up to a power of two when the queue is
+ * constructed, so the head and tail counters can be mapped to buffer
+ * indexes with a bit mask.  The head counter is only written by the
+ * consumer and the tail counter only by the producer, and each is kept
+ * on its own cache line together with the cached copy of the other
+ * counter that only the same thread uses, so the two threads do not
+ * contend for the same cache line on every operation.
+ *
+ * The enqueue() and tryEnqueue() methods may only be called by the
+ * producer thread, and front(), dequeue(), dequeueValue(), tryDequeue()
+ * and clear() only by the consumer thread.  getSize() and isEmpty()
+ * may be called by either, but the answer can be out of date by the
+ * time it is used.  The indexing operator, str() and operator==
+ * should only be used when neither thread is changing the queue.
+ */
+template<class T>
+class SPSCQueue : public Queue<T>
+{
+public:
+  // constructors and destructors
+  SPSCQueue(int capacity = DEFAULT_CAPACITY);    // bounded capacity constructor
+  SPSCQueue(const SPSCQueue<T>& otherQueue) = delete;
+  ~SPSCQueue();                                  // destructor
+
+  // accessors and information methods
+  int getSize() const;
+  bool isEmpty() const;
+  int getCapacity() const;
+  T front() const;
+  bool operator==(const Queue<T>& rhs) const;
+  T& operator[](int index) const;
+  bool visitSegments(const function<bool(const T*, int)>& visitor) const;
+
+  // adding, accessing and removing values from the queue
+  void clear();
+  void enqueue(const T& newItem);
+  void enqueue(T&& newItem);
+  bool tryEnqueue(const T& newItem);
+  bool tryEnqueue(T&& newItem);
+  void dequeue();
+  T dequeueValue();
+  bool tryDequeue(T& item);
+
+  /// @brief the capacity of a queue if no capacity is asked for
+  static const int DEFAULT_CAPACITY = 1024;
+
+  /// @brief the largest capacity a queue can have, the largest power
+  ///   of two an int can hold
+  static constexpr int MAXIMUM_CAPACITY = 1 << 30;
+
+  /// @brief the assumed size of a cache line, the counters written by
+  ///   the two threads are kept this far apart
+  static const int CACHE_LINE_SIZE = 64;
+
+private:
+  /// @brief the counter of the next item to be dequeued, only written
+  ///   by the consumer thread.
+  alignas(CACHE_LINE_SIZE) atomic<unsigned long> head;
+
+  /// @brief the consumer thread copy of the tail counter the last time
+  ///   it was read, so the consumer only needs to read the shared
+  ///   tail when the queue looks empty.
+  unsigned long cachedTail;
+
+  /// @brief the counter of the next free slot to enqueue into, only
+  ///   written by the producer thread.
+  alignas(CACHE_LINE_SIZE) atomic<unsigned long> tail;
+
+  /// @brief the producer thread copy of the head counter the last time
+  ///   it was read, so the producer only needs to read the shared
+  ///   head when the queue looks full.
+  unsigned long cachedHead;
+
+  /// @brief the fixed number of items the buffer can hold, always
+  ///   a power of two.
+  alignas(CACHE_LINE_SIZE) int capacity;
+
+  /// @brief the mask that maps a head or tail counter to its index in
+  ///   the circular buffer of values.
+  unsigned long indexMask;
+
+  /// @brief the fixed block of memory holding the circular buffer of
+  ///   values.
+  T* values;
+
+  // private member methods for the producer and consumer
+  bool isFull(unsigned long currentTail);
+  bool hasItem(unsigned long currentHead);
+};
+
+#endif // define _SPSCQUEUE_HPP_
@@ -0,0 +1,167 @@
+/** @file SpillQueue.hpp
+ * @brief Concrete disk spilling implementation of Queue ADT, for
+ *   queues that can grow larger than the memory set aside for them.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement the Queue abstraction with a fixed memory budget.  The
+ * items at the front of the queue, which will be dequeued next, and
+ * the items at the back, which were enqueued last, are held in memory
+ * in two array based queues.  When the back of the queue fills its
+ * half of the budget, its items are appended to a segment file on
+ * disk, so the middle of a very long queue is paged out to disk in
+ * the order it was enqueued.  When the front of the queue runs dry,
+ * it is refilled with a long sequential read of the oldest segment,
+ * and segment files are deleted once they have been read.
+ */
+#ifndef _SPILLQUEUE_HPP_
+#define _SPILLQUEUE_HPP_
+#include "AQueue.hpp"
+#include "Queue.hpp"
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <string>
+using namespace std;
+
+/** @class SpillQueue
+ * @brief The SpillQueue concrete disk spilling implementation of the
+ *   Queue interface.
+ *
+ * Items are written to disk as the records of a queue snapshot, so
+ * only items that can be saved in a snapshot, trivially copyable types
+ * and Job, can be held in a SpillQueue.  Each queue writes its own
+ * segment files into the given spill directory, and deletes them when
+ * they have been read, or when the queue is cleared or destroyed.
+ *
+ * The memory budget is allocated up front, half for the front of the
+ * queue and half for the back.  Enqueue and dequeue are constant time
+ * O(1) operations, except for the enqueue that spills the back of the
+ * queue to disk and the dequeue that refills the front, which each
+ * move half a budget of items in one long sequential write or read.
+ * The indexing operator can read an item that is on disk, but it has
+ * to seek to it, and returns a reference to a copy of the item that
+ * is only good until the next index, so it should not be used to
+ * walk the queue.  visitSegments() reads the items on disk in long
+ * sequential blocks, so it, str() and operator== should be used
+ * instead.
+ */
+template<class T>
+class SpillQueue : public Queue<T>
+{
+public:
+  // constructors and destructors
+  SpillQueue(const string& spillDirectory, size_t memoryBudget = DEFAULT_MEMORY_BUDGET); // budget constructor
+  SpillQueue(const SpillQueue<T>& otherQueue) = delete;
+  ~SpillQueue(); // destructor
+
+  // accessors and information methods
+  size_t getMemoryBudget() const;
+  int getInMemorySize() const;
+  long getSpilledSize() const;
+  int getSegmentCount() const;
+  T front() const;
+  bool operator==(const Queue<T>& rhs) const;
+  T& operator[](int index) const;
+  bool visitSegments(const function<bool(const T*, int)>& visitor) const;
+
+  // adding, accessing and removing values from the queue
+  void clear();
+  void enqueue(const T& newItem);
+  void enqueue(T&& newItem);
+  void dequeue();
+  T dequeueValue();
+
+  /// @brief the memory budget of a queue if no budget is asked for,
+  ///   64 MiB
+  static const size_t DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024;
+
+  /// @brief the number of spills of the back of the queue that are
+  ///   appended to a segment file before a new one is started
+  static const int SPILLS_PER_SEGMENT = 16;
+
+  /// @brief the number of records read or written with each stream
+  ///   operation when records have to be encoded or decoded
+  static const int RECORD_BLOCK_SIZE = 1024;
+
+private:
+  // reads the items of the queue in order, for comparing queues
+  class ItemReader;
+
+  /** @brief a segment file holding part of the middle of the queue
+   */
+  struct Segment
+  {
+    /// @brief the path of the segment file
+    string path;
+
+    /// @brief the number of records written to the segment file
+    long count;
+  };
+
+  /// @brief the directory segment files are written in
+  string spillDirectory;
+
+  /// @brief the number of bytes of items the queue holds in memory
+  size_t memoryBudget;
+
+  /// @brief the number of items each of the front and back of the
+  ///   queue holds in memory
+  int bufferLimit;
+
+  /// @brief the two in memory buffers of items, one is the head and
+  ///   the other the tail of the queue, they trade places when the
+  ///   head runs dry and nothing is on disk
+  AQueue<T> buffers[2];
+
+  /// @brief the items at the front of the queue, which come before
+  ///   all items on disk
+  AQueue<T>* head;
+
+  /// @brief the items at the back of the queue, which come after all
+  ///   items on disk
+  AQueue<T>* tail;
+
+  /// @brief the segment files on disk, oldest first
+  deque<Segment> segments;
+
+  /// @brief the total number of items in the segment files that have
+  ///   not been read back yet
+  long spilledSize;
+
+  /// @brief the number of records already read from the oldest segment
+  long readCount;
+
+  /// @brief stream reading the oldest segment, open once it has
+  ///   started to be read
+  ifstream readStream;
+
+  /// @brief stream appending to the newest segment, open until the
+  ///   segment is full or has to be read
+  ofstream writeStream;
+
+  /// @brief the number identifying this queue in the names of its
+  ///   segment files
+  long queueId;
+
+  /// @brief the number of segment files this queue has created, used
+  ///   to name the next one
+  long segmentsCreated;
+
+  /// @brief the copy of an item on disk last returned by the indexing
+  ///   operator
+  mutable T indexedItem;
+
+  // private member methods for spilling and refilling
+  void spillTail();
+  void refillHead();
+  void closeWriteSegment();
+  void removeSegmentFiles();
+  void emptyBuffer(AQueue<T>* buffer);
+};
+
+#endif // define _SPILLQUEUE_HPP_
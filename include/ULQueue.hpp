@@ -0,0 +1,247 @@
+/** @file ULQueue.hpp
+ * @brief Concrete unrolled linked list based implementation of Queue
+ *   ADT.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement the Queue abstraction using an unrolled linked list.
+ * Instead of a node for every value, each node of the list holds a
+ * small fixed size block of values, sized to fill a cache line or two.
+ * Enqueue fills the back block and links on a new block when it is
+ * full, and dequeue empties the front block and unlinks it when it has
+ * been used up.  Both are still constant time O(1) operations, like
+ * for the LQueue, but there is only one allocation for every block of
+ * values, the values sit next to each other in memory, and finding
+ * the value at an index only has to step over whole blocks.
+ */
+#ifndef _ULQUEUE_HPP_
+#define _ULQUEUE_HPP_
+#include "Queue.hpp"
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <type_traits>
+using namespace std;
+
+/** @class ULQueue
+ * @brief The ULQueue concrete unrolled linked list implemention of the
+ *   Queue interface.
+ *
+ * Values are enqueued into the back block of the list and dequeued
+ * from the front block.  The block emptied by a dequeue is kept as a
+ * spare for the next block needed by an enqueue, so a queue whose size
+ * goes back and forth over a block boundary does not allocate and free
+ * a block every time it crosses it.
+ *
+ * The indexing operator remembers the block it last found, so walking
+ * through the queue by index takes constant time per item rather than
+ * time proportional to the index.  Forward iterators walk the values
+ * of each block with a pointer, and only follow a link at the end of
+ * a block.  Enqueue does not invalidate iterators, but dequeue
+ * invalidates iterators to the items that are dequeued.
+ */
+template<class T>
+class ULQueue : public Queue<T>
+{
+public:
+  // iterator types
+  template<class Value>
+  class BasicIterator;
+  typedef BasicIterator<T> iterator;
+  typedef BasicIterator<const T> const_iterator;
+
+  // constructors and destructors
+  ULQueue();                             // default constructor
+  ULQueue(int size, T values[]);         // array based constructor
+  ULQueue(const ULQueue<T>& otherQueue); // copy constructor
+  ~ULQueue();                            // destructor
+
+  // accessors and information methods
+  int getBlockCount() const;
+  T front() const;
+  bool operator==(const Queue<T>& rhs) const;
+  T& operator[](int index) const;
+  bool visitSegments(const function<bool(const T*, int)>& visitor) const;
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+  const_iterator cbegin() const;
+  const_iterator cend() const;
+
+  // adding, accessing and removing values from the queue
+  void clear();
+  void enqueue(const T& value);
+  void enqueue(T&& value);
+  void enqueueArray(const T* items, int count);
+  void dequeue();
+  T dequeueValue();
+  int dequeueInto(T* out, int count);
+
+  /// @brief the assumed size of a cache line, blocks are sized to fill
+  ///   a cache line
+  static const int CACHE_LINE_SIZE = 64;
+
+  /// @brief the fewest values held by a block, for value types so large
+  ///   that only a few of them fit on a cache line
+  static const int MINIMUM_BLOCK_CAPACITY = 4;
+
+  /// @brief the number of values held by each block of the list
+  static constexpr int BLOCK_CAPACITY =
+    sizeof(T) * MINIMUM_BLOCK_CAPACITY >= CACHE_LINE_SIZE ? MINIMUM_BLOCK_CAPACITY : CACHE_LINE_SIZE / sizeof(T);
+
+private:
+  /** @brief one node of the unrolled linked list
+   */
+  struct Block
+  {
+    /// @brief the values held in this block
+    T values[BLOCK_CAPACITY];
+
+    /// @brief the next block of the list, or nullptr if this is the
+    ///   back block
+    Block* next;
+  };
+
+  /// @brief the front block of the list, or nullptr if the queue is
+  ///   empty
+  Block* frontBlock;
+
+  /// @brief the back block of the list, or nullptr if the queue is
+  ///   empty
+  Block* backBlock;
+
+  /// @brief the index of the front value in the front block
+  int frontOffset;
+
+  /// @brief the index one past the back value in the back block
+  int backOffset;
+
+  /// @brief a block that was emptied and can be reused, or nullptr
+  Block* spareBlock;
+
+  /// @brief the count of all values ever dequeued, which is also the
+  ///   position of the front value counting from the first value ever
+  ///   enqueued.  Positions stay the same for a value while it is in
+  ///   the queue, unlike indexes.
+  long frontPosition;
+
+  /// @brief the block last found by the indexing operator, or nullptr
+  mutable Block* cursorBlock;
+
+  /// @brief the position of the first slot of the cursor block
+  mutable long cursorPosition;
+
+  // private member methods for managing blocks
+  Block* allocateBlock();
+  void releaseBlock(Block* block);
+  void appendBlock();
+  void releaseFrontBlock();
+  template<class Iterator>
+  Iterator makeEnd() const;
+};
+
+/** @class ULQueue::BasicIterator
+ * @brief Forward iterator over the values of a ULQueue, from the front
+ *   of the queue to the back.
+ *
+ * The Value is T for an iterator, and const T for a const_iterator.
+ * The iterator steps a pointer through the values of a block, and
+ * moves on to the first value of the next block at the end of the
+ * block.  The end iterator points just past the back value, or is
+ * nullptr if the back block is full, which is where stepping past the
+ * last value of a full back block ends up.  The iterator is so small
+ * and used so often that it is defined here in the header, so it can
+ * be inlined into the loops using it.
+ */
+template<class T>
+template<class Value>
+class ULQueue<T>::BasicIterator
+{
+public:
+  typedef forward_iterator_tag iterator_category;
+  typedef remove_const_t<Value> value_type;
+  typedef ptrdiff_t difference_type;
+  typedef Value* pointer;
+  typedef Value& reference;
+
+  /// @brief construct an iterator that does not refer to any queue
+  BasicIterator()
+    : block(nullptr), current(nullptr)
+  {
+  }
+
+  /// @brief construct an iterator at current in the given block
+  BasicIterator(Block* block, Value* current)
+    : block(block), current(current)
+  {
+  }
+
+  /// @brief convert an iterator to a const_iterator
+  template<class OtherValue, class = enable_if_t<is_same<const OtherValue, Value>::value>>
+  BasicIterator(const BasicIterator<OtherValue>& other)
+    : block(other.block), current(other.current)
+  {
+  }
+
+  /// @brief access the value the iterator is at
+  reference operator*() const
+  {
+    return *current;
+  }
+
+  /// @brief access a member of the value the iterator is at
+  pointer operator->() const
+  {
+    return current;
+  }
+
+  /// @brief advance to the next value, following the link to the next
+  ///   block at the end of this one
+  BasicIterator& operator++()
+  {
+    ++current;
+    if (current == block->values + BLOCK_CAPACITY)
+    {
+      block = block->next;
+      current = (block == nullptr) ? nullptr : block->values;
+    }
+    return *this;
+  }
+
+  /// @brief advance to the next value, returning the iterator as it was
+  BasicIterator operator++(int)
+  {
+    BasicIterator previous = *this;
+    ++(*this);
+    return previous;
+  }
+
+  /// @brief iterators are equal if they are at the same value
+  bool operator==(const BasicIterator& rhs) const
+  {
+    return current == rhs.current;
+  }
+
+  /// @brief iterators are not equal if they are at different values
+  bool operator!=(const BasicIterator& rhs) const
+  {
+    return current != rhs.current;
+  }
+
+private:
+  template<class OtherValue>
+  friend class BasicIterator;
+
+  /// @brief the block holding the value the iterator is at
+  Block* block;
+
+  /// @brief the value the iterator is at
+  Value* current;
+};
+
+#endif // define _ULQUEUE_HPP_
@@ -0,0 +1,497 @@
+/** @file AHeapPriorityQueue.cpp
+ * @brief Concrete array based binary heap implementation of Priority
+ *   Queue ADT.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement the Queue abstraction but maintain the queue as a
+ * priority queue using a binary heap.  This is an array based
+ * implementation.  We inherit from the AQueue class to reuse its
+ * block of values and growth policy, but the values are kept in heap
+ * order starting at index 0 of the array instead of as a circular
+ * buffer.  Both enqueue() and dequeue() are O(log n) operations.  As
+ * with the APriorityQueue, we assume that operator>() is defined for
+ * the type T being managed, and that it returns true when the lhs T
+ * value is higher priority than the rhs T value.
+ */
+#include "AHeapPriorityQueue.hpp"
+#include "Job.hpp"
+#include "QueueException.hpp"
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// define macros to make it easier to access the base class protected
+// members without all of the cruft
+#define size AQueue<T>::size
+#define allocationSize AQueue<T>::allocationSize
+#define frontIndex AQueue<T>::frontIndex
+#define backIndex AQueue<T>::backIndex
+#define values AQueue<T>::values
+#define growQueueIfNeeded() AQueue<T>::growQueueIfNeeded()
+#define growQueueToFit(minimumSize) AQueue<T>::growQueueToFit(minimumSize)
+#define shrinkQueueIfNeeded() AQueue<T>::shrinkQueueIfNeeded()
+
+/**
+ * @brief Default constructor
+ *
+ * Construct an empty queue.  The empty queue will have no allocated memory
+ * nor any values.
+ */
+template<class T>
+AHeapPriorityQueue<T>::AHeapPriorityQueue()
+  : AQueue<T>()
+{
+  nextSequence = 0;
+  sequence = nullptr;
+}
+
+/**
+ * @brief Standard constructor
+ *
+ * Construct a queue of values from a (statically) defined and
+ * provided array of values.  The values are copied into our own
+ * block of memory by the AQueue constructor, and then rearranged
+ * into heap order in O(n) time, bottom up.  Items are given sequence
+ * numbers in the order they appear in the array, so equal priority
+ * items will be dequeued in array order.
+ *
+ * @param initSize The size of the input values were are given as well as the
+ *   size of the new queue we are to construct.
+ * @param initValues The (static) array of values to use to construct
+ *   this Queue values with.
+ */
+template<class T>
+AHeapPriorityQueue<T>::AHeapPriorityQueue(int initSize, T initValues[])
+  : AQueue<T>(initSize, initValues)
+{
+  sequence = new unsigned long[allocationSize];
+  for (int index = 0; index < size; index++)
+  {
+    sequence[index] = index;
+  }
+  nextSequence = size;
+
+  // every node past the last parent is already a heap of 1 item, so
+  // sift each of the parents down starting from the bottom of the heap
+  for (int index = size / 2 - 1; index >= 0; index--)
+  {
+    siftDown(index);
+  }
+}
+
+/**
+ * @brief Copy constructor
+ *
+ * Make a copy of the values of the given heap into a new
+ * AHeapPriorityQueue instance.  The values are copied in heap order
+ * by the AQueue copy constructor, we only need to copy the sequence
+ * numbers along with them.
+ *
+ * @param queue The other heap we are to make a copy of in this
+ *   constructor.
+ */
+template<class T>
+AHeapPriorityQueue<T>::AHeapPriorityQueue(const AHeapPriorityQueue<T>& queue)
+  : AQueue<T>(queue)
+{
+  sequence = new unsigned long[allocationSize];
+  for (int index = 0; index < size; index++)
+  {
+    sequence[index] = queue.sequence[index];
+  }
+  nextSequence = queue.nextSequence;
+}
+
+/**
+ * @brief Class destructor
+ *
+ * The AQueue destructor will only clear out the values, so we need to
+ * clear here as well so that the sequence numbers are returned to the
+ * heap.
+ */
+template<class T>
+AHeapPriorityQueue<T>::~AHeapPriorityQueue()
+{
+  clear();
+}
+
+/**
+ * @brief Clear out queue
+ *
+ * Clear or empty out the queue.  Return the queue back
+ * to an empty queue.
+ */
+template<class T>
+void AHeapPriorityQueue<T>::clear()
+{
+  if (sequence != nullptr)
+  {
+    delete[] sequence;
+    sequence = nullptr;
+  }
+  nextSequence = 0;
+
+  AQueue<T>::clear();
+}
+
+/**
+ * @brief Dequeue queue front item
+ *
+ * Dequeue the highest priority item from the front of the queue,
+ * which is at the root of the heap.  The back item of the heap is
+ * moved into the root and then sifted down until the heap property
+ * is restored.  As for the AQueue, the allocation is shrunk once the
+ * heap has drained to less than a quarter of it.
+ */
+template<class T>
+void AHeapPriorityQueue<T>::dequeue()
+{
+  // make sure queue is not empty before we try and access
+  // the front item
+  if (this->isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <AHeapPriorityQueue>::dequeue() attempt to dequeue front item"
+        << " from empty queue, size:  " << size;
+
+    throw QueueEmptyException(out.str());
+  }
+
+  size--;
+  backIndex = size - 1;
+  QUEUE_COUNT(dequeues, 1);
+  if (size > 0)
+  {
+    values[0] = std::move(values[size]);
+    sequence[0] = sequence[size];
+    siftDown(0);
+  }
+  shrinkQueueIfNeeded();
+}
+
+/**
+ * @brief Enqueue copy by priority
+ *
+ * Enqueue a copy of the new value in priority order.  The copy is
+ * made once and then moved into place by the move enqueue.
+ *
+ * @param newItem The value to be added to the queue.
+ */
+template<class T>
+void AHeapPriorityQueue<T>::enqueue(const T& newItem)
+{
+  enqueue(T(newItem));
+}
+
+/**
+ * @brief Enqueue value by priority
+ *
+ * Enqueue the new value at the back of the heap, and then sift it up
+ * towards the root until its parent is of higher priority.  This
+ * is an O(log n) operation, except when the allocation needs to grow.
+ *
+ * @param newItem The value to be added to the queue.
+ */
+template<class T>
+void AHeapPriorityQueue<T>::enqueue(T&& newItem)
+{
+  growQueueIfNeeded();
+
+  int index = size;
+  values[index] = std::move(newItem);
+  sequence[index] = nextSequence++;
+  size++;
+  backIndex = size - 1;
+  QUEUE_COUNT(enqueues, 1);
+
+  siftUp(index);
+}
+
+/**
+ * @brief Enqueue array of values by priority
+ *
+ * Enqueue copies of a batch of values in priority order.  The heap is
+ * grown once for the whole batch and the values are appended to the
+ * back of the heap.  A small batch is then sifted up one value at a
+ * time, O(k log n), but when the batch is at least as large as the
+ * heap it was added to it is cheaper to rebuild the whole heap bottom
+ * up, which is O(n + k).  Either way the values are given sequence
+ * numbers in the order they appear in the batch.
+ *
+ * @param items The block of values to enqueue.
+ * @param count The number of values in the block.
+ */
+template<class T>
+void AHeapPriorityQueue<T>::enqueueArray(const T* items, int count)
+{
+  if (count <= 0)
+  {
+    return;
+  }
+
+  growQueueToFit(size + count);
+
+  int firstNew = size;
+  for (int index = 0; index < count; index++)
+  {
+    values[firstNew + index] = items[index];
+    sequence[firstNew + index] = nextSequence++;
+  }
+  size += count;
+  backIndex = size - 1;
+  QUEUE_COUNT(enqueues, count);
+
+  if (count >= firstNew)
+  {
+    for (int index = size / 2 - 1; index >= 0; index--)
+    {
+      siftDown(index);
+    }
+  }
+  else
+  {
+    for (int index = firstNew; index < size; index++)
+    {
+      siftUp(index);
+    }
+  }
+}
+
+/**
+ * @brief Dequeue front items into array
+ *
+ * Dequeue up to count items in priority order into the given block
+ * of values.  The heap has to be restored after every item is
+ * removed, so unlike the AQueue this can not move the items out as
+ * a block, and dequeues them one at a time.
+ *
+ * @param out The block to move the dequeued items into, must have room
+ *   for count items.
+ * @param count The largest number of items to dequeue.
+ *
+ * @returns int Returns the number of items that were dequeued.
+ */
+template<class T>
+int AHeapPriorityQueue<T>::dequeueInto(T* out, int count)
+{
+  return Queue<T>::dequeueInto(out, count);
+}
+
+/**
+ * @brief Reallocate queue memory
+ *
+ * Grow the block of sequence numbers along with the block of
+ * values.  The heap always starts at index 0 of the array, so the
+ * AQueue reallocation does not reorder any of the values.
+ *
+ * @param newAllocationSize The size of the new block of memory.
+ */
+template<class T>
+void AHeapPriorityQueue<T>::reallocate(int newAllocationSize)
+{
+  unsigned long* newSequence = new unsigned long[newAllocationSize];
+  for (int index = 0; index < size; index++)
+  {
+    newSequence[index] = sequence[index];
+  }
+  delete[] sequence;
+  sequence = newSequence;
+  QUEUE_COUNT(bytesCopied, (long long)size * sizeof(unsigned long));
+
+  AQueue<T>::reallocate(newAllocationSize);
+}
+
+/**
+ * @brief Heap ordering of two items
+ *
+ * Test if the lhs item should be dequeued before the rhs item.  An
+ * item comes first if it is of higher priority, or if it is of equal
+ * priority but was enqueued earlier.  Only operator>() is needed for
+ * the type T.
+ *
+ * @param lhs The value of the left hand side item.
+ * @param lhsSequence The enqueue sequence number of the lhs item.
+ * @param rhs The value of the right hand side item.
+ * @param rhsSequence The enqueue sequence number of the rhs item.
+ *
+ * @returns bool true if the lhs item comes before the rhs item.
+ */
+template<class T>
+bool AHeapPriorityQueue<T>::isBefore(const T& lhs, unsigned long lhsSequence, const T& rhs, unsigned long rhsSequence) const
+{
+  QUEUE_COUNT(comparisons, 1);
+  if (lhs > rhs)
+  {
+    return true;
+  }
+  if (rhs > lhs)
+  {
+    return false;
+  }
+  return lhsSequence < rhsSequence;
+}
+
+/**
+ * @brief Sift item up the heap
+ *
+ * Move the item at the given index up towards the root of the heap
+ * until its parent comes before it.  Instead of swapping at each
+ * level, we hold the item aside and shift the parents down into the
+ * hole it leaves, placing the item once its final position is known.
+ *
+ * @param index The index of the item to sift up.
+ */
+template<class T>
+void AHeapPriorityQueue<T>::siftUp(int index)
+{
+  T item = std::move(values[index]);
+  unsigned long itemSequence = sequence[index];
+
+  while (index > 0)
+  {
+    int parent = (index - 1) / 2;
+    if (not isBefore(item, itemSequence, values[parent], sequence[parent]))
+    {
+      break;
+    }
+
+    values[index] = std::move(values[parent]);
+    sequence[index] = sequence[parent];
+    index = parent;
+    QUEUE_COUNT(swaps, 1);
+  }
+
+  values[index] = std::move(item);
+  sequence[index] = itemSequence;
+}
+
+/**
+ * @brief Sift item down the heap
+ *
+ * Move the item at the given index down towards the leaves of the
+ * heap until both of its children come after it.  As with siftUp(),
+ * the children are shifted up into the hole left by the item rather
+ * than swapping at each level.
+ *
+ * @param index The index of the item to sift down.
+ */
+template<class T>
+void AHeapPriorityQueue<T>::siftDown(int index)
+{
+  T item = std::move(values[index]);
+  unsigned long itemSequence = sequence[index];
+
+  int child = 2 * index + 1;
+  while (child < size)
+  {
+    // pick the child that should be dequeued first
+    if ((child + 1 < size) and isBefore(values[child + 1], sequence[child + 1], values[child], sequence[child]))
+    {
+      child++;
+    }
+
+    if (not isBefore(values[child], sequence[child], item, itemSequence))
+    {
+      break;
+    }
+
+    values[index] = std::move(values[child]);
+    sequence[index] = sequence[child];
+    index = child;
+    QUEUE_COUNT(swaps, 1);
+    child = 2 * index + 1;
+  }
+
+  values[index] = std::move(item);
+  sequence[index] = itemSequence;
+}
+
+/**
+ * @brief Visit items in dequeue order
+ *
+ * A snapshot of the heap is saved in the order the items will be
+ * dequeued, rather than in heap order, since the sequence numbers that
+ * order items of equal priority are not saved.  The indexes of the
+ * items are sorted into dequeue order in O(n log n) time, and the items
+ * are then copied out and visited a block at a time.
+ *
+ * @param visitor The function to call with a pointer to each segment
+ *   of values and the number of values in it.  It returns false to
+ *   stop the visit.
+ *
+ * @returns bool Returns true if every segment was visited, or false if
+ *   the visitor stopped the visit early.
+ */
+template<class T>
+bool AHeapPriorityQueue<T>::visitSnapshotOrder(const function<bool(const T*, int)>& visitor) const
+{
+  vector<int> order(size);
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(), [this](int lhs, int rhs) {
+    return isBefore(values[lhs], sequence[lhs], values[rhs], sequence[rhs]);
+  });
+
+  const int BLOCK_SIZE = 1024;
+  vector<T> block;
+  for (int start = 0; start < size; start += BLOCK_SIZE)
+  {
+    int blockSize = min(BLOCK_SIZE, size - start);
+    block.clear();
+    for (int index = 0; index < blockSize; index++)
+    {
+      block.push_back(values[order[start + index]]);
+    }
+    if (not visitor(block.data(), blockSize))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Restore heap order after load
+ *
+ * The items of a loaded snapshot are numbered in the order they were
+ * saved, and the heap is then rebuilt bottom up in O(n) time, the
+ * same as for the array constructor.  A snapshot saved from a heap is
+ * in dequeue order, which is already a heap, so the rebuild does not
+ * move any items, and equal priority items keep the order they were
+ * first enqueued in.
+ */
+template<class T>
+void AHeapPriorityQueue<T>::restoreOrder()
+{
+  for (int index = 0; index < size; index++)
+  {
+    sequence[index] = nextSequence++;
+  }
+
+  for (int index = size / 2 - 1; index >= 0; index--)
+  {
+    siftDown(index);
+  }
+}
+
+/**
+ * @brief Cause specific instance compilations
+ *
+ * This is a bit of a kludge, but we can use normal make dependencies
+ * and separate compilation by declaring template class Queue<needed_type>
+ * here of any types we are going to be instantianting with the
+ * template.
+ *
+ * https://isocpp.org/wiki/faq/templates#templates-defn-vs-decl
+ * https://isocpp.org/wiki/faq/templates#separate-template-class-defn-from-decl
+ */
+template class AHeapPriorityQueue<int>;
+template class AHeapPriorityQueue<string>;
+template class AHeapPriorityQueue<Job>;
@@ -19,6 +19,11 @@
 #include "APriorityQueue.hpp"
 #include "Job.hpp"
 #include "QueueException.hpp"
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
 using namespace std;
 
 // define macros to make it easier to access the base class protected
@@ -29,6 +34,8 @@ using namespace std;
 #define backIndex AQueue<T>::backIndex
 #define values AQueue<T>::values
 #define growQueueIfNeeded() AQueue<T>::growQueueIfNeeded()
+#define growQueueToFit(minimumSize) AQueue<T>::growQueueToFit(minimumSize)
+#define wrapIndex(index) AQueue<T>::wrapIndex(index)
 
 /**
  * @brief Default constructor
@@ -62,96 +69,261 @@ APriorityQueue<T>::APriorityQueue(int initSize, T initValues[])
 }
 
 /**
- * @brief Implement true modulo
- *
- * Unfortunately the C/C++ `%` operation actually gives the remainder
- * instead of the true modulo value.  Modulo of a positive number should always
- * be a positive remainder.  Thus
- *     -1 modulo 5 == 4.
- * But C/C++ '%' operation actually returns the remainder,
- *     -1 remainder 5 == -1 because -1 goes into 5 0 times with a remainder of -1
- * For our circular buffer, we want a true modulo operation, so we implement
- * as a private function to use in our enqueue() method.
- *
- * @param dividend The top number in the division/modulo operation we are
- *   performing.
- * @param divisor The bottom number in the divison/modulo operation.
- *
- * @returns int Returns true modulo of the division.  If the divisor is positive,
- *   we return a positive remainder.
+ * @brief Enqueue copy with a sort
+ *
+ * Enqueue a copy of the new value in priority order.  The copy is
+ * made once and then moved into place by the move enqueue.
+ *
+ * @param newItem The value to be added to the queue.
+ */
+template<class T>
+void APriorityQueue<T>::enqueue(const T& newItem)
+{
+  enqueue(T(newItem));
+}
+
+/**
+ * @brief Enqueue with a sort
+ *
+ * Enqueue a new value in priority order, so that the values of the
+ * queue stay sorted in descending order of priority.  The insertion
+ * point is found with a binary search, after any values of equal
+ * priority so they stay first-in-first-out.  Then either the values in
+ * front of it are shifted one place towards the front of the circular
+ * buffer, or the values behind it one place towards the back,
+ * whichever moves fewer values, and the new value is moved into the
+ * gap.  A value that belongs at the back of the queue is simply
+ * appended, and one that belongs at the front is simply put in front
+ * of it, so both of these common cases take constant time.
+ *
+ * @param newItem The value to be added to the queue.
  */
 template<class T>
-int APriorityQueue<T>::modulo(int dividend, int divisor)
+void APriorityQueue<T>::enqueue(T&& newItem)
 {
-  int remainder = dividend % divisor;
+  growQueueIfNeeded();
 
-  if ((divisor > 0) and (remainder < 0))
+  int index = findInsertionIndex(newItem);
+  if (index < size - index)
+  {
+    openFrontGap(index);
+  }
+  else
   {
-    remainder = divisor + remainder;
+    openBackGap(index);
   }
 
-  return remainder;
+  values[wrapIndex(frontIndex + index)] = std::move(newItem);
+  size++;
+  backIndex = wrapIndex(frontIndex + size - 1);
+  QUEUE_COUNT(enqueues, 1);
 }
 
 /**
- * 
- * @brief Enqueue with a sort
- * 
- * Enqueue a new value and sort the queue so that 
- * its values are alligned in descending order. This 
- * implementation will work with a queue implemented
- * using an array as opposed to a linked list.
- * 
- *  @param newItem The value to be added to the queue.
- * Initially starts at backIndex but will be compared and swapped
- * with the values "in front" of it within the queue until it's 
- * placed in the proper location.
- * 
+ * @brief Find insertion index
+ *
+ * Binary search the sorted values for the index the new value should
+ * be inserted at, which is the number of values it does not have a
+ * higher priority than.  The search halves the range with a
+ * conditional move instead of a branch at each step, since for
+ * random priorities the branch would be mispredicted half of the
+ * time.  Values that belong at the back of the queue are checked for
+ * first, since a queue of equal or falling priorities puts every new
+ * value there.
+ *
+ * @param newItem The value being inserted.
+ *
+ * @returns int The index, counting from the front of the queue, the
+ *   new value should end up at.
  */
 template<class T>
-void APriorityQueue<T>::enqueue(const T& newItem)
+int APriorityQueue<T>::findInsertionIndex(const T& newItem) const
 {
-  growQueueIfNeeded();
+  QUEUE_COUNT(comparisons, (size > 0) ? 1 : 0);
+  if ((size == 0) or not(newItem > values[backIndex]))
+  {
+    return size;
+  }
 
-  backIndex = (backIndex + 1) % allocationSize;
-  values[backIndex] = newItem;
-  this->size++;
+  // the value at the back has a lower priority, so the index is in
+  // the range [base, base + count - 1] of values left to search
+  int base = 0;
+  int count = size - 1;
+  while (count > 1)
+  {
+    int half = count / 2;
+    base = (newItem > values[wrapIndex(frontIndex + base + half - 1)]) ? base : base + half;
+    count -= half;
+    QUEUE_COUNT(comparisons, 1);
+  }
+  QUEUE_COUNT(comparisons, count);
+  if ((count == 1) and not(newItem > values[wrapIndex(frontIndex + base)]))
+  {
+    base++;
+  }
+  return base;
+}
 
-  // Don't sort an array of one element
-  if(this->size -1 == 0)
+/**
+ * @brief Move run of values
+ *
+ * Move a run of values that is contiguous in the buffer, where the
+ * source and destination may overlap.  Values that are trivially
+ * copyable are moved with a single memmove(), others are moved one
+ * by one in the direction that is safe for the overlap.
+ *
+ * @param from The buffer index of the first value to move.
+ * @param to The buffer index to move the first value to.
+ * @param count The number of values to move.
+ */
+template<class T>
+void APriorityQueue<T>::moveRun(int from, int to, int count)
+{
+  QUEUE_COUNT(swaps, count);
+  QUEUE_COUNT(bytesCopied, (long long)count * sizeof(T));
+  if constexpr (is_trivially_copyable<T>::value)
   {
-    return;
+    memmove(values + to, values + from, count * sizeof(T));
   }
+  else if (to < from)
+  {
+    std::move(values + from, values + from + count, values + to);
+  }
+  else
+  {
+    std::move_backward(values + from, values + from + count, values + to + count);
+  }
+}
 
-  int currentIndex = backIndex;
-  int previousIndex = currentIndex - 1;
+/**
+ * @brief Open gap towards front
+ *
+ * Move the front of the queue back by one place in the circular
+ * buffer, and shift the values in front of the given index into the
+ * place before them, leaving a gap at the index.  The shift is done
+ * in runs of values that do not wrap around the end of the buffer.
+ *
+ * @param index The index, counting from the front of the queue, to
+ *   open the gap at.
+ */
+template<class T>
+void APriorityQueue<T>::openFrontGap(int index)
+{
+  frontIndex = wrapIndex(frontIndex + allocationSize - 1);
 
-  if (previousIndex < 0)   
+  int moved = 0;
+  while (moved < index)
   {
-    previousIndex = allocationSize - 1;
+    int from = wrapIndex(frontIndex + moved + 1);
+    int to = wrapIndex(frontIndex + moved);
+    int run = min({index - moved, allocationSize - from, allocationSize - to});
+    moveRun(from, to, run);
+    moved += run;
   }
-  if (currentIndex < 0)
+}
+
+/**
+ * @brief Open gap towards back
+ *
+ * Shift the values from the given index to the back of the queue into
+ * the place behind them, leaving a gap at the index.  The shift starts
+ * from the back, in runs of values that do not wrap around the start
+ * of the buffer.
+ *
+ * @param index The index, counting from the front of the queue, to
+ *   open the gap at.
+ */
+template<class T>
+void APriorityQueue<T>::openBackGap(int index)
+{
+  int remaining = size - index;
+  while (remaining > 0)
   {
-    currentIndex = allocationSize - 1;
+    int fromLast = wrapIndex(frontIndex + index + remaining - 1);
+    int toLast = wrapIndex(frontIndex + index + remaining);
+    int run = min({remaining, fromLast + 1, toLast + 1});
+    moveRun(fromLast - run + 1, toLast - run + 1, run);
+    remaining -= run;
   }
+}
 
-  while (values[currentIndex] > values[previousIndex] && currentIndex != frontIndex)
-  { 
-    T temp = values[previousIndex];
-    values[previousIndex] = values[currentIndex];
-    values[currentIndex] = temp;
+/**
+ * @brief Enqueue array of values with a merge
+ *
+ * Enqueue copies of a batch of values in priority order.  Rather than
+ * shifting each value into place one at a time, the batch is sorted
+ * on its own and then merged with the queue in a single pass.  The
+ * merge runs from the back of the queue towards the front, so that it
+ * can be done in place in the (grown) circular buffer.  Items of equal
+ * priority stay first-in-first-out: the items already in the queue
+ * come before equal items of the batch, and items of the batch keep
+ * the order they were given in.
+ *
+ * @param items The block of values to enqueue.
+ * @param count The number of values in the block.
+ */
+template<class T>
+void APriorityQueue<T>::enqueueArray(const T* items, int count)
+{
+  if (count <= 0)
+  {
+    return;
+  }
+
+  // stable sort keeps equal priority items of the batch in order
+  vector<T> batch(items, items + count);
+  stable_sort(batch.begin(), batch.end(), [](const T& lhs, const T& rhs) {
+    return lhs > rhs;
+  });
 
-    currentIndex--;
-    previousIndex--;
-    
-    if (previousIndex < 0)
+  growQueueToFit(size + count);
+
+  // fill the merged queue from its back, taking the lower priority of
+  // the back items of the queue and the batch.  Once the batch is used
+  // up the rest of the queue items are already in their place
+  int queueIndex = size - 1;
+  int batchIndex = count - 1;
+  for (int mergedIndex = size + count - 1; batchIndex >= 0; mergedIndex--)
+  {
+    T& target = values[wrapIndex(frontIndex + mergedIndex)];
+    QUEUE_COUNT(comparisons, (queueIndex >= 0) ? 1 : 0);
+    if ((queueIndex >= 0) and (batch[batchIndex] > values[wrapIndex(frontIndex + queueIndex)]))
     {
-      previousIndex = allocationSize - 1;
+      target = std::move(values[wrapIndex(frontIndex + queueIndex)]);
+      queueIndex--;
+      QUEUE_COUNT(swaps, 1);
     }
-    if (currentIndex < 0)
+    else
     {
-      currentIndex = allocationSize - 1;
-    } 
+      target = std::move(batch[batchIndex]);
+      batchIndex--;
+    }
+  }
+
+  size += count;
+  backIndex = wrapIndex(frontIndex + size - 1);
+  QUEUE_COUNT(enqueues, count);
+}
+
+/**
+ * @brief Restore priority order after load
+ *
+ * A snapshot saved from an APriorityQueue is already in priority
+ * order, which is checked in a single pass.  A snapshot saved from
+ * some other queue is stable sorted into priority order, so items of
+ * equal priority are dequeued in the order they were saved.  The
+ * items of a loaded snapshot always start at index 0 of the array.
+ */
+template<class T>
+void APriorityQueue<T>::restoreOrder()
+{
+  auto isHigherPriority = [](const T& lhs, const T& rhs) {
+    return lhs > rhs;
+  };
+
+  if (not is_sorted(values, values + size, isHigherPriority))
+  {
+    stable_sort(values, values + size, isHigherPriority);
   }
 }
 
@@ -15,16 +15,102 @@
  * memory allocation if it needs to grow. In order to make
  * queue operations efficient for both enqueue on the back and dequeue
  * on the front of the queue, we have to now treat the array ov
- * values as a circular buffer.
+ * values as a circular buffer.  Optionally the allocation can be kept
+ * to a power of two in size, so that wrapping indexes around the
+ * circular buffer only needs a bit mask instead of an integer division.
  */
 #include "AQueue.hpp"
 #include "Job.hpp"
 #include "QueueException.hpp"
+#include "QueueSimd.hpp"
+#include "QueueSnapshot.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <type_traits>
+#include <utility>
 using namespace std;
 
+/**
+ * @brief Find value in segment
+ *
+ * Find the first value in a contiguous segment of values equal to the
+ * given value, with SIMD instructions for int values.
+ *
+ * @param segment The segment of values to search.
+ * @param count The number of values in the segment.
+ * @param value The value to search for.
+ *
+ * @returns int The index in the segment of the first value equal to
+ *   value, or -1 if there is none.
+ */
+template<class T>
+static int findInSegment(const T* segment, int count, const T& value)
+{
+  if constexpr (is_same<T, int>::value)
+  {
+    return simdFind(segment, count, value);
+  }
+  else
+  {
+    const T* found = std::find(segment, segment + count, value);
+    return (found == segment + count) ? -1 : found - segment;
+  }
+}
+
+/**
+ * @brief Count value in segment
+ *
+ * Count the values in a contiguous segment of values equal to the
+ * given value, with SIMD instructions for int values.
+ *
+ * @param segment The segment of values to search.
+ * @param count The number of values in the segment.
+ * @param value The value to count.
+ *
+ * @returns int The number of values in the segment equal to value.
+ */
+template<class T>
+static int countInSegment(const T* segment, int count, const T& value)
+{
+  if constexpr (is_same<T, int>::value)
+  {
+    return simdCount(segment, count, value);
+  }
+  else
+  {
+    return std::count(segment, segment + count, value);
+  }
+}
+
+/**
+ * @brief Compare segments
+ *
+ * Test if two contiguous segments of the same number of values are
+ * equal, with SIMD instructions for int values.
+ *
+ * @param lhs The first segment of values.
+ * @param rhs The second segment of values.
+ * @param count The number of values in each segment.
+ *
+ * @returns bool true if all of the values of the segments are equal.
+ */
+template<class T>
+static bool segmentsEqual(const T* lhs, const T* rhs, int count)
+{
+  if constexpr (is_same<T, int>::value)
+  {
+    return simdEqual(lhs, rhs, count);
+  }
+  else
+  {
+    return std::equal(lhs, lhs + count, rhs);
+  }
+}
+
 /**
  * @brief Default constructor
  *
@@ -36,8 +122,35 @@ AQueue<T>::AQueue()
 {
   // Empty queue has no values nor any allocated memory
   // associated with it
+  this->capacityPolicy = DOUBLING_CAPACITY;
+  this->size = 0;
+  this->allocationSize = 0;
+  this->reservedSize = 0;
+  this->frontIndex = 0;
+  this->backIndex = -1; // for empty queue, back index is an invalid index
+  values = nullptr;
+}
+
+/**
+ * @brief Capacity policy constructor
+ *
+ * Construct an empty queue that sizes its allocations using the given
+ * policy.  With the POWER_OF_TWO_CAPACITY policy all allocations are
+ * rounded up to a power of two, so indexes can be wrapped around the
+ * circular buffer with a bit mask, which is cheaper than the integer
+ * division needed to wrap indexes with modulo.
+ *
+ * @param capacityPolicy The policy to use to size the allocations.
+ */
+template<class T>
+AQueue<T>::AQueue(CapacityPolicy capacityPolicy)
+{
+  // Empty queue has no values nor any allocated memory
+  // associated with it
+  this->capacityPolicy = capacityPolicy;
   this->size = 0;
   this->allocationSize = 0;
+  this->reservedSize = 0;
   this->frontIndex = 0;
   this->backIndex = -1; // for empty queue, back index is an invalid index
   values = nullptr;
@@ -61,8 +174,10 @@ AQueue<T>::AQueue(int size, T values[])
 {
   // dynamically allocate a block of memory on the heap large enough to copy
   // the given input values into
+  this->capacityPolicy = DOUBLING_CAPACITY;
   this->size = size;
   this->allocationSize = size;
+  this->reservedSize = 0;
   this->values = new T[allocationSize];
 
   // copy the values from the input paramter into our new shiny block of memory
@@ -90,21 +205,37 @@ AQueue<T>::AQueue(int size, T values[])
  *
  * @param queue The other Queue we are to make a copy of in this
  *   constructor.
+ *
+ * @throws QueueMemoryBoundsException if the copy of a queue with the
+ *   POWER_OF_TWO_CAPACITY policy would need an allocation larger than
+ *   MAXIMUM_CAPACITY.
  */
 template<class T>
 AQueue<T>::AQueue(const AQueue<T>& queue)
 {
   // copy the size of the existing queue and allocate memory to hold
-  // values we will copy
+  // values we will copy, twice the size unless that would overflow
+  this->capacityPolicy = queue.capacityPolicy;
   this->size = queue.getSize();
-  allocationSize = 2 * this->size;
+  int minimumSize = (this->size > INT_MAX / 2) ? this->size : 2 * this->size;
+  if (capacityPolicy == POWER_OF_TWO_CAPACITY)
+  {
+    if (this->size > MAXIMUM_CAPACITY)
+    {
+      ostringstream out;
+      out << "Error: <AQueue>::AQueue() copy of size " << this->size << " is larger than the maximum capacity "
+          << MAXIMUM_CAPACITY;
+
+      throw QueueMemoryBoundsException(out.str());
+    }
+    minimumSize = min(minimumSize, MAXIMUM_CAPACITY);
+  }
+  allocationSize = roundAllocationSize(minimumSize);
+  reservedSize = 0;
   values = new T[allocationSize];
 
   // copy the values from the input Queue into this queue
-  for (int index = 0; index < this->size; index++)
-  {
-    values[index] = queue[index];
-  }
+  copy(queue.begin(), queue.end(), values);
 
   // set up front and back index.  Back index should point to the
   // last value of the array
@@ -144,49 +275,32 @@ int AQueue<T>::getAllocationSize() const
 }
 
 /**
- * @brief Queue to string
+ * @brief Reserved size accessor
  *
- * Accessor method to construct and return a string representation
- * of the current values and status of this Queue instance.
+ * Accessor method to get the allocation size asked for by the last
+ * call to reserve().
  *
- * @returns string Returns the string constructed with the information
- *   about this Queue.
+ * @returns int Returns the reserved allocation size of the Queue, or 0
+ *   if none has been reserved.
  */
 template<class T>
-string AQueue<T>::str() const
+int AQueue<T>::getReservedSize() const
 {
-  ostringstream out;
-
-  // stream queue information into the output stream
-  out << "<queue> size: " << this->size << " front:[ ";
-
-  // stream the current values of the queue to the output stream
-  // the array is a circular buffer, so we use the size to
-  // determine number of times loop should occur, and calculate
-  // index to access as an offset from frontIndex, being careful to wrap
-  // it around the buffer when it reaches the end
-  for (int index = 0; index < this->size; index++)
-  {
-    // calculate the index in the circular buffer
-    int queueIndex = (frontIndex + index) % allocationSize;
-
-    // stream the value out
-    out << values[queueIndex];
-
-    // separate the values of the queue, last one does not need , separator
-    if (queueIndex == backIndex)
-    {
-      out << " ";
-    }
-    else
-    {
-      out << ", ";
-    }
-  }
-  out << "]:back";
+  return reservedSize;
+}
 
-  // convert the string stream into a concrete string to return
-  return out.str();
+/**
+ * @brief Capacity policy accessor
+ *
+ * Accessor method to get the policy this queue uses to size its
+ * allocations and wrap indexes around its circular buffer.
+ *
+ * @returns CapacityPolicy Returns the capacity policy of this queue.
+ */
+template<class T>
+CapacityPolicy AQueue<T>::getCapacityPolicy() const
+{
+  return capacityPolicy;
 }
 
 /**
@@ -194,7 +308,11 @@ string AQueue<T>::str() const
  *
  * Check if this Queue is equal to the right hand side (rhs) queue.
  * The queues are equal if their sizes are equal, and if all elements
- * in both queues are equal.
+ * in both queues are equal.  The values of rhs are visited segment by
+ * segment, so comparing with any kind of queue is a single linear
+ * pass, and each segment of rhs is compared as a block with the runs
+ * of our circular buffer it lines up with, which for int values
+ * compares several values with each SIMD instruction.
  *
  * @param rhs The other queue on the right hand side of the
  *   boolean comparison that we are comparing this Queue to.
@@ -204,28 +322,135 @@ string AQueue<T>::str() const
 template<class T>
 bool AQueue<T>::operator==(const Queue<T>& rhs) const
 {
-  // first the queues have to be of the same size, or else they
-  // cannot be equal
   if (this->size != rhs.getSize())
   {
     return false;
   }
 
-  // otherwise, queues are equal if all elements are equal.
-  // compare each element, and if we find a pair that is not
-  // equal then the answer is false
-  for (int rhsIndex = 0; rhsIndex < rhs.getSize(); rhsIndex++)
+  int index = 0;
+  return rhs.visitSegments([this, &index](const T* segment, int count) {
+    // our values may wrap around the end of the buffer part way
+    // through the segment of rhs
+    while (count > 0)
+    {
+      int bufferIndex = wrapIndex(frontIndex + index);
+      int run = min(count, allocationSize - bufferIndex);
+      if (not segmentsEqual(values + bufferIndex, segment, run))
+      {
+        return false;
+      }
+      index += run;
+      segment += run;
+      count -= run;
+    }
+    return true;
+  });
+}
+
+/**
+ * @brief Visit contiguous segments of the queue
+ *
+ * Call the visitor with the values of the circular buffer, which are
+ * in at most two segments, the front of the queue up to the end of
+ * the allocation and then the start of the allocation up to the back
+ * of the queue.
+ *
+ * @param visitor The function to call with each segment.
+ *
+ * @returns bool Returns true if every segment was visited, or false if
+ *   the visitor stopped the visit early.
+ */
+template<class T>
+bool AQueue<T>::visitSegments(const function<bool(const T*, int)>& visitor) const
+{
+  if (this->size == 0)
+  {
+    return true;
+  }
+
+  int firstSegmentSize = min(this->size, allocationSize - frontIndex);
+  if (not visitor(values + frontIndex, firstSegmentSize))
   {
-    int lhsIndex = (frontIndex + rhsIndex) % allocationSize;
-    if (values[lhsIndex] != rhs[rhsIndex])
+    return false;
+  }
+
+  int secondSegmentSize = this->size - firstSegmentSize;
+  return (secondSegmentSize == 0) or visitor(values, secondSegmentSize);
+}
+
+/**
+ * @brief Find value
+ *
+ * Search the queue from front to back for the first value equal to
+ * the given value.  Each of the (at most) two segments of the circular
+ * buffer is searched as a block, so there is no index wrapping or
+ * bounds checking per value, and int values are compared several at a
+ * time with SIMD instructions.
+ *
+ * @param value The value to search for.
+ *
+ * @returns int The index of the first value equal to value, counting
+ *   from 0 at the front of the queue, or -1 if there is none.
+ */
+template<class T>
+int AQueue<T>::find(const T& value) const
+{
+  // the state of the search is captured as a single reference, so that
+  // the visitor is small enough for function not to allocate it
+  struct
+  {
+    const T* value;
+    int searched;
+    int found;
+  } search = {&value, 0, -1};
+
+  visitSegments([&search](const T* segment, int count) {
+    int index = findInSegment(segment, count, *search.value);
+    if (index >= 0)
     {
+      search.found = search.searched + index;
       return false;
     }
-  }
+    search.searched += count;
+    return true;
+  });
+  return search.found;
+}
 
-  // if we get to this point, all values were the same in both
-  // queues, so the answer is true, the queues are equal
-  return true;
+/**
+ * @brief Count value
+ *
+ * Count the values of the queue equal to the given value, searching
+ * the segments of the circular buffer as blocks as for find().
+ *
+ * @param value The value to count.
+ *
+ * @returns int The number of values in the queue equal to value.
+ */
+template<class T>
+int AQueue<T>::count(const T& value) const
+{
+  int total = 0;
+  visitSegments([&total, &value](const T* segment, int count) {
+    total += countInSegment(segment, count, value);
+    return true;
+  });
+  return total;
+}
+
+/**
+ * @brief Test for value
+ *
+ * Test if any value of the queue is equal to the given value.
+ *
+ * @param value The value to search for.
+ *
+ * @returns bool true if the queue holds a value equal to value.
+ */
+template<class T>
+bool AQueue<T>::contains(const T& value) const
+{
+  return find(value) >= 0;
 }
 
 /**
@@ -265,10 +490,151 @@ T& AQueue<T>::operator[](int index) const
   // implementations, the values is a circular bufer so we need to
   // interpret index 0 as front of queue, pointed to by frontIndex,
   // and the back item is at the backIndex of the array.
-  int queueIndex = (frontIndex + index) % allocationSize;
+  int queueIndex = wrapIndex(frontIndex + index);
   return values[queueIndex];
 }
 
+/**
+ * @brief Iterator to front of queue
+ *
+ * Get an iterator to the front item of the queue, iterating from it
+ * visits the items in order from the front to the back of the queue.
+ *
+ * @returns iterator Returns an iterator at the front item, which is the
+ *   same as end() if the queue is empty.
+ */
+template<class T>
+typename AQueue<T>::iterator AQueue<T>::begin()
+{
+  return makeBegin<iterator>();
+}
+
+/**
+ * @brief Iterator past back of queue
+ *
+ * Get an iterator just past the back item of the queue.
+ *
+ * @returns iterator Returns an iterator just past the back item.
+ */
+template<class T>
+typename AQueue<T>::iterator AQueue<T>::end()
+{
+  return makeEnd<iterator>();
+}
+
+/**
+ * @brief Const iterator to front of queue
+ *
+ * Get an iterator to the front item of the queue that can not be used
+ * to change the items.
+ *
+ * @returns const_iterator Returns an iterator at the front item.
+ */
+template<class T>
+typename AQueue<T>::const_iterator AQueue<T>::begin() const
+{
+  return makeBegin<const_iterator>();
+}
+
+/**
+ * @brief Const iterator past back of queue
+ *
+ * Get an iterator just past the back item of the queue that can not be
+ * used to change the items.
+ *
+ * @returns const_iterator Returns an iterator just past the back item.
+ */
+template<class T>
+typename AQueue<T>::const_iterator AQueue<T>::end() const
+{
+  return makeEnd<const_iterator>();
+}
+
+/**
+ * @brief Const iterator to front of queue
+ *
+ * Get a const iterator to the front item, even of a queue that could
+ * be changed.
+ *
+ * @returns const_iterator Returns an iterator at the front item.
+ */
+template<class T>
+typename AQueue<T>::const_iterator AQueue<T>::cbegin() const
+{
+  return makeBegin<const_iterator>();
+}
+
+/**
+ * @brief Const iterator past back of queue
+ *
+ * Get a const iterator just past the back item, even of a queue that
+ * could be changed.
+ *
+ * @returns const_iterator Returns an iterator just past the back item.
+ */
+template<class T>
+typename AQueue<T>::const_iterator AQueue<T>::cend() const
+{
+  return makeEnd<const_iterator>();
+}
+
+/**
+ * @brief Make iterator to front of queue
+ *
+ * Private member method to build an iterator at the front item.  The
+ * first segment runs from the front item to the end of the allocation,
+ * or to the back item if the values do not wrap around, and the second
+ * segment is the rest of the values from the start of the allocation.
+ *
+ * @returns Iterator Returns the iterator or const_iterator at the front
+ *   item.
+ */
+template<class T>
+template<class Iterator>
+Iterator AQueue<T>::makeBegin() const
+{
+  if (this->size == 0)
+  {
+    return makeEnd<Iterator>();
+  }
+
+  int firstSegmentSize = min(this->size, allocationSize - frontIndex);
+  int secondSegmentSize = this->size - firstSegmentSize;
+  if (secondSegmentSize == 0)
+  {
+    return Iterator(values + frontIndex, values + frontIndex + firstSegmentSize, nullptr, nullptr);
+  }
+  return Iterator(values + frontIndex, values + allocationSize, values, values + secondSegmentSize);
+}
+
+/**
+ * @brief Make iterator past back of queue
+ *
+ * Private member method to build an iterator just past the back item,
+ * in the last segment of the values.
+ *
+ * @returns Iterator Returns the iterator or const_iterator just past the
+ *   back item.
+ */
+template<class T>
+template<class Iterator>
+Iterator AQueue<T>::makeEnd() const
+{
+  if (this->size == 0)
+  {
+    return Iterator();
+  }
+
+  int firstSegmentSize = min(this->size, allocationSize - frontIndex);
+  int secondSegmentSize = this->size - firstSegmentSize;
+  if (secondSegmentSize == 0)
+  {
+    T* last = values + frontIndex + firstSegmentSize;
+    return Iterator(last, last, nullptr, nullptr);
+  }
+  return Iterator(values + secondSegmentSize, values + secondSegmentSize, nullptr, nullptr);
+}
+
 /**
  * @brief Clear out queue
  *
@@ -298,46 +664,122 @@ void AQueue<T>::clear()
  *
  * Private member method that will increase the memory allocation if
  * the queue is currently at capacity.  To do this, we double the
- * current allocation, copy all of the values from the original block
- * of memory to the new block of memory, then delete the old block
- * that is no longer needed.  This method is called by methods that
- * need to grow the queue, to ensure we have enough allocated capacity
- * to accommodate the growth.
+ * current allocation and reallocate the values into the new block
+ * of memory.  This method is called by methods that need to grow the
+ * queue, to ensure we have enough allocated capacity to accommodate
+ * the growth.
  */
 template<class T>
 void AQueue<T>::growQueueIfNeeded()
 {
-  // if size is still less than what we have allocated, we still have room
-  // to grow at least one or more items in sizes
-  if (this->size < allocationSize)
+  growQueueToFit(this->size + 1);
+}
+
+/**
+ * @brief Grow queue allocation to fit
+ *
+ * Private member method that will increase the memory allocation if
+ * it can not hold the given number of items.  As for a single item,
+ * the allocation is at least doubled, or made size 10 (or the reserved
+ * size, if larger) initially by default if an empty queue is being
+ * grown, but it is grown further if that is still not enough, so a
+ * batch of items only needs a single reallocation.
+ *
+ * @param minimumSize The number of items the allocation must hold.
+ *
+ * @throws QueueMemoryBoundsException if the queue has the
+ *   POWER_OF_TWO_CAPACITY policy and the number of items is larger
+ *   than MAXIMUM_CAPACITY, since it could not be rounded up to a power
+ *   of two.
+ */
+template<class T>
+void AQueue<T>::growQueueToFit(int minimumSize)
+{
+  // if the items still fit in what we have allocated, we have room
+  if (minimumSize <= allocationSize)
   {
     return;
   }
 
-  // otherwise size is equal to our allocation, double the size of our allocation
-  // to accommodate future growth, or make size 10 initially by default if
-  // an empty queue is being grown
+  if ((capacityPolicy == POWER_OF_TWO_CAPACITY) and (minimumSize > MAXIMUM_CAPACITY))
+  {
+    ostringstream out;
+    out << "Error: <AQueue>::growQueueToFit() size " << minimumSize << " is larger than the maximum capacity "
+        << MAXIMUM_CAPACITY;
+
+    throw QueueMemoryBoundsException(out.str());
+  }
+
   int newAllocationSize;
   if (allocationSize == 0)
   {
-    newAllocationSize = INITIAL_ALLOCATION_SIZE;
+    newAllocationSize = max(INITIAL_ALLOCATION_SIZE, reservedSize);
   }
   else
   {
-    newAllocationSize = 2 * allocationSize;
+    newAllocationSize = (allocationSize > INT_MAX / 2) ? INT_MAX : 2 * allocationSize;
   }
+  if (capacityPolicy == POWER_OF_TWO_CAPACITY)
+  {
+    newAllocationSize = min(newAllocationSize, MAXIMUM_CAPACITY);
+  }
+  newAllocationSize = roundAllocationSize(max(minimumSize, newAllocationSize));
+
+  reallocate(newAllocationSize);
+}
 
+/**
+ * @brief Shrink queue allocation
+ *
+ * Private member method that will halve the memory allocation if the
+ * queue has drained to less than a quarter of it.  The allocation
+ * is never shrunk below the initial allocation size of 10, or below
+ * the reserved size.  This method is called by methods that remove
+ * items from the queue.  After a shrink the queue is still less than
+ * half full, so it has to double in size before it grows again.
+ */
+template<class T>
+void AQueue<T>::shrinkQueueIfNeeded()
+{
+  int minimumAllocationSize = roundAllocationSize(max(INITIAL_ALLOCATION_SIZE, reservedSize));
+  if ((allocationSize <= minimumAllocationSize) or (this->size >= allocationSize / 4))
+  {
+    return;
+  }
+
+  reallocate(max(roundAllocationSize(allocationSize / 2), minimumAllocationSize));
+}
+
+/**
+ * @brief Reallocate queue memory
+ *
+ * Move the values of the queue into a newly allocated block of memory
+ * of the given size.  The values in the possibly wrapped original
+ * buffer are moved so that the front of the queue ends up at index 0
+ * of the new block.  This is virtual so that derived queues that keep
+ * additional per item bookkeeping in parallel with the values can
+ * resize that bookkeeping at the same time.
+ *
+ * @param newAllocationSize The size of the new block of memory, must be
+ *   at least as large as the current size of the queue.
+ */
+template<class T>
+void AQueue<T>::reallocate(int newAllocationSize)
+{
   // dynamically allocate a new block of values of the new size
   T* newValues = new T[newAllocationSize];
+  QUEUE_COUNT(grows, (newAllocationSize > allocationSize) ? 1 : 0);
+  QUEUE_COUNT(shrinks, (newAllocationSize < allocationSize) ? 1 : 0);
+  QUEUE_COUNT(bytesCopied, (long long)this->size * sizeof(T));
 
-  // copy the values from the original memory to this new block of memory
-  // we will just go ahead and copy the values in the possibly wrapped
+  // move the values from the original memory to this new block of memory
+  // we will just go ahead and move the values in the possibly wrapped
   // original buffer to index 0 of the new block of values
   int oldIndex = frontIndex;
   for (int newIndex = 0; newIndex < this->size; newIndex++)
   {
-    newValues[newIndex] = values[oldIndex];
-    oldIndex = (oldIndex + 1) % allocationSize;
+    newValues[newIndex] = std::move(values[oldIndex]);
+    oldIndex = wrapIndex(oldIndex + 1);
   }
 
   // we don't need the old block of memory anymore, be good managers of
@@ -352,6 +794,60 @@ void AQueue<T>::growQueueIfNeeded()
   backIndex = this->size - 1;
 }
 
+/**
+ * @brief Round allocation size
+ *
+ * Private member method to round a requested allocation size up to
+ * the size required by the capacity policy of this queue.  For the
+ * POWER_OF_TWO_CAPACITY policy this is the next power of two, otherwise
+ * the requested size is used as is.
+ *
+ * @param minimumSize The smallest allocation size that is needed, for
+ *   the POWER_OF_TWO_CAPACITY policy it must be no larger than
+ *   MAXIMUM_CAPACITY.
+ *
+ * @returns int Returns the allocation size to use.
+ */
+template<class T>
+int AQueue<T>::roundAllocationSize(int minimumSize) const
+{
+  if (capacityPolicy != POWER_OF_TWO_CAPACITY)
+  {
+    return minimumSize;
+  }
+
+  int roundedSize = (minimumSize > 0) ? 1 : 0;
+  while (roundedSize < minimumSize)
+  {
+    roundedSize *= 2;
+  }
+  return roundedSize;
+}
+
+/**
+ * @brief Wrap index around buffer
+ *
+ * Private member method to wrap an index that may have run past the
+ * end of the allocation back around to the start of the circular
+ * buffer.  When the allocation is a power of two, the high bits can
+ * simply be masked off, otherwise we need the modulo of the allocation
+ * size.
+ *
+ * @param index The index to wrap, must not be negative.
+ *
+ * @returns int Returns the index wrapped into the range 0 to
+ *   allocationSize - 1.
+ */
+template<class T>
+int AQueue<T>::wrapIndex(int index) const
+{
+  if (capacityPolicy == POWER_OF_TWO_CAPACITY)
+  {
+    return index & (allocationSize - 1);
+  }
+  return index % allocationSize;
+}
+
 /**
  * @brief Access front of queue
  *
@@ -401,8 +897,43 @@ void AQueue<T>::dequeue()
 
     throw QueueEmptyException(out.str());
   }
-  frontIndex = (frontIndex + 1) % allocationSize;
+  frontIndex = wrapIndex(frontIndex + 1);
   this->size--;
+  QUEUE_COUNT(dequeues, 1);
+  shrinkQueueIfNeeded();
+}
+
+/**
+ * @brief Dequeue and return queue front item
+ *
+ * Dequeue the item from the front of the queue, and return it.  The
+ * front item is moved out of the queue, rather than copied by front()
+ * and then discarded by dequeue().
+ *
+ * @returns T Returns the item that was at the front of the queue.
+ *
+ * @throws QueueEmptyException If an attempt is made to
+ *   dequeue from an empty queue.
+ */
+template<class T>
+T AQueue<T>::dequeueValue()
+{
+  // make sure queue is not empty before we try and access
+  // the front item
+  if (this->isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <AQueue>::dequeueValue() attempt to dequeue front item"
+        << " from empty queue, size:  " << this->size;
+
+    throw QueueEmptyException(out.str());
+  }
+
+  // dequeue() is virtual, so derived queues can restore their ordering
+  // once the front item has been moved out
+  T frontItem = std::move(values[frontIndex]);
+  this->dequeue();
+  return frontItem;
 }
 
 /**
@@ -416,12 +947,397 @@ template<class T>
 void AQueue<T>::enqueue(const T& newItem)
 {
   growQueueIfNeeded();
-  backIndex = (backIndex + 1) % allocationSize;
+  backIndex = wrapIndex(backIndex + 1);
   values[backIndex] = newItem;
   this->size++;
+  QUEUE_COUNT(enqueues, 1);
+}
+
+/**
+ * @brief Enqueue value on back of queue
+ *
+ * Enqueue the value to the back of this Queue, moving it into the
+ * queue instead of copying it.
+ *
+ * @param newItem The value to enqueue on back of the current queue.
+ */
+template<class T>
+void AQueue<T>::enqueue(T&& newItem)
+{
+  growQueueIfNeeded();
+  backIndex = wrapIndex(backIndex + 1);
+  values[backIndex] = std::move(newItem);
+  this->size++;
+  QUEUE_COUNT(enqueues, 1);
+}
+
+/**
+ * @brief Enqueue array of values on back of queue
+ *
+ * Enqueue copies of the given block of values, in order, onto the back
+ * of this Queue.  The allocation is grown at most once for the whole
+ * batch, and the values are then copied in as at most two contiguous
+ * segments, the part that fits before the end of the circular buffer
+ * and the part that wraps around to its start.  For simple types such
+ * as int, std::copy of a contiguous segment is a single memmove.
+ *
+ * @param items The block of values to enqueue.
+ * @param count The number of values in the block.
+ */
+template<class T>
+void AQueue<T>::enqueueArray(const T* items, int count)
+{
+  if (count <= 0)
+  {
+    return;
+  }
+
+  growQueueToFit(this->size + count);
+
+  int startIndex = wrapIndex(frontIndex + this->size);
+  int firstSegment = min(count, allocationSize - startIndex);
+  copy(items, items + firstSegment, values + startIndex);
+  copy(items + firstSegment, items + count, values);
+
+  this->size += count;
+  backIndex = wrapIndex(frontIndex + this->size - 1);
+  QUEUE_COUNT(enqueues, count);
+}
+
+/**
+ * @brief Dequeue front items into array
+ *
+ * Dequeue up to count items from the front of this Queue, moving them
+ * in order into the given block of values.  The items are moved out as
+ * at most two contiguous segments of the circular buffer.
+ *
+ * @param out The block to move the dequeued items into, must have room
+ *   for count items.
+ * @param count The largest number of items to dequeue.
+ *
+ * @returns int Returns the number of items that were dequeued.
+ */
+template<class T>
+int AQueue<T>::dequeueInto(T* out, int count)
+{
+  int dequeued = min(count, this->size);
+  if (dequeued <= 0)
+  {
+    return 0;
+  }
+
+  int firstSegment = min(dequeued, allocationSize - frontIndex);
+  move(values + frontIndex, values + frontIndex + firstSegment, out);
+  move(values, values + dequeued - firstSegment, out + firstSegment);
+
+  frontIndex = wrapIndex(frontIndex + dequeued);
+  this->size -= dequeued;
+  QUEUE_COUNT(dequeues, dequeued);
+  shrinkQueueIfNeeded();
+  return dequeued;
 }
 
+/**
+ * @brief Reserve queue allocation
+ *
+ * Make sure the queue has room for at least the given number of items
+ * without growing.  The reserved size is remembered: the allocation
+ * is never automatically shrunk below it, and when an empty queue
+ * without any allocation, for example after a clear(), grows again it
+ * grows straight to the reserved size.  Reserving 0 removes the
+ * reservation.
+ *
+ * @param minimumAllocation The number of items to reserve room for.
+ *
+ * @throws QueueMemoryBoundsException if the queue has the
+ *   POWER_OF_TWO_CAPACITY policy and the reservation is larger than
+ *   MAXIMUM_CAPACITY.
+ */
+template<class T>
+void AQueue<T>::reserve(int minimumAllocation)
+{
+  if ((capacityPolicy == POWER_OF_TWO_CAPACITY) and (minimumAllocation > MAXIMUM_CAPACITY))
+  {
+    ostringstream out;
+    out << "Error: <AQueue>::reserve() reservation " << minimumAllocation << " is larger than the maximum capacity "
+        << MAXIMUM_CAPACITY;
+
+    throw QueueMemoryBoundsException(out.str());
+  }
 
+  reservedSize = max(0, minimumAllocation);
+  if (reservedSize > allocationSize)
+  {
+    reallocate(roundAllocationSize(reservedSize));
+  }
+}
+
+/**
+ * @brief Shrink allocation to fit
+ *
+ * Give back all of the allocated memory that is not needed to hold the
+ * current items, the allocation is shrunk to the size of the queue
+ * (rounded up under the POWER_OF_TWO_CAPACITY policy).  This drops any
+ * reservation as well, since it asks for all unneeded memory to be
+ * returned.
+ */
+template<class T>
+void AQueue<T>::shrinkToFit()
+{
+  reservedSize = 0;
+
+  int newAllocationSize = roundAllocationSize(this->size);
+  if (newAllocationSize < allocationSize)
+  {
+    reallocate(newAllocationSize);
+  }
+}
+
+/**
+ * @brief Save binary snapshot
+ *
+ * Write a binary snapshot of the queue to the given stream, a header
+ * followed by a record for each item in the order given by
+ * visitSnapshotOrder(), from the front of the queue to the back.  The
+ * items of a plain queue are written directly from the (at most) two
+ * segments of the circular buffer, one stream write per segment when
+ * the items are their own records.  Otherwise they are encoded a
+ * block of records at a time, so the stream is still written in large
+ * blocks without first making a copy of the whole queue.
+ *
+ * @param out The (binary) stream to write the snapshot to.
+ *
+ * @throws QueueSnapshotException if the item type can not be saved
+ *   in a snapshot, or if writing to the stream fails.
+ */
+template<class T>
+void AQueue<T>::saveSnapshot(ostream& out) const
+{
+  typedef QueueSnapshotCodec<T> Codec;
+
+  if constexpr (not Codec::SUPPORTED)
+  {
+    ostringstream message;
+    message << "Error: <AQueue>::saveSnapshot() the item type of this queue"
+            << " can not be saved in a snapshot";
+
+    throw QueueSnapshotException(message.str());
+  }
+  else
+  {
+    typedef typename Codec::Record Record;
+
+    QueueSnapshotHeader header;
+    memcpy(header.magic, QUEUE_SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = QUEUE_SNAPSHOT_VERSION;
+    header.recordSize = sizeof(Record);
+    header.count = this->size;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    visitSnapshotOrder([&out](const T* segment, int segmentSize) {
+      if constexpr (Codec::IDENTITY)
+      {
+        out.write(reinterpret_cast<const char*>(segment), segmentSize * sizeof(Record));
+      }
+      else
+      {
+        const int BLOCK_SIZE = 1024;
+        Record block[BLOCK_SIZE];
+        for (int start = 0; start < segmentSize; start += BLOCK_SIZE)
+        {
+          int blockSize = min(BLOCK_SIZE, segmentSize - start);
+          for (int index = 0; index < blockSize; index++)
+          {
+            block[index] = Codec::encode(segment[start + index]);
+          }
+          out.write(reinterpret_cast<const char*>(block), blockSize * sizeof(Record));
+        }
+      }
+      return bool(out);
+    });
+
+    if (not out)
+    {
+      ostringstream message;
+      message << "Error: <AQueue>::saveSnapshot() failed writing snapshot of "
+              << this->size << " items";
+
+      throw QueueSnapshotException(message.str());
+    }
+  }
+}
+
+/**
+ * @brief Load binary snapshot
+ *
+ * Replace the items of this queue with the items of a binary snapshot
+ * read from the given stream.  The header is checked first, and when
+ * the stream can seek, that it has room for all of the records the
+ * header claims.  The queue is then cleared and the records are read
+ * in blocks straight into the back of the allocation, which is grown
+ * to fit each block as it arrives, so a header claiming more items
+ * than the stream holds can not make the queue allocate memory for
+ * them.  When the length of the stream has been checked the queue is
+ * grown once to fit all of the items instead.  Derived queues that
+ * keep their items in some order then restore it with restoreOrder().
+ *
+ * If the stream does not hold a snapshot of this item type, or is too
+ * short to hold all of its records, the queue is left unchanged.  If
+ * the stream ends while the records are being read, the queue is left
+ * empty.
+ *
+ * @param in The (binary) stream to read the snapshot from.
+ *
+ * @throws QueueSnapshotException if the item type can not be saved
+ *   in a snapshot, if the stream does not hold a snapshot of items of
+ *   this type, or if the stream ends before all items are read.
+ */
+template<class T>
+void AQueue<T>::loadSnapshot(istream& in)
+{
+  typedef QueueSnapshotCodec<T> Codec;
+
+  if constexpr (not Codec::SUPPORTED)
+  {
+    ostringstream message;
+    message << "Error: <AQueue>::loadSnapshot() the item type of this queue"
+            << " can not be restored from a snapshot";
+
+    throw QueueSnapshotException(message.str());
+  }
+  else
+  {
+    typedef typename Codec::Record Record;
+
+    QueueSnapshotHeader header;
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if ((not in) or (memcmp(header.magic, QUEUE_SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) or
+        (header.version != QUEUE_SNAPSHOT_VERSION) or (header.recordSize != sizeof(Record)) or
+        (header.count > uint64_t(INT32_MAX)))
+    {
+      ostringstream message;
+      message << "Error: <AQueue>::loadSnapshot() stream does not hold a"
+              << " snapshot of a queue of this item type";
+
+      throw QueueSnapshotException(message.str());
+    }
+
+    // when the stream can seek, check it is long enough for all of the
+    // records before anything is allocated for them
+    int count = header.count;
+    bool lengthChecked = false;
+    streampos position = in.tellg();
+    if (position != streampos(-1))
+    {
+      if (in.seekg(0, ios::end))
+      {
+        streamoff remaining = in.tellg() - position;
+        in.seekg(position);
+        if (remaining < streamoff(count) * streamoff(sizeof(Record)))
+        {
+          ostringstream message;
+          message << "Error: <AQueue>::loadSnapshot() stream is too short to hold all "
+                  << count << " items of the snapshot";
+
+          throw QueueSnapshotException(message.str());
+        }
+        lengthChecked = true;
+      }
+      else
+      {
+        in.clear();
+        in.seekg(position);
+      }
+    }
+
+    // read the records in blocks, growing the allocation to fit each
+    // block unless the stream is known to hold all of them
+    const int READ_BLOCK_SIZE = 65536;
+    clear();
+    growQueueToFit(lengthChecked ? count : min(count, READ_BLOCK_SIZE));
+    for (int start = 0; (start < count) and in; start += READ_BLOCK_SIZE)
+    {
+      int readSize = min(READ_BLOCK_SIZE, count - start);
+      growQueueToFit(start + readSize);
+
+      if constexpr (Codec::IDENTITY)
+      {
+        in.read(reinterpret_cast<char*>(values + start), streamsize(readSize) * sizeof(Record));
+      }
+      else
+      {
+        const int BLOCK_SIZE = 1024;
+        Record block[BLOCK_SIZE];
+        for (int blockStart = 0; (blockStart < readSize) and in; blockStart += BLOCK_SIZE)
+        {
+          int blockSize = min(BLOCK_SIZE, readSize - blockStart);
+          in.read(reinterpret_cast<char*>(block), blockSize * sizeof(Record));
+          for (int index = 0; index < blockSize; index++)
+          {
+            values[start + blockStart + index] = Codec::decode(block[index]);
+          }
+        }
+      }
+
+      // the items read so far have to be counted, so they are moved if
+      // the allocation grows for the next block
+      this->size = start + readSize;
+      backIndex = this->size - 1;
+    }
+
+    if (not in)
+    {
+      clear();
+
+      ostringstream message;
+      message << "Error: <AQueue>::loadSnapshot() snapshot ended before all "
+              << count << " items were read";
+
+      throw QueueSnapshotException(message.str());
+    }
+
+    this->size = count;
+    frontIndex = 0;
+    backIndex = count - 1;
+    restoreOrder();
+  }
+}
+
+/**
+ * @brief Visit items in snapshot order
+ *
+ * Hook called by saveSnapshot() to visit the items in the order they
+ * are saved, which should be the order they will be dequeued in.  A
+ * plain queue keeps its items in that order, so they are visited in
+ * place with visitSegments(), but derived queues that keep their items
+ * in some other order override this.
+ *
+ * @param visitor The function to call with a pointer to each segment
+ *   of values and the number of values in it.  It returns false to
+ *   stop the visit.
+ *
+ * @returns bool Returns true if every segment was visited, or false if
+ *   the visitor stopped the visit early.
+ */
+template<class T>
+bool AQueue<T>::visitSnapshotOrder(const function<bool(const T*, int)>& visitor) const
+{
+  return visitSegments(visitor);
+}
+
+/**
+ * @brief Restore order after load
+ *
+ * Hook called once the items of a snapshot have been read into the
+ * queue, from front to back starting at index 0.  A plain queue keeps
+ * its items in the order they were saved, so there is nothing to do
+ * here, but derived queues that keep their items in some other order
+ * override this to put them back into it.
+ */
+template<class T>
+void AQueue<T>::restoreOrder()
+{
+}
 
 /**
  * @brief Cause specific instance compilations
@@ -0,0 +1,596 @@
+/** @file CalendarQueue.cpp
+ * @brief Concrete calendar queue implementation of a Queue ADT that
+ *   dequeues items in order of an integer timestamp.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement a queue of timed events as a calendar queue, an array of
+ * buckets that each hold the items whose timestamps fall on one day of
+ * a year that wraps around.  The current bucket always holds the front
+ * item, so front() is a constant time lookup, and dequeue() turns the
+ * pages of the calendar to the next bucket with an item due this year.
+ */
+#include "CalendarQueue.hpp"
+#include "Job.hpp"
+#include "QueueException.hpp"
+#include <algorithm>
+#include <sstream>
+#include <utility>
+using namespace std;
+
+/**
+ * @brief Default constructor
+ *
+ * Construct an empty queue, a calendar of the fewest buckets, each a
+ * day of one time unit.
+ */
+template<class T>
+CalendarQueue<T>::CalendarQueue()
+{
+  this->size = 0;
+  bucketCount = MINIMUM_BUCKET_COUNT;
+  bucketWidth = 1;
+  buckets = new vector<T>[bucketCount];
+  currentBucket = 0;
+  bucketTop = 0;
+}
+
+/**
+ * @brief Standard constructor
+ *
+ * Construct a queue of items from a (statically) defined and provided
+ * array of items.  Items with equal timestamps will be dequeued in
+ * array order.
+ *
+ * @param initSize The size of the input values were are given as well as the
+ *   size of the new queue we are to construct.
+ * @param initValues The (static) array of values to use to construct
+ *   this Queue values with.
+ */
+template<class T>
+CalendarQueue<T>::CalendarQueue(int initSize, T initValues[])
+  : CalendarQueue()
+{
+  for (int index = 0; index < initSize; index++)
+  {
+    enqueue(initValues[index]);
+  }
+}
+
+/**
+ * @brief Copy constructor
+ *
+ * Make a copy of the given queue, with the same calendar of buckets,
+ * so the copy dequeues its items in the same order as the original.
+ *
+ * @param queue The other queue we are to make a copy of in this
+ *   constructor.
+ */
+template<class T>
+CalendarQueue<T>::CalendarQueue(const CalendarQueue<T>& queue)
+{
+  this->size = queue.size;
+  bucketCount = queue.bucketCount;
+  bucketWidth = queue.bucketWidth;
+  buckets = new vector<T>[bucketCount];
+  for (int bucket = 0; bucket < bucketCount; bucket++)
+  {
+    buckets[bucket] = queue.buckets[bucket];
+  }
+  currentBucket = queue.currentBucket;
+  bucketTop = queue.bucketTop;
+}
+
+/**
+ * @brief Class destructor
+ *
+ * Free up the buckets of the calendar.
+ */
+template<class T>
+CalendarQueue<T>::~CalendarQueue()
+{
+  delete[] buckets;
+}
+
+/**
+ * @brief Bucket count accessor
+ *
+ * Accessor method to get the number of buckets, the days of the year
+ * of the calendar.
+ *
+ * @returns int Returns the current number of buckets.
+ */
+template<class T>
+int CalendarQueue<T>::getBucketCount() const
+{
+  return bucketCount;
+}
+
+/**
+ * @brief Bucket width accessor
+ *
+ * Accessor method to get the span of timestamps that fall on each
+ * day of the calendar.
+ *
+ * @returns int Returns the current width of a bucket.
+ */
+template<class T>
+int CalendarQueue<T>::getBucketWidth() const
+{
+  return bucketWidth;
+}
+
+/**
+ * @brief Access front of queue
+ *
+ * Accessor method to get a copy of the item with the earliest
+ * timestamp, which is the last item of the current bucket.
+ *
+ * @returns T Returns a copy of the front item of the queue.
+ *
+ * @throws QueueEmptyException If an attempt is made to
+ *   access front item of an empty queue.
+ */
+template<class T>
+T CalendarQueue<T>::front() const
+{
+  if (this->isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <CalendarQueue>::front() attempt to get item"
+        << " from empty queue, size:  " << this->size;
+
+    throw QueueEmptyException(out.str());
+  }
+
+  return buckets[currentBucket].back();
+}
+
+/**
+ * @brief Boolean equals operator
+ *
+ * Check if this Queue is equal to the right hand side (rhs) queue.
+ * The queues are equal if their sizes are equal, and all items in the
+ * queues are equal, this queue being compared bucket by bucket.
+ *
+ * @param rhs The other queue on the right hand side of the
+ *   boolean comparison that we are comparing this queue to.
+ *
+ * @returns bool true if the queues are equal, false if they are not.
+ */
+template<class T>
+bool CalendarQueue<T>::operator==(const Queue<T>& rhs) const
+{
+  if (this->size != rhs.getSize())
+  {
+    return false;
+  }
+
+  // walk the buckets in step with the segments of rhs, skipping over
+  // empty buckets
+  struct
+  {
+    int bucket;
+    int index;
+  } cursor = {0, 0};
+  return rhs.visitSegments([this, &cursor](const T* segment, int count) {
+    for (int segmentIndex = 0; segmentIndex < count; segmentIndex++)
+    {
+      while (cursor.index == int(buckets[cursor.bucket].size()))
+      {
+        cursor.bucket++;
+        cursor.index = 0;
+      }
+      if (not(buckets[cursor.bucket][cursor.index] == segment[segmentIndex]))
+      {
+        return false;
+      }
+      cursor.index++;
+    }
+    return true;
+  });
+}
+
+/**
+ * @brief Indexing operator
+ *
+ * Provide a way to index the items of the queue, bucket by bucket,
+ * with bounds checking.  Finding an index walks the buckets, so this
+ * is O(number of buckets), use visitSegments() to walk the queue.
+ *
+ * @param index The index of the item it is desired to access from
+ *   this Queue, counting bucket by bucket.
+ *
+ * @returns T& Returns a reference to the item at the requested index.
+ *
+ * @throws QueueMemoryBoundsException if a request for an index beyond
+ *   the end of the queue (or less than 0) is made.
+ */
+template<class T>
+T& CalendarQueue<T>::operator[](int index) const
+{
+  if ((index < 0) or (index >= this->size))
+  {
+    ostringstream out;
+    out << "Error: <CalendarQueue::operator[]> illegal bounds access, queue size: " << this->size
+        << " tried to access index address: " << index;
+
+    throw QueueMemoryBoundsException(out.str());
+  }
+
+  int bucket = 0;
+  while (index >= int(buckets[bucket].size()))
+  {
+    index -= buckets[bucket].size();
+    bucket++;
+  }
+  return buckets[bucket][index];
+}
+
+/**
+ * @brief Visit contiguous segments of the queue
+ *
+ * Call the visitor with the block of items of each non empty bucket,
+ * in bucket order.
+ *
+ * @param visitor The function to call with each segment.
+ *
+ * @returns bool Returns true if every segment was visited, or false if
+ *   the visitor stopped the visit early.
+ */
+template<class T>
+bool CalendarQueue<T>::visitSegments(const function<bool(const T*, int)>& visitor) const
+{
+  for (int bucket = 0; bucket < bucketCount; bucket++)
+  {
+    if ((not buckets[bucket].empty()) and (not visitor(buckets[bucket].data(), buckets[bucket].size())))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Clear out queue
+ *
+ * Clear or empty out the queue.  Return the queue back to an empty
+ * calendar of the fewest buckets.
+ */
+template<class T>
+void CalendarQueue<T>::clear()
+{
+  delete[] buckets;
+  this->size = 0;
+  bucketCount = MINIMUM_BUCKET_COUNT;
+  bucketWidth = 1;
+  buckets = new vector<T>[bucketCount];
+  currentBucket = 0;
+  bucketTop = 0;
+}
+
+/**
+ * @brief Enqueue copy by timestamp
+ *
+ * Enqueue a copy of the new item in order of its timestamp.
+ *
+ * @param newItem The item to be added to the queue.
+ */
+template<class T>
+void CalendarQueue<T>::enqueue(const T& newItem)
+{
+  enqueue(T(newItem));
+}
+
+/**
+ * @brief Enqueue item by timestamp
+ *
+ * Enqueue the new item in order of its timestamp, into the bucket of
+ * the day it falls on.  If it is now the earliest item, the calendar
+ * is turned back to its day.  The calendar doubles its buckets when
+ * there are more than two items per bucket.
+ *
+ * @param newItem The item to be added to the queue.
+ */
+template<class T>
+void CalendarQueue<T>::enqueue(T&& newItem)
+{
+  int time = CalendarTime<T>::of(newItem);
+  bool isFront = (this->size == 0) or (time < CalendarTime<T>::of(buckets[currentBucket].back()));
+
+  placeItem(std::move(newItem));
+  this->size++;
+  QUEUE_COUNT(enqueues, 1);
+  if (isFront)
+  {
+    setCurrentDay(time);
+  }
+
+  if (this->size > 2 * bucketCount)
+  {
+    resize(2 * bucketCount);
+  }
+}
+
+/**
+ * @brief Dequeue queue front item
+ *
+ * Dequeue the item with the earliest timestamp, and turn the calendar
+ * to the bucket of the next item.  The calendar halves its buckets
+ * when there is less than one item for every two buckets.
+ *
+ * @throws QueueEmptyException If an attempt is made to
+ *   dequeue from an empty queue.
+ */
+template<class T>
+void CalendarQueue<T>::dequeue()
+{
+  if (this->isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <CalendarQueue>::dequeue() attempt to dequeue front item"
+        << " from empty queue, size:  " << this->size;
+
+    throw QueueEmptyException(out.str());
+  }
+
+  buckets[currentBucket].pop_back();
+  this->size--;
+  QUEUE_COUNT(dequeues, 1);
+
+  if ((bucketCount > MINIMUM_BUCKET_COUNT) and (this->size < bucketCount / 2))
+  {
+    resize(bucketCount / 2);
+  }
+  else if (this->size > 0)
+  {
+    findFront();
+  }
+}
+
+/**
+ * @brief Dequeue and return queue front item
+ *
+ * Dequeue the item with the earliest timestamp, and return it.
+ *
+ * @returns T Returns the item that was at the front of the queue.
+ *
+ * @throws QueueEmptyException If an attempt is made to
+ *   dequeue from an empty queue.
+ */
+template<class T>
+T CalendarQueue<T>::dequeueValue()
+{
+  if (this->isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <CalendarQueue>::dequeueValue() attempt to dequeue front item"
+        << " from empty queue, size:  " << this->size;
+
+    throw QueueEmptyException(out.str());
+  }
+
+  T item = std::move(buckets[currentBucket].back());
+  dequeue();
+  return item;
+}
+
+/**
+ * @brief Day of timestamp
+ *
+ * Find the day a timestamp falls on, counting days of the bucket width
+ * from time 0, rounding down for negative timestamps.
+ *
+ * @param time The timestamp.
+ *
+ * @returns long long The day of the timestamp.
+ */
+template<class T>
+long long CalendarQueue<T>::dayOf(int time) const
+{
+  long long day = time / bucketWidth;
+  if ((time % bucketWidth) < 0)
+  {
+    day--;
+  }
+  return day;
+}
+
+/**
+ * @brief Place item in its bucket
+ *
+ * Insert the item into the bucket of the day its timestamp falls on,
+ * keeping the bucket sorted from latest to earliest timestamp.  The
+ * item goes in front of the items with the same timestamp, so it is
+ * removed from the end of the bucket after them.  The caller is
+ * responsible for the size and the current bucket.
+ *
+ * @param item The item to place.
+ */
+template<class T>
+void CalendarQueue<T>::placeItem(T&& item)
+{
+  int time = CalendarTime<T>::of(item);
+  vector<T>& bucket = buckets[dayOf(time) & (bucketCount - 1)];
+
+  // later items are usually enqueued than are in the bucket, so check
+  // the start of the bucket before searching it
+  auto position = bucket.begin();
+  if ((not bucket.empty()) and (CalendarTime<T>::of(bucket.front()) > time))
+  {
+    position = partition_point(bucket.begin(), bucket.end(), [time](const T& other) { return CalendarTime<T>::of(other) > time; });
+  }
+  QUEUE_COUNT(swaps, bucket.end() - position);
+  bucket.insert(position, std::move(item));
+}
+
+/**
+ * @brief Turn calendar to day
+ *
+ * Make the bucket of the day the given timestamp falls on the current
+ * bucket.
+ *
+ * @param time The timestamp of the front item.
+ */
+template<class T>
+void CalendarQueue<T>::setCurrentDay(int time)
+{
+  long long day = dayOf(time);
+  currentBucket = day & (bucketCount - 1);
+  bucketTop = (day + 1) * bucketWidth;
+}
+
+/**
+ * @brief Find front item
+ *
+ * Turn the pages of the calendar from the current bucket until a
+ * bucket has an item due before the end of its day this year.  If a
+ * whole year passes without finding one, the next item is more than a
+ * year away, and the buckets are searched directly for the earliest
+ * item instead.
+ */
+template<class T>
+void CalendarQueue<T>::findFront()
+{
+  for (int page = 0; page < bucketCount; page++)
+  {
+    const vector<T>& bucket = buckets[currentBucket];
+    if ((not bucket.empty()) and (CalendarTime<T>::of(bucket.back()) < bucketTop))
+    {
+      return;
+    }
+    currentBucket = (currentBucket + 1) & (bucketCount - 1);
+    bucketTop += bucketWidth;
+  }
+
+  findEarliest();
+}
+
+/**
+ * @brief Find earliest item
+ *
+ * Search the ends of all of the buckets for the item with the earliest
+ * timestamp, and turn the calendar to its day.  This is O(number of
+ * buckets), and only needed when the next item is more than a year
+ * away, or the calendar has been resized.
+ */
+template<class T>
+void CalendarQueue<T>::findEarliest()
+{
+  int earliestBucket = -1;
+  for (int bucket = 0; bucket < bucketCount; bucket++)
+  {
+    if ((not buckets[bucket].empty()) and
+        ((earliestBucket < 0) or
+         (CalendarTime<T>::of(buckets[bucket].back()) < CalendarTime<T>::of(buckets[earliestBucket].back()))))
+    {
+      earliestBucket = bucket;
+    }
+  }
+  setCurrentDay(CalendarTime<T>::of(buckets[earliestBucket].back()));
+}
+
+/**
+ * @brief Resize calendar
+ *
+ * Change the number of buckets, choose a new width of a day for the
+ * items now in the queue, and redistribute the items into the new
+ * buckets.  The items of each old bucket are placed from the end of the
+ * bucket to the start, in the order they would have been dequeued, so
+ * items with equal timestamps keep their first-in-first-out order.
+ *
+ * @param newBucketCount The new number of buckets, a power of two.
+ */
+template<class T>
+void CalendarQueue<T>::resize(int newBucketCount)
+{
+  int newBucketWidth = sampleBucketWidth();
+  vector<T>* oldBuckets = buckets;
+  int oldBucketCount = bucketCount;
+
+  QUEUE_COUNT(grows, (newBucketCount > bucketCount) ? 1 : 0);
+  QUEUE_COUNT(shrinks, (newBucketCount < bucketCount) ? 1 : 0);
+  QUEUE_COUNT(bytesCopied, (long long)this->size * sizeof(T));
+  bucketCount = newBucketCount;
+  bucketWidth = newBucketWidth;
+  buckets = new vector<T>[bucketCount];
+  for (int bucket = 0; bucket < oldBucketCount; bucket++)
+  {
+    while (not oldBuckets[bucket].empty())
+    {
+      placeItem(std::move(oldBuckets[bucket].back()));
+      oldBuckets[bucket].pop_back();
+    }
+  }
+  delete[] oldBuckets;
+
+  if (this->size > 0)
+  {
+    findEarliest();
+  }
+}
+
+/**
+ * @brief Sample bucket width
+ *
+ * Choose the width of a day from the timestamps of the next items to
+ * be dequeued, as in Brown's calendar queue: three times the average
+ * gap between them, after leaving out gaps more than twice the average
+ * of all of them, so a few outliers do not make the days too long.
+ *
+ * @returns int The new width of a day, at least 1.
+ */
+template<class T>
+int CalendarQueue<T>::sampleBucketWidth() const
+{
+  if (this->size < 2)
+  {
+    return bucketWidth;
+  }
+
+  vector<int> times;
+  times.reserve(this->size);
+  for (int bucket = 0; bucket < bucketCount; bucket++)
+  {
+    for (const T& item : buckets[bucket])
+    {
+      times.push_back(CalendarTime<T>::of(item));
+    }
+  }
+  int sampleSize = min(int(times.size()), WIDTH_SAMPLE_SIZE);
+  partial_sort(times.begin(), times.begin() + sampleSize, times.end());
+
+  double averageGap = (double(times[sampleSize - 1]) - times[0]) / (sampleSize - 1);
+  double totalGap = 0.0;
+  int gapCount = 0;
+  for (int index = 1; index < sampleSize; index++)
+  {
+    double gap = double(times[index]) - times[index - 1];
+    if (gap <= 2.0 * averageGap)
+    {
+      totalGap += gap;
+      gapCount++;
+    }
+  }
+
+  double width = (gapCount > 0) ? 3.0 * totalGap / gapCount : 3.0 * averageGap;
+  return max(1, int(min(width, 1.0e9)));
+}
+
+/**
+ * @brief Cause specific instance compilations
+ *
+ * This is a bit of a kludge, but we can use normal make dependencies
+ * and separate compilation by declaring template class Queue<needed_type>
+ * here of any types we are going to be instantianting with the
+ * template.
+ *
+ * https://isocpp.org/wiki/faq/templates#templates-defn-vs-decl
+ * https://isocpp.org/wiki/faq/templates#separate-template-class-defn-from-decl
+ */
+template class CalendarQueue<int>;
+template class CalendarQueue<Job>;
@@ -0,0 +1,627 @@
+/** @file ConcurrentPriorityQueue.cpp
+ * @brief Concrete thread safe sharded implementation of Priority
+ *   Queue ADT.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement the Queue abstraction as a priority queue that many
+ * threads can enqueue to and dequeue from at the same time.  A single
+ * heap guarded by a single lock makes every thread wait on every
+ * other thread, so instead the items are spread over several shards,
+ * each a binary heap with its own lock (a multi-queue).  An enqueue
+ * locks only one shard, and a dequeue looks at the front of a few
+ * sampled shards and takes the highest priority of those.  The item
+ * dequeued is then not always the highest priority item in the whole
+ * queue, but it is always close to it, and how close can be traded
+ * off against throughput by choosing how many shards are sampled.
+ */
+#include "ConcurrentPriorityQueue.hpp"
+#include "Job.hpp"
+#include "QueueException.hpp"
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+using namespace std;
+
+/**
+ * @brief Sharded constructor
+ *
+ * Construct an empty queue spread over the given number of shards.
+ * The sample count is kept between 1 and the shard count, a sample
+ * count of the shard count or more gives a strict priority queue.
+ *
+ * @param shardCount The number of heaps to spread the items over.
+ * @param sampleCount The number of shards each dequeue looks at.
+ */
+template<class T>
+ConcurrentPriorityQueue<T>::ConcurrentPriorityQueue(int shardCount, int sampleCount)
+{
+  this->shardCount = max(1, shardCount);
+  this->sampleCount = min(max(1, sampleCount), this->shardCount);
+  shards = new Shard[this->shardCount];
+
+  // the base class size member is not used, since it can not be kept
+  // up to date by all of the threads, getSize() uses itemCount instead
+  this->size = 0;
+  itemCount.store(0);
+}
+
+/**
+ * @brief Class destructor
+ *
+ * Return the shards back to the heap.  No thread may be using the
+ * queue once it is being destroyed.
+ */
+template<class T>
+ConcurrentPriorityQueue<T>::~ConcurrentPriorityQueue()
+{
+  delete[] shards;
+}
+
+/**
+ * @brief Size accessor
+ *
+ * @returns int Returns the current size of the queue of values, which
+ *   may already be out of date if other threads are using the queue.
+ */
+template<class T>
+int ConcurrentPriorityQueue<T>::getSize() const
+{
+  return itemCount.load();
+}
+
+/**
+ * @brief Check if empty queue
+ *
+ * @returns bool Returns true if the queue currently holds no items.
+ */
+template<class T>
+bool ConcurrentPriorityQueue<T>::isEmpty() const
+{
+  return getSize() == 0;
+}
+
+/**
+ * @brief Shard count accessor
+ *
+ * @returns int Returns the number of shards the items are spread over.
+ */
+template<class T>
+int ConcurrentPriorityQueue<T>::getShardCount() const
+{
+  return shardCount;
+}
+
+/**
+ * @brief Sample count accessor
+ *
+ * @returns int Returns the number of shards each dequeue looks at.
+ */
+template<class T>
+int ConcurrentPriorityQueue<T>::getSampleCount() const
+{
+  return sampleCount;
+}
+
+/**
+ * @brief Check if strict priority queue
+ *
+ * @returns bool Returns true if every dequeue looks at every shard, so
+ *   that the highest priority item is always the one dequeued.
+ */
+template<class T>
+bool ConcurrentPriorityQueue<T>::isStrict() const
+{
+  return sampleCount == shardCount;
+}
+
+/**
+ * @brief Access front of queue
+ *
+ * Accessor method to get a copy of the highest priority item
+ * currently in the queue.  All of the shards are looked at, whatever
+ * the sample count, so this is the item a strict priority queue would
+ * dequeue next.
+ *
+ * @returns T Returns a copy of the front item of the queue.
+ *
+ * @throws QueueEmptyException If the queue is empty.
+ */
+template<class T>
+T ConcurrentPriorityQueue<T>::front() const
+{
+  int best = lockBestShard(0, shardCount);
+  if (best < 0)
+  {
+    unlockShards(0, shardCount);
+
+    ostringstream out;
+    out << "Error: <ConcurrentPriorityQueue>::front() attempt to get item"
+        << " from empty queue, size:  " << getSize();
+
+    throw QueueEmptyException(out.str());
+  }
+
+  T item = shards[best].heap.front();
+  unlockShards(0, shardCount);
+  return item;
+}
+
+/** @class ConcurrentPriorityQueue::ItemIterator
+ * @brief Iterates over the items of the queue shard by shard.
+ *
+ * The iterator walks the heap of each shard in turn, in the same order
+ * as visitSegments(), skipping empty shards, so the queue can be
+ * compared with another queue in a single pass by equalsInOrder()
+ * instead of searching the shards for each index.
+ */
+template<class T>
+class ConcurrentPriorityQueue<T>::ItemIterator
+{
+public:
+  ItemIterator(const Shard* shards, int shardCount);
+  const T& operator*() const;
+  ItemIterator& operator++();
+
+private:
+  /// @brief the block of shards being iterated over
+  const Shard* shards;
+
+  /// @brief the number of shards in the block
+  int shardCount;
+
+  /// @brief the shard the iterator is in
+  int shard;
+
+  /// @brief the item the iterator is at in the heap of its shard
+  typename AHeapPriorityQueue<T>::const_iterator current;
+
+  /// @brief the end of the heap of the shard the iterator is in
+  typename AHeapPriorityQueue<T>::const_iterator shardEnd;
+
+  void skipEmptyShards();
+};
+
+/**
+ * @brief Iterator constructor
+ *
+ * Construct an iterator at the first item of the first shard that is
+ * not empty.
+ *
+ * @param shards The block of shards to iterate over.
+ * @param shardCount The number of shards in the block.
+ */
+template<class T>
+ConcurrentPriorityQueue<T>::ItemIterator::ItemIterator(const Shard* shards, int shardCount)
+  : shards(shards),
+    shardCount(shardCount),
+    shard(0),
+    current(shards[0].heap.begin()),
+    shardEnd(shards[0].heap.end())
+{
+  skipEmptyShards();
+}
+
+/**
+ * @brief Access current item
+ *
+ * @returns const T& Returns the item the iterator is at.
+ */
+template<class T>
+const T& ConcurrentPriorityQueue<T>::ItemIterator::operator*() const
+{
+  return *current;
+}
+
+/**
+ * @brief Advance to next item
+ *
+ * Move on to the next item of the shard, or to the first item of the
+ * next shard that is not empty once this shard runs out.
+ *
+ * @returns ItemIterator& Returns this iterator.
+ */
+template<class T>
+typename ConcurrentPriorityQueue<T>::ItemIterator& ConcurrentPriorityQueue<T>::ItemIterator::operator++()
+{
+  ++current;
+  skipEmptyShards();
+  return *this;
+}
+
+/**
+ * @brief Skip past the end of shards
+ *
+ * Move on to the following shards while the iterator is at the end of
+ * the shard it is in, stopping at the end of the last shard.
+ */
+template<class T>
+void ConcurrentPriorityQueue<T>::ItemIterator::skipEmptyShards()
+{
+  while ((current == shardEnd) and (shard + 1 < shardCount))
+  {
+    shard++;
+    current = shards[shard].heap.begin();
+    shardEnd = shards[shard].heap.end();
+  }
+}
+
+/**
+ * @brief Boolean equals operator
+ *
+ * Check if this Queue is equal to the right hand side (rhs) queue.
+ * The queues are equal if their sizes are equal, and if all elements
+ * in both queues are equal in the order of visitSegments(), shard by
+ * shard and in heap order within each shard.  This is equality of the
+ * layout of the items over the shards, not of the order in which they
+ * would be dequeued, so two queues holding the same items in different
+ * shards are not equal.  Should only be used while the queues are not
+ * being changed.
+ *
+ * @param rhs The other queue on the right hand side of the
+ *   boolean comparison that we are comparing this Queue to.
+ *
+ * @returns bool true if the queues are equal, false if the are not.
+ */
+template<class T>
+bool ConcurrentPriorityQueue<T>::operator==(const Queue<T>& rhs) const
+{
+  return this->equalsInOrder(ItemIterator(shards, shardCount), rhs);
+}
+
+/**
+ * @brief Visit contiguous segments of the queue
+ *
+ * Call the visitor with the segments of each shard in turn, in the
+ * same order as the indexing operator.  Should only be used while the
+ * queue is not being changed.
+ *
+ * @param visitor The function to call with each segment.
+ *
+ * @returns bool Returns true if every segment was visited, or false if
+ *   the visitor stopped the visit early.
+ */
+template<class T>
+bool ConcurrentPriorityQueue<T>::visitSegments(const function<bool(const T*, int)>& visitor) const
+{
+  for (int shard = 0; shard < shardCount; shard++)
+  {
+    if (not shards[shard].heap.visitSegments(visitor))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Indexing operator
+ *
+ * Access the value at the given position, counting through the
+ * shards in order and through each shard in heap order.  Should only
+ * be used while the queue is not being changed.
+ *
+ * @param index The index of the value it is desired to access from
+ *   this Queue.
+ *
+ * @returns T& Returns a reference to the requested Queue item at
+ *   the requested index.
+ *
+ * @throws QueueMemoryBoundsException if a request for an index beyond
+ *   the end of the queue (or less than 0) is made.
+ */
+template<class T>
+T& ConcurrentPriorityQueue<T>::operator[](int index) const
+{
+  if ((index < 0) or (index >= getSize()))
+  {
+    ostringstream out;
+    out << "Error: <ConcurrentPriorityQueue::operator[]> illegal bounds access, queue size: " << getSize()
+        << " tried to access index address: " << index;
+
+    throw QueueMemoryBoundsException(out.str());
+  }
+
+  int shard = 0;
+  while (index >= shards[shard].heap.getSize())
+  {
+    index -= shards[shard].heap.getSize();
+    shard++;
+  }
+  return shards[shard].heap[index];
+}
+
+/**
+ * @brief Clear out queue
+ *
+ * Clear or empty out the queue, one shard at a time.  Items enqueued
+ * by other threads at the same time may or may not be discarded.
+ */
+template<class T>
+void ConcurrentPriorityQueue<T>::clear()
+{
+  for (int shard = 0; shard < shardCount; shard++)
+  {
+    lock_guard<mutex> guard(shards[shard].lock);
+    itemCount -= shards[shard].heap.getSize();
+    shards[shard].heap.clear();
+  }
+}
+
+/**
+ * @brief Enqueue copy by priority
+ *
+ * Enqueue a copy of the new value in priority order.  The copy is
+ * made once and then moved into place by the move enqueue.
+ *
+ * @param newItem The value to be added to the queue.
+ */
+template<class T>
+void ConcurrentPriorityQueue<T>::enqueue(const T& newItem)
+{
+  enqueue(T(newItem));
+}
+
+/**
+ * @brief Enqueue value by priority
+ *
+ * Enqueue the new value on a randomly chosen shard.  If the shard is
+ * locked by another thread we try the following shards instead of
+ * waiting, and only wait for a lock if every shard was busy.
+ *
+ * @param newItem The value to be added to the queue.
+ */
+template<class T>
+void ConcurrentPriorityQueue<T>::enqueue(T&& newItem)
+{
+  int shard = randomShard();
+  unique_lock<mutex> guard(shards[shard].lock, try_to_lock);
+  for (int attempt = 1; (not guard.owns_lock()) and (attempt < shardCount); attempt++)
+  {
+    shard = (shard + 1) % shardCount;
+    guard = unique_lock<mutex>(shards[shard].lock, try_to_lock);
+  }
+  if (not guard.owns_lock())
+  {
+    guard.lock();
+  }
+
+  shards[shard].heap.enqueue(std::move(newItem));
+  itemCount++;
+}
+
+/**
+ * @brief Dequeue queue front item
+ *
+ * Dequeue the highest priority front item of the sampled shards.
+ *
+ * @throws QueueEmptyException If the queue is empty.
+ */
+template<class T>
+void ConcurrentPriorityQueue<T>::dequeue()
+{
+  dequeueValue();
+}
+
+/**
+ * @brief Dequeue and return queue front item
+ *
+ * Move the highest priority front item of the sampled shards out of
+ * the queue and return it.
+ *
+ * @returns T Returns the item that was dequeued.
+ *
+ * @throws QueueEmptyException If the queue is empty.
+ */
+template<class T>
+T ConcurrentPriorityQueue<T>::dequeueValue()
+{
+  T item;
+  if (not tryDequeue(item))
+  {
+    ostringstream out;
+    out << "Error: <ConcurrentPriorityQueue>::dequeue() attempt to dequeue front item"
+        << " from empty queue, size:  " << getSize();
+
+    throw QueueEmptyException(out.str());
+  }
+
+  return item;
+}
+
+/**
+ * @brief Try to dequeue queue front item
+ *
+ * Move the highest priority front item of the sampled shards out of
+ * the queue.  The sampled shards are a window of sample count shards
+ * starting at a random shard.  If all of them are empty then all of
+ * the shards are searched before the queue is taken to be empty, so a
+ * dequeue never fails while there are items in the queue.
+ *
+ * @param item Set to the item that was dequeued, left alone if the
+ *   queue was empty.
+ *
+ * @returns bool true if an item was dequeued, false if the queue was
+ *   empty.
+ */
+template<class T>
+bool ConcurrentPriorityQueue<T>::tryDequeue(T& item)
+{
+  if (dequeueFromShards(item, randomShard(), sampleCount))
+  {
+    return true;
+  }
+
+  if (isStrict())
+  {
+    return false;
+  }
+  return dequeueFromShards(item, 0, shardCount);
+}
+
+/**
+ * @brief Pick a random shard
+ *
+ * Each thread has its own random number generator, so that threads
+ * do not contend on the generator and spread their work differently.
+ *
+ * @returns int The index of a shard picked at random.
+ */
+template<class T>
+int ConcurrentPriorityQueue<T>::randomShard() const
+{
+  static thread_local minstd_rand generator(hash<thread::id>()(this_thread::get_id()));
+  return generator() % shardCount;
+}
+
+/**
+ * @brief Check if shard is in window
+ *
+ * A window is a run of shards starting at the first shard that wraps
+ * around past the last shard back to shard 0.
+ *
+ * @param shard The shard to test.
+ * @param firstShard The shard the window starts at.
+ * @param windowSize The number of shards in the window.
+ *
+ * @returns bool true if the shard is in the window.
+ */
+template<class T>
+bool ConcurrentPriorityQueue<T>::isInWindow(int shard, int firstShard, int windowSize) const
+{
+  return (shard - firstShard + shardCount) % shardCount < windowSize;
+}
+
+/**
+ * @brief Lock window and find best shard
+ *
+ * Lock all of the shards in the window, and find the shard in it whose
+ * front item is of highest priority.  The shards are always locked in
+ * order of their index, whatever shard the window starts at, so that
+ * two threads locking overlapping windows can not deadlock.  All of
+ * the window is left locked and must be unlocked with unlockShards().
+ *
+ * @param firstShard The shard the window starts at.
+ * @param windowSize The number of shards in the window.
+ *
+ * @returns int The index of the best shard, or -1 if every shard in
+ *   the window is empty.
+ */
+template<class T>
+int ConcurrentPriorityQueue<T>::lockBestShard(int firstShard, int windowSize) const
+{
+  int best = -1;
+  for (int shard = 0; shard < shardCount; shard++)
+  {
+    if (not isInWindow(shard, firstShard, windowSize))
+    {
+      continue;
+    }
+
+    shards[shard].lock.lock();
+    if (shards[shard].heap.isEmpty())
+    {
+      continue;
+    }
+    if ((best < 0) or (shards[shard].heap[0] > shards[best].heap[0]))
+    {
+      best = shard;
+    }
+  }
+
+  return best;
+}
+
+/**
+ * @brief Unlock window
+ *
+ * Unlock all of the shards in a window locked by lockBestShard().
+ *
+ * @param firstShard The shard the window starts at.
+ * @param windowSize The number of shards in the window.
+ */
+template<class T>
+void ConcurrentPriorityQueue<T>::unlockShards(int firstShard, int windowSize) const
+{
+  for (int shard = 0; shard < shardCount; shard++)
+  {
+    if (isInWindow(shard, firstShard, windowSize))
+    {
+      shards[shard].lock.unlock();
+    }
+  }
+}
+
+/**
+ * @brief Dequeue from window
+ *
+ * Dequeue the highest priority front item of the shards in the window.
+ *
+ * @param item Set to the item that was dequeued, left alone if the
+ *   window was empty.
+ * @param firstShard The shard the window starts at.
+ * @param windowSize The number of shards in the window.
+ *
+ * @returns bool true if an item was dequeued, false if every shard in
+ *   the window was empty.
+ */
+template<class T>
+bool ConcurrentPriorityQueue<T>::dequeueFromShards(T& item, int firstShard, int windowSize)
+{
+  int best = lockBestShard(firstShard, windowSize);
+  if (best >= 0)
+  {
+    item = shards[best].heap.dequeueValue();
+    itemCount--;
+  }
+  unlockShards(firstShard, windowSize);
+
+  return best >= 0;
+}
+
+/**
+ * @brief Dequeue front items into array
+ *
+ * Dequeue up to count items into the given block of values, stopping
+ * early if the queue is empty.  Unlike the default, which checks
+ * isEmpty() before each dequeue, this is safe while other threads
+ * are dequeuing from the queue as well.
+ *
+ * @param out The block to move the dequeued items into, must have room
+ *   for count items.
+ * @param count The largest number of items to dequeue.
+ *
+ * @returns int Returns the number of items that were dequeued.
+ */
+template<class T>
+int ConcurrentPriorityQueue<T>::dequeueInto(T* out, int count)
+{
+  int dequeued = 0;
+  while ((dequeued < count) and tryDequeue(out[dequeued]))
+  {
+    dequeued++;
+  }
+  return dequeued;
+}
+
+/**
+ * @brief Cause specific instance compilations
+ *
+ * This is a bit of a kludge, but we can use normal make dependencies
+ * and separate compilation by declaring template class Queue<needed_type>
+ * here of any types we are going to be instantianting with the
+ * template.
+ *
+ * https://isocpp.org/wiki/faq/templates#templates-defn-vs-decl
+ * https://isocpp.org/wiki/faq/templates#separate-template-class-defn-from-decl
+ */
+template class ConcurrentPriorityQueue<int>;
+template class ConcurrentPriorityQueue<string>;
+template class ConcurrentPriorityQueue<Job>;
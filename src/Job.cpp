@@ -22,7 +22,7 @@ using namespace std;
  * A constant for the Job class, used to keep track of
  * and assign unique id's for each job created.
  */
-int Job::nextListId = 1;
+atomic<int> Job::nextListId(1);
 
 /**
  * @brief Job default constructor
@@ -35,7 +35,7 @@ int Job::nextListId = 1;
  */
 Job::Job()
 {
-  this->id = nextListId++;
+  this->id = nextListId.fetch_add(1, memory_order_relaxed);
   this->priority = 0;
   this->serviceTime = 0;
   this->startTime = 0;
@@ -84,6 +84,21 @@ void Job::setEndTime(int endTime)
   this->endTime = endTime;
 }
 
+/**
+ * @brief Priority setter
+ *
+ * Setter method to change the priority of this Job, for example to
+ * raise the priority of a job that has been waiting a long time.  A
+ * job that is waiting in a priority queue should have its priority
+ * changed through the queue, so the queue can keep it in order.
+ *
+ * @param priority The new priority level of the job.
+ */
+void Job::setPriority(int priority)
+{
+  this->priority = priority;
+}
+
 /**
  * @brief Get job id
  *
@@ -124,6 +139,34 @@ int Job::getPriority() const
   return priority;
 }
 
+/**
+ * @brief Start time getter
+ *
+ * Getter method to return the time this Job was created, its arrival
+ * time, which is when it began waiting to be serviced.
+ *
+ * @returns int The start time of this Job is returned.
+ */
+int Job::getStartTime() const
+{
+  return startTime;
+}
+
+/**
+ * @brief End time getter
+ *
+ * Getter method to return the time this Job finished waiting and
+ * began being serviced.  Until setEndTime() is called the end time is
+ * the same as the start time, which is 0 for a default constructed
+ * Job.
+ *
+ * @returns int The end time of this Job is returned.
+ */
+int Job::getEndTime() const
+{
+  return endTime;
+}
+
 /**
  * @brief waitTime getter
  *
@@ -0,0 +1,891 @@
+/** @file JobPriorityQueue.cpp
+ * @brief Concrete structure of arrays binary heap implementation of
+ *   Priority Queue ADT specialized for Job items.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement a priority queue of Job items as a binary heap, but
+ * instead of moving whole Job objects around the heap, the heap only
+ * holds a small key for each job, with the jobs themselves held in a
+ * separate block of memory that the heap refers to by index.  The
+ * ordering of the heap only depends on the priority of the jobs, and
+ * the order they were enqueued in, so both are packed into a single
+ * 64 bit integer key, and sifting an item up or down the heap only
+ * compares and moves the keys, which are packed densely together in
+ * memory, instead of calling Job::operator>() and moving the five
+ * ints of a Job at every level.
+ *
+ * The jobs of the queue can also be looked up by their id, to change
+ * their priority or remove them from the middle of the queue.
+ */
+#include "JobPriorityQueue.hpp"
+#include "QueueException.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Default constructor
+ *
+ * Construct an empty queue.  The empty queue will have no allocated memory
+ * nor any values.
+ */
+JobPriorityQueue::JobPriorityQueue()
+{
+  size = 0;
+  allocationSize = 0;
+  keys = nullptr;
+  slots = nullptr;
+  jobs = nullptr;
+  positions = nullptr;
+  freeSlots = nullptr;
+  freeCount = 0;
+  idTable = nullptr;
+  idTableBits = 0;
+  nextSequence = 0;
+}
+
+/**
+ * @brief Standard constructor
+ *
+ * Construct a queue of jobs from a (statically) defined and provided
+ * array of jobs.  The jobs are enqueued as a single batch, so the heap
+ * is built bottom up in O(n) time, and jobs of equal priority will be
+ * dequeued in array order.
+ *
+ * @param initSize The size of the input values were are given as well as the
+ *   size of the new queue we are to construct.
+ * @param initValues The (static) array of jobs to use to construct
+ *   this Queue values with.
+ */
+JobPriorityQueue::JobPriorityQueue(int initSize, Job initValues[])
+  : JobPriorityQueue()
+{
+  enqueueArray(initValues, initSize);
+}
+
+/**
+ * @brief Copy constructor
+ *
+ * Make a copy of the given queue.  The heap of keys and the payload
+ * slots are copied as they are, so the copy has the same jobs in the
+ * same heap order and the same slots as the original.
+ *
+ * @param queue The other queue we are to make a copy of in this
+ *   constructor.
+ */
+JobPriorityQueue::JobPriorityQueue(const JobPriorityQueue& queue)
+  : JobPriorityQueue()
+{
+  if (queue.allocationSize == 0)
+  {
+    return;
+  }
+
+  reallocate(queue.allocationSize);
+  for (int index = 0; index < queue.size; index++)
+  {
+    keys[index] = queue.keys[index];
+    slots[index] = queue.slots[index];
+    jobs[slots[index]] = queue.jobs[slots[index]];
+    positions[slots[index]] = index;
+  }
+  for (int index = 0; index < queue.freeCount; index++)
+  {
+    freeSlots[index] = queue.freeSlots[index];
+  }
+  freeCount = queue.freeCount;
+  size = queue.size;
+  rebuildIdTable();
+  nextSequence = queue.nextSequence;
+}
+
+/**
+ * @brief Class destructor
+ *
+ * Free up the blocks of memory of the heap and the payload.
+ */
+JobPriorityQueue::~JobPriorityQueue()
+{
+  clear();
+}
+
+/**
+ * @brief Allocation size accessor
+ *
+ * Accessor method to get the number of jobs the queue has room for
+ * before it has to grow.
+ *
+ * @returns int Returns the current allocation size of the queue.
+ */
+int JobPriorityQueue::getAllocationSize() const
+{
+  return allocationSize;
+}
+
+/**
+ * @brief Access front of queue
+ *
+ * Accessor method to get a copy of the highest priority job, which is
+ * the job of the key at the root of the heap.
+ *
+ * @returns Job Returns a copy of the front job of the queue.
+ *
+ * @throws QueueEmptyException If an attempt is made to
+ *   access front item of an empty queue.
+ */
+Job JobPriorityQueue::front() const
+{
+  if (isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <JobPriorityQueue>::front() attempt to get item"
+        << " from empty queue, size:  " << size;
+
+    throw QueueEmptyException(out.str());
+  }
+
+  return jobs[slots[0]];
+}
+
+/**
+ * @brief Boolean equals operator
+ *
+ * Check if this Queue is equal to the right hand side (rhs) queue.
+ * The queues are equal if their sizes are equal, and all jobs in the
+ * queues are equal, this queue being compared in heap order.
+ *
+ * @param rhs The other queue on the right hand side of the
+ *   boolean comparison that we are comparing this queue to.
+ *
+ * @returns bool true if the queues are equal, false if they are not.
+ */
+bool JobPriorityQueue::operator==(const Queue<Job>& rhs) const
+{
+  return equalsInOrder(rhs);
+}
+
+/**
+ * @brief Indexing operator
+ *
+ * Provide a way to index the jobs of the queue, in heap order, with
+ * bounds checking.
+ *
+ * @param index The index of the job it is desired to access from
+ *   this Queue.  Index 0 is the front of the queue, but the rest of
+ *   the jobs are in heap order.
+ *
+ * @returns Job& Returns a reference to the job at the requested
+ *   index of the heap.
+ *
+ * @throws QueueMemoryBoundsException if a request for an index beyond
+ *   the end of the heap (or less than 0) is made.
+ */
+Job& JobPriorityQueue::operator[](int index) const
+{
+  if ((index < 0) or (index >= size))
+  {
+    ostringstream out;
+    out << "Error: <JobPriorityQueue::operator[]> illegal bounds access, queue size: " << size
+        << " tried to access index address: " << index;
+
+    throw QueueMemoryBoundsException(out.str());
+  }
+
+  return jobs[slots[index]];
+}
+
+/**
+ * @brief Clear out queue
+ *
+ * Clear or empty out the queue.  Return the queue back
+ * to an empty queue with no allocated memory.
+ */
+void JobPriorityQueue::clear()
+{
+  delete[] keys;
+  delete[] slots;
+  ::operator delete(jobs);
+  delete[] positions;
+  delete[] freeSlots;
+  keys = nullptr;
+  slots = nullptr;
+  jobs = nullptr;
+  positions = nullptr;
+  freeSlots = nullptr;
+  delete[] idTable;
+  idTable = nullptr;
+  idTableBits = 0;
+
+  size = 0;
+  allocationSize = 0;
+  freeCount = 0;
+  nextSequence = 0;
+}
+
+/**
+ * @brief Enqueue copy by priority
+ *
+ * Enqueue a copy of the new job in priority order.
+ *
+ * @param newItem The job to be added to the queue.
+ *
+ * @throws QueueKeyException If a job with the same id as the new job
+ *   is already in the queue.
+ */
+void JobPriorityQueue::enqueue(const Job& newItem)
+{
+  if (nextSequence > MAXIMUM_SEQUENCE)
+  {
+    renumberSequences();
+  }
+  growQueueToFit(size + 1);
+
+  int index = size;
+  placeJob(index, newItem);
+  size++;
+  siftUp(index);
+}
+
+/**
+ * @brief Enqueue value by priority
+ *
+ * Enqueue the new job in priority order.  A Job is only a handful of
+ * ints, so it is simply copied into its payload slot.
+ *
+ * @param newItem The job to be added to the queue.
+ *
+ * @throws QueueKeyException If a job with the same id as the new job
+ *   is already in the queue.
+ */
+void JobPriorityQueue::enqueue(Job&& newItem)
+{
+  enqueue(static_cast<const Job&>(newItem));
+}
+
+/**
+ * @brief Enqueue array of jobs by priority
+ *
+ * Enqueue copies of a batch of jobs in priority order.  As for the
+ * AHeapPriorityQueue, the queue is grown once for the whole batch,
+ * and a batch at least as large as the heap it is added to rebuilds
+ * the whole heap bottom up, O(n + k), while a smaller batch is sifted
+ * up one key at a time, O(k log n).  Jobs of the batch are given
+ * sequence numbers in the order they appear in the batch.
+ *
+ * @param items The block of jobs to enqueue.
+ * @param count The number of jobs in the block.
+ *
+ * @throws QueueKeyException If a job of the batch has the same id as
+ *   a job already in the queue, in which case the jobs of the batch
+ *   before it have been enqueued.
+ */
+void JobPriorityQueue::enqueueArray(const Job* items, int count)
+{
+  if (count <= 0)
+  {
+    return;
+  }
+
+  if (nextSequence + count > MAXIMUM_SEQUENCE + 1)
+  {
+    renumberSequences();
+  }
+  growQueueToFit(size + count);
+
+  int firstNew = size;
+  try
+  {
+    for (int index = 0; index < count; index++)
+    {
+      placeJob(size, items[index]);
+      size++;
+    }
+  }
+  catch (const QueueKeyException&)
+  {
+    // keep the jobs placed before the duplicate in a valid heap
+    restoreHeap(firstNew);
+    throw;
+  }
+  restoreHeap(firstNew);
+}
+
+/**
+ * @brief Dequeue queue front item
+ *
+ * Dequeue the highest priority job.  Its payload slot is freed, and
+ * the back key of the heap is moved into the root and sifted down.
+ * The job itself is never moved.
+ *
+ * @throws QueueEmptyException If an attempt is made to
+ *   dequeue from an empty queue.
+ */
+void JobPriorityQueue::dequeue()
+{
+  if (isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <JobPriorityQueue>::dequeue() attempt to dequeue front item"
+        << " from empty queue, size:  " << size;
+
+    throw QueueEmptyException(out.str());
+  }
+
+  removeAt(0);
+  QUEUE_COUNT(dequeues, 1);
+}
+
+/**
+ * @brief Dequeue and return queue front item
+ *
+ * Dequeue the highest priority job, and return it.
+ *
+ * @returns Job Returns the job that was at the front of the queue.
+ *
+ * @throws QueueEmptyException If an attempt is made to
+ *   dequeue from an empty queue.
+ */
+Job JobPriorityQueue::dequeueValue()
+{
+  if (isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <JobPriorityQueue>::dequeueValue() attempt to dequeue front item"
+        << " from empty queue, size:  " << size;
+
+    throw QueueEmptyException(out.str());
+  }
+
+  Job job = jobs[slots[0]];
+  dequeue();
+  return job;
+}
+
+/**
+ * @brief Test for job id
+ *
+ * Test if a job with the given id is waiting in the queue.
+ *
+ * @param id The id of the job to look for.
+ *
+ * @returns bool true if a job with the id is in the queue, false if not.
+ */
+bool JobPriorityQueue::contains(int id) const
+{
+  return findIdEntry(id) >= 0;
+}
+
+/**
+ * @brief Change priority of job
+ *
+ * Change the priority of the job with the given id, and move its key
+ * up or down the heap to its new place, in O(log n) time.  The job
+ * keeps its enqueue sequence number, so among jobs of its new priority
+ * it is dequeued in the order it was first enqueued, which is what we
+ * want when raising the priority of a job that has been waiting a long
+ * time.
+ *
+ * @param id The id of the job to change the priority of.
+ * @param priority The new priority of the job.
+ *
+ * @throws QueueKeyException If there is no job with the id in the
+ *   queue.
+ */
+void JobPriorityQueue::updatePriority(int id, int priority)
+{
+  int slot = findSlot(id, "updatePriority");
+  int index = positions[slot];
+  uint64_t oldKey = keys[index];
+
+  keys[index] = makeKey(priority, MAXIMUM_SEQUENCE) | (oldKey & MAXIMUM_SEQUENCE);
+  jobs[slot].setPriority(priority);
+  if (keys[index] > oldKey)
+  {
+    siftUp(index);
+  }
+  else
+  {
+    siftDown(index);
+  }
+}
+
+/**
+ * @brief Remove job by id
+ *
+ * Remove the job with the given id from wherever it is in the queue,
+ * in O(log n) time.
+ *
+ * @param id The id of the job to remove.
+ *
+ * @throws QueueKeyException If there is no job with the id in the
+ *   queue.
+ */
+void JobPriorityQueue::erase(int id)
+{
+  int slot = findSlot(id, "erase");
+  removeAt(positions[slot]);
+}
+
+/**
+ * @brief Pack heap key
+ *
+ * Pack the priority and sequence number of a job into its heap key.
+ * The priority is biased so that negative priorities order below
+ * positive ones as unsigned integers, and the sequence number is
+ * complemented so that earlier jobs have larger keys.
+ *
+ * @param priority The priority of the job.
+ * @param sequence The enqueue sequence number of the job.
+ *
+ * @returns uint64_t The key of the job, larger keys are dequeued first.
+ */
+uint64_t JobPriorityQueue::makeKey(int priority, uint64_t sequence)
+{
+  uint64_t biasedPriority = uint32_t(priority) ^ 0x80000000u;
+  return (biasedPriority << 32) | (MAXIMUM_SEQUENCE - sequence);
+}
+
+/**
+ * @brief Grow queue allocation to fit
+ *
+ * Grow the arrays if they can not hold the given number of jobs.  The
+ * allocation is doubled, or made the initial allocation size for an
+ * empty queue, and grown further if that is still not enough.
+ *
+ * @param minimumSize The number of jobs the arrays must hold.
+ */
+void JobPriorityQueue::growQueueToFit(int minimumSize)
+{
+  if (minimumSize <= allocationSize)
+  {
+    return;
+  }
+
+  int newAllocationSize = (allocationSize == 0) ? INITIAL_ALLOCATION_SIZE : 2 * allocationSize;
+  reallocate(max(minimumSize, newAllocationSize));
+}
+
+/**
+ * @brief Reallocate queue memory
+ *
+ * Move the heap, the payload and the free slots into newly allocated
+ * arrays of the given size.  Jobs keep their payload slots, and the
+ * new slots are pushed on the free slot stack so the lowest of them
+ * are used first.  The payload is raw memory that jobs are copied
+ * into, a new Job[] would default construct a job for every slot and
+ * use up a job id for each of them.
+ *
+ * @param newAllocationSize The size of the new arrays, must be
+ *   larger than the current allocation size.
+ */
+void JobPriorityQueue::reallocate(int newAllocationSize)
+{
+  uint64_t* newKeys = new uint64_t[newAllocationSize];
+  int* newSlots = new int[newAllocationSize];
+  static_assert(is_trivially_copyable<Job>::value, "the job payload is copied as raw memory");
+  Job* newJobs = static_cast<Job*>(::operator new(newAllocationSize * sizeof(Job)));
+  int* newPositions = new int[newAllocationSize]();
+  int* newFreeSlots = new int[newAllocationSize];
+
+  for (int index = 0; index < size; index++)
+  {
+    newKeys[index] = keys[index];
+    newSlots[index] = slots[index];
+  }
+  // copy the whole payload in order rather than following the slots of
+  // the heap, a few unused slots are cheaper than jumping around memory
+  if (allocationSize > 0)
+  {
+    memcpy(newJobs, jobs, allocationSize * sizeof(Job));
+  }
+  for (int slot = 0; slot < allocationSize; slot++)
+  {
+    newPositions[slot] = positions[slot];
+  }
+  for (int index = 0; index < freeCount; index++)
+  {
+    newFreeSlots[index] = freeSlots[index];
+  }
+  for (int slot = newAllocationSize - 1; slot >= allocationSize; slot--)
+  {
+    newFreeSlots[freeCount++] = slot;
+  }
+  QUEUE_COUNT(grows, 1);
+  QUEUE_COUNT(bytesCopied, (long long)size * (sizeof(uint64_t) + sizeof(int)) + (long long)allocationSize * (sizeof(Job) + sizeof(int)));
+
+  delete[] keys;
+  delete[] slots;
+  ::operator delete(jobs);
+  delete[] positions;
+  delete[] freeSlots;
+  keys = newKeys;
+  slots = newSlots;
+  jobs = newJobs;
+  positions = newPositions;
+  freeSlots = newFreeSlots;
+  allocationSize = newAllocationSize;
+  rebuildIdTable();
+}
+
+/**
+ * @brief Renumber sequence numbers
+ *
+ * Give the jobs in the heap new sequence numbers starting from 0, in
+ * the order they will be dequeued, once the 32 bits of sequence
+ * numbers in the keys have been used up.  The keys are sorted into
+ * dequeue order, which is also a valid heap, so this is O(n log n),
+ * but it only happens once every four billion enqueues.
+ */
+void JobPriorityQueue::renumberSequences()
+{
+  vector<pair<uint64_t, int>> entries(size);
+  for (int index = 0; index < size; index++)
+  {
+    entries[index] = make_pair(keys[index], slots[index]);
+  }
+  sort(entries.begin(), entries.end(), greater<pair<uint64_t, int>>());
+
+  for (int index = 0; index < size; index++)
+  {
+    uint64_t priorityBits = entries[index].first & ~MAXIMUM_SEQUENCE;
+    keys[index] = priorityBits | (MAXIMUM_SEQUENCE - index);
+    slots[index] = entries[index].second;
+    positions[slots[index]] = index;
+  }
+  nextSequence = size;
+}
+
+/**
+ * @brief Home entry of id
+ *
+ * Hash a job id to the entry of the id table its search starts at.
+ * The id is multiplied by a large odd constant and the top bits of
+ * the product are used, so that consecutive ids are spread out over
+ * the table.
+ *
+ * @param id The job id to hash.
+ *
+ * @returns int The index of the home entry of the id in the id table.
+ */
+int JobPriorityQueue::idHome(int id) const
+{
+  return (uint32_t(id) * 0x9e3779b1u) >> (32 - idTableBits);
+}
+
+/**
+ * @brief Find id table entry
+ *
+ * Search the id table for the entry of the given job id, starting at
+ * its home entry and stepping forward until the id or an empty entry
+ * is found.
+ *
+ * @param id The job id to look for.
+ *
+ * @returns int The index of the entry of the id in the id table, or -1
+ *   if no job in the queue has the id.
+ */
+int JobPriorityQueue::findIdEntry(int id) const
+{
+  if (idTable == nullptr)
+  {
+    return -1;
+  }
+
+  int mask = (1 << idTableBits) - 1;
+  for (int entry = idHome(id); idTable[entry].slot >= 0; entry = (entry + 1) & mask)
+  {
+    if (idTable[entry].id == id)
+    {
+      return entry;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Insert id table entry
+ *
+ * Add the payload slot of a job to the id table, in the first empty
+ * entry at or after the home entry of its id.  The table is at least
+ * twice the allocation size, so there is always an empty entry.
+ *
+ * @param id The id of the job.
+ * @param slot The payload slot of the job.
+ */
+void JobPriorityQueue::insertIdEntry(int id, int slot)
+{
+  int mask = (1 << idTableBits) - 1;
+  int entry = idHome(id);
+  while (idTable[entry].slot >= 0)
+  {
+    entry = (entry + 1) & mask;
+  }
+  idTable[entry].id = id;
+  idTable[entry].slot = slot;
+}
+
+/**
+ * @brief Remove id table entry
+ *
+ * Empty an entry of the id table.  Entries after it, up to the next
+ * empty entry, whose search would have passed over the emptied entry
+ * are moved back into it, so that no search stops early at the hole.
+ *
+ * @param entry The index of the entry to remove.
+ */
+void JobPriorityQueue::removeIdEntry(int entry)
+{
+  int mask = (1 << idTableBits) - 1;
+  int hole = entry;
+  for (int next = (hole + 1) & mask; idTable[next].slot >= 0; next = (next + 1) & mask)
+  {
+    // the entry can fill the hole if its home is not in (hole, next]
+    int home = idHome(idTable[next].id);
+    if (((next - home) & mask) >= ((next - hole) & mask))
+    {
+      idTable[hole] = idTable[next];
+      hole = next;
+    }
+  }
+  idTable[hole].slot = -1;
+}
+
+/**
+ * @brief Rebuild id table
+ *
+ * Allocate a new id table with at least twice as many entries as the
+ * allocation size, and add the jobs in the heap to it.
+ */
+void JobPriorityQueue::rebuildIdTable()
+{
+  delete[] idTable;
+  idTableBits = 1;
+  while ((1 << idTableBits) < 2 * allocationSize)
+  {
+    idTableBits++;
+  }
+
+  int tableSize = 1 << idTableBits;
+  idTable = new IdEntry[tableSize];
+  for (int entry = 0; entry < tableSize; entry++)
+  {
+    idTable[entry].slot = -1;
+  }
+  for (int index = 0; index < size; index++)
+  {
+    insertIdEntry(jobs[slots[index]].getId(), slots[index]);
+  }
+}
+
+/**
+ * @brief Find slot of job id
+ *
+ * Look up the payload slot of the job with the given id.
+ *
+ * @param id The id of the job to look up.
+ * @param method The name of the method looking up the job, for the
+ *   exception message.
+ *
+ * @returns int The payload slot of the job.
+ *
+ * @throws QueueKeyException If there is no job with the id in the
+ *   queue.
+ */
+int JobPriorityQueue::findSlot(int id, const string& method) const
+{
+  int entry = findIdEntry(id);
+  if (entry < 0)
+  {
+    ostringstream out;
+    out << "Error: <JobPriorityQueue>::" << method << "() no job with id: " << id
+        << " in queue, size:  " << size;
+
+    throw QueueKeyException(out.str());
+  }
+
+  return idTable[entry].slot;
+}
+
+/**
+ * @brief Place job at back of heap
+ *
+ * Copy the job into a free payload slot, and give it the next sequence
+ * number and the key at the given index of the heap.  The caller is
+ * responsible for restoring the heap property.
+ *
+ * @param index The index of the heap to put the key of the job at.
+ * @param job The job to place.
+ *
+ * @throws QueueKeyException If a job with the same id is already in
+ *   the queue, in which case nothing is placed.
+ */
+void JobPriorityQueue::placeJob(int index, const Job& job)
+{
+  if (findIdEntry(job.getId()) >= 0)
+  {
+    ostringstream out;
+    out << "Error: <JobPriorityQueue>::enqueue() job with id: " << job.getId()
+        << " is already in queue, size:  " << size;
+
+    throw QueueKeyException(out.str());
+  }
+
+  int slot = freeSlots[--freeCount];
+  jobs[slot] = job;
+  insertIdEntry(job.getId(), slot);
+  keys[index] = makeKey(job.getPriority(), nextSequence++);
+  slots[index] = slot;
+  positions[slot] = index;
+  QUEUE_COUNT(enqueues, 1);
+}
+
+/**
+ * @brief Restore heap after batch
+ *
+ * Restore the heap property after the keys from the given index to the
+ * back of the heap were placed.  As for the AHeapPriorityQueue, a batch
+ * at least as large as the heap it was added to rebuilds the whole
+ * heap bottom up, O(n + k), while a smaller batch is sifted up one key
+ * at a time, O(k log n).
+ *
+ * @param firstNew The index of the first key placed.
+ */
+void JobPriorityQueue::restoreHeap(int firstNew)
+{
+  if (size - firstNew >= firstNew)
+  {
+    for (int index = size / 2 - 1; index >= 0; index--)
+    {
+      siftDown(index);
+    }
+  }
+  else
+  {
+    for (int index = firstNew; index < size; index++)
+    {
+      siftUp(index);
+    }
+  }
+}
+
+/**
+ * @brief Remove key from heap
+ *
+ * Remove the key at the given index of the heap, and free the payload
+ * slot and id of its job.  The back key of the heap is moved into the
+ * hole, and sifted up or down depending on whether it is larger or
+ * smaller than the key it replaced.
+ *
+ * @param index The index of the key to remove.
+ */
+void JobPriorityQueue::removeAt(int index)
+{
+  int slot = slots[index];
+  removeIdEntry(findIdEntry(jobs[slot].getId()));
+  freeSlots[freeCount++] = slot;
+  size--;
+
+  if (index < size)
+  {
+    uint64_t removedKey = keys[index];
+    keys[index] = keys[size];
+    slots[index] = slots[size];
+    if (keys[index] > removedKey)
+    {
+      siftUp(index);
+    }
+    else
+    {
+      siftDown(index);
+    }
+  }
+}
+
+/**
+ * @brief Sift key up the heap
+ *
+ * Move the key at the given index up towards the root of the heap
+ * while it is larger than its parent.  The key and its slot are held
+ * aside and the parents shifted down into the hole, as for the
+ * AHeapPriorityQueue, but only keys are compared and moved.
+ *
+ * @param index The index of the key to sift up.
+ */
+void JobPriorityQueue::siftUp(int index)
+{
+  uint64_t key = keys[index];
+  int slot = slots[index];
+
+  while (index > 0)
+  {
+    int parent = (index - 1) / 2;
+    QUEUE_COUNT(comparisons, 1);
+    if (keys[parent] >= key)
+    {
+      break;
+    }
+
+    keys[index] = keys[parent];
+    slots[index] = slots[parent];
+    positions[slots[index]] = index;
+    index = parent;
+    QUEUE_COUNT(swaps, 1);
+  }
+
+  keys[index] = key;
+  slots[index] = slot;
+  positions[slot] = index;
+}
+
+/**
+ * @brief Sift key down the heap
+ *
+ * Move the key at the given index down towards the leaves of the heap
+ * while one of its children is larger, shifting the larger child up
+ * into the hole at each level.
+ *
+ * @param index The index of the key to sift down.
+ */
+void JobPriorityQueue::siftDown(int index)
+{
+  uint64_t key = keys[index];
+  int slot = slots[index];
+
+  int child = 2 * index + 1;
+  while (child < size)
+  {
+    // pick the larger child, which should be dequeued first
+    QUEUE_COUNT(comparisons, (child + 1 < size) ? 2 : 1);
+    if ((child + 1 < size) and (keys[child + 1] > keys[child]))
+    {
+      child++;
+    }
+
+    if (keys[child] <= key)
+    {
+      break;
+    }
+
+    keys[index] = keys[child];
+    slots[index] = slots[child];
+    positions[slots[index]] = index;
+    index = child;
+    QUEUE_COUNT(swaps, 1);
+    child = 2 * index + 1;
+  }
+
+  keys[index] = key;
+  slots[index] = slot;
+  positions[slot] = index;
+}
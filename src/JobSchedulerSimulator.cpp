@@ -0,0 +1,498 @@
+/** @file JobSchedulerSimulator.cpp
+ * @brief Discrete event simulation of a job scheduling system, driven
+ *   by any Queue of jobs.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Simulate a system that runs jobs on one or more servers.  Jobs
+ * arrive at random on a Poisson basis, wait on a job queue until a
+ * server is free, and then run for their service time.  The queue
+ * decides which waiting job runs next, so comparing the results of
+ * simulations with different kinds of queues compares scheduling
+ * policies, and the time the simulation takes compares the speed of
+ * the queue implementations under load.
+ *
+ * Independent simulations are run in parallel on a pool of threads,
+ * which take the indexes of the simulations to run from a shared
+ * MPMCQueue until it is empty.
+ */
+#include "JobSchedulerSimulator.hpp"
+#include "AHeapPriorityQueue.hpp"
+#include "APriorityQueue.hpp"
+#include "AQueue.hpp"
+#include "JobPriorityQueue.hpp"
+#include "LPriorityQueue.hpp"
+#include "LQueue.hpp"
+#include "MPMCQueue.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+using namespace std;
+
+/**
+ * @brief Wait time percentile
+ *
+ * Find the wait time that the given fraction of the wait times are at
+ * or below.  The wait times are partially reordered.
+ *
+ * @param waitTimes The wait times of the jobs, must not be empty.
+ * @param fraction The fraction of the wait times, between 0 and 1.
+ *
+ * @returns int The wait time at the percentile.
+ */
+static int percentile(vector<int>& waitTimes, double fraction)
+{
+  size_t rank = min(waitTimes.size() - 1, size_t(ceil(fraction * waitTimes.size())) - 1);
+  nth_element(waitTimes.begin(), waitTimes.begin() + rank, waitTimes.end());
+  return waitTimes[rank];
+}
+
+/**
+ * @brief Confidence interval half width
+ *
+ * Compute the half width of the 95% confidence interval of the mean of
+ * a sample, using the Student t distribution for small samples.
+ *
+ * @param values The sample.
+ * @param mean The mean of the sample.
+ *
+ * @returns double The half width of the interval, 0 for a sample of
+ *   less than two values.
+ */
+static double confidenceHalfWidth(const vector<double>& values, double mean)
+{
+  // 97.5th percentiles of the t distribution, for 1 to 30 degrees of freedom
+  const double T_QUANTILES[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+  int count = values.size();
+  if (count < 2)
+  {
+    return 0.0;
+  }
+
+  double sumOfSquares = 0.0;
+  for (double value : values)
+  {
+    sumOfSquares += (value - mean) * (value - mean);
+  }
+  double standardError = sqrt(sumOfSquares / (count - 1) / count);
+  double quantile = (count - 1 <= 30) ? T_QUANTILES[count - 2] : 1.960;
+  return quantile * standardError;
+}
+
+/**
+ * @brief Constructor
+ *
+ * Construct a simulator that runs simulations with the given
+ * parameters.
+ *
+ * @param config The parameters of the simulations.
+ *
+ * @throws invalid_argument If the parameters can not be simulated,
+ *   for example the arrival rate is not positive or the priority mix
+ *   has no weight.
+ */
+JobSchedulerSimulator::JobSchedulerSimulator(const SimulationConfig& config)
+  : config(config)
+{
+  ostringstream out;
+  if (config.numJobs <= 0)
+  {
+    out << "number of jobs must be positive: " << config.numJobs;
+  }
+  else if (not(config.arrivalRate > 0.0))
+  {
+    out << "arrival rate must be positive: " << config.arrivalRate;
+  }
+  else if (config.numServers <= 0)
+  {
+    out << "number of servers must be positive: " << config.numServers;
+  }
+  else if ((config.serviceDistribution != UNIFORM_SERVICE) and not(config.meanServiceTime > 0.0))
+  {
+    out << "mean service time must be positive: " << config.meanServiceTime;
+  }
+  else if ((config.serviceDistribution == UNIFORM_SERVICE) and
+           ((config.minServiceTime <= 0) or (config.maxServiceTime < config.minServiceTime)))
+  {
+    out << "service time range must be positive and not empty: " << config.minServiceTime << " to "
+        << config.maxServiceTime;
+  }
+  else if (config.priorityMix.empty() or
+           any_of(config.priorityMix.begin(), config.priorityMix.end(), [](double weight) { return weight < 0.0; }) or
+           all_of(config.priorityMix.begin(), config.priorityMix.end(), [](double weight) { return weight == 0.0; }))
+  {
+    out << "priority mix must have a positive weight and no negative weights";
+  }
+
+  if (not out.str().empty())
+  {
+    throw invalid_argument("Error: <JobSchedulerSimulator>::JobSchedulerSimulator() " + out.str());
+  }
+}
+
+/**
+ * @brief Configuration accessor
+ *
+ * Accessor method to get the parameters of the simulations this
+ * simulator runs.
+ *
+ * @returns const SimulationConfig& The simulation parameters.
+ */
+const SimulationConfig& JobSchedulerSimulator::getConfig() const
+{
+  return config;
+}
+
+/**
+ * @brief Run simulation
+ *
+ * Run a simulation of the configured number of jobs, using the given
+ * queue to hold the jobs waiting for a server.  The arrival times of
+ * the jobs are a Poisson process, the time between arrivals is
+ * exponentially distributed, and each job is given a priority from the
+ * priority mix and a service time from the service distribution.  Jobs
+ * are numbered from 1 in the order they arrive, so the queue need not
+ * be a kind that accepts Job default ids.
+ *
+ * The simulation is deterministic, running the same simulator on two
+ * queues that dequeue jobs in the same order gives the same results,
+ * apart from the elapsed time.
+ *
+ * @param jobQueue The queue of waiting jobs, which should be empty.
+ *   It is left empty when the simulation completes.
+ *
+ * @returns SimulationResult The measurements of the simulation.
+ */
+SimulationResult JobSchedulerSimulator::simulate(Queue<Job>& jobQueue) const
+{
+  mt19937 generator(config.seed);
+  exponential_distribution<double> interarrivalTime(config.arrivalRate);
+  discrete_distribution<int> priorityIndex(config.priorityMix.begin(), config.priorityMix.end());
+  exponential_distribution<double> exponentialServiceTime(1.0 / config.meanServiceTime);
+  uniform_int_distribution<int> uniformServiceTime(config.minServiceTime, config.maxServiceTime);
+  int constantServiceTime = max(1, int(lround(config.meanServiceTime)));
+
+  SimulationResult result;
+  vector<int> waitTimes;
+  waitTimes.reserve(config.numJobs);
+  long long totalWaitTime = 0;
+  long long busyTime = 0;
+
+  // the completion times of the running jobs, earliest first
+  priority_queue<long long, vector<long long>, greater<long long>> completions;
+  int freeServers = config.numServers;
+
+  double arrivalClock = interarrivalTime(generator);
+  long long nextArrival = llround(ceil(arrivalClock));
+  long generated = 0;
+
+  auto start = chrono::steady_clock::now();
+  while (result.jobs < config.numJobs)
+  {
+    // step to the next arrival or completion, whichever is first
+    long long now = nextArrival;
+    if ((not completions.empty()) and ((generated == config.numJobs) or (completions.top() < now)))
+    {
+      now = completions.top();
+    }
+
+    while ((not completions.empty()) and (completions.top() <= now))
+    {
+      completions.pop();
+      freeServers++;
+      result.events++;
+    }
+
+    while ((generated < config.numJobs) and (nextArrival <= now))
+    {
+      int priority = priorityIndex(generator) + 1;
+      int serviceTime = constantServiceTime;
+      if (config.serviceDistribution == UNIFORM_SERVICE)
+      {
+        serviceTime = uniformServiceTime(generator);
+      }
+      else if (config.serviceDistribution == EXPONENTIAL_SERVICE)
+      {
+        serviceTime = max(1, int(ceil(exponentialServiceTime(generator))));
+      }
+
+      generated++;
+      jobQueue.enqueue(Job(priority, serviceTime, int(nextArrival), int(generated)));
+      result.events++;
+
+      arrivalClock += interarrivalTime(generator);
+      nextArrival = llround(ceil(arrivalClock));
+    }
+    result.maxQueueSize = max(result.maxQueueSize, jobQueue.getSize());
+
+    while ((freeServers > 0) and (not jobQueue.isEmpty()))
+    {
+      Job job = jobQueue.dequeueValue();
+      job.setEndTime(int(now));
+      int waitTime = job.getWaitTime();
+      waitTimes.push_back(waitTime);
+      totalWaitTime += waitTime;
+      // computed in 64 bits, a long wait times a high priority can
+      // overflow the int of Job::getCost()
+      result.totalCost += static_cast<long long>(job.getPriority()) * waitTime;
+      busyTime += job.getServiceTime();
+
+      completions.push(now + job.getServiceTime());
+      freeServers--;
+      result.jobs++;
+      result.events++;
+    }
+  }
+
+  // let the jobs still running complete
+  while (not completions.empty())
+  {
+    result.simulatedTime = completions.top();
+    completions.pop();
+    result.events++;
+  }
+  result.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  result.eventsPerSecond = (result.elapsedSeconds > 0.0) ? result.events / result.elapsedSeconds : 0.0;
+  result.utilization = double(busyTime) / (double(config.numServers) * max(1LL, result.simulatedTime));
+  result.meanCost = double(result.totalCost) / result.jobs;
+  result.meanWaitTime = double(totalWaitTime) / result.jobs;
+  result.medianWaitTime = percentile(waitTimes, 0.5);
+  result.p90WaitTime = percentile(waitTimes, 0.9);
+  result.p99WaitTime = percentile(waitTimes, 0.99);
+  result.maxWaitTime = *max_element(waitTimes.begin(), waitTimes.end());
+  return result;
+}
+
+/**
+ * @brief Replication configuration
+ *
+ * Make the configuration of one replication of this simulator's
+ * configuration.  The replication has its own random number seed,
+ * mixed from the configured seed and the replication number, so each
+ * replication draws an independent stream of jobs, and the same
+ * replication number always draws the same stream.
+ *
+ * @param replication The number of the replication, from 0.
+ *
+ * @returns SimulationConfig The configuration of the replication.
+ */
+SimulationConfig JobSchedulerSimulator::replicationConfig(int replication) const
+{
+  seed_seq sequence = {config.seed, static_cast<unsigned int>(replication)};
+  unsigned int seeds[1];
+  sequence.generate(seeds, seeds + 1);
+
+  SimulationConfig replicationConfig = config;
+  replicationConfig.seed = seeds[0];
+  return replicationConfig;
+}
+
+/**
+ * @brief Run replications in parallel
+ *
+ * Run independent replications of this simulator's configuration in
+ * parallel, each with its own random number stream, see
+ * replicationConfig(), and its own queue of the given type.
+ *
+ * @param replications The number of replications to run.
+ * @param numThreads The number of threads to run them on, or 0 for one
+ *   thread per processor core.
+ *
+ * @returns vector<SimulationResult> The results of the replications,
+ *   in replication order.
+ */
+template<class JobQueue>
+vector<SimulationResult> JobSchedulerSimulator::simulateReplications(int replications, int numThreads) const
+{
+  vector<SimulationConfig> configs;
+  for (int replication = 0; replication < replications; replication++)
+  {
+    configs.push_back(replicationConfig(replication));
+  }
+  return simulateSweep<JobQueue>(configs, numThreads);
+}
+
+/**
+ * @brief Run configurations in parallel
+ *
+ * Run a simulation of each of the given configurations in parallel,
+ * for example a sweep over arrival rates or numbers of servers.  Each
+ * simulation constructs its own queue of the given type on the thread
+ * that runs it, so nothing is shared between the event loops.
+ *
+ * @param configs The configurations to simulate.
+ * @param numThreads The number of threads to run them on, or 0 for one
+ *   thread per processor core.
+ *
+ * @returns vector<SimulationResult> The results of the simulations, in
+ *   the order of their configurations.
+ *
+ * @throws invalid_argument If one of the configurations can not be
+ *   simulated, before any simulation is run.
+ */
+template<class JobQueue>
+vector<SimulationResult> JobSchedulerSimulator::simulateSweep(const vector<SimulationConfig>& configs, int numThreads)
+{
+  vector<JobSchedulerSimulator> simulators;
+  simulators.reserve(configs.size());
+  for (const SimulationConfig& config : configs)
+  {
+    simulators.push_back(JobSchedulerSimulator(config));
+  }
+
+  vector<SimulationResult> results(configs.size());
+  runInParallel(configs.size(), numThreads, [&simulators, &results](int task) {
+    JobQueue jobQueue;
+    results[task] = simulators[task].simulate(jobQueue);
+  });
+  return results;
+}
+
+/**
+ * @brief Summarize simulations
+ *
+ * Aggregate the measurements of a set of independent simulations.
+ *
+ * @param results The results of the simulations.
+ *
+ * @returns SimulationSummary The aggregated measurements.
+ */
+SimulationSummary JobSchedulerSimulator::summarize(const vector<SimulationResult>& results)
+{
+  SimulationSummary summary;
+  summary.runs = results.size();
+  if (results.empty())
+  {
+    return summary;
+  }
+
+  vector<double> meanCosts;
+  vector<double> meanWaitTimes;
+  for (const SimulationResult& result : results)
+  {
+    summary.jobs += result.jobs;
+    summary.events += result.events;
+    summary.simulationSeconds += result.elapsedSeconds;
+    summary.totalCost += result.totalCost;
+    summary.medianWaitTime += result.medianWaitTime;
+    summary.p90WaitTime += result.p90WaitTime;
+    summary.p99WaitTime += result.p99WaitTime;
+    summary.maxWaitTime = max(summary.maxWaitTime, result.maxWaitTime);
+    summary.maxQueueSize = max(summary.maxQueueSize, result.maxQueueSize);
+    meanCosts.push_back(result.meanCost);
+    meanWaitTimes.push_back(result.meanWaitTime);
+  }
+
+  summary.meanCost = accumulate(meanCosts.begin(), meanCosts.end(), 0.0) / summary.runs;
+  summary.meanCostHalfWidth = confidenceHalfWidth(meanCosts, summary.meanCost);
+  summary.meanWaitTime = accumulate(meanWaitTimes.begin(), meanWaitTimes.end(), 0.0) / summary.runs;
+  summary.meanWaitTimeHalfWidth = confidenceHalfWidth(meanWaitTimes, summary.meanWaitTime);
+  summary.medianWaitTime /= summary.runs;
+  summary.p90WaitTime /= summary.runs;
+  summary.p99WaitTime /= summary.runs;
+  return summary;
+}
+
+/**
+ * @brief Run tasks on a thread pool
+ *
+ * Run the tasks numbered 0 to taskCount - 1 on a pool of threads.  The
+ * task numbers are put on an MPMCQueue, and each thread takes the next
+ * task from it as soon as it finishes its last one, so threads that
+ * draw short simulations go on to run more of them.  If a task throws,
+ * the other tasks still run, and the first exception is rethrown once
+ * all of the threads are done.
+ *
+ * @param taskCount The number of tasks to run.
+ * @param numThreads The number of threads in the pool, or 0 for one
+ *   thread per processor core.  No more threads than tasks are started.
+ * @param task The task to run, given the number of the task.
+ */
+void JobSchedulerSimulator::runInParallel(int taskCount, int numThreads, const function<void(int)>& task)
+{
+  if (numThreads <= 0)
+  {
+    numThreads = max(1u, thread::hardware_concurrency());
+  }
+  numThreads = min(numThreads, taskCount);
+
+  MPMCQueue<int> tasks(taskCount);
+  for (int taskNumber = 0; taskNumber < taskCount; taskNumber++)
+  {
+    tasks.enqueue(taskNumber);
+  }
+
+  mutex errorMutex;
+  exception_ptr error;
+  vector<thread> pool;
+  for (int threadNumber = 0; threadNumber < numThreads; threadNumber++)
+  {
+    pool.emplace_back([&tasks, &task, &errorMutex, &error]() {
+      int taskNumber;
+      while (tasks.tryDequeue(taskNumber))
+      {
+        try
+        {
+          task(taskNumber);
+        }
+        catch (...)
+        {
+          lock_guard<mutex> lock(errorMutex);
+          if (not error)
+          {
+            error = current_exception();
+          }
+        }
+      }
+    });
+  }
+  for (thread& worker : pool)
+  {
+    worker.join();
+  }
+
+  if (error)
+  {
+    rethrow_exception(error);
+  }
+}
+
+/**
+ * @brief Cause specific instance compilations
+ *
+ * This is a bit of a kludge, but we can use normal make dependencies
+ * and separate compilation by declaring template class Queue<needed_type>
+ * here of any types we are going to be instantianting with the
+ * template.
+ *
+ * https://isocpp.org/wiki/faq/templates#templates-defn-vs-decl
+ * https://isocpp.org/wiki/faq/templates#separate-template-class-defn-from-decl
+ */
+template vector<SimulationResult> JobSchedulerSimulator::simulateReplications<AQueue<Job>>(int, int) const;
+template vector<SimulationResult> JobSchedulerSimulator::simulateReplications<LQueue<Job>>(int, int) const;
+template vector<SimulationResult> JobSchedulerSimulator::simulateReplications<APriorityQueue<Job>>(int, int) const;
+template vector<SimulationResult> JobSchedulerSimulator::simulateReplications<LPriorityQueue<Job>>(int, int) const;
+template vector<SimulationResult> JobSchedulerSimulator::simulateReplications<AHeapPriorityQueue<Job>>(int, int) const;
+template vector<SimulationResult> JobSchedulerSimulator::simulateReplications<JobPriorityQueue>(int, int) const;
+template vector<SimulationResult> JobSchedulerSimulator::simulateSweep<AQueue<Job>>(const vector<SimulationConfig>&, int);
+template vector<SimulationResult> JobSchedulerSimulator::simulateSweep<LQueue<Job>>(const vector<SimulationConfig>&, int);
+template vector<SimulationResult> JobSchedulerSimulator::simulateSweep<APriorityQueue<Job>>(const vector<SimulationConfig>&, int);
+template vector<SimulationResult> JobSchedulerSimulator::simulateSweep<LPriorityQueue<Job>>(const vector<SimulationConfig>&, int);
+template vector<SimulationResult> JobSchedulerSimulator::simulateSweep<AHeapPriorityQueue<Job>>(const vector<SimulationConfig>&, int);
+template vector<SimulationResult> JobSchedulerSimulator::simulateSweep<JobPriorityQueue>(const vector<SimulationConfig>&, int);
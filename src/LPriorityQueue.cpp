@@ -19,6 +19,9 @@
 #include "LPriorityQueue.hpp"
 #include "Job.hpp"
 #include "QueueException.hpp"
+#include <algorithm>
+#include <utility>
+#include <vector>
 using namespace std;
 
 // define macros to make it easier to access the base class protected
@@ -26,77 +29,483 @@ using namespace std;
 #define size LQueue<T>::size
 #define frontNode LQueue<T>::frontNode
 #define backNode LQueue<T>::backNode
+#define pool LQueue<T>::pool
 
 /**
- * 
- * @brief Enqueue with a sort on linked list
- * 
- * Enqueue a new value and sort the queue so that 
- * its values are alligned in descending order. This 
- * implementation will work with a queue created using 
- * the linked list method as opposed to being created
- * with an array format.
- * 
- *  @param newItem The value to be added to the queue.
- * Initially starts at backIndex but will be compared and swapped
- * with the values "in front" of it within the queue until it's 
- * placed in the proper location.
- * 
+ * @brief Default constructor
+ *
+ * Construct an empty queue that allocates its nodes from its own
+ * private pool.
+ */
+template<class T>
+LPriorityQueue<T>::LPriorityQueue()
+  : LQueue<T>()
+{
+  initializeIndex();
+}
+
+/**
+ * @brief Shared node pool constructor
+ *
+ * Construct an empty queue that allocates its nodes from the given
+ * pool, which may also be used by other queues.  The pool must
+ * outlive this queue.
+ *
+ * @param sharedPool The pool of nodes to allocate nodes from.
+ */
+template<class T>
+LPriorityQueue<T>::LPriorityQueue(NodePool<T>& sharedPool)
+  : LQueue<T>(sharedPool)
+{
+  initializeIndex();
+}
+
+/**
+ * @brief Copy constructor
+ *
+ * Copy the values of the other queue, which are already in priority
+ * order, and then build the index of the copied list in a single walk,
+ * appending each node to the back of the levels it is indexed on.
+ *
+ * @param queue The other priority queue to make a copy of.
+ */
+template<class T>
+LPriorityQueue<T>::LPriorityQueue(const LPriorityQueue<T>& queue)
+  : LQueue<T>(queue)
+{
+  initializeIndex();
+  for (Node<T>* node = frontNode; node != nullptr; node = node->next)
+  {
+    indexNode(node, indexBack);
+  }
+}
+
+/**
+ * @brief Class destructor
+ *
+ * Return the entries of the index to the heap.  The nodes themselves
+ * are released by the LQueue destructor.
+ */
+template<class T>
+LPriorityQueue<T>::~LPriorityQueue()
+{
+  clearIndex();
+}
+
+/**
+ * @brief Clear out queue
+ *
+ * Clear out the index as well as the list of nodes, returning the
+ * entries of the index to the heap.
+ */
+template<class T>
+void LPriorityQueue<T>::clear()
+{
+  clearIndex();
+  LQueue<T>::clear();
+}
+
+/**
+ * @brief Enqueue copy by priority
+ *
+ * Enqueue a copy of the new value in priority order.  The copy is
+ * made once and then moved into its node by the move enqueue.
+ *
+ * @param newItem The value to be added to the queue.
  */
 template<class T>
 void LPriorityQueue<T>::enqueue(const T& newItem)
 {
-  
-  // dynamically allocate a new Node to hold the value
-  Node<T>* newNode = new Node<T>;
-  newNode->value = newItem;
+  enqueue(T(newItem));
+}
+
+/**
+ * @brief Enqueue value by priority
+ *
+ * Enqueue a new value into its sorted position in the linked list, so
+ * that values are kept in descending order of priority.  The new value
+ * is linked in after all of the values that are of higher or equal
+ * priority, so items of equal priority stay first-in-first-out.
+ * Values that belong on the back or the front of the queue are
+ * linked in in O(1) time.  Otherwise the insertion point is searched
+ * for from the top level of the index down, moving along each level
+ * while the next entry is of higher or equal priority, and then along
+ * the list from the last entry of the lowest level, which takes
+ * O(log n) expected time.
+ *
+ * @param newItem The value to be added to the queue.
+ */
+template<class T>
+void LPriorityQueue<T>::enqueue(T&& newItem)
+{
+  // get a new Node from the pool to hold the value
+  Node<T>* newNode = pool->allocate(std::move(newItem));
   newNode->next = nullptr;
 
-  // if queue is currently empty, this node becomes the front and back
-  if (this->isEmpty())
+  // if queue is empty, or the new item is not of higher priority than the
+  // back item, this node simply becomes the new back node, and is indexed
+  // after the back entry of each level
+  QUEUE_COUNT(comparisons, this->isEmpty() ? 0 : 1);
+  if (this->isEmpty() or not(newNode->value > backNode->value))
+  {
+    if (this->isEmpty())
+    {
+      frontNode = newNode;
+    }
+    else
+    {
+      backNode->next = newNode;
+    }
+    backNode = newNode;
+    indexNode(newNode, indexBack);
+  }
+  // if the new item is of higher priority than the front item, it becomes
+  // the new front node, and is indexed before every entry of each level
+  else if (newNode->value > frontNode->value)
   {
+    QUEUE_COUNT(comparisons, 1);
+    newNode->next = frontNode;
     frontNode = newNode;
+
+    IndexNode* previousIndex[MAX_INDEX_LEVEL] = {};
+    indexNode(newNode, previousIndex);
   }
-  // otherwise at least one node, so just make this the new back node
+  // otherwise it belongs somewhere in the middle, find the last entry of
+  // each level that is of higher or equal priority, then the last node
+  // after it that is of higher or equal priority, and link the new node in
+  // after that.  The back node is of lower priority, so the searches
+  // always stop before it
   else
   {
-    backNode->next = newNode;
-  }
+    QUEUE_COUNT(comparisons, 1);
+    IndexNode* previousIndex[MAX_INDEX_LEVEL] = {};
+    IndexNode* current = nullptr;
+    for (int level = indexLevels - 1; level >= 0; level--)
+    {
+      IndexNode* next = (current == nullptr) ? indexFront[level] : current->next;
+      while ((next != nullptr) and (QUEUE_COUNT(comparisons, 1), not(newNode->value > next->node->value)))
+      {
+        current = next;
+        next = next->next;
+      }
+      previousIndex[level] = current;
 
-  // this new node is always the new back node
-  backNode = newNode;
+      if ((current != nullptr) and (level > 0))
+      {
+        current = current->down;
+      }
+    }
+
+    Node<T>* previous = (current == nullptr) ? frontNode : current->node;
+    QUEUE_COUNT(comparisons, 1);
+    while (not(newNode->value > previous->next->value))
+    {
+      previous = previous->next;
+      QUEUE_COUNT(comparisons, 1);
+    }
+    newNode->next = previous->next;
+    previous->next = newNode;
+
+    indexNode(newNode, previousIndex);
+  }
 
   // queue has now grown by 1 item, don't forget to update size member
   // variable
   this->size += 1;
+  QUEUE_COUNT(enqueues, 1);
+}
 
-  Node<T>* tempNode1 = frontNode;
-  Node<T>* tempNode2 = frontNode;
-  for (int index1 = 0; index1 < this->size; index1++)
+/**
+ * @brief Enqueue array of values with a merge
+ *
+ * Enqueue copies of a batch of values in priority order.  The batch
+ * is sorted on its own first, and then merged into the linked list in
+ * a single walk from the front of the list, since each value of the
+ * sorted batch is linked in after the one before it.  The last entry
+ * of each level of the index before the walk is tracked as the walk
+ * goes, so the new nodes are indexed without searching.  Items of
+ * equal priority stay first-in-first-out: the items already in the
+ * queue come before equal items of the batch, and items of the batch
+ * keep the order they were given in.
+ *
+ * @param items The block of values to enqueue.
+ * @param count The number of values in the block.
+ */
+template<class T>
+void LPriorityQueue<T>::enqueueArray(const T* items, int count)
+{
+  if (count <= 0)
   {
-    for (int index2 = 0; index2 < this->size - 1; index2++)
+    return;
+  }
+
+  // stable sort keeps equal priority items of the batch in order
+  vector<T> batch(items, items + count);
+  stable_sort(batch.begin(), batch.end(), [](const T& lhs, const T& rhs) {
+    return lhs > rhs;
+  });
+
+  // previous is the node to link the next batch item in after, or
+  // nullptr while the batch item belongs at the front of the list, and
+  // previousIndex holds the last entry of each level at or before it
+  Node<T>* previous = nullptr;
+  IndexNode* previousIndex[MAX_INDEX_LEVEL] = {};
+  for (int index = 0; index < count; index++)
+  {
+    Node<T>* newNode = pool->allocate(std::move(batch[index]));
+
+    // skip past the nodes that are of higher or equal priority, the
+    // entries of a node are at the front of the rest of each level it
+    // is indexed on, from the lowest level up
+    Node<T>* next = (previous == nullptr) ? frontNode : previous->next;
+    while ((next != nullptr) and (QUEUE_COUNT(comparisons, 1), not(newNode->value > next->value)))
     {
-      if (tempNode1-> value > tempNode2->value)
+      previous = next;
+      next = next->next;
+
+      for (int level = 0; level < indexLevels; level++)
       {
-        T temp = tempNode1 ->value;
-        tempNode1->value = tempNode2->value;
-        tempNode2->value = temp;
+        IndexNode* entry = (previousIndex[level] == nullptr) ? indexFront[level] : previousIndex[level]->next;
+        if ((entry == nullptr) or (entry->node != previous))
+        {
+          break;
+        }
+        previousIndex[level] = entry;
       }
-      tempNode2 = tempNode2->next;
     }
-    tempNode2 = frontNode;
-    tempNode1 = frontNode->next;
-    for (int index3 = 0; index3 < index1; index3++)
+
+    newNode->next = next;
+    if (previous == nullptr)
+    {
+      frontNode = newNode;
+    }
+    else
+    {
+      previous->next = newNode;
+    }
+    if (next == nullptr)
+    {
+      backNode = newNode;
+    }
+    indexNode(newNode, previousIndex);
+    previous = newNode;
+  }
+
+  size += count;
+  QUEUE_COUNT(enqueues, count);
+}
+
+/**
+ * @brief Dequeue queue front item
+ *
+ * Remove the entries of the front node from the index, then dequeue
+ * it from the list.  The entries of the front node are the front
+ * entries of the levels it is indexed on, so this is still O(1)
+ * expected time.
+ *
+ * @throws QueueEmptyException If an attempt is made to
+ *   dequeue from an empty queue.
+ */
+template<class T>
+void LPriorityQueue<T>::dequeue()
+{
+  if (not this->isEmpty())
+  {
+    unindexFrontNode(frontNode);
+  }
+  LQueue<T>::dequeue();
+}
+
+/**
+ * @brief Dequeue front items into array
+ *
+ * Remove the entries of the nodes that will be dequeued from the
+ * index, then dequeue them all at once from the list.
+ *
+ * @param out The block to move the dequeued items into, must have room
+ *   for count items.
+ * @param count The largest number of items to dequeue.
+ *
+ * @returns int Returns the number of items that were dequeued.
+ */
+template<class T>
+int LPriorityQueue<T>::dequeueInto(T* out, int count)
+{
+  Node<T>* node = frontNode;
+  for (int index = 0; index < min(count, this->size); index++)
+  {
+    unindexFrontNode(node);
+    node = node->next;
+  }
+  return LQueue<T>::dequeueInto(out, count);
+}
+
+/**
+ * @brief Initialize index
+ *
+ * Private member method to start out with an empty index, used by the
+ * constructors.
+ */
+template<class T>
+void LPriorityQueue<T>::initializeIndex()
+{
+  for (int level = 0; level < MAX_INDEX_LEVEL; level++)
+  {
+    indexFront[level] = nullptr;
+    indexBack[level] = nullptr;
+  }
+  indexLevels = 0;
+  freeIndexNodes = nullptr;
+  randomState = 0x9e3779b9;
+}
+
+/**
+ * @brief Clear index
+ *
+ * Private member method to return all of the entries of the index,
+ * including the released entries waiting to be reused, to the heap.
+ */
+template<class T>
+void LPriorityQueue<T>::clearIndex()
+{
+  for (int level = 0; level < indexLevels; level++)
+  {
+    while (indexFront[level] != nullptr)
     {
-      tempNode1 = tempNode1->next;
+      IndexNode* entry = indexFront[level];
+      indexFront[level] = entry->next;
+      delete entry;
     }
+    indexBack[level] = nullptr;
+  }
+  indexLevels = 0;
+
+  while (freeIndexNodes != nullptr)
+  {
+    IndexNode* entry = freeIndexNodes;
+    freeIndexNodes = entry->next;
+    delete entry;
+  }
+}
+
+/**
+ * @brief Random index level
+ *
+ * Private member method to choose how many levels of the index a new
+ * node is indexed on.  Each level holds about a quarter of the nodes
+ * of the level below it, so a node is on no level of the index with
+ * probability 3/4, on the first level only with probability 3/16, and
+ * so on.  Two random bits of a xorshift generator are used per level.
+ *
+ * @returns int Returns the number of levels, from 0 to MAX_INDEX_LEVEL.
+ */
+template<class T>
+int LPriorityQueue<T>::randomIndexLevel()
+{
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+
+  int levels = 0;
+  unsigned int bits = randomState;
+  while ((levels < MAX_INDEX_LEVEL) and ((bits & 3) == 0))
+  {
+    levels++;
+    bits >>= 2;
   }
+  return levels;
 }
 
+/**
+ * @brief Index a node
+ *
+ * Private member method to add entries for a node that has just been
+ * linked into the list to a random number of levels of the index.  On
+ * each level the entry is linked in after the given previous entry,
+ * which is then updated to be the new entry, so that a caller adding
+ * several nodes in order can keep using the same previous entries.
+ *
+ * @param node The node to index.
+ * @param previousIndex The entry on each level to link the entry of
+ *   the node in after, or nullptr to link it in at the front of the
+ *   level.  Must have MAX_INDEX_LEVEL entries.
+ */
+template<class T>
+void LPriorityQueue<T>::indexNode(Node<T>* node, IndexNode* previousIndex[])
+{
+  int levels = randomIndexLevel();
+  IndexNode* below = nullptr;
+  for (int level = 0; level < levels; level++)
+  {
+    IndexNode* entry = freeIndexNodes;
+    if (entry != nullptr)
+    {
+      freeIndexNodes = entry->next;
+    }
+    else
+    {
+      entry = new IndexNode;
+    }
+    entry->node = node;
+    entry->down = below;
 
+    if (previousIndex[level] == nullptr)
+    {
+      entry->next = indexFront[level];
+      indexFront[level] = entry;
+    }
+    else
+    {
+      entry->next = previousIndex[level]->next;
+      previousIndex[level]->next = entry;
+    }
+    if (entry->next == nullptr)
+    {
+      indexBack[level] = entry;
+    }
+
+    previousIndex[level] = entry;
+    below = entry;
+  }
+  indexLevels = max(indexLevels, levels);
+}
 
+/**
+ * @brief Unindex front node
+ *
+ * Private member method to remove the entries of the front node of the
+ * list from the index, before the node is dequeued.  The entries are
+ * the front entries of the lowest levels, up to the first level whose
+ * front entry is for another node.  Levels left empty at the top of
+ * the index are dropped.
+ *
+ * @param node The front node, about to be dequeued.
+ */
+template<class T>
+void LPriorityQueue<T>::unindexFrontNode(Node<T>* node)
+{
+  for (int level = 0; level < indexLevels; level++)
+  {
+    IndexNode* entry = indexFront[level];
+    if (entry->node != node)
+    {
+      break;
+    }
 
+    indexFront[level] = entry->next;
+    if (indexFront[level] == nullptr)
+    {
+      indexBack[level] = nullptr;
+    }
+    entry->next = freeIndexNodes;
+    freeIndexNodes = entry;
+  }
 
+  while ((indexLevels > 0) and (indexFront[indexLevels - 1] == nullptr))
+  {
+    indexLevels--;
+  }
+}
 
 /**
  * @brief Cause specific instance compilations
@@ -113,25 +522,3 @@ template class LPriorityQueue<int>;
 template class LPriorityQueue<string>;
 template class LPriorityQueue<Job>;
 
-/*
-  Node<T>* temp1 = frontNode;
-  Node<T>* temp2 = frontNode;
-  for (int i = 0; i < this->size; i++)
-  {
-    for (int j = 0; j < this->size - 1; j++)
-    {
-      if (temp1-> value > temp2->value)
-      {
-        T temp = temp1 ->value;
-        temp1->value = temp2->value;
-        temp2->value = temp;
-      }
-      temp2 = temp2->next;
-    }
-    temp2 = frontNode;
-    temp1 = frontNode->next;
-    for (int k = 0; k < i; k++)
-    {
-      temp1 = temp1->next;
-    }
-  }*/
\ No newline at end of file
@@ -12,7 +12,9 @@
  * new nodes dynamically when items are pushed onto the queue, and
  * deletes these nodes when the value is popped back off.  The Node
  * structure defined in the Node.hpp header file is used by this queue
- * and is private to this queue member functions.  We use the back of
+ * and is private to this queue member functions.  Nodes are allocated
+ * from and released back to a NodePool, which recycles them rather
+ * than going to the heap for every enqueue and dequeue.  We use the back of
  * the linked list to enqueue items onto the queue, and the front of
  * the list to dequeue items from.  This is the natural interpretation
  * of the queue, and since we are only removing from the front, both
@@ -21,9 +23,11 @@
 #include "LQueue.hpp"
 #include "Job.hpp"
 #include "QueueException.hpp"
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <utility>
 using namespace std;
 
 /**
@@ -39,6 +43,32 @@ LQueue<T>::LQueue()
   this->size = 0;
   frontNode = nullptr;
   backNode = nullptr;
+
+  // this queue gets its own private pool of nodes
+  pool = new NodePool<T>();
+  ownsPool = true;
+}
+
+/**
+ * @brief Shared node pool constructor
+ *
+ * Construct an empty queue that allocates its nodes from the given
+ * pool, which may also be used by other queues.  Nodes dequeued from
+ * one queue can then be recycled by enqueues on any of the others.
+ * The pool must outlive this queue.
+ *
+ * @param sharedPool The pool of nodes to allocate nodes from.
+ */
+template<class T>
+LQueue<T>::LQueue(NodePool<T>& sharedPool)
+{
+  // Empty queue has size 0 and top is null
+  this->size = 0;
+  frontNode = nullptr;
+  backNode = nullptr;
+
+  pool = &sharedPool;
+  ownsPool = false;
 }
 
 /**
@@ -62,6 +92,8 @@ LQueue<T>::LQueue(int size, T values[])
   this->size = 0;
   frontNode = nullptr;
   backNode = nullptr;
+  pool = new NodePool<T>();
+  ownsPool = true;
 
   // iterate through the array reusing member functions to
   // simply insert new values one-by-one on the back.
@@ -93,12 +125,15 @@ LQueue<T>::LQueue(const LQueue<T>& queue)
   this->size = 0;
   frontNode = nullptr;
   backNode = nullptr;
+  pool = new NodePool<T>();
+  ownsPool = true;
 
   // if the other queue is not empty, then we need to iterate through
-  // its values and insert them into the back of this queue
-  for (int index = 0; index < queue.getSize(); index++)
+  // its values and insert them into the back of this queue, indexing
+  // the other queue would restart from its front node every time
+  for (const T& value : queue)
   {
-    enqueue(queue[index]);
+    enqueue(value);
   }
 }
 
@@ -116,6 +151,28 @@ LQueue<T>::~LQueue()
   // call clear to do actual work to deallocate any allocation
   // before we destruct
   clear();
+
+  // the nodes all belong to the pool, so it can only be destroyed once
+  // they have been released
+  if (ownsPool)
+  {
+    delete pool;
+  }
+}
+
+/**
+ * @brief Node pool accessor
+ *
+ * Accessor method to get the pool this queue allocates its nodes from,
+ * for example to check how many nodes have been recycled.
+ *
+ * @returns NodePool<T>& Returns a reference to the node pool of this
+ *   queue.
+ */
+template<class T>
+NodePool<T>& LQueue<T>::getNodePool() const
+{
+  return *pool;
 }
 
 /**
@@ -149,56 +206,14 @@ T LQueue<T>::front() const
   return frontNode->value;
 }
 
-/**
- * @brief Queue to string
- *
- * Accessor method to construct and return a string representation
- * of the current values and status of this Queue instance.
- *
- * @returns string Returns the string constructed with the information
- *   about this Queue.
- */
-template<class T>
-string LQueue<T>::str() const
-{
-  ostringstream out;
-
-  // stream queue information into the output stream
-  out << "<queue> size: " << this->size << " front:[ ";
-
-  // stream the current values of the queue to the output stream
-  Node<T>* current = frontNode;
-  while (current != nullptr)
-  {
-    // put value out to the stream
-    out << current->value;
-
-    // advance to the next value
-    current = current->next;
-
-    // separate for next value, or just space if no more values
-    if (current == nullptr)
-    {
-      out << " ";
-    }
-    else
-    {
-      out << ", ";
-    }
-  }
-
-  out << "]:back";
-
-  // convert the string stream into a concrete string to return
-  return out.str();
-}
-
 /**
  * @brief Boolean equals operator
  *
  * Check if this Queue is equal to the right hand side (rhs)
  * queue.  The queues are equal if their sizes are equal, and if
- * all elements in both queues are equal.
+ * all elements in both queues are equal.  Our list of nodes is walked
+ * while the values of rhs are visited segment by segment, so comparing
+ * with any kind of queue is a single linear pass.
  *
  * @param rhs The other queue on the right hand side of the
  *   boolean comparison that we are comparing this Queue to.
@@ -208,26 +223,31 @@ string LQueue<T>::str() const
 template<class T>
 bool LQueue<T>::operator==(const Queue<T>& rhs) const
 {
-  // first the queues have to be of the same size, or else they
-  // cannot be equal
-  if (this->size != rhs.getSize())
-  {
-    return false;
-  }
+  return this->equalsInOrder(begin(), rhs);
+}
 
-  // otherwise, queues are equal if all elements are equal.
-  // compare each element, and if we find a pair that is not
-  // equal then the answer is false
-  for (int index = 0; index < this->size; index++)
+/**
+ * @brief Visit contiguous segments of the queue
+ *
+ * Call the visitor with the value of each node of the list in turn,
+ * since no two values of a linked list are known to be next to each
+ * other in memory.
+ *
+ * @param visitor The function to call with each segment.
+ *
+ * @returns bool Returns true if every segment was visited, or false if
+ *   the visitor stopped the visit early.
+ */
+template<class T>
+bool LQueue<T>::visitSegments(const function<bool(const T*, int)>& visitor) const
+{
+  for (Node<T>* current = frontNode; current != nullptr; current = current->next)
   {
-    if (this->operator[](index) != rhs[index])
+    if (not visitor(&current->value, 1))
     {
       return false;
     }
   }
-
-  // if we get to this point, all values were the same in both
-  // queues, so the answer is true, the queues are equal
   return true;
 }
 
@@ -277,33 +297,107 @@ T& LQueue<T>::operator[](int index) const
   return current->value;
 }
 
+/**
+ * @brief Iterator to front of queue
+ *
+ * Get an iterator to the front item of the queue, iterating from it
+ * visits the items in order from the front to the back of the queue.
+ *
+ * @returns iterator Returns an iterator at the front node, which is the
+ *   same as end() if the queue is empty.
+ */
+template<class T>
+typename LQueue<T>::iterator LQueue<T>::begin()
+{
+  return iterator(frontNode);
+}
+
+/**
+ * @brief Iterator past back of queue
+ *
+ * Get an iterator just past the back item of the queue.
+ *
+ * @returns iterator Returns an iterator past the back node.
+ */
+template<class T>
+typename LQueue<T>::iterator LQueue<T>::end()
+{
+  return iterator(nullptr);
+}
+
+/**
+ * @brief Const iterator to front of queue
+ *
+ * Get an iterator to the front item of the queue that can not be used
+ * to change the items.
+ *
+ * @returns const_iterator Returns an iterator at the front node.
+ */
+template<class T>
+typename LQueue<T>::const_iterator LQueue<T>::begin() const
+{
+  return const_iterator(frontNode);
+}
+
+/**
+ * @brief Const iterator past back of queue
+ *
+ * Get an iterator just past the back item of the queue that can not be
+ * used to change the items.
+ *
+ * @returns const_iterator Returns an iterator past the back node.
+ */
+template<class T>
+typename LQueue<T>::const_iterator LQueue<T>::end() const
+{
+  return const_iterator(nullptr);
+}
+
+/**
+ * @brief Const iterator to front of queue
+ *
+ * Get a const iterator to the front item, even of a queue that could
+ * be changed.
+ *
+ * @returns const_iterator Returns an iterator at the front node.
+ */
+template<class T>
+typename LQueue<T>::const_iterator LQueue<T>::cbegin() const
+{
+  return const_iterator(frontNode);
+}
+
+/**
+ * @brief Const iterator past back of queue
+ *
+ * Get a const iterator just past the back item, even of a queue that
+ * could be changed.
+ *
+ * @returns const_iterator Returns an iterator past the back node.
+ */
+template<class T>
+typename LQueue<T>::const_iterator LQueue<T>::cend() const
+{
+  return const_iterator(nullptr);
+}
+
 /**
  * @brief Clear out queue
  *
  * Clear or empty out the queue.  Return the queue back
- * to an empty queue.
+ * to an empty queue.  The memory of the nodes is returned to the heap
+ * as well, unless the pool is shared with a queue still using it.
  */
 template<class T>
 void LQueue<T>::clear()
 {
-  // if the queue is not empty, we need to deallocate and return the nodes
-  // back to the heap
+  // if the queue is not empty, we need to return the nodes back to
+  // the pool, the whole list of nodes can be given back at once
   if (not this->isEmpty())
   {
-    Node<T>* current = frontNode;
-
-    // iterate through the nodes of the queue to delete them
-    while (current != nullptr)
-    {
-      // remember this node to delete while advancing
-      // to next node for next iteration
-      Node<T>* nodeToDelete = current;
-      current = current->next;
-
-      // now safe to free up the memory of this node
-      delete nodeToDelete;
-    }
+    pool->release(frontNode, backNode, this->size);
   }
+  pool->freeChunks();
 
   // make sure size is now 0 and top is null again
   this->size = 0;
@@ -321,9 +415,8 @@ void LQueue<T>::clear()
 template<class T>
 void LQueue<T>::enqueue(const T& value)
 {
-  // dynamically allocate a new Node to hold the value
-  Node<T>* newNode = new Node<T>;
-  newNode->value = value;
+  // get a new Node from the pool to hold the value
+  Node<T>* newNode = pool->allocate(value);
   newNode->next = nullptr;
 
   // if queue is currently empty, this node becomes the front and back
@@ -343,7 +436,86 @@ void LQueue<T>::enqueue(const T& value)
   // queue has now grown by 1 item, don't forget to update size member
   // variable
   this->size += 1;
- 
+  QUEUE_COUNT(enqueues, 1);
+}
+
+/**
+ * @brief Enqueue value on back of queue
+ *
+ * Enqueue the value to the back of this Queue, moving it into the
+ * queue instead of copying it.
+ *
+ * @param value The value to enqueue on back of the current queue.
+ */
+template<class T>
+void LQueue<T>::enqueue(T&& value)
+{
+  // get a new Node from the pool to hold the value
+  Node<T>* newNode = pool->allocate(std::move(value));
+  newNode->next = nullptr;
+
+  // if queue is currently empty, this node becomes the front and back
+  if (this->isEmpty())
+  {
+    frontNode = newNode;
+  }
+  // otherwise at least one node, so just make this the new back node
+  else
+  {
+    backNode->next = newNode;
+  }
+
+  // this new node is always the new back node
+  backNode = newNode;
+
+  // queue has now grown by 1 item, don't forget to update size member
+  // variable
+  this->size += 1;
+  QUEUE_COUNT(enqueues, 1);
+}
+
+/**
+ * @brief Enqueue array of values on back of queue
+ *
+ * Enqueue copies of the given block of values, in order, onto the back
+ * of this Queue.  A chain of nodes holding the values is built first
+ * and then linked onto the back of the queue all at once.
+ *
+ * @param items The block of values to enqueue.
+ * @param count The number of values in the block.
+ */
+template<class T>
+void LQueue<T>::enqueueArray(const T* items, int count)
+{
+  if (count <= 0)
+  {
+    return;
+  }
+
+  // build the chain of new nodes
+  Node<T>* chainFront = pool->allocate(items[0]);
+  Node<T>* chainBack = chainFront;
+  for (int index = 1; index < count; index++)
+  {
+    Node<T>* newNode = pool->allocate(items[index]);
+    chainBack->next = newNode;
+    chainBack = newNode;
+  }
+  chainBack->next = nullptr;
+
+  // and link the whole chain onto the back of the queue
+  if (this->isEmpty())
+  {
+    frontNode = chainFront;
+  }
+  else
+  {
+    backNode->next = chainFront;
+  }
+  backNode = chainBack;
+
+  this->size += count;
+  QUEUE_COUNT(enqueues, count);
 }
 
 /**
@@ -368,16 +540,17 @@ void LQueue<T>::dequeue()
   }
 
   // remember current front
-  Node<T>* nodeToDelete = frontNode;
+  Node<T>* nodeToRelease = frontNode;
 
   // move to new front
   frontNode = frontNode->next;
 
-  // delete the node we removed
-  delete nodeToDelete;
+  // give the node we removed back to the pool
+  pool->release(nodeToRelease);
 
   // update queue size since we just removed a node
   this->size -= 1;
+  QUEUE_COUNT(dequeues, 1);
 
   // queue could have become empty, so if it did make sure backNode
   // is updated as well
@@ -388,6 +561,82 @@ void LQueue<T>::dequeue()
   }
 }
 
+/**
+ * @brief Dequeue and return queue front item
+ *
+ * Dequeue the item from the front of the queue, and return it.  The
+ * front item is moved out of its node, rather than copied by front()
+ * and then discarded by dequeue().
+ *
+ * @returns T Returns the item that was at the front of the queue.
+ *
+ * @throws QueueEmptyException If an attempt is made to
+ *   dequeue from an empty queue.
+ */
+template<class T>
+T LQueue<T>::dequeueValue()
+{
+  // make sure queue is not empty before we try and access
+  // the front item
+  if (this->isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <LQueue>::dequeueValue() attempt to dequeue front item"
+        << " from empty queue, size:  " << this->size;
+
+    throw QueueEmptyException(out.str());
+  }
+
+  T frontItem = std::move(frontNode->value);
+  dequeue();
+  return frontItem;
+}
+
+/**
+ * @brief Dequeue front items into array
+ *
+ * Dequeue up to count items from the front of this Queue, moving them
+ * in order into the given block of values.  The nodes of all of the
+ * dequeued items are given back to the pool at once.
+ *
+ * @param out The block to move the dequeued items into, must have room
+ *   for count items.
+ * @param count The largest number of items to dequeue.
+ *
+ * @returns int Returns the number of items that were dequeued.
+ */
+template<class T>
+int LQueue<T>::dequeueInto(T* out, int count)
+{
+  int dequeued = min(count, this->size);
+  if (dequeued <= 0)
+  {
+    return 0;
+  }
+
+  // move the values out, stopping on the last node dequeued
+  Node<T>* lastNode = frontNode;
+  out[0] = std::move(lastNode->value);
+  for (int index = 1; index < dequeued; index++)
+  {
+    lastNode = lastNode->next;
+    out[index] = std::move(lastNode->value);
+  }
+
+  Node<T>* newFront = lastNode->next;
+  pool->release(frontNode, lastNode, dequeued);
+  frontNode = newFront;
+
+  this->size -= dequeued;
+  QUEUE_COUNT(dequeues, dequeued);
+  if (this->isEmpty())
+  {
+    frontNode = nullptr;
+    backNode = nullptr;
+  }
+  return dequeued;
+}
+
 /**
  * @brief Cause specific instance compilations
  *
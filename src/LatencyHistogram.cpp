@@ -0,0 +1,275 @@
+/** @file LatencyHistogram.cpp
+ * @brief Implement the fixed memory histogram of operation latencies.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement recording latencies into the buckets of the histogram,
+ * and finding percentiles of the recorded latencies from the counts of
+ * the buckets.
+ */
+#include "LatencyHistogram.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+using namespace std;
+
+/**
+ * @brief Default constructor
+ *
+ * Construct an empty histogram, with no latencies recorded.
+ */
+LatencyHistogram::LatencyHistogram()
+{
+  reset();
+}
+
+/**
+ * @brief Count accessor
+ *
+ * @returns long long Returns the number of latencies recorded.
+ */
+long long LatencyHistogram::getCount() const
+{
+  return count;
+}
+
+/**
+ * @brief Minimum accessor
+ *
+ * @returns long long Returns the smallest latency recorded, in
+ *   nanoseconds, or 0 if none have been recorded.
+ */
+long long LatencyHistogram::getMinimum() const
+{
+  return (count == 0) ? 0 : minimum;
+}
+
+/**
+ * @brief Maximum accessor
+ *
+ * @returns long long Returns the largest latency recorded, in
+ *   nanoseconds, or 0 if none have been recorded.
+ */
+long long LatencyHistogram::getMaximum() const
+{
+  return maximum;
+}
+
+/**
+ * @brief Mean accessor
+ *
+ * @returns double Returns the mean of the latencies recorded, in
+ *   nanoseconds, or 0 if none have been recorded.
+ */
+double LatencyHistogram::getMean() const
+{
+  return (count == 0) ? 0.0 : double(total) / count;
+}
+
+/**
+ * @brief Latency percentile
+ *
+ * Find the latency that the given percent of the recorded latencies
+ * are at or below, for example percentile(99.9) for the latency only
+ * one in a thousand operations took longer than.  The answer is the
+ * highest latency of the bucket the percentile falls in, so it is
+ * never less than the true percentile, and never more than the
+ * largest latency recorded.
+ *
+ * @param percent The percentile to find, from 0 to 100.
+ *
+ * @returns long long Returns the latency of the percentile in
+ *   nanoseconds, or 0 if no latencies have been recorded.
+ */
+long long LatencyHistogram::percentile(double percent) const
+{
+  if (count == 0)
+  {
+    return 0;
+  }
+
+  // the rank of the latency we are looking for, counting from 1,
+  // allowing for rounding so that 99.9% of 1000 is rank 999 not 1000
+  double fraction = min(100.0, max(0.0, percent)) / 100.0;
+  long long rank = max(1LL, (long long)ceil(fraction * count - 1.0e-9));
+
+  long long seen = 0;
+  for (int bucket = 0; bucket < BUCKET_COUNT; bucket++)
+  {
+    seen += counts[bucket];
+    // the last bucket has no upper limit, only the maximum bounds it
+    if ((seen >= rank) and (bucket < BUCKET_COUNT - 1))
+    {
+      return min(highestIn(bucket), maximum);
+    }
+  }
+  return maximum;
+}
+
+/**
+ * @brief Write summary to output stream
+ *
+ * Write the count, mean and the usual percentiles of the recorded
+ * latencies on a single line, in nanoseconds, for example
+ *   <latency> count: 1000 mean: 41.3 p50: 38 p99: 95 p999: 2047
+ *     max: 4122
+ *
+ * @param out The output stream to write the summary to.
+ */
+void LatencyHistogram::write(ostream& out) const
+{
+  ostringstream mean;
+  mean.setf(ios::fixed);
+  mean.precision(1);
+  mean << getMean();
+
+  out << "<latency> count: " << count << " mean: " << mean.str() << " p50: " << percentile(50.0)
+      << " p99: " << percentile(99.0) << " p999: " << percentile(99.9) << " max: " << getMaximum();
+}
+
+/**
+ * @brief Summary to string
+ *
+ * The summary of the latencies as written by write(), gathered up into
+ * a string.
+ *
+ * @returns string Returns the string summarizing the latencies.
+ */
+string LatencyHistogram::str() const
+{
+  ostringstream out;
+  write(out);
+  return out.str();
+}
+
+/**
+ * @brief Record latency
+ *
+ * Count a latency in its bucket.  Negative latencies, which a clock
+ * should never give, are counted as 0.
+ *
+ * @param nanoseconds The latency to record, in nanoseconds.
+ */
+void LatencyHistogram::record(long long nanoseconds)
+{
+  nanoseconds = max(0LL, nanoseconds);
+  counts[bucketOf(nanoseconds)]++;
+  count++;
+  total += nanoseconds;
+  minimum = min(minimum, nanoseconds);
+  maximum = max(maximum, nanoseconds);
+}
+
+/**
+ * @brief Reset histogram
+ *
+ * Forget all of the recorded latencies.
+ */
+void LatencyHistogram::reset()
+{
+  fill(counts, counts + BUCKET_COUNT, 0LL);
+  count = 0;
+  minimum = numeric_limits<long long>::max();
+  maximum = 0;
+  total = 0;
+}
+
+/**
+ * @brief Add histograms
+ *
+ * Add the latencies recorded by another histogram to this one, for
+ * example to combine the histograms of several threads or runs.
+ *
+ * @param rhs The histogram to add to this one.
+ *
+ * @returns LatencyHistogram& Returns this histogram, now holding the
+ *   latencies of both.
+ */
+LatencyHistogram& LatencyHistogram::operator+=(const LatencyHistogram& rhs)
+{
+  for (int bucket = 0; bucket < BUCKET_COUNT; bucket++)
+  {
+    counts[bucket] += rhs.counts[bucket];
+  }
+  count += rhs.count;
+  total += rhs.total;
+  minimum = min(minimum, rhs.minimum);
+  maximum = max(maximum, rhs.maximum);
+  return *this;
+}
+
+/**
+ * @brief Bucket of latency
+ *
+ * Find the bucket a latency is counted in.  A latency below
+ * SUB_BUCKET_COUNT is its own bucket.  Otherwise its highest set bit
+ * picks the doubling it falls in, and the SUB_BUCKET_BITS bits after
+ * it pick the bucket within the doubling.
+ *
+ * @param nanoseconds The latency, not negative.
+ *
+ * @returns int The index of the bucket of the latency.
+ */
+int LatencyHistogram::bucketOf(long long nanoseconds)
+{
+  if (nanoseconds < SUB_BUCKET_COUNT)
+  {
+    return int(nanoseconds);
+  }
+  if (nanoseconds >= (1LL << MAXIMUM_EXPONENT))
+  {
+    return BUCKET_COUNT - 1;
+  }
+
+  int exponent = 63 - __builtin_clzll((unsigned long long)nanoseconds);
+  int shift = exponent - SUB_BUCKET_BITS;
+  return (shift + 1) * SUB_BUCKET_COUNT + int(nanoseconds >> shift) - SUB_BUCKET_COUNT;
+}
+
+/**
+ * @brief Highest latency of bucket
+ *
+ * Find the highest latency that is counted in a bucket, the inverse
+ * of bucketOf().
+ *
+ * @param bucket The index of the bucket.
+ *
+ * @returns long long The highest latency of the bucket, in
+ *   nanoseconds.
+ */
+long long LatencyHistogram::highestIn(int bucket)
+{
+  if (bucket < SUB_BUCKET_COUNT)
+  {
+    return bucket;
+  }
+
+  int shift = bucket / SUB_BUCKET_COUNT - 1;
+  long long lowest = (long long)(bucket % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT) << shift;
+  return lowest + (1LL << shift) - 1;
+}
+
+/**
+ * @brief Overload output stream operator
+ *
+ * Write the summary of the latencies to an output stream, as for
+ * write().
+ *
+ * @param out The output stream to write the summary to.
+ * @param rhs The histogram to summarize.
+ *
+ * @returns ostream& Returns the output stream, so that output
+ *   operations can be chained.
+ */
+ostream& operator<<(ostream& out, const LatencyHistogram& rhs)
+{
+  rhs.write(out);
+  return out;
+}
@@ -0,0 +1,368 @@
+/** @file LatencyQueue.cpp
+ * @brief Implementation of the wrapper around any Queue that records
+ *   the latencies of its enqueue and dequeue operations.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement the LatencyQueue, which passes every operation on to the
+ * queue it wraps, timing the enqueues and dequeues while recording.
+ */
+#include "LatencyQueue.hpp"
+#include "Job.hpp"
+#include <chrono>
+#include <string>
+#include <utility>
+using namespace std;
+
+/**
+ * @brief Wrapping constructor
+ *
+ * Construct a queue that times the operations of the given queue.
+ *
+ * @param queue The queue to pass the operations on to, which must
+ *   outlive this wrapper.
+ * @param recording Whether to start out recording latencies.
+ */
+template<class T>
+LatencyQueue<T>::LatencyQueue(Queue<T>& queue, bool recording)
+  : queue(queue),
+    recording(recording)
+{
+  // the size is always asked of the wrapped queue
+  this->size = 0;
+}
+
+/**
+ * @brief Size accessor
+ *
+ * @returns int Returns the size of the wrapped queue.
+ */
+template<class T>
+int LatencyQueue<T>::getSize() const
+{
+  return queue.getSize();
+}
+
+/**
+ * @brief Check if empty queue
+ *
+ * @returns bool Returns true if the wrapped queue is empty.
+ */
+template<class T>
+bool LatencyQueue<T>::isEmpty() const
+{
+  return queue.isEmpty();
+}
+
+/**
+ * @brief Access front of queue
+ *
+ * @returns T Returns a copy of the front item of the wrapped queue.
+ *
+ * @throws QueueEmptyException If the wrapped queue is empty.
+ */
+template<class T>
+T LatencyQueue<T>::front() const
+{
+  return queue.front();
+}
+
+/**
+ * @brief Equality comparison
+ *
+ * @param rhs The queue to compare the wrapped queue with.
+ *
+ * @returns bool true if the wrapped queue is equal to rhs.
+ */
+template<class T>
+bool LatencyQueue<T>::operator==(const Queue<T>& rhs) const
+{
+  return queue == rhs;
+}
+
+/**
+ * @brief Indexing operator
+ *
+ * @param index The index of the item of the wrapped queue to access.
+ *
+ * @returns T& Returns a reference to the item of the wrapped queue.
+ *
+ * @throws QueueMemoryBoundsException If the index is not valid for
+ *   the wrapped queue.
+ */
+template<class T>
+T& LatencyQueue<T>::operator[](int index) const
+{
+  return queue[index];
+}
+
+/**
+ * @brief Visit contiguous segments of the queue
+ *
+ * Visit the segments of the wrapped queue.
+ *
+ * @param visitor The function to call with each segment.
+ *
+ * @returns bool Returns true if every segment was visited, or false if
+ *   the visitor stopped the visit early.
+ */
+template<class T>
+bool LatencyQueue<T>::visitSegments(const function<bool(const T*, int)>& visitor) const
+{
+  return queue.visitSegments(visitor);
+}
+
+/**
+ * @brief Recording accessor
+ *
+ * @returns bool Returns true if latencies are being recorded.
+ */
+template<class T>
+bool LatencyQueue<T>::isRecording() const
+{
+  return recording;
+}
+
+/**
+ * @brief Turn recording on or off
+ *
+ * Start or stop recording latencies.  The latencies already recorded
+ * are kept.
+ *
+ * @param recording true to record latencies, false to stop.
+ */
+template<class T>
+void LatencyQueue<T>::setRecording(bool recording)
+{
+  this->recording = recording;
+}
+
+/**
+ * @brief Enqueue latency accessor
+ *
+ * @returns const LatencyHistogram& Returns the histogram of the
+ *   latencies of enqueue operations.
+ */
+template<class T>
+const LatencyHistogram& LatencyQueue<T>::getEnqueueLatency() const
+{
+  return enqueueLatency;
+}
+
+/**
+ * @brief Dequeue latency accessor
+ *
+ * @returns const LatencyHistogram& Returns the histogram of the
+ *   latencies of dequeue operations.
+ */
+template<class T>
+const LatencyHistogram& LatencyQueue<T>::getDequeueLatency() const
+{
+  return dequeueLatency;
+}
+
+/**
+ * @brief Reset latencies
+ *
+ * Forget the latencies recorded so far, for example once a queue has
+ * been filled, to measure only its steady state.
+ */
+template<class T>
+void LatencyQueue<T>::resetLatency()
+{
+  enqueueLatency.reset();
+  dequeueLatency.reset();
+}
+
+/**
+ * @brief Clear out queue
+ *
+ * Clear the wrapped queue.  This is not timed.
+ */
+template<class T>
+void LatencyQueue<T>::clear()
+{
+  queue.clear();
+}
+
+/**
+ * @brief Enqueue copy
+ *
+ * Enqueue a copy of the new item on the wrapped queue, timing it.
+ *
+ * @param newItem The item to be added to the queue.
+ */
+template<class T>
+void LatencyQueue<T>::enqueue(const T& newItem)
+{
+  if (not recording)
+  {
+    queue.enqueue(newItem);
+    return;
+  }
+
+  auto start = now();
+  queue.enqueue(newItem);
+  enqueueLatency.record(nanosecondsSince(start));
+}
+
+/**
+ * @brief Enqueue value
+ *
+ * Move the new item onto the wrapped queue, timing it.
+ *
+ * @param newItem The item to be added to the queue.
+ */
+template<class T>
+void LatencyQueue<T>::enqueue(T&& newItem)
+{
+  if (not recording)
+  {
+    queue.enqueue(std::move(newItem));
+    return;
+  }
+
+  auto start = now();
+  queue.enqueue(std::move(newItem));
+  enqueueLatency.record(nanosecondsSince(start));
+}
+
+/**
+ * @brief Enqueue array of values
+ *
+ * Enqueue copies of a batch of values on the wrapped queue, timing the
+ * whole batch as a single enqueue.
+ *
+ * @param items The block of values to enqueue.
+ * @param count The number of values in the block.
+ */
+template<class T>
+void LatencyQueue<T>::enqueueArray(const T* items, int count)
+{
+  if (not recording)
+  {
+    queue.enqueueArray(items, count);
+    return;
+  }
+
+  auto start = now();
+  queue.enqueueArray(items, count);
+  enqueueLatency.record(nanosecondsSince(start));
+}
+
+/**
+ * @brief Dequeue front item
+ *
+ * Dequeue the front item of the wrapped queue, timing it.
+ *
+ * @throws QueueEmptyException If the wrapped queue is empty, in which
+ *   case no latency is recorded.
+ */
+template<class T>
+void LatencyQueue<T>::dequeue()
+{
+  if (not recording)
+  {
+    queue.dequeue();
+    return;
+  }
+
+  auto start = now();
+  queue.dequeue();
+  dequeueLatency.record(nanosecondsSince(start));
+}
+
+/**
+ * @brief Dequeue and return front item
+ *
+ * Dequeue the front item of the wrapped queue and return it, timing
+ * it.
+ *
+ * @returns T Returns the item that was at the front of the queue.
+ *
+ * @throws QueueEmptyException If the wrapped queue is empty, in which
+ *   case no latency is recorded.
+ */
+template<class T>
+T LatencyQueue<T>::dequeueValue()
+{
+  if (not recording)
+  {
+    return queue.dequeueValue();
+  }
+
+  auto start = now();
+  T item = queue.dequeueValue();
+  dequeueLatency.record(nanosecondsSince(start));
+  return item;
+}
+
+/**
+ * @brief Dequeue front items into array
+ *
+ * Dequeue up to count items of the wrapped queue into the given block,
+ * timing the whole batch as a single dequeue.
+ *
+ * @param out The block to move the dequeued items into, must have room
+ *   for count items.
+ * @param count The largest number of items to dequeue.
+ *
+ * @returns int Returns the number of items that were dequeued.
+ */
+template<class T>
+int LatencyQueue<T>::dequeueInto(T* out, int count)
+{
+  if (not recording)
+  {
+    return queue.dequeueInto(out, count);
+  }
+
+  auto start = now();
+  int dequeued = queue.dequeueInto(out, count);
+  dequeueLatency.record(nanosecondsSince(start));
+  return dequeued;
+}
+
+/**
+ * @brief Read the clock
+ *
+ * @returns chrono::steady_clock::time_point Returns the current time
+ *   of the steady clock.
+ */
+template<class T>
+chrono::steady_clock::time_point LatencyQueue<T>::now()
+{
+  return chrono::steady_clock::now();
+}
+
+/**
+ * @brief Nanoseconds since time
+ *
+ * @param start A time read with now().
+ *
+ * @returns long long Returns the nanoseconds elapsed since start.
+ */
+template<class T>
+long long LatencyQueue<T>::nanosecondsSince(chrono::steady_clock::time_point start)
+{
+  return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Cause specific instance compilations
+ *
+ * This is a bit of a kludge, but we can use normal make dependencies
+ * and separate compilation by declaring template class Queue<needed_type>
+ * here of any types we are going to be instantianting with the
+ * template.
+ *
+ * https://isocpp.org/wiki/faq/templates#templates-defn-vs-decl
+ * https://isocpp.org/wiki/faq/templates#separate-template-class-defn-from-decl
+ */
+template class LatencyQueue<int>;
+template class LatencyQueue<string>;
+template class LatencyQueue<Job>;
@@ -0,0 +1,537 @@
+/** @file MPMCQueue.cpp
+ * @brief Concrete lock-free multi-producer/multi-consumer bounded
+ *   implementation of Queue ADT.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement the Queue abstraction as a fixed size circular buffer that
+ * any number of threads can enqueue to and dequeue from at the same
+ * time without any locks.  This is the bounded array queue described
+ * by Dmitry Vyukov: every cell of the buffer has its own sequence
+ * number, which tells a producer when the cell is free to be filled
+ * and a consumer when the cell holds a value ready to be taken.
+ * Threads claim a cell by advancing a shared enqueue or dequeue
+ * position with a compare and swap, and then fill or empty the cell
+ * without interference from any other thread.
+ */
+#include "MPMCQueue.hpp"
+#include "Job.hpp"
+#include "QueueException.hpp"
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+using namespace std;
+
+/**
+ * @brief Bounded capacity constructor
+ *
+ * Construct an empty queue that can hold at most the given number of
+ * items, rounded up to the next power of two, and at least 2.  Each
+ * cell starts out free for the producer that claims its own position.
+ *
+ * @param capacity The number of items the queue should be able to
+ *   hold.
+ *
+ * @throws QueueMemoryBoundsException if the capacity is larger than
+ *   MAXIMUM_CAPACITY, since it could not be rounded up to a power of
+ *   two.
+ */
+template<class T>
+MPMCQueue<T>::MPMCQueue(int capacity)
+{
+  if (capacity > MAXIMUM_CAPACITY)
+  {
+    ostringstream out;
+    out << "Error: <MPMCQueue>::MPMCQueue() capacity " << capacity << " is larger than the maximum capacity "
+        << MAXIMUM_CAPACITY;
+
+    throw QueueMemoryBoundsException(out.str());
+  }
+
+  this->capacity = 2;
+  while (this->capacity < capacity)
+  {
+    this->capacity *= 2;
+  }
+  indexMask = this->capacity - 1;
+
+  cells = new Cell[this->capacity];
+  for (int index = 0; index < this->capacity; index++)
+  {
+    cells[index].sequence.store(index, memory_order_relaxed);
+  }
+
+  // the base class size member is not used, since it can not be kept
+  // up to date by all of the threads, getSize() computes the size instead
+  this->size = 0;
+  enqueuePosition.store(0, memory_order_relaxed);
+  dequeuePosition.store(0, memory_order_relaxed);
+}
+
+/**
+ * @brief Class destructor
+ *
+ * Return the buffer of cells back to the heap.  No thread may be
+ * using the queue once it is being destroyed.
+ */
+template<class T>
+MPMCQueue<T>::~MPMCQueue()
+{
+  delete[] cells;
+}
+
+/**
+ * @brief Size accessor
+ *
+ * Approximate the number of items currently in the queue from the
+ * difference between the enqueue and dequeue positions.  Cells that
+ * have been claimed but not yet filled or emptied are counted as
+ * well, and the result is kept within 0 and the capacity, so it is
+ * always a possible size of the queue even when it is out of date.
+ *
+ * @returns int Returns the current size of the queue of values.
+ */
+template<class T>
+int MPMCQueue<T>::getSize() const
+{
+  // read the dequeue position first, so the enqueue position can only
+  // have moved further ahead of it
+  unsigned long currentDequeue = dequeuePosition.load(memory_order_acquire);
+  unsigned long currentEnqueue = enqueuePosition.load(memory_order_acquire);
+
+  long difference = static_cast<long>(currentEnqueue - currentDequeue);
+  if (difference < 0)
+  {
+    return 0;
+  }
+  if (difference > capacity)
+  {
+    return capacity;
+  }
+  return difference;
+}
+
+/**
+ * @brief Check if empty queue
+ *
+ * @returns bool Returns true if the queue currently holds no items.
+ */
+template<class T>
+bool MPMCQueue<T>::isEmpty() const
+{
+  return getSize() == 0;
+}
+
+/**
+ * @brief Capacity accessor
+ *
+ * @returns int Returns the fixed number of items this queue can hold.
+ */
+template<class T>
+int MPMCQueue<T>::getCapacity() const
+{
+  return capacity;
+}
+
+/**
+ * @brief Access front of queue
+ *
+ * Accessor method to get a copy of the item currently at the front of
+ * this queue.  Should only be used while the queue is not being
+ * changed.
+ *
+ * @returns T Returns a copy of the front item of the queue.
+ *
+ * @throws QueueEmptyException If the queue is empty.
+ */
+template<class T>
+T MPMCQueue<T>::front() const
+{
+  if (isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <MPMCQueue>::front() attempt to get item"
+        << " from empty queue, size:  " << getSize();
+
+    throw QueueEmptyException(out.str());
+  }
+
+  return (*this)[0];
+}
+
+/**
+ * @brief Boolean equals operator
+ *
+ * Check if this Queue is equal to the right hand side (rhs) queue.
+ * The queues are equal if their sizes are equal, and if all elements
+ * in both queues are equal.  Should only be used while the queues are
+ * not being changed.
+ *
+ * @param rhs The other queue on the right hand side of the
+ *   boolean comparison that we are comparing this Queue to.
+ *
+ * @returns bool true if the queues are equal, false if the are not.
+ */
+template<class T>
+bool MPMCQueue<T>::operator==(const Queue<T>& rhs) const
+{
+  return this->equalsInOrder(rhs);
+}
+
+/**
+ * @brief Indexing operator
+ *
+ * Access the value at the given position from the front of the queue.
+ * Should only be used while the queue is not being changed.
+ *
+ * @param index The index of the value it is desired to access from
+ *   this Queue.  Index 0 should indicate front of queue, and
+ *   index size - 1 is back item of queue.
+ *
+ * @returns T& Returns a reference to the requested Queue item at
+ *   the requested index.
+ *
+ * @throws QueueMemoryBoundsException if a request for an index beyond
+ *   the end of the queue (or less than 0) is made.
+ */
+template<class T>
+T& MPMCQueue<T>::operator[](int index) const
+{
+  int size = getSize();
+  if ((index < 0) or (index >= size))
+  {
+    ostringstream out;
+    out << "Error: <MPMCQueue::operator[]> illegal bounds access, queue size: " << size << " tried to access index address: " << index;
+
+    throw QueueMemoryBoundsException(out.str());
+  }
+
+  return cells[(dequeuePosition.load(memory_order_relaxed) + index) & indexMask].value;
+}
+
+/**
+ * @brief Clear out queue
+ *
+ * Discard all of the items currently in the queue by dequeuing them
+ * until the queue is empty.  This is safe to call while other threads
+ * are using the queue, but items enqueued at the same time may or may
+ * not be discarded.  The buffer itself is kept.
+ */
+template<class T>
+void MPMCQueue<T>::clear()
+{
+  T item;
+  while (tryDequeue(item))
+  {
+  }
+}
+
+/**
+ * @brief Claim a cell to enqueue into
+ *
+ * Find the cell at the current enqueue position and, if it is free,
+ * advance the enqueue position past it so that no other producer can
+ * claim it.  If another producer claims the cell first we retry at the
+ * new enqueue position.
+ *
+ * @param position Set to the position of the claimed cell.
+ *
+ * @returns Cell* The claimed cell, or nullptr if the queue was full.
+ */
+template<class T>
+typename MPMCQueue<T>::Cell* MPMCQueue<T>::claimEnqueueCell(unsigned long& position)
+{
+  position = enqueuePosition.load(memory_order_relaxed);
+  while (true)
+  {
+    Cell* cell = &cells[position & indexMask];
+    unsigned long sequence = cell->sequence.load(memory_order_acquire);
+    long difference = static_cast<long>(sequence - position);
+
+    if (difference == 0)
+    {
+      // the cell is free, on failure position is reloaded for us
+      if (enqueuePosition.compare_exchange_weak(position, position + 1, memory_order_relaxed))
+      {
+        return cell;
+      }
+    }
+    else if (difference < 0)
+    {
+      // the cell still holds the value from the last time around
+      return nullptr;
+    }
+    else
+    {
+      // another producer already claimed this position
+      position = enqueuePosition.load(memory_order_relaxed);
+    }
+  }
+}
+
+/**
+ * @brief Claim a cell to dequeue from
+ *
+ * Find the cell at the current dequeue position and, if it has been
+ * filled, advance the dequeue position past it so that no other
+ * consumer can claim it.  If another consumer claims the cell first we
+ * retry at the new dequeue position.
+ *
+ * @param position Set to the position of the claimed cell.
+ *
+ * @returns Cell* The claimed cell, or nullptr if the queue was empty.
+ */
+template<class T>
+typename MPMCQueue<T>::Cell* MPMCQueue<T>::claimDequeueCell(unsigned long& position)
+{
+  position = dequeuePosition.load(memory_order_relaxed);
+  while (true)
+  {
+    Cell* cell = &cells[position & indexMask];
+    unsigned long sequence = cell->sequence.load(memory_order_acquire);
+    long difference = static_cast<long>(sequence - (position + 1));
+
+    if (difference == 0)
+    {
+      if (dequeuePosition.compare_exchange_weak(position, position + 1, memory_order_relaxed))
+      {
+        return cell;
+      }
+    }
+    else if (difference < 0)
+    {
+      // the cell has not been filled yet
+      return nullptr;
+    }
+    else
+    {
+      // another consumer already claimed this position
+      position = dequeuePosition.load(memory_order_relaxed);
+    }
+  }
+}
+
+/**
+ * @brief Enqueue value on back of queue
+ *
+ * Enqueue a copy of the value to the back of this Queue, waiting for
+ * a consumer to make room if the buffer is full.
+ *
+ * @param newItem The value to enqueue on back of the current queue.
+ */
+template<class T>
+void MPMCQueue<T>::enqueue(const T& newItem)
+{
+  while (not tryEnqueue(newItem))
+  {
+    this_thread::yield();
+  }
+}
+
+/**
+ * @brief Enqueue value on back of queue
+ *
+ * Move the value to the back of this Queue, waiting for a consumer
+ * to make room if the buffer is full.
+ *
+ * @param newItem The value to enqueue on back of the current queue.
+ */
+template<class T>
+void MPMCQueue<T>::enqueue(T&& newItem)
+{
+  while (not tryEnqueue(std::move(newItem)))
+  {
+    this_thread::yield();
+  }
+}
+
+/**
+ * @brief Try to enqueue value on back of queue
+ *
+ * Enqueue a copy of the value to the back of this Queue if there is
+ * room for it.
+ *
+ * @param newItem The value to enqueue on back of the current queue.
+ *
+ * @returns bool true if the value was enqueued, false if the queue
+ *   was full.
+ */
+template<class T>
+bool MPMCQueue<T>::tryEnqueue(const T& newItem)
+{
+  unsigned long position;
+  Cell* cell = claimEnqueueCell(position);
+  if (cell == nullptr)
+  {
+    return false;
+  }
+
+  cell->value = newItem;
+
+  // release makes the value visible to the consumer of this position
+  cell->sequence.store(position + 1, memory_order_release);
+  return true;
+}
+
+/**
+ * @brief Try to enqueue value on back of queue
+ *
+ * Move the value to the back of this Queue if there is room for it.
+ * The value is only moved from if it was enqueued.
+ *
+ * @param newItem The value to enqueue on back of the current queue.
+ *
+ * @returns bool true if the value was enqueued, false if the queue
+ *   was full.
+ */
+template<class T>
+bool MPMCQueue<T>::tryEnqueue(T&& newItem)
+{
+  unsigned long position;
+  Cell* cell = claimEnqueueCell(position);
+  if (cell == nullptr)
+  {
+    return false;
+  }
+
+  cell->value = std::move(newItem);
+  cell->sequence.store(position + 1, memory_order_release);
+  return true;
+}
+
+/**
+ * @brief Dequeue queue front item
+ *
+ * Dequeue the item from the front of the queue, without waiting if
+ * there is none.
+ *
+ * @throws QueueEmptyException If the queue is empty.
+ */
+template<class T>
+void MPMCQueue<T>::dequeue()
+{
+  dequeueValue();
+}
+
+/**
+ * @brief Dequeue and return queue front item
+ *
+ * Move the item out of the front of the queue and return it, without
+ * waiting if there is none.
+ *
+ * @returns T Returns the item that was at the front of the queue.
+ *
+ * @throws QueueEmptyException If the queue is empty.
+ */
+template<class T>
+T MPMCQueue<T>::dequeueValue()
+{
+  unsigned long position;
+  Cell* cell = claimDequeueCell(position);
+  if (cell == nullptr)
+  {
+    ostringstream out;
+    out << "Error: <MPMCQueue>::dequeueValue() attempt to dequeue front item"
+        << " from empty queue, size:  " << getSize();
+
+    throw QueueEmptyException(out.str());
+  }
+
+  // the item is constructed straight from the cell, rather than default
+  // constructed and then assigned
+  T item(std::move(cell->value));
+
+  // release hands the emptied cell to the producer one time around later
+  cell->sequence.store(position + indexMask + 1, memory_order_release);
+  return item;
+}
+
+/**
+ * @brief Try to dequeue queue front item
+ *
+ * Move the item out of the front of the queue if there is one.
+ *
+ * @param item Set to the item that was at the front of the queue, left
+ *   alone if the queue was empty.
+ *
+ * @returns bool true if an item was dequeued, false if the queue was
+ *   empty.
+ */
+template<class T>
+bool MPMCQueue<T>::tryDequeue(T& item)
+{
+  unsigned long position;
+  Cell* cell = claimDequeueCell(position);
+  if (cell == nullptr)
+  {
+    return false;
+  }
+
+  item = std::move(cell->value);
+
+  // release hands the emptied cell to the producer one time around later
+  cell->sequence.store(position + indexMask + 1, memory_order_release);
+  return true;
+}
+
+/**
+ * @brief Wait to dequeue queue front item
+ *
+ * Move the item out of the front of the queue, waiting for a producer
+ * to enqueue one if the queue is empty.
+ *
+ * @param item Set to the item that was at the front of the queue.
+ */
+template<class T>
+void MPMCQueue<T>::waitDequeue(T& item)
+{
+  while (not tryDequeue(item))
+  {
+    this_thread::yield();
+  }
+}
+
+/**
+ * @brief Dequeue front items into array
+ *
+ * Dequeue up to count items into the given block of values, stopping
+ * early if the queue is empty.  Unlike the default, which checks
+ * isEmpty() before each dequeue, this is safe while other threads
+ * are dequeuing from the queue as well.
+ *
+ * @param out The block to move the dequeued items into, must have room
+ *   for count items.
+ * @param count The largest number of items to dequeue.
+ *
+ * @returns int Returns the number of items that were dequeued.
+ */
+template<class T>
+int MPMCQueue<T>::dequeueInto(T* out, int count)
+{
+  int dequeued = 0;
+  while ((dequeued < count) and tryDequeue(out[dequeued]))
+  {
+    dequeued++;
+  }
+  return dequeued;
+}
+
+/**
+ * @brief Cause specific instance compilations
+ *
+ * This is a bit of a kludge, but we can use normal make dependencies
+ * and separate compilation by declaring template class Queue<needed_type>
+ * here of any types we are going to be instantianting with the
+ * template.
+ *
+ * https://isocpp.org/wiki/faq/templates#templates-defn-vs-decl
+ * https://isocpp.org/wiki/faq/templates#separate-template-class-defn-from-decl
+ */
+template class MPMCQueue<int>;
+template class MPMCQueue<string>;
+template class MPMCQueue<Job>;
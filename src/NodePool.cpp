@@ -0,0 +1,271 @@
+/** @file NodePool.cpp
+ * @brief Pooled allocator of Node items used by the linked list
+ *   queues.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * A NodePool hands out Node items to the linked list queues, and takes
+ * them back again when values are dequeued.  Instead of going to the
+ * heap for every single node, nodes are allocated in contiguous chunks,
+ * and nodes that are given back are kept on a free list to be recycled
+ * by the next enqueue.
+ */
+#include "NodePool.hpp"
+#include "Job.hpp"
+#include <algorithm>
+#include <new>
+#include <string>
+#include <type_traits>
+using namespace std;
+
+/**
+ * @brief Default constructor
+ *
+ * Construct an empty pool.  No chunks are allocated until the first
+ * node is asked for.
+ *
+ * @param chunkSize The number of nodes to allocate together in each
+ *   chunk of memory, a chunk size less than 1 is taken as 1.
+ */
+template<class T>
+NodePool<T>::NodePool(int chunkSize)
+{
+  this->chunkSize = max(1, chunkSize);
+  nextFreshNode = this->chunkSize;
+  freeList = nullptr;
+  nodesRecycled = 0;
+  nodesInUse = 0;
+}
+
+/**
+ * @brief Class destructor
+ *
+ * Return all of the chunks of nodes back to the heap.  Any nodes still
+ * in use by a queue are no longer valid after the pool is destroyed.
+ */
+template<class T>
+NodePool<T>::~NodePool()
+{
+  for (Node<T>* chunk : chunks)
+  {
+    ::operator delete(chunk);
+  }
+}
+
+/**
+ * @brief Chunk size accessor
+ *
+ * @returns int Returns the number of nodes allocated together in each
+ *   chunk by this pool.
+ */
+template<class T>
+int NodePool<T>::getChunkSize() const
+{
+  return chunkSize;
+}
+
+/**
+ * @brief Chunks allocated accessor
+ *
+ * @returns int Returns the number of chunks of nodes this pool has
+ *   allocated from the heap.
+ */
+template<class T>
+int NodePool<T>::getChunksAllocated() const
+{
+  return chunks.size();
+}
+
+/**
+ * @brief Nodes recycled accessor
+ *
+ * @returns long Returns the number of allocations that were satisfied
+ *   by reusing a previously released node, instead of a fresh one.
+ */
+template<class T>
+long NodePool<T>::getNodesRecycled() const
+{
+  return nodesRecycled;
+}
+
+/**
+ * @brief Nodes in use accessor
+ *
+ * @returns long Returns the number of nodes that have been allocated
+ *   from this pool and not released back to it yet.
+ */
+template<class T>
+long NodePool<T>::getNodesInUse() const
+{
+  return nodesInUse;
+}
+
+/**
+ * @brief Allocate a node holding a copy
+ *
+ * Hand out a node with a copy of the given value constructed in it.
+ * The caller is expected to set the next pointer.
+ *
+ * @param value The value to copy into the node.
+ *
+ * @returns Node<T>* Returns a node that is now owned by the caller.
+ */
+template<class T>
+Node<T>* NodePool<T>::allocate(const T& value)
+{
+  Node<T>* node = allocateNode();
+  ::new (static_cast<void*>(&node->value)) T(value);
+  return node;
+}
+
+/**
+ * @brief Allocate a node holding a value
+ *
+ * Hand out a node with the given value moved into it.  The caller is
+ * expected to set the next pointer.
+ *
+ * @param value The value to move into the node.
+ *
+ * @returns Node<T>* Returns a node that is now owned by the caller.
+ */
+template<class T>
+Node<T>* NodePool<T>::allocate(T&& value)
+{
+  Node<T>* node = allocateNode();
+  ::new (static_cast<void*>(&node->value)) T(std::move(value));
+  return node;
+}
+
+/**
+ * @brief Allocate node storage
+ *
+ * Private member method to find room for a node, preferring the most
+ * recently released node since it is most likely to still be in the
+ * cache.  If there are no released nodes, the next fresh node of the
+ * current chunk is used, and a new chunk is allocated when the current
+ * chunk has been used up.  Chunks are raw memory, so no value is
+ * constructed in a node until it is handed out, and filling a chunk of
+ * Job nodes does not use up job ids.
+ *
+ * @returns Node<T>* Returns a node whose value has not been
+ *   constructed.
+ */
+template<class T>
+Node<T>* NodePool<T>::allocateNode()
+{
+  nodesInUse++;
+  if (freeList != nullptr)
+  {
+    Node<T>* node = freeList;
+    freeList = freeList->next;
+    nodesRecycled++;
+    return node;
+  }
+
+  if (nextFreshNode == chunkSize)
+  {
+    chunks.push_back(static_cast<Node<T>*>(::operator new(chunkSize * sizeof(Node<T>))));
+    nextFreshNode = 0;
+  }
+
+  return &chunks.back()[nextFreshNode++];
+}
+
+/**
+ * @brief Release a node
+ *
+ * Give a node back to the pool so it can be recycled by a later
+ * allocation.  The value of the node is destroyed, so that a released
+ * node does not hold on to the resources of the value it held, such as
+ * the memory of a string.  Values of trivially destructible types, like
+ * int or Job, have nothing to destroy.
+ *
+ * @param node The node to release, it must have been allocated from
+ *   this pool.
+ */
+template<class T>
+void NodePool<T>::release(Node<T>* node)
+{
+  if constexpr (not is_trivially_destructible<T>::value)
+  {
+    node->value.~T();
+  }
+  node->next = freeList;
+  freeList = node;
+  nodesInUse--;
+}
+
+/**
+ * @brief Release a list of nodes
+ *
+ * Give a whole linked list of nodes back to the pool at once, spliced
+ * onto the front of the free list in the order it was in.  For
+ * trivially destructible types this takes constant time, otherwise the
+ * list is walked once to destroy the values of its nodes.
+ *
+ * @param firstNode The first node of the linked list to release.
+ * @param lastNode The last node of the linked list to release, which
+ *   must be reachable by following next pointers from firstNode.
+ * @param count The number of nodes in the list from firstNode to
+ *   lastNode inclusive.
+ */
+template<class T>
+void NodePool<T>::release(Node<T>* firstNode, Node<T>* lastNode, long count)
+{
+  if constexpr (not is_trivially_destructible<T>::value)
+  {
+    for (Node<T>* node = firstNode; node != lastNode; node = node->next)
+    {
+      node->value.~T();
+    }
+    lastNode->value.~T();
+  }
+  nodesInUse -= count;
+
+  lastNode->next = freeList;
+  freeList = firstNode;
+}
+
+/**
+ * @brief Free chunks of unused pool
+ *
+ * Return all of the chunks of nodes back to the heap, if no node of
+ * the pool is in use.  Otherwise the chunks are kept, since nodes in
+ * use are in them, and nothing is done.  The next allocation after the
+ * chunks are freed starts a new chunk.
+ */
+template<class T>
+void NodePool<T>::freeChunks()
+{
+  if (nodesInUse > 0)
+  {
+    return;
+  }
+
+  for (Node<T>* chunk : chunks)
+  {
+    ::operator delete(chunk);
+  }
+  chunks.clear();
+  nextFreshNode = chunkSize;
+  freeList = nullptr;
+}
+
+/**
+ * @brief Cause specific instance compilations
+ *
+ * This is a bit of a kludge, but we can use normal make dependencies
+ * and separate compilation by declaring template class Queue<needed_type>
+ * here of any types we are going to be instantianting with the
+ * template.
+ *
+ * https://isocpp.org/wiki/faq/templates#templates-defn-vs-decl
+ * https://isocpp.org/wiki/faq/templates#separate-template-class-defn-from-decl
+ */
+template class NodePool<int>;
+template class NodePool<string>;
+template class NodePool<Job>;
@@ -14,13 +14,18 @@
  */
 #include "Queue.hpp"
 #include "Job.hpp"
+#include <algorithm>
 #include <iostream>
+#include <sstream>
+#include <string>
 using namespace std;
 
 /**
  * @brief Size accessor
  *
  * Accessor method to get the current size of this Queue of values.
+ * This is virtual so that queues shared between threads, which do not
+ * keep the size member up to date, can compute their own size.
  *
  * @returns int Returns the current size of the queue of values.
  */
@@ -47,14 +52,214 @@ bool Queue<T>::isEmpty() const
   return size == 0;
 }
 
+/**
+ * @brief Queue to string
+ *
+ * Accessor method to construct and return a string representation
+ * of the current values and status of this Queue instance.  This is
+ * the same representation written by write(), gathered up into a
+ * string.  Use write() or the output stream operator instead to show
+ * a large queue without building a copy of it as a string.
+ *
+ * @returns string Returns the string constructed with the information
+ *   about this Queue.
+ */
+template<class T>
+string Queue<T>::str() const
+{
+  ostringstream out;
+  write(out);
+  return out.str();
+}
+
+/**
+ * @brief Write queue to output stream
+ *
+ * Stream the size and the values of this queue, from front to back,
+ * straight to the given output stream, for example
+ *   <queue> size: 3 front:[ 1, 2, 3 ]:back
+ * The values are visited segment by segment and written out as they
+ * are visited, so nothing is allocated no matter how large the queue
+ * is.  If maxElements is not negative only that many values are
+ * written, followed by ... when some were left out.
+ *
+ * @param out The output stream to write the queue to.
+ * @param maxElements The most values to write, or -1 (the default)
+ *   to write all of them.
+ */
+template<class T>
+void Queue<T>::write(ostream& out, int maxElements) const
+{
+  int count = getSize();
+  int shown = (maxElements < 0) ? count : min(count, maxElements);
+
+  out << "<queue> size: " << count << " front:[ ";
+
+  // the visitor only refers to this one local, so that it is small
+  // enough for the function wrapper to hold without allocating
+  struct
+  {
+    int written;
+    int shown;
+    int count;
+    ostream* out;
+  } progress = {0, shown, count, &out};
+
+  if (shown > 0)
+  {
+    visitSegments([&progress](const T* segment, int segmentCount) {
+      for (int index = 0; index < segmentCount; index++)
+      {
+        if (progress.written == progress.shown)
+        {
+          return false;
+        }
+        *progress.out << segment[index];
+        progress.written++;
+
+        // separate the values, last one does not need , separator
+        if (progress.written == progress.count)
+        {
+          *progress.out << " ";
+        }
+        else
+        {
+          *progress.out << ", ";
+        }
+      }
+      return true;
+    });
+  }
+
+  // show that values were left out
+  if (progress.written < count)
+  {
+    out << "... ";
+  }
+  out << "]:back";
+}
+
+/**
+ * @brief Visit contiguous segments of the queue
+ *
+ * Call the visitor with each run of values of this queue that are
+ * next to each other in memory, in order from the front of the queue
+ * to the back, as a pointer to the first value of the run and the
+ * number of values in it.  The visitor returns false to stop the visit
+ * early.  This lets code walk any queue in a single linear pass, with
+ * one virtual call for each run instead of one for each value.  This
+ * default visits the values one at a time through the indexing
+ * operator, concrete queues override it to hand over their blocks of
+ * values directly.
+ *
+ * @param visitor The function to call with each segment.
+ *
+ * @returns bool Returns true if every segment was visited, or false if
+ *   the visitor stopped the visit early.
+ */
+template<class T>
+bool Queue<T>::visitSegments(const function<bool(const T*, int)>& visitor) const
+{
+  int count = getSize();
+  for (int index = 0; index < count; index++)
+  {
+    if (not visitor(&(*this)[index], 1))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Enqueue array of values on back of queue
+ *
+ * Enqueue copies of the given block of values, in order, onto the back
+ * of this Queue.  This default simply enqueues the values one at a
+ * time.  Concrete queues override it when they can add a whole batch
+ * of values at once more cheaply than one by one.
+ *
+ * @param items The block of values to enqueue.
+ * @param count The number of values in the block.
+ */
+template<class T>
+void Queue<T>::enqueueArray(const T* items, int count)
+{
+  for (int index = 0; index < count; index++)
+  {
+    enqueue(items[index]);
+  }
+}
+
+/**
+ * @brief Dequeue front items into array
+ *
+ * Dequeue up to count items from the front of this Queue, moving them
+ * in order into the given block of values.  Fewer items are dequeued
+ * if the queue runs out of items first.  This default simply dequeues
+ * the items one at a time, concrete queues override it when they can
+ * remove a whole batch of items at once more cheaply.
+ *
+ * @param out The block to move the dequeued items into, must have room
+ *   for count items.
+ * @param count The largest number of items to dequeue.
+ *
+ * @returns int Returns the number of items that were dequeued.
+ */
+template<class T>
+int Queue<T>::dequeueInto(T* out, int count)
+{
+  int dequeued = 0;
+  while ((dequeued < count) and not isEmpty())
+  {
+    out[dequeued] = dequeueValue();
+    dequeued++;
+  }
+  return dequeued;
+}
+
+/**
+ * @brief Statistics accessor
+ *
+ * Accessor method to get a copy of the counts of the work done by the
+ * operations of this queue since it was constructed or its statistics
+ * were last reset.  A copy of a queue starts counting again from 0.
+ * Unless the program was built with QUEUE_STATISTICS defined the
+ * counters are always 0.
+ *
+ * @returns QueueStatistics Returns the counters of this queue.
+ */
+template<class T>
+QueueStatistics Queue<T>::getStatistics() const
+{
+#ifdef QUEUE_STATISTICS
+  return statistics;
+#else
+  return QueueStatistics();
+#endif
+}
+
+/**
+ * @brief Reset statistics
+ *
+ * Set the counters of the work done by this queue back to 0, for
+ * example to measure only the steady state of a long running queue.
+ */
+template<class T>
+void Queue<T>::resetStatistics()
+{
+#ifdef QUEUE_STATISTICS
+  statistics.reset();
+#endif
+}
+
 /**
  * @brief Overload output stream operator for Queue type.
  *
  * Overload the output stream operator so that we can display current
- * values of a Queue on standard output.  We can define this in the
- * base class because concrete derived classes must implement the
- * actual str() method that is used here to represent the
- * queue as a string object output.
+ * values of a Queue on standard output.  The queue is written straight
+ * to the stream by write(), rather than first being built into a
+ * string by str() and then copied to the stream.
  *
  * @param out The output stream we should send the representation
  *   of the current Queue to.
@@ -68,13 +273,51 @@ bool Queue<T>::isEmpty() const
 template<typename U>
 ostream& operator<<(ostream& out, const Queue<U>& rhs)
 {
-  // reuse Queue str() method to stream to output stream
-  out << rhs.str();
+  // stream the queue straight to the output stream
+  rhs.write(out);
 
   // return the modified output stream as our result
   return out;
 }
 
+/**
+ * @brief Compare indexed values in order with another queue
+ *
+ * Check if the values of this queue, accessed through the indexing
+ * operator, are equal to the values of the rhs queue, in order from
+ * front to back.  The rhs queue is walked once with visitSegments(), so
+ * this is the common part of the operator== of concrete queues that
+ * can not iterate over their own values but can index them in constant
+ * time, and the comparison is then linear time whatever kind of queue
+ * rhs is.
+ *
+ * @param rhs The other queue on the right hand side of the
+ *   boolean comparison that we are comparing this Queue to.
+ *
+ * @returns bool true if the queues are equal, false if the are not.
+ */
+template<class T>
+bool Queue<T>::equalsInOrder(const Queue<T>& rhs) const
+{
+  if (getSize() != rhs.getSize())
+  {
+    return false;
+  }
+
+  int index = 0;
+  return rhs.visitSegments([this, &index](const T* segment, int count) {
+    for (int segmentIndex = 0; segmentIndex < count; segmentIndex++)
+    {
+      if ((*this)[index] != segment[segmentIndex])
+      {
+        return false;
+      }
+      index++;
+    }
+    return true;
+  });
+}
+
 /**
  * @brief Cause specific instance compilations
  *
@@ -88,6 +331,7 @@ ostream& operator<<(ostream& out, const Queue<U>& rhs)
  */
 template ostream& operator<<<int>(ostream&, const Queue<int>&);
 template ostream& operator<<<string>(ostream&, const Queue<string>&);
+template ostream& operator<<<Job>(ostream&, const Queue<Job>&);
 
 /**
  * @brief Cause specific instance compilations
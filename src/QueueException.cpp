@@ -82,4 +82,108 @@ const char* QueueMemoryBoundsException::what() const throw()
 {
   // what expects old style array of characters, so convert to that
   return message.c_str();
-}
\ No newline at end of file
+}
+/**
+ * @brief QueueSnapshotException constructor
+ *
+ * Constructor for exceptions used for our
+ * Queue  class.
+ *
+ * @param message The exception message thrown when an error occurs.
+ */
+QueueSnapshotException::QueueSnapshotException(const string& message)
+{
+  this->message = message;
+}
+
+/**
+ * @brief QueueSnapshotException destructor
+ *
+ * Destructor for exceptions used for our QueueSnapshotException
+ * class.
+ */
+QueueSnapshotException::~QueueSnapshotException() {}
+
+/**
+ * @brief QueueSnapshotException message
+ *
+ * Accessor method to access/return message given when an exception occurs.
+ *
+ * @returns char* Returns a const old style c character array message for
+ *   display/use by the process that catches this exception.
+ */
+const char* QueueSnapshotException::what() const throw()
+{
+  // what expects old style array of characters, so convert to that
+  return message.c_str();
+}
+
+/**
+ * @brief QueueSpillException constructor
+ *
+ * Constructor for exceptions used for our
+ * Queue  class.
+ *
+ * @param message The exception message thrown when an error occurs.
+ */
+QueueSpillException::QueueSpillException(const string& message)
+{
+  this->message = message;
+}
+
+/**
+ * @brief QueueSpillException destructor
+ *
+ * Destructor for exceptions used for our QueueSpillException
+ * class.
+ */
+QueueSpillException::~QueueSpillException() {}
+
+/**
+ * @brief QueueSpillException message
+ *
+ * Accessor method to access/return message given when an exception occurs.
+ *
+ * @returns char* Returns a const old style c character array message for
+ *   display/use by the process that catches this exception.
+ */
+const char* QueueSpillException::what() const throw()
+{
+  // what expects old style array of characters, so convert to that
+  return message.c_str();
+}
+
+/**
+ * @brief QueueKeyException constructor
+ *
+ * Constructor for exceptions used for our
+ * Queue  class.
+ *
+ * @param message The exception message thrown when an error occurs.
+ */
+QueueKeyException::QueueKeyException(const string& message)
+{
+  this->message = message;
+}
+
+/**
+ * @brief QueueKeyException destructor
+ *
+ * Destructor for exceptions used for our QueueKeyException
+ * class.
+ */
+QueueKeyException::~QueueKeyException() {}
+
+/**
+ * @brief QueueKeyException message
+ *
+ * Accessor method to access/return message given when an exception occurs.
+ *
+ * @returns char* Returns a const old style c character array message for
+ *   display/use by the process that catches this exception.
+ */
+const char* QueueKeyException::what() const throw()
+{
+  // what expects old style array of characters, so convert to that
+  return message.c_str();
+}
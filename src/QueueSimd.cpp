@@ -0,0 +1,347 @@
+/** @file QueueSimd.cpp
+ * @brief Vectorized search and comparison of blocks of integer values,
+ *   used by the array based queues.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Search and compare contiguous blocks of int values several values at
+ * a time with SIMD instructions.  The AVX2 versions of the functions
+ * are compiled for AVX2 with the target attribute, so the rest of the
+ * program does not need to be compiled for AVX2, and they are only
+ * called after checking that the processor supports them.
+ */
+#include "QueueSimd.hpp"
+#include <string>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+using namespace std;
+
+#if defined(__x86_64__)
+/**
+ * @brief Check for AVX2
+ *
+ * Ask the processor, once, if it supports the AVX2 instructions.
+ *
+ * @returns bool true if the AVX2 versions of the functions can be used.
+ */
+static bool hasAvx2()
+{
+  static const bool supported = __builtin_cpu_supports("avx2") != 0;
+  return supported;
+}
+
+/**
+ * @brief Find value with AVX2
+ *
+ * Compare eight values at a time with the value searched for, and
+ * find the first match in a block of eight from the bit mask of the
+ * comparison.
+ *
+ * @param values The block of values to search.
+ * @param count The number of values in the block.
+ * @param value The value to search for.
+ *
+ * @returns int The index of the first value equal to value, or -1.
+ */
+__attribute__((target("avx2"))) static int avx2Find(const int* values, int count, int value)
+{
+  __m256i key = _mm256_set1_epi32(value);
+  int index = 0;
+  for (; index + 8 <= count; index += 8)
+  {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + index));
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block, key)));
+    if (mask != 0)
+    {
+      return index + __builtin_ctz(mask);
+    }
+  }
+  for (; index < count; index++)
+  {
+    if (values[index] == value)
+    {
+      return index;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Count value with AVX2
+ *
+ * Compare eight values at a time with the value counted.  A matching
+ * lane of the comparison is all one bits, which is -1, so subtracting
+ * the comparisons from a running total counts the matches of each
+ * lane, and the lanes are added up at the end.
+ *
+ * @param values The block of values to search.
+ * @param count The number of values in the block.
+ * @param value The value to count.
+ *
+ * @returns int The number of values equal to value.
+ */
+__attribute__((target("avx2"))) static int avx2Count(const int* values, int count, int value)
+{
+  __m256i key = _mm256_set1_epi32(value);
+  __m256i totals = _mm256_setzero_si256();
+  int index = 0;
+  for (; index + 8 <= count; index += 8)
+  {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + index));
+    totals = _mm256_sub_epi32(totals, _mm256_cmpeq_epi32(block, key));
+  }
+
+  int lanes[8];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), totals);
+  int total = 0;
+  for (int lane = 0; lane < 8; lane++)
+  {
+    total += lanes[lane];
+  }
+  for (; index < count; index++)
+  {
+    total += (values[index] == value);
+  }
+  return total;
+}
+
+/**
+ * @brief Compare blocks with AVX2
+ *
+ * Compare eight pairs of values at a time, the blocks are equal up to
+ * a point as long as the exclusive or of their values is all zero.
+ *
+ * @param lhs The first block of values.
+ * @param rhs The second block of values.
+ * @param count The number of values in each block.
+ *
+ * @returns bool true if all of the values of the blocks are equal.
+ */
+__attribute__((target("avx2"))) static bool avx2Equal(const int* lhs, const int* rhs, int count)
+{
+  int index = 0;
+  for (; index + 8 <= count; index += 8)
+  {
+    __m256i difference = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + index)),
+                                          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + index)));
+    if (not _mm256_testz_si256(difference, difference))
+    {
+      return false;
+    }
+  }
+  for (; index < count; index++)
+  {
+    if (lhs[index] != rhs[index])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Find value with SSE2
+ *
+ * The same as avx2Find(), four values at a time.
+ *
+ * @param values The block of values to search.
+ * @param count The number of values in the block.
+ * @param value The value to search for.
+ *
+ * @returns int The index of the first value equal to value, or -1.
+ */
+static int sse2Find(const int* values, int count, int value)
+{
+  __m128i key = _mm_set1_epi32(value);
+  int index = 0;
+  for (; index + 4 <= count; index += 4)
+  {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + index));
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, key)));
+    if (mask != 0)
+    {
+      return index + __builtin_ctz(mask);
+    }
+  }
+  for (; index < count; index++)
+  {
+    if (values[index] == value)
+    {
+      return index;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Count value with SSE2
+ *
+ * The same as avx2Count(), four values at a time.
+ *
+ * @param values The block of values to search.
+ * @param count The number of values in the block.
+ * @param value The value to count.
+ *
+ * @returns int The number of values equal to value.
+ */
+static int sse2Count(const int* values, int count, int value)
+{
+  __m128i key = _mm_set1_epi32(value);
+  __m128i totals = _mm_setzero_si128();
+  int index = 0;
+  for (; index + 4 <= count; index += 4)
+  {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + index));
+    totals = _mm_sub_epi32(totals, _mm_cmpeq_epi32(block, key));
+  }
+
+  int lanes[4];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), totals);
+  int total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  for (; index < count; index++)
+  {
+    total += (values[index] == value);
+  }
+  return total;
+}
+
+/**
+ * @brief Compare blocks with SSE2
+ *
+ * The same as avx2Equal(), four pairs of values at a time, using the
+ * byte mask of the comparison since SSE2 has no test instruction.
+ *
+ * @param lhs The first block of values.
+ * @param rhs The second block of values.
+ * @param count The number of values in each block.
+ *
+ * @returns bool true if all of the values of the blocks are equal.
+ */
+static bool sse2Equal(const int* lhs, const int* rhs, int count)
+{
+  int index = 0;
+  for (; index + 4 <= count; index += 4)
+  {
+    __m128i same = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + index)),
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + index)));
+    if (_mm_movemask_epi8(same) != 0xffff)
+    {
+      return false;
+    }
+  }
+  for (; index < count; index++)
+  {
+    if (lhs[index] != rhs[index])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+#endif
+
+/**
+ * @brief Find value in block
+ *
+ * Find the first value in a block of values that is equal to the
+ * given value.
+ *
+ * @param values The block of values to search.
+ * @param count The number of values in the block.
+ * @param value The value to search for.
+ *
+ * @returns int The index of the first value equal to value, or -1 if
+ *   there is none.
+ */
+int simdFind(const int* values, int count, int value)
+{
+#if defined(__x86_64__)
+  return hasAvx2() ? avx2Find(values, count, value) : sse2Find(values, count, value);
+#else
+  for (int index = 0; index < count; index++)
+  {
+    if (values[index] == value)
+    {
+      return index;
+    }
+  }
+  return -1;
+#endif
+}
+
+/**
+ * @brief Count value in block
+ *
+ * Count the values in a block of values that are equal to the given
+ * value.
+ *
+ * @param values The block of values to search.
+ * @param count The number of values in the block.
+ * @param value The value to count.
+ *
+ * @returns int The number of values equal to value.
+ */
+int simdCount(const int* values, int count, int value)
+{
+#if defined(__x86_64__)
+  return hasAvx2() ? avx2Count(values, count, value) : sse2Count(values, count, value);
+#else
+  int total = 0;
+  for (int index = 0; index < count; index++)
+  {
+    total += (values[index] == value);
+  }
+  return total;
+#endif
+}
+
+/**
+ * @brief Compare blocks
+ *
+ * Test if two blocks of values of the same size hold the same values
+ * in the same order.
+ *
+ * @param lhs The first block of values.
+ * @param rhs The second block of values.
+ * @param count The number of values in each block.
+ *
+ * @returns bool true if all of the values of the blocks are equal.
+ */
+bool simdEqual(const int* lhs, const int* rhs, int count)
+{
+#if defined(__x86_64__)
+  return hasAvx2() ? avx2Equal(lhs, rhs, count) : sse2Equal(lhs, rhs, count);
+#else
+  for (int index = 0; index < count; index++)
+  {
+    if (lhs[index] != rhs[index])
+    {
+      return false;
+    }
+  }
+  return true;
+#endif
+}
+
+/**
+ * @brief Instruction set in use
+ *
+ * Name the instruction set the functions use on this processor, for
+ * reporting benchmark results.
+ *
+ * @returns string The name of the instruction set, avx2, sse2 or
+ *   scalar.
+ */
+string simdInstructionSet()
+{
+#if defined(__x86_64__)
+  return hasAvx2() ? "avx2" : "sse2";
+#else
+  return "scalar";
+#endif
+}
@@ -0,0 +1,108 @@
+/** @file QueueStatistics.cpp
+ * @brief Implement the counters of the work done by the operations of
+ *   a Queue.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement resetting, adding up and showing the statistics kept by
+ * queues built with QUEUE_STATISTICS defined.
+ */
+#include "QueueStatistics.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+using namespace std;
+
+/**
+ * @brief Reset counters
+ *
+ * Set all of the counters back to 0.
+ */
+void QueueStatistics::reset()
+{
+  *this = QueueStatistics();
+}
+
+/**
+ * @brief Add counters
+ *
+ * Add the counters of another set of statistics to these, to total up
+ * the statistics of several queues.
+ *
+ * @param rhs The statistics to add to these.
+ *
+ * @returns QueueStatistics& Returns these statistics, now holding the
+ *   totals.
+ */
+QueueStatistics& QueueStatistics::operator+=(const QueueStatistics& rhs)
+{
+  enqueues += rhs.enqueues;
+  dequeues += rhs.dequeues;
+  grows += rhs.grows;
+  shrinks += rhs.shrinks;
+  bytesCopied += rhs.bytesCopied;
+  comparisons += rhs.comparisons;
+  swaps += rhs.swaps;
+  return *this;
+}
+
+/**
+ * @brief Write counters to output stream
+ *
+ * Write all of the counters on a single line, for example
+ *   <statistics> enqueues: 3 dequeues: 1 grows: 1 shrinks: 0
+ *     bytesCopied: 0 comparisons: 2 swaps: 1
+ * so the statistics of a queue can be logged along with other
+ * measurements.  Statistics of a program built without
+ * QUEUE_STATISTICS are marked as disabled, so all zero counters are
+ * not mistaken for an idle queue.
+ *
+ * @param out The output stream to write the counters to.
+ */
+void QueueStatistics::write(ostream& out) const
+{
+  out << "<statistics>";
+  if (not ENABLED)
+  {
+    out << " disabled";
+    return;
+  }
+  out << " enqueues: " << enqueues << " dequeues: " << dequeues << " grows: " << grows << " shrinks: " << shrinks
+      << " bytesCopied: " << bytesCopied << " comparisons: " << comparisons << " swaps: " << swaps;
+}
+
+/**
+ * @brief Counters to string
+ *
+ * The counters as written by write(), gathered up into a string.
+ *
+ * @returns string Returns the string showing the counters.
+ */
+string QueueStatistics::str() const
+{
+  ostringstream out;
+  write(out);
+  return out.str();
+}
+
+/**
+ * @brief Overload output stream operator
+ *
+ * Write the counters to an output stream, as for write().
+ *
+ * @param out The output stream we should send the representation
+ *   of the current statistics to.
+ * @param rhs The statistics object to write.
+ *
+ * @returns ostream& Returns the output stream, so that output
+ *   operations can be chained.
+ */
+ostream& operator<<(ostream& out, const QueueStatistics& rhs)
+{
+  rhs.write(out);
+  return out;
+}
@@ -0,0 +1,474 @@
+/** @file SPSCQueue.cpp
+ * @brief Concrete lock-free single-producer/single-consumer bounded
+ *   implementation of Queue ADT.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement the Queue abstraction as a fixed size circular buffer that
+ * can be safely shared by two threads, one thread that only enqueues
+ * (the producer) and one thread that only dequeues (the consumer),
+ * without any locks.  Like the AQueue, the values are held in a
+ * circular buffer, but the front and back of the queue are kept as
+ * atomic counters so that each thread can see the progress of the
+ * other.  The buffer never grows, a producer that finds the buffer
+ * full has to wait for the consumer to make room.
+ */
+#include "SPSCQueue.hpp"
+#include "Job.hpp"
+#include "QueueException.hpp"
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+using namespace std;
+
+/**
+ * @brief Bounded capacity constructor
+ *
+ * Construct an empty queue that can hold at most the given number of
+ * items, rounded up to the next power of two.  The whole buffer is
+ * allocated up front and never grows.
+ *
+ * @param capacity The number of items the queue should be able to
+ *   hold.
+ *
+ * @throws QueueMemoryBoundsException if the capacity is larger than
+ *   MAXIMUM_CAPACITY, since it could not be rounded up to a power of
+ *   two.
+ */
+template<class T>
+SPSCQueue<T>::SPSCQueue(int capacity)
+{
+  if (capacity > MAXIMUM_CAPACITY)
+  {
+    ostringstream out;
+    out << "Error: <SPSCQueue>::SPSCQueue() capacity " << capacity << " is larger than the maximum capacity "
+        << MAXIMUM_CAPACITY;
+
+    throw QueueMemoryBoundsException(out.str());
+  }
+
+  this->capacity = 1;
+  while (this->capacity < capacity)
+  {
+    this->capacity *= 2;
+  }
+  indexMask = this->capacity - 1;
+  values = new T[this->capacity];
+
+  // the base class size member is not used, since it can not be kept
+  // up to date by both threads, getSize() computes the size instead
+  this->size = 0;
+  head.store(0);
+  tail.store(0);
+  cachedHead = 0;
+  cachedTail = 0;
+}
+
+/**
+ * @brief Class destructor
+ *
+ * Return the buffer of values back to the heap.  Neither thread may be
+ * using the queue once it is being destroyed.
+ */
+template<class T>
+SPSCQueue<T>::~SPSCQueue()
+{
+  delete[] values;
+}
+
+/**
+ * @brief Size accessor
+ *
+ * Compute the number of items currently in the queue from the
+ * difference between the tail and head counters.  When called while
+ * the other thread is changing the queue this is only a snapshot.
+ *
+ * @returns int Returns the current size of the queue of values.
+ */
+template<class T>
+int SPSCQueue<T>::getSize() const
+{
+  // read head first, so tail can only have moved further ahead of it
+  unsigned long currentHead = head.load(memory_order_acquire);
+  unsigned long currentTail = tail.load(memory_order_acquire);
+  return currentTail - currentHead;
+}
+
+/**
+ * @brief Check if empty queue
+ *
+ * @returns bool Returns true if the queue currently holds no items.
+ */
+template<class T>
+bool SPSCQueue<T>::isEmpty() const
+{
+  return getSize() == 0;
+}
+
+/**
+ * @brief Capacity accessor
+ *
+ * @returns int Returns the fixed number of items this queue can hold.
+ */
+template<class T>
+int SPSCQueue<T>::getCapacity() const
+{
+  return capacity;
+}
+
+/**
+ * @brief Access front of queue
+ *
+ * Accessor method to get a copy of the item currently at the front of
+ * this queue.  Only the consumer thread may call this.
+ *
+ * @returns T Returns a copy of the front item of the queue.
+ *
+ * @throws QueueEmptyException If the queue is empty.
+ */
+template<class T>
+T SPSCQueue<T>::front() const
+{
+  if (isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <SPSCQueue>::front() attempt to get item"
+        << " from empty queue, size:  " << getSize();
+
+    throw QueueEmptyException(out.str());
+  }
+
+  return values[head.load(memory_order_relaxed) & indexMask];
+}
+
+/**
+ * @brief Boolean equals operator
+ *
+ * Check if this Queue is equal to the right hand side (rhs) queue.
+ * The queues are equal if their sizes are equal, and if all elements
+ * in both queues are equal.  Should only be used while the queues are
+ * not being changed.
+ *
+ * @param rhs The other queue on the right hand side of the
+ *   boolean comparison that we are comparing this Queue to.
+ *
+ * @returns bool true if the queues are equal, false if the are not.
+ */
+template<class T>
+bool SPSCQueue<T>::operator==(const Queue<T>& rhs) const
+{
+  return this->equalsInOrder(rhs);
+}
+
+/**
+ * @brief Visit contiguous segments of the queue
+ *
+ * Call the visitor with the values of the ring buffer, which are in at
+ * most two segments, the head of the queue up to the end of the buffer
+ * and then the start of the buffer up to the tail.  Should only be
+ * used while the queue is not being changed.
+ *
+ * @param visitor The function to call with each segment.
+ *
+ * @returns bool Returns true if every segment was visited, or false if
+ *   the visitor stopped the visit early.
+ */
+template<class T>
+bool SPSCQueue<T>::visitSegments(const function<bool(const T*, int)>& visitor) const
+{
+  int size = getSize();
+  if (size == 0)
+  {
+    return true;
+  }
+
+  int headIndex = head.load(memory_order_relaxed) & indexMask;
+  int firstSegmentSize = min(size, capacity - headIndex);
+  if (not visitor(values + headIndex, firstSegmentSize))
+  {
+    return false;
+  }
+
+  int secondSegmentSize = size - firstSegmentSize;
+  return (secondSegmentSize == 0) or visitor(values, secondSegmentSize);
+}
+
+/**
+ * @brief Indexing operator
+ *
+ * Access the value at the given position from the front of the queue.
+ * Should only be used while the queue is not being changed.
+ *
+ * @param index The index of the value it is desired to access from
+ *   this Queue.  Index 0 should indicate front of queue, and
+ *   index size - 1 is back item of queue.
+ *
+ * @returns T& Returns a reference to the requested Queue item at
+ *   the requested index.
+ *
+ * @throws QueueMemoryBoundsException if a request for an index beyond
+ *   the end of the queue (or less than 0) is made.
+ */
+template<class T>
+T& SPSCQueue<T>::operator[](int index) const
+{
+  int size = getSize();
+  if ((index < 0) or (index >= size))
+  {
+    ostringstream out;
+    out << "Error: <SPSCQueue::operator[]> illegal bounds access, queue size: " << size << " tried to access index address: " << index;
+
+    throw QueueMemoryBoundsException(out.str());
+  }
+
+  return values[(head.load(memory_order_relaxed) + index) & indexMask];
+}
+
+/**
+ * @brief Clear out queue
+ *
+ * Discard all of the items currently in the queue.  Only the consumer
+ * thread may call this, items enqueued by the producer at the same
+ * time may or may not be discarded.  The buffer itself is kept.
+ */
+template<class T>
+void SPSCQueue<T>::clear()
+{
+  cachedTail = tail.load(memory_order_acquire);
+  head.store(cachedTail, memory_order_release);
+}
+
+/**
+ * @brief Check for room to enqueue
+ *
+ * Producer side test if the buffer is full.  The shared head counter
+ * is only read if the buffer looks full using the cached copy.
+ *
+ * @param currentTail The tail counter of the producer.
+ *
+ * @returns bool true if there is no room to enqueue another item.
+ */
+template<class T>
+bool SPSCQueue<T>::isFull(unsigned long currentTail)
+{
+  if (currentTail - cachedHead < static_cast<unsigned long>(capacity))
+  {
+    return false;
+  }
+
+  cachedHead = head.load(memory_order_acquire);
+  return currentTail - cachedHead >= static_cast<unsigned long>(capacity);
+}
+
+/**
+ * @brief Check for an item to dequeue
+ *
+ * Consumer side test if there is an item to dequeue.  The shared tail
+ * counter is only read if the queue looks empty using the cached copy.
+ *
+ * @param currentHead The head counter of the consumer.
+ *
+ * @returns bool true if there is an item at the head of the queue.
+ */
+template<class T>
+bool SPSCQueue<T>::hasItem(unsigned long currentHead)
+{
+  if (currentHead != cachedTail)
+  {
+    return true;
+  }
+
+  cachedTail = tail.load(memory_order_acquire);
+  return currentHead != cachedTail;
+}
+
+/**
+ * @brief Enqueue value on back of queue
+ *
+ * Enqueue a copy of the value to the back of this Queue, waiting for
+ * the consumer to make room if the buffer is full.  Only the producer
+ * thread may call this.
+ *
+ * @param newItem The value to enqueue on back of the current queue.
+ */
+template<class T>
+void SPSCQueue<T>::enqueue(const T& newItem)
+{
+  while (not tryEnqueue(newItem))
+  {
+    this_thread::yield();
+  }
+}
+
+/**
+ * @brief Enqueue value on back of queue
+ *
+ * Move the value to the back of this Queue, waiting for the consumer
+ * to make room if the buffer is full.  Only the producer thread may
+ * call this.
+ *
+ * @param newItem The value to enqueue on back of the current queue.
+ */
+template<class T>
+void SPSCQueue<T>::enqueue(T&& newItem)
+{
+  while (not tryEnqueue(std::move(newItem)))
+  {
+    this_thread::yield();
+  }
+}
+
+/**
+ * @brief Try to enqueue value on back of queue
+ *
+ * Enqueue a copy of the value to the back of this Queue if there is
+ * room for it.  Only the producer thread may call this.
+ *
+ * @param newItem The value to enqueue on back of the current queue.
+ *
+ * @returns bool true if the value was enqueued, false if the queue
+ *   was full.
+ */
+template<class T>
+bool SPSCQueue<T>::tryEnqueue(const T& newItem)
+{
+  unsigned long currentTail = tail.load(memory_order_relaxed);
+  if (isFull(currentTail))
+  {
+    return false;
+  }
+
+  values[currentTail & indexMask] = newItem;
+
+  // release makes the value visible to the consumer before the new tail
+  tail.store(currentTail + 1, memory_order_release);
+  return true;
+}
+
+/**
+ * @brief Try to enqueue value on back of queue
+ *
+ * Move the value to the back of this Queue if there is room for it.
+ * The value is only moved from if it was enqueued.  Only the producer
+ * thread may call this.
+ *
+ * @param newItem The value to enqueue on back of the current queue.
+ *
+ * @returns bool true if the value was enqueued, false if the queue
+ *   was full.
+ */
+template<class T>
+bool SPSCQueue<T>::tryEnqueue(T&& newItem)
+{
+  unsigned long currentTail = tail.load(memory_order_relaxed);
+  if (isFull(currentTail))
+  {
+    return false;
+  }
+
+  values[currentTail & indexMask] = std::move(newItem);
+  tail.store(currentTail + 1, memory_order_release);
+  return true;
+}
+
+/**
+ * @brief Dequeue queue front item
+ *
+ * Dequeue the item from the front of the queue.  Only the consumer
+ * thread may call this.
+ *
+ * @throws QueueEmptyException If the queue is empty.
+ */
+template<class T>
+void SPSCQueue<T>::dequeue()
+{
+  unsigned long currentHead = head.load(memory_order_relaxed);
+  if (not hasItem(currentHead))
+  {
+    ostringstream out;
+    out << "Error: <SPSCQueue>::dequeue() attempt to dequeue front item"
+        << " from empty queue, size:  " << getSize();
+
+    throw QueueEmptyException(out.str());
+  }
+
+  // release hands the slot back to the producer
+  head.store(currentHead + 1, memory_order_release);
+}
+
+/**
+ * @brief Dequeue and return queue front item
+ *
+ * Move the item out of the front of the queue and return it.  Only
+ * the consumer thread may call this.
+ *
+ * @returns T Returns the item that was at the front of the queue.
+ *
+ * @throws QueueEmptyException If the queue is empty.
+ */
+template<class T>
+T SPSCQueue<T>::dequeueValue()
+{
+  unsigned long currentHead = head.load(memory_order_relaxed);
+  if (not hasItem(currentHead))
+  {
+    ostringstream out;
+    out << "Error: <SPSCQueue>::dequeueValue() attempt to dequeue front item"
+        << " from empty queue, size:  " << getSize();
+
+    throw QueueEmptyException(out.str());
+  }
+
+  // the item is constructed straight from the buffer, rather than default
+  // constructed and then assigned
+  T item(std::move(values[currentHead & indexMask]));
+  head.store(currentHead + 1, memory_order_release);
+  return item;
+}
+
+/**
+ * @brief Try to dequeue queue front item
+ *
+ * Move the item out of the front of the queue if there is one.  Only
+ * the consumer thread may call this.
+ *
+ * @param item Set to the item that was at the front of the queue, left
+ *   alone if the queue was empty.
+ *
+ * @returns bool true if an item was dequeued, false if the queue was
+ *   empty.
+ */
+template<class T>
+bool SPSCQueue<T>::tryDequeue(T& item)
+{
+  unsigned long currentHead = head.load(memory_order_relaxed);
+  if (not hasItem(currentHead))
+  {
+    return false;
+  }
+
+  item = std::move(values[currentHead & indexMask]);
+  head.store(currentHead + 1, memory_order_release);
+  return true;
+}
+
+/**
+ * @brief Cause specific instance compilations
+ *
+ * This is a bit of a kludge, but we can use normal make dependencies
+ * and separate compilation by declaring template class Queue<needed_type>
+ * here of any types we are going to be instantianting with the
+ * template.
+ *
+ * https://isocpp.org/wiki/faq/templates#templates-defn-vs-decl
+ * https://isocpp.org/wiki/faq/templates#separate-template-class-defn-from-decl
+ */
+template class SPSCQueue<int>;
+template class SPSCQueue<string>;
+template class SPSCQueue<Job>;
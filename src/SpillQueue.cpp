@@ -0,0 +1,893 @@
+/** @file SpillQueue.cpp
+ * @brief Concrete disk spilling implementation of Queue ADT, for
+ *   queues that can grow larger than the memory set aside for them.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement the Queue abstraction with a fixed memory budget.  The
+ * items at the front of the queue, which will be dequeued next, and
+ * the items at the back, which were enqueued last, are held in memory
+ * in two array based queues.  When the back of the queue fills its
+ * half of the budget, its items are appended to a segment file on
+ * disk, so the middle of a very long queue is paged out to disk in
+ * the order it was enqueued.  When the front of the queue runs dry,
+ * it is refilled with a long sequential read of the oldest segment,
+ * and segment files are deleted once they have been read.
+ */
+#include "SpillQueue.hpp"
+#include "Job.hpp"
+#include "QueueException.hpp"
+#include "QueueSnapshot.hpp"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <filesystem>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+using namespace std;
+
+/// @brief the number identifying the next spill queue constructed, so
+///   queues sharing a spill directory do not share segment files
+static atomic<long> nextQueueId(0);
+
+/** @class SpillQueue::ItemReader
+ * @brief Reads the items of a spill queue in order, front to back.
+ *
+ * The reader is an input iterator over the items of the queue, so the
+ * queue can be compared with another queue in a single pass by
+ * equalsInOrder().  Items in memory are read in place, and the items
+ * on disk are read from each segment file in turn a block of records
+ * at a time, as visitSegments() does, rather than seeking to each one
+ * as the indexing operator has to.
+ */
+template<class T>
+class SpillQueue<T>::ItemReader
+{
+public:
+  explicit ItemReader(const SpillQueue<T>& queue);
+  const T& operator*() const;
+  ItemReader& operator++();
+
+private:
+  /// @brief the queue being read
+  const SpillQueue<T>& queue;
+
+  /// @brief the index in the queue of the item the reader is at
+  long index;
+
+  /// @brief the next segment file to read once the open one runs out
+  typename deque<Segment>::const_iterator nextSegment;
+
+  /// @brief stream reading the segment file the reader is in
+  ifstream in;
+
+  /// @brief the number of records of the open segment file not yet read
+  long remaining;
+
+  /// @brief the decoded block of items on disk the reader is in
+  vector<T> block;
+
+  /// @brief the index in the block of the item the reader is at
+  int blockIndex;
+
+  void readBlock();
+};
+
+/**
+ * @brief Reader constructor
+ *
+ * Construct a reader at the front item of the queue.  The queue must
+ * not be changed while it is being read.
+ *
+ * @param queue The queue to read the items of.
+ */
+template<class T>
+SpillQueue<T>::ItemReader::ItemReader(const SpillQueue<T>& queue)
+  : queue(queue),
+    index(0),
+    nextSegment(queue.segments.begin()),
+    remaining(0),
+    blockIndex(0)
+{
+  if (queue.head->isEmpty() and (queue.spilledSize > 0))
+  {
+    readBlock();
+  }
+}
+
+/**
+ * @brief Access current item
+ *
+ * @returns const T& Returns the item the reader is at, which is only
+ *   good until the reader is advanced if it was read from disk.
+ */
+template<class T>
+const T& SpillQueue<T>::ItemReader::operator*() const
+{
+  long spilledIndex = index - queue.head->getSize();
+  if (spilledIndex < 0)
+  {
+    return (*queue.head)[index];
+  }
+  if (spilledIndex < queue.spilledSize)
+  {
+    return block[blockIndex];
+  }
+  return (*queue.tail)[spilledIndex - queue.spilledSize];
+}
+
+/**
+ * @brief Advance to next item
+ *
+ * Move on to the next item of the queue, reading the next block of
+ * items from disk when the reader is on disk and has used up the
+ * block it read last.
+ *
+ * @returns ItemReader& Returns this reader.
+ *
+ * @throws QueueSpillException if the items can not be read from disk.
+ */
+template<class T>
+typename SpillQueue<T>::ItemReader& SpillQueue<T>::ItemReader::operator++()
+{
+  index++;
+  long spilledIndex = index - queue.head->getSize();
+  if ((spilledIndex >= 0) and (spilledIndex < queue.spilledSize))
+  {
+    blockIndex++;
+    if ((spilledIndex == 0) or (blockIndex == int(block.size())))
+    {
+      readBlock();
+    }
+  }
+  return *this;
+}
+
+/**
+ * @brief Read next block from disk
+ *
+ * Read and decode the next block of records, opening the next segment
+ * file when the open one has been read, and skipping the records of
+ * the oldest segment file that have already been dequeued.
+ *
+ * @throws QueueSpillException if the segment file can not be read.
+ */
+template<class T>
+void SpillQueue<T>::ItemReader::readBlock()
+{
+  typedef QueueSnapshotCodec<T> Codec;
+  typedef typename Codec::Record Record;
+
+  while (remaining == 0)
+  {
+    long skip = (nextSegment == queue.segments.begin()) ? queue.readCount : 0;
+    in.close();
+    in.open(nextSegment->path, ios::binary);
+    in.seekg(skip * sizeof(Record));
+    remaining = nextSegment->count - skip;
+    ++nextSegment;
+  }
+
+  Record records[RECORD_BLOCK_SIZE];
+  int blockSize = min(long(RECORD_BLOCK_SIZE), remaining);
+  in.read(reinterpret_cast<char*>(records), blockSize * sizeof(Record));
+  if (not in)
+  {
+    ostringstream out;
+    out << "Error: <SpillQueue>::operator==() could not read segment file " << prev(nextSegment)->path;
+
+    throw QueueSpillException(out.str());
+  }
+  remaining -= blockSize;
+
+  block.clear();
+  for (int recordIndex = 0; recordIndex < blockSize; recordIndex++)
+  {
+    block.push_back(Codec::decode(records[recordIndex]));
+  }
+  blockIndex = 0;
+}
+
+/**
+ * @brief Budget constructor
+ *
+ * Construct an empty queue that holds at most the given number of
+ * bytes of items in memory, and spills the rest into segment files
+ * in the given directory.  The directory is created if it does not
+ * exist yet.  The budget is split between the front and the back of
+ * the queue, which are both allocated up front, so the queue never
+ * grows past its budget.
+ *
+ * @param spillDirectory The directory to write segment files in.
+ * @param memoryBudget The number of bytes of items to hold in memory.
+ *
+ * @throws QueueSpillException if the spill directory can not be
+ *   created.
+ */
+template<class T>
+SpillQueue<T>::SpillQueue(const string& spillDirectory, size_t memoryBudget)
+{
+  static_assert(QueueSnapshotCodec<T>::SUPPORTED, "SpillQueue items must be able to be saved in a queue snapshot");
+
+  error_code error;
+  filesystem::create_directories(spillDirectory, error);
+  if (error)
+  {
+    ostringstream out;
+    out << "Error: <SpillQueue>::SpillQueue() could not create spill directory " << spillDirectory << ": "
+        << error.message();
+
+    throw QueueSpillException(out.str());
+  }
+
+  this->spillDirectory = spillDirectory;
+  this->memoryBudget = memoryBudget;
+  bufferLimit = max(size_t(1), min(memoryBudget / sizeof(T) / 2, size_t(INT_MAX / 2)));
+
+  head = &buffers[0];
+  head->reserve(bufferLimit);
+  tail = &buffers[1];
+  tail->reserve(bufferLimit);
+
+  this->size = 0;
+  spilledSize = 0;
+  readCount = 0;
+  queueId = nextQueueId++;
+  segmentsCreated = 0;
+}
+
+/**
+ * @brief Class destructor
+ *
+ * Delete any segment files still holding items of the queue, the
+ * in memory buffers free their own memory.
+ */
+template<class T>
+SpillQueue<T>::~SpillQueue()
+{
+  clear();
+}
+
+/**
+ * @brief Memory budget accessor
+ *
+ * Accessor method to get the number of bytes of items this queue
+ * holds in memory.
+ *
+ * @returns size_t The memory budget of this queue in bytes.
+ */
+template<class T>
+size_t SpillQueue<T>::getMemoryBudget() const
+{
+  return memoryBudget;
+}
+
+/**
+ * @brief In memory size accessor
+ *
+ * Accessor method to get the number of items of the queue that are
+ * currently held in memory, at the front and the back of the queue.
+ *
+ * @returns int The number of items held in memory.
+ */
+template<class T>
+int SpillQueue<T>::getInMemorySize() const
+{
+  return head->getSize() + tail->getSize();
+}
+
+/**
+ * @brief Spilled size accessor
+ *
+ * Accessor method to get the number of items of the queue that are
+ * currently spilled to segment files on disk.
+ *
+ * @returns long The number of items on disk.
+ */
+template<class T>
+long SpillQueue<T>::getSpilledSize() const
+{
+  return spilledSize;
+}
+
+/**
+ * @brief Segment count accessor
+ *
+ * Accessor method to get the number of segment files currently
+ * holding items of the queue.
+ *
+ * @returns int The number of segment files on disk.
+ */
+template<class T>
+int SpillQueue<T>::getSegmentCount() const
+{
+  return segments.size();
+}
+
+/**
+ * @brief Access front of queue
+ *
+ * Accessor method to get a copy of the item currently at the front of
+ * this queue.  The front of the queue is always refilled as soon as
+ * it runs dry, so the front item is always in memory.
+ *
+ * @returns T Returns a copy of the front item of the queue.
+ *
+ * @throws QueueEmptyException if an attempt is made to access the
+ *   front item of an empty queue.
+ */
+template<class T>
+T SpillQueue<T>::front() const
+{
+  if (this->isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <SpillQueue>::front() attempt to access front item"
+        << " of empty queue, size:  " << this->size;
+
+    throw QueueEmptyException(out.str());
+  }
+
+  return head->front();
+}
+
+/**
+ * @brief Boolean equals operator
+ *
+ * Check if this Queue is equal to the right hand side (rhs)
+ * queue.  The queues are equal if their sizes are equal, and all
+ * elements in the queues are equal.  The rhs queue is visited once,
+ * and this queue is read alongside it in order, the items on disk in
+ * long sequential blocks, so the comparison is linear time and never
+ * indexes either queue.
+ *
+ * @param rhs The other queue on the right hand side of the
+ *   boolean comparison that we are comparing this queue to.
+ *
+ * @returns bool true if the queues are equal, false if they are not.
+ *
+ * @throws QueueSpillException if the items can not be read from disk.
+ */
+template<class T>
+bool SpillQueue<T>::operator==(const Queue<T>& rhs) const
+{
+  if (this->size != rhs.getSize())
+  {
+    return false;
+  }
+
+  return this->equalsInOrder(ItemReader(*this), rhs);
+}
+
+/**
+ * @brief Indexing operator
+ *
+ * Provide a way to index individual values of the queue.  Items at
+ * the front and back of the queue are returned from memory, but an
+ * item spilled to disk has to be read from its segment file, and a
+ * reference to a copy of it is returned, which is only good until the
+ * next time the queue is indexed.  Changing the copy does not change
+ * the item on disk.
+ *
+ * @param index The index of the value it is desired to access from
+ *   this Queue.  Index 0 should indicate front of queue, and
+ *   index size - 1 is back item of queue.
+ *
+ * @returns T& Returns a reference to the requested Queue item at
+ *   the requested index, or to a copy of it if it is on disk.
+ *
+ * @throws QueueMemoryBoundsException if a request for an index beyond
+ *   the end of the queue (or less than 0) is made.
+ * @throws QueueSpillException if the item can not be read from disk.
+ */
+template<class T>
+T& SpillQueue<T>::operator[](int index) const
+{
+  typedef QueueSnapshotCodec<T> Codec;
+  typedef typename Codec::Record Record;
+
+  if ((index < 0) or (index >= this->size))
+  {
+    ostringstream out;
+    out << "Error: <SpillQueue::operator[]> illegal bounds access, queue size: " << this->size
+        << " tried to access index address: " << index;
+
+    throw QueueMemoryBoundsException(out.str());
+  }
+
+  if (index < head->getSize())
+  {
+    return (*head)[index];
+  }
+  long spilledIndex = index - head->getSize();
+  if (spilledIndex >= spilledSize)
+  {
+    return (*tail)[spilledIndex - spilledSize];
+  }
+
+  // find the segment holding the item, items already read from the
+  // oldest segment are no longer part of the queue
+  long position = spilledIndex + readCount;
+  for (const Segment& segment : segments)
+  {
+    if (position < segment.count)
+    {
+      Record record;
+      ifstream in(segment.path, ios::binary);
+      in.seekg(position * sizeof(Record));
+      in.read(reinterpret_cast<char*>(&record), sizeof(Record));
+      if (not in)
+      {
+        ostringstream out;
+        out << "Error: <SpillQueue::operator[]> could not read index " << index << " from segment file "
+            << segment.path;
+
+        throw QueueSpillException(out.str());
+      }
+
+      indexedItem = Codec::decode(record);
+      break;
+    }
+    position -= segment.count;
+  }
+  return indexedItem;
+}
+
+/**
+ * @brief Visit contiguous segments of the queue
+ *
+ * Call the visitor with the values of the queue from front to back.
+ * The front and back of the queue are visited in place in memory, and
+ * the items on disk are read from each segment file in turn in blocks
+ * of records, each block visited as a segment.
+ *
+ * @param visitor The function to call with a pointer to each segment
+ *   of values and the number of values in it.  It returns false to
+ *   stop the visit.
+ *
+ * @returns bool Returns true if every segment was visited, or false if
+ *   the visitor stopped the visit early.
+ *
+ * @throws QueueSpillException if the items can not be read from disk.
+ */
+template<class T>
+bool SpillQueue<T>::visitSegments(const function<bool(const T*, int)>& visitor) const
+{
+  typedef QueueSnapshotCodec<T> Codec;
+  typedef typename Codec::Record Record;
+
+  if (not head->visitSegments(visitor))
+  {
+    return false;
+  }
+
+  Record block[RECORD_BLOCK_SIZE];
+  vector<T> items;
+  long skip = readCount;
+  for (const Segment& segment : segments)
+  {
+    ifstream in(segment.path, ios::binary);
+    in.seekg(skip * sizeof(Record));
+    for (long remaining = segment.count - skip; remaining > 0;)
+    {
+      int blockSize = min(long(RECORD_BLOCK_SIZE), remaining);
+      in.read(reinterpret_cast<char*>(block), blockSize * sizeof(Record));
+      if (not in)
+      {
+        ostringstream out;
+        out << "Error: <SpillQueue>::visitSegments() could not read segment file " << segment.path;
+
+        throw QueueSpillException(out.str());
+      }
+      remaining -= blockSize;
+
+      bool visitMore;
+      if constexpr (Codec::IDENTITY)
+      {
+        visitMore = visitor(block, blockSize);
+      }
+      else
+      {
+        items.clear();
+        for (int index = 0; index < blockSize; index++)
+        {
+          items.push_back(Codec::decode(block[index]));
+        }
+        visitMore = visitor(items.data(), blockSize);
+      }
+      if (not visitMore)
+      {
+        return false;
+      }
+    }
+    skip = 0;
+  }
+
+  return tail->visitSegments(visitor);
+}
+
+/**
+ * @brief Clear out queue
+ *
+ * Clear or empty out the queue.  The memory budget stays allocated,
+ * but all segment files of the queue are deleted.
+ */
+template<class T>
+void SpillQueue<T>::clear()
+{
+  emptyBuffer(head);
+  emptyBuffer(tail);
+  closeWriteSegment();
+  if (readStream.is_open())
+  {
+    readStream.close();
+  }
+  removeSegmentFiles();
+
+  this->size = 0;
+  spilledSize = 0;
+  readCount = 0;
+}
+
+/**
+ * @brief Enqueue copy on back
+ *
+ * Enqueue a copy of the new item on the back of the queue.  The copy
+ * is made once and then moved into place by the move enqueue.
+ *
+ * @param newItem The item to be added to the back of the queue.
+ */
+template<class T>
+void SpillQueue<T>::enqueue(const T& newItem)
+{
+  enqueue(T(newItem));
+}
+
+/**
+ * @brief Enqueue value on back
+ *
+ * Move the new item onto the back of the queue.  While the whole
+ * queue fits in the front half of the memory budget, items go
+ * straight to the front of the queue.  After that they go to the back
+ * of the queue, and once the back half of the budget is full all of
+ * its items are spilled to disk.
+ *
+ * @param newItem The item to be added to the back of the queue.
+ *
+ * @throws QueueSpillException if the back of the queue can not be
+ *   spilled to disk, in which case the new item is still enqueued and
+ *   the back of the queue stays in memory until the next spill.
+ */
+template<class T>
+void SpillQueue<T>::enqueue(T&& newItem)
+{
+  // the item is counted before the spill, which can throw
+  this->size++;
+  QUEUE_COUNT(enqueues, 1);
+  if ((spilledSize == 0) and tail->isEmpty() and (head->getSize() < bufferLimit))
+  {
+    head->enqueue(std::move(newItem));
+  }
+  else
+  {
+    tail->enqueue(std::move(newItem));
+    if (tail->getSize() >= bufferLimit)
+    {
+      spillTail();
+    }
+  }
+}
+
+/**
+ * @brief Dequeue front item
+ *
+ * Remove the item from the front of the queue.  If that empties the
+ * front of the queue it is refilled from disk, or from the back of the
+ * queue if nothing is on disk.
+ *
+ * @throws QueueEmptyException if an attempt is made to dequeue from an
+ *   empty queue.
+ * @throws QueueSpillException if the front of the queue can not be
+ *   refilled from disk.
+ */
+template<class T>
+void SpillQueue<T>::dequeue()
+{
+  if (this->isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <SpillQueue>::dequeue() attempt to dequeue front item"
+        << " from empty queue, size:  " << this->size;
+
+    throw QueueEmptyException(out.str());
+  }
+
+  head->dequeue();
+  this->size--;
+  QUEUE_COUNT(dequeues, 1);
+  if (head->isEmpty() and (this->size > 0))
+  {
+    refillHead();
+  }
+}
+
+/**
+ * @brief Dequeue and return front item
+ *
+ * Move the item at the front of the queue out and return it, refilling
+ * the front of the queue as for dequeue().
+ *
+ * @returns T The item that was at the front of the queue.
+ *
+ * @throws QueueEmptyException if an attempt is made to dequeue from an
+ *   empty queue.
+ * @throws QueueSpillException if the front of the queue can not be
+ *   refilled from disk.
+ */
+template<class T>
+T SpillQueue<T>::dequeueValue()
+{
+  if (this->isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <SpillQueue>::dequeueValue() attempt to dequeue front item"
+        << " from empty queue, size:  " << this->size;
+
+    throw QueueEmptyException(out.str());
+  }
+
+  T item = head->dequeueValue();
+  this->size--;
+  QUEUE_COUNT(dequeues, 1);
+  if (head->isEmpty() and (this->size > 0))
+  {
+    refillHead();
+  }
+  return item;
+}
+
+/**
+ * @brief Spill back of queue to disk
+ *
+ * Append all of the items at the back of the queue to the newest
+ * segment file, starting a new segment file if there is none open for
+ * writing.  The items are written straight from the segments of the
+ * circular buffer when they are their own records, or encoded a block
+ * of records at a time.  The stream is flushed so the items can be
+ * read back by the indexing operator, and the segment is closed once
+ * it has taken SPILLS_PER_SEGMENT spills.  If the write fails, the
+ * partly written records are cut off the end of the segment file, the
+ * segment is closed, and the items stay at the back of the queue.
+ *
+ * @throws QueueSpillException if the segment file can not be created
+ *   or written.
+ */
+template<class T>
+void SpillQueue<T>::spillTail()
+{
+  typedef QueueSnapshotCodec<T> Codec;
+  typedef typename Codec::Record Record;
+
+  if (not writeStream.is_open())
+  {
+    ostringstream name;
+    name << "spill-" << getpid() << "-" << queueId << "-" << segmentsCreated++ << ".seg";
+    string path = (filesystem::path(spillDirectory) / name.str()).string();
+
+    writeStream.open(path, ios::binary | ios::trunc);
+    if (not writeStream)
+    {
+      writeStream.close();
+      ostringstream out;
+      out << "Error: <SpillQueue>::spillTail() could not create segment file " << path;
+
+      throw QueueSpillException(out.str());
+    }
+    segments.push_back(Segment{path, 0});
+  }
+
+  ofstream& out = writeStream;
+  tail->visitSegments([&out](const T* segment, int segmentSize) {
+    if constexpr (Codec::IDENTITY)
+    {
+      out.write(reinterpret_cast<const char*>(segment), segmentSize * sizeof(Record));
+    }
+    else
+    {
+      Record block[RECORD_BLOCK_SIZE];
+      for (int start = 0; start < segmentSize; start += RECORD_BLOCK_SIZE)
+      {
+        int blockSize = min(int(RECORD_BLOCK_SIZE), segmentSize - start);
+        for (int index = 0; index < blockSize; index++)
+        {
+          block[index] = Codec::encode(segment[start + index]);
+        }
+        out.write(reinterpret_cast<const char*>(block), blockSize * sizeof(Record));
+      }
+    }
+    return bool(out);
+  });
+  writeStream.flush();
+  if (not writeStream)
+  {
+    Segment& segment = segments.back();
+    ostringstream message;
+    message << "Error: <SpillQueue>::spillTail() failed writing " << tail->getSize() << " items to segment file "
+            << segment.path;
+
+    // keep only the records of earlier spills in the segment file
+    writeStream.close();
+    error_code error;
+    if (segment.count == 0)
+    {
+      filesystem::remove(segment.path, error);
+      segments.pop_back();
+    }
+    else
+    {
+      filesystem::resize_file(segment.path, segment.count * sizeof(Record), error);
+    }
+
+    throw QueueSpillException(message.str());
+  }
+
+  segments.back().count += tail->getSize();
+  spilledSize += tail->getSize();
+  QUEUE_COUNT(bytesCopied, (long long)tail->getSize() * sizeof(Record));
+  emptyBuffer(tail);
+
+  if (segments.back().count >= long(SPILLS_PER_SEGMENT) * bufferLimit)
+  {
+    closeWriteSegment();
+  }
+}
+
+/**
+ * @brief Refill front of queue
+ *
+ * Refill the empty front of the queue.  If items are on disk, a front
+ * half budget of them is read from the oldest segment files, in order,
+ * with long sequential reads.  Segment files are deleted as soon as
+ * they have been read, and the newest segment is closed for writing
+ * before it is read.  If nothing is on disk, the back of the queue
+ * simply becomes the front.
+ *
+ * @throws QueueSpillException if a segment file can not be read.
+ */
+template<class T>
+void SpillQueue<T>::refillHead()
+{
+  typedef QueueSnapshotCodec<T> Codec;
+  typedef typename Codec::Record Record;
+
+  if (spilledSize == 0)
+  {
+    swap(head, tail);
+    return;
+  }
+
+  Record block[RECORD_BLOCK_SIZE];
+  while ((head->getSize() < bufferLimit) and (spilledSize > 0))
+  {
+    Segment& segment = segments.front();
+    if (not readStream.is_open())
+    {
+      if ((segments.size() == 1) and writeStream.is_open())
+      {
+        closeWriteSegment();
+      }
+      readStream.open(segment.path, ios::binary);
+      readCount = 0;
+    }
+
+    long blockSize = min({long(RECORD_BLOCK_SIZE), segment.count - readCount, long(bufferLimit - head->getSize())});
+    readStream.read(reinterpret_cast<char*>(block), blockSize * sizeof(Record));
+    if (not readStream)
+    {
+      ostringstream out;
+      out << "Error: <SpillQueue>::refillHead() could not read segment file " << segment.path;
+
+      throw QueueSpillException(out.str());
+    }
+
+    if constexpr (Codec::IDENTITY)
+    {
+      head->enqueueArray(block, blockSize);
+    }
+    else
+    {
+      for (int index = 0; index < blockSize; index++)
+      {
+        head->enqueue(Codec::decode(block[index]));
+      }
+    }
+    readCount += blockSize;
+    spilledSize -= blockSize;
+    QUEUE_COUNT(bytesCopied, (long long)blockSize * sizeof(Record));
+
+    // delete the segment once it has been read
+    if (readCount == segment.count)
+    {
+      readStream.close();
+      error_code error;
+      filesystem::remove(segment.path, error);
+      segments.pop_front();
+      readCount = 0;
+    }
+  }
+}
+
+/**
+ * @brief Close newest segment
+ *
+ * Close the newest segment file for writing, if it is open, so that
+ * the next spill starts a new segment file.
+ */
+template<class T>
+void SpillQueue<T>::closeWriteSegment()
+{
+  if (writeStream.is_open())
+  {
+    writeStream.close();
+  }
+}
+
+/**
+ * @brief Remove segment files
+ *
+ * Delete all of the segment files of the queue from disk.  Errors are
+ * ignored, since this is used to clean up after the queue.
+ */
+template<class T>
+void SpillQueue<T>::removeSegmentFiles()
+{
+  for (const Segment& segment : segments)
+  {
+    error_code error;
+    filesystem::remove(segment.path, error);
+  }
+  segments.clear();
+}
+
+/**
+ * @brief Empty in memory buffer
+ *
+ * Remove all of the items from one of the in memory buffers.  The
+ * items are dequeued rather than cleared, since clearing an array
+ * queue frees its memory, while dequeuing never shrinks it below its
+ * reservation, so the memory budget stays allocated.
+ *
+ * @param buffer The buffer to empty.
+ */
+template<class T>
+void SpillQueue<T>::emptyBuffer(AQueue<T>* buffer)
+{
+  while (not buffer->isEmpty())
+  {
+    buffer->dequeue();
+  }
+}
+
+/**
+ * @brief Cause specific instance compilations
+ *
+ * This is a bit of a kludge, but we can use normal make dependencies
+ * and separate compilation by declaring template class Queue<needed_type>
+ * here of any types we are going to be instantianting with the
+ * template.  Only item types that can be saved in a queue snapshot
+ * can be spilled to disk, so there is no SpillQueue<string>.
+ *
+ * https://isocpp.org/wiki/faq/templates#templates-defn-vs-decl
+ * https://isocpp.org/wiki/faq/templates#separate-template-class-defn-from-decl
+ */
+template class SpillQueue<int>;
+template class SpillQueue<Job>;
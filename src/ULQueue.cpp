@@ -0,0 +1,693 @@
+/** @file ULQueue.cpp
+ * @brief Concrete unrolled linked list based implementation of Queue
+ *   ADT.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Implement the Queue abstraction using an unrolled linked list.
+ * Instead of a node for every value, each node of the list holds a
+ * small fixed size block of values, sized to fill a cache line or two.
+ * Enqueue fills the back block and links on a new block when it is
+ * full, and dequeue empties the front block and unlinks it when it has
+ * been used up.  Both are still constant time O(1) operations, like
+ * for the LQueue, but there is only one allocation for every block of
+ * values, the values sit next to each other in memory, and finding
+ * the value at an index only has to step over whole blocks.
+ */
+#include "ULQueue.hpp"
+#include "Job.hpp"
+#include "QueueException.hpp"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+using namespace std;
+
+/**
+ * @brief Default constructor
+ *
+ * Construct an empty queue.  The empty queue will have no allocated
+ * blocks nor any values.
+ */
+template<class T>
+ULQueue<T>::ULQueue()
+{
+  this->size = 0;
+  frontBlock = nullptr;
+  backBlock = nullptr;
+  frontOffset = 0;
+  backOffset = 0;
+  spareBlock = nullptr;
+  frontPosition = 0;
+  cursorBlock = nullptr;
+  cursorPosition = 0;
+}
+
+/**
+ * @brief Standard constructor
+ *
+ * Construct a queue of values from a (statically) defined and
+ * provided array of values.  The values are copied into as few blocks
+ * as are needed to hold them.
+ *
+ * @param size The size of the input values we are given as well as the
+ *   size of the new queue we are to construct.
+ * @param values The (static) array of values to use to construct
+ *   this new Queue of values with.
+ */
+template<class T>
+ULQueue<T>::ULQueue(int size, T values[])
+{
+  this->size = 0;
+  frontBlock = nullptr;
+  backBlock = nullptr;
+  frontOffset = 0;
+  backOffset = 0;
+  spareBlock = nullptr;
+  frontPosition = 0;
+  cursorBlock = nullptr;
+  cursorPosition = 0;
+
+  enqueueArray(values, size);
+}
+
+/**
+ * @brief Copy constructor
+ *
+ * Provide a copy constructor for the Queue class.  A copy constructor
+ * will be invoked whenver you assign one instance of a Queue to another.
+ * For example
+ *   Queue newQueue = existingQueue;
+ * Where of course existingQueue was a previously created Queue.  The
+ * blocks of the other queue are walked in order, and the values of each
+ * block are copied into this queue as a batch.
+ *
+ * @param queue The other Queue type we are to make a copy of in this
+ *   constructor.
+ */
+template<class T>
+ULQueue<T>::ULQueue(const ULQueue<T>& queue)
+{
+  this->size = 0;
+  frontBlock = nullptr;
+  backBlock = nullptr;
+  frontOffset = 0;
+  backOffset = 0;
+  spareBlock = nullptr;
+  frontPosition = 0;
+  cursorBlock = nullptr;
+  cursorPosition = 0;
+
+  for (Block* block = queue.frontBlock; block != nullptr; block = block->next)
+  {
+    int first = (block == queue.frontBlock) ? queue.frontOffset : 0;
+    int last = (block == queue.backBlock) ? queue.backOffset : BLOCK_CAPACITY;
+    enqueueArray(block->values + first, last - first);
+  }
+}
+
+/**
+ * @brief Class destructor
+ *
+ * Destructor for the Queue class.  Invoke the clear of this queue to
+ * give back all of the blocks before we destruct.
+ */
+template<class T>
+ULQueue<T>::~ULQueue()
+{
+  clear();
+}
+
+/**
+ * @brief Block count accessor
+ *
+ * Accessor method to get the number of blocks currently linked into
+ * the list holding the values of this queue, not counting a spare
+ * block.
+ *
+ * @returns int Returns the number of blocks of the queue.
+ */
+template<class T>
+int ULQueue<T>::getBlockCount() const
+{
+  int blockCount = 0;
+  for (Block* block = frontBlock; block != nullptr; block = block->next)
+  {
+    blockCount++;
+  }
+  return blockCount;
+}
+
+/**
+ * @brief Access front of queue
+ *
+ * Accessor method to get a copy of the item currently
+ * at the front of this queue.
+ *
+ * @returns T Returns a copy of the front item of the
+ *   queue.
+ *
+ * @throws QueueEmptyException If an attempt is made to
+ *   access front item of an empty queue, this exception
+ *   is generated and thrown instead.
+ */
+template<class T>
+T ULQueue<T>::front() const
+{
+  if (this->isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <ULQueue>::front() attempt to get item"
+        << " from empty queue, size:  " << this->size;
+
+    throw QueueEmptyException(out.str());
+  }
+
+  return frontBlock->values[frontOffset];
+}
+
+/**
+ * @brief Boolean equals operator
+ *
+ * Check if this Queue is equal to the right hand side (rhs)
+ * queue.  The queues are equal if their sizes are equal, and if
+ * all elements in both queues are equal.  Our values are iterated
+ * while the values of rhs are visited segment by segment, so comparing
+ * with any kind of queue is a single linear pass.
+ *
+ * @param rhs The other queue on the right hand side of the
+ *   boolean comparison that we are comparing this Queue to.
+ *
+ * @returns bool true if the queues are equal, false if the are not.
+ */
+template<class T>
+bool ULQueue<T>::operator==(const Queue<T>& rhs) const
+{
+  return this->equalsInOrder(begin(), rhs);
+}
+
+/**
+ * @brief Visit contiguous segments of the queue
+ *
+ * Call the visitor with the values of each block of the list in turn.
+ *
+ * @param visitor The function to call with each segment.
+ *
+ * @returns bool Returns true if every segment was visited, or false if
+ *   the visitor stopped the visit early.
+ */
+template<class T>
+bool ULQueue<T>::visitSegments(const function<bool(const T*, int)>& visitor) const
+{
+  for (Block* block = frontBlock; block != nullptr; block = block->next)
+  {
+    int first = (block == frontBlock) ? frontOffset : 0;
+    int last = (block == backBlock) ? backOffset : BLOCK_CAPACITY;
+    if (not visitor(block->values + first, last - first))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Indexing operator
+ *
+ * Provide a way to index individual values in our private
+ * list of blocks of values.  The block holding the value is found by
+ * stepping over whole blocks, starting from the block the last
+ * indexing found if the value is at or after it, or else from the
+ * front block.  Indexing the values in order therefore only ever steps
+ * over one block at a time.
+ *
+ * @param index The index of the value it is desired to access from
+ *   this Queue.
+ *
+ * @returns T& Returns a reference to the requested Queue item at
+ *   the requested index.
+ *
+ * @throws QueueMemoryBoundsException if a request for an index beyond
+ *   the end of the queue (or less than 0) is made.
+ */
+template<class T>
+T& ULQueue<T>::operator[](int index) const
+{
+  // first check that the requsted index is legally
+  // within the bounds of the current size of our queue
+  if ((index < 0) or (index >= this->size))
+  {
+    ostringstream out;
+    out << "Error: <ULQueue::operator[]> illegal bounds access, queue size: " << this->size << " tried to access index address: " << index;
+
+    throw QueueMemoryBoundsException(out.str());
+  }
+
+  long position = frontPosition + index;
+  if ((cursorBlock == nullptr) or (position < cursorPosition))
+  {
+    cursorBlock = frontBlock;
+    cursorPosition = frontPosition - frontOffset;
+  }
+
+  // step over whole blocks until we reach the block holding the value
+  while (position - cursorPosition >= BLOCK_CAPACITY)
+  {
+    cursorBlock = cursorBlock->next;
+    cursorPosition += BLOCK_CAPACITY;
+  }
+
+  return cursorBlock->values[position - cursorPosition];
+}
+
+/**
+ * @brief Iterator to front of queue
+ *
+ * Get an iterator to the front item of the queue, iterating from it
+ * visits the items in order from the front to the back of the queue.
+ *
+ * @returns iterator Returns an iterator at the front item, which is the
+ *   same as end() if the queue is empty.
+ */
+template<class T>
+typename ULQueue<T>::iterator ULQueue<T>::begin()
+{
+  if (frontBlock == nullptr)
+  {
+    return iterator();
+  }
+  return iterator(frontBlock, frontBlock->values + frontOffset);
+}
+
+/**
+ * @brief Iterator past back of queue
+ *
+ * Get an iterator just past the back item of the queue.
+ *
+ * @returns iterator Returns an iterator just past the back item.
+ */
+template<class T>
+typename ULQueue<T>::iterator ULQueue<T>::end()
+{
+  return makeEnd<iterator>();
+}
+
+/**
+ * @brief Const iterator to front of queue
+ *
+ * Get an iterator to the front item of the queue that can not be used
+ * to change the items.
+ *
+ * @returns const_iterator Returns an iterator at the front item.
+ */
+template<class T>
+typename ULQueue<T>::const_iterator ULQueue<T>::begin() const
+{
+  if (frontBlock == nullptr)
+  {
+    return const_iterator();
+  }
+  return const_iterator(frontBlock, frontBlock->values + frontOffset);
+}
+
+/**
+ * @brief Const iterator past back of queue
+ *
+ * Get an iterator just past the back item of the queue that can not be
+ * used to change the items.
+ *
+ * @returns const_iterator Returns an iterator just past the back item.
+ */
+template<class T>
+typename ULQueue<T>::const_iterator ULQueue<T>::end() const
+{
+  return makeEnd<const_iterator>();
+}
+
+/**
+ * @brief Const iterator to front of queue
+ *
+ * Get a const iterator to the front item, even of a queue that could
+ * be changed.
+ *
+ * @returns const_iterator Returns an iterator at the front item.
+ */
+template<class T>
+typename ULQueue<T>::const_iterator ULQueue<T>::cbegin() const
+{
+  return begin();
+}
+
+/**
+ * @brief Const iterator past back of queue
+ *
+ * Get a const iterator just past the back item, even of a queue that
+ * could be changed.
+ *
+ * @returns const_iterator Returns an iterator just past the back item.
+ */
+template<class T>
+typename ULQueue<T>::const_iterator ULQueue<T>::cend() const
+{
+  return makeEnd<const_iterator>();
+}
+
+/**
+ * @brief Clear out queue
+ *
+ * Clear or empty out the queue.  Return the queue back
+ * to an empty queue, giving back all of the blocks including the
+ * spare block.
+ */
+template<class T>
+void ULQueue<T>::clear()
+{
+  while (frontBlock != nullptr)
+  {
+    Block* blockToDelete = frontBlock;
+    frontBlock = frontBlock->next;
+    delete blockToDelete;
+  }
+  delete spareBlock;
+
+  this->size = 0;
+  frontBlock = nullptr;
+  backBlock = nullptr;
+  frontOffset = 0;
+  backOffset = 0;
+  spareBlock = nullptr;
+  cursorBlock = nullptr;
+}
+
+/**
+ * @brief Enqueue value on back of queue
+ *
+ * Enqueue the value to the back of this Queue.
+ *
+ * @param value The value to enqueue on back of the current queue.
+ */
+template<class T>
+void ULQueue<T>::enqueue(const T& value)
+{
+  if ((backBlock == nullptr) or (backOffset == BLOCK_CAPACITY))
+  {
+    appendBlock();
+  }
+
+  backBlock->values[backOffset] = value;
+  backOffset++;
+  this->size += 1;
+  QUEUE_COUNT(enqueues, 1);
+}
+
+/**
+ * @brief Enqueue value on back of queue
+ *
+ * Enqueue the value to the back of this Queue, moving it into the
+ * queue instead of copying it.
+ *
+ * @param value The value to enqueue on back of the current queue.
+ */
+template<class T>
+void ULQueue<T>::enqueue(T&& value)
+{
+  if ((backBlock == nullptr) or (backOffset == BLOCK_CAPACITY))
+  {
+    appendBlock();
+  }
+
+  backBlock->values[backOffset] = std::move(value);
+  backOffset++;
+  this->size += 1;
+  QUEUE_COUNT(enqueues, 1);
+}
+
+/**
+ * @brief Enqueue array of values on back of queue
+ *
+ * Enqueue copies of the given block of values, in order, onto the back
+ * of this Queue.  The values are copied a block at a time, filling the
+ * back block and then as many new blocks as are needed.
+ *
+ * @param items The block of values to enqueue.
+ * @param count The number of values in the block.
+ */
+template<class T>
+void ULQueue<T>::enqueueArray(const T* items, int count)
+{
+  while (count > 0)
+  {
+    if ((backBlock == nullptr) or (backOffset == BLOCK_CAPACITY))
+    {
+      appendBlock();
+    }
+
+    int copied = min(count, BLOCK_CAPACITY - backOffset);
+    copy(items, items + copied, backBlock->values + backOffset);
+    backOffset += copied;
+    this->size += copied;
+    QUEUE_COUNT(enqueues, copied);
+    items += copied;
+    count -= copied;
+  }
+}
+
+/**
+ * @brief Dequeue queue front item
+ *
+ * Dequeue the item from the front of the queue.  The front block is
+ * unlinked once its last value has been dequeued.
+ *
+ * @throws QueueEmptyException If an attempt is made to
+ *   dequeue from an empty queue.
+ */
+template<class T>
+void ULQueue<T>::dequeue()
+{
+  if (this->isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <ULQueue>::dequeue() attempt to dequeue front item"
+        << " from empty queue, size:  " << this->size;
+
+    throw QueueEmptyException(out.str());
+  }
+
+  frontOffset++;
+  frontPosition++;
+  this->size -= 1;
+  QUEUE_COUNT(dequeues, 1);
+
+  if ((frontOffset == BLOCK_CAPACITY) or this->isEmpty())
+  {
+    releaseFrontBlock();
+  }
+}
+
+/**
+ * @brief Dequeue and return queue front item
+ *
+ * Dequeue the item from the front of the queue, and return it.  The
+ * front item is moved out of its block, rather than copied by front()
+ * and then discarded by dequeue().
+ *
+ * @returns T Returns the item that was at the front of the queue.
+ *
+ * @throws QueueEmptyException If an attempt is made to
+ *   dequeue from an empty queue.
+ */
+template<class T>
+T ULQueue<T>::dequeueValue()
+{
+  if (this->isEmpty())
+  {
+    ostringstream out;
+    out << "Error: <ULQueue>::dequeueValue() attempt to dequeue front item"
+        << " from empty queue, size:  " << this->size;
+
+    throw QueueEmptyException(out.str());
+  }
+
+  T frontItem = std::move(frontBlock->values[frontOffset]);
+  dequeue();
+  return frontItem;
+}
+
+/**
+ * @brief Dequeue front items into array
+ *
+ * Dequeue up to count items from the front of this Queue, moving them
+ * in order into the given block of values.  The values are moved out a
+ * block at a time.
+ *
+ * @param out The block to move the dequeued items into, must have room
+ *   for count items.
+ * @param count The largest number of items to dequeue.
+ *
+ * @returns int Returns the number of items that were dequeued.
+ */
+template<class T>
+int ULQueue<T>::dequeueInto(T* out, int count)
+{
+  int dequeued = max(0, min(count, this->size));
+  int remaining = dequeued;
+  while (remaining > 0)
+  {
+    int last = (frontBlock == backBlock) ? backOffset : BLOCK_CAPACITY;
+    int moved = min(remaining, last - frontOffset);
+    T* first = frontBlock->values + frontOffset;
+    out = std::move(first, first + moved, out);
+
+    frontOffset += moved;
+    frontPosition += moved;
+    this->size -= moved;
+    QUEUE_COUNT(dequeues, moved);
+    remaining -= moved;
+
+    if ((frontOffset == BLOCK_CAPACITY) or this->isEmpty())
+    {
+      releaseFrontBlock();
+    }
+  }
+
+  return dequeued;
+}
+
+/**
+ * @brief Allocate a block
+ *
+ * Private member method to get an unlinked block to fill with values,
+ * the spare block if there is one, or else a newly allocated block.
+ *
+ * @returns Block* Returns the block, with no next block.
+ */
+template<class T>
+typename ULQueue<T>::Block* ULQueue<T>::allocateBlock()
+{
+  Block* block = spareBlock;
+  if (block == nullptr)
+  {
+    block = new Block;
+  }
+  else
+  {
+    spareBlock = nullptr;
+  }
+
+  block->next = nullptr;
+  return block;
+}
+
+/**
+ * @brief Release a block
+ *
+ * Private member method to give back a block that is no longer linked
+ * into the list.  The block is kept as the spare block if there is not
+ * already one, and is otherwise deleted.
+ *
+ * @param block The block to give back.
+ */
+template<class T>
+void ULQueue<T>::releaseBlock(Block* block)
+{
+  if (cursorBlock == block)
+  {
+    cursorBlock = nullptr;
+  }
+
+  if (spareBlock == nullptr)
+  {
+    spareBlock = block;
+  }
+  else
+  {
+    delete block;
+  }
+}
+
+/**
+ * @brief Append a block
+ *
+ * Private member method to link a new empty block onto the back of the
+ * list, when the back block is full or the queue has no blocks.
+ */
+template<class T>
+void ULQueue<T>::appendBlock()
+{
+  Block* block = allocateBlock();
+  if (backBlock == nullptr)
+  {
+    frontBlock = block;
+    frontOffset = 0;
+  }
+  else
+  {
+    backBlock->next = block;
+  }
+
+  backBlock = block;
+  backOffset = 0;
+}
+
+/**
+ * @brief Release the front block
+ *
+ * Private member method to unlink the front block once all of its
+ * values have been dequeued.  If it was the only block the queue is
+ * now empty and has no blocks left.
+ */
+template<class T>
+void ULQueue<T>::releaseFrontBlock()
+{
+  Block* blockToRelease = frontBlock;
+  frontBlock = frontBlock->next;
+  frontOffset = 0;
+  if (frontBlock == nullptr)
+  {
+    backBlock = nullptr;
+    backOffset = 0;
+  }
+
+  releaseBlock(blockToRelease);
+}
+
+/**
+ * @brief Make iterator past back of queue
+ *
+ * Private member method to build an iterator just past the back item.
+ * If the back block is full, stepping past its last value follows its
+ * nullptr link, so the end iterator is nullptr as well.
+ *
+ * @returns Iterator Returns the iterator or const_iterator just past the
+ *   back item.
+ */
+template<class T>
+template<class Iterator>
+Iterator ULQueue<T>::makeEnd() const
+{
+  if ((backBlock == nullptr) or (backOffset == BLOCK_CAPACITY))
+  {
+    return Iterator();
+  }
+  return Iterator(backBlock, backBlock->values + backOffset);
+}
+
+/**
+ * @brief Cause specific instance compilations
+ *
+ * This is a bit of a kludge, but we can use normal make dependencies
+ * and separate compilation by declaring template class Queue<needed_type>
+ * here of any types we are going to be instantianting with the
+ * template.
+ *
+ * https://isocpp.org/wiki/faq/templates#templates-defn-vs-decl
+ * https://isocpp.org/wiki/faq/templates#separate-template-class-defn-from-decl
+ */
+template class ULQueue<int>;
+template class ULQueue<string>;
+template class ULQueue<Job>;
@@ -0,0 +1,2021 @@
+/** @file bench.cpp
+ * @brief Benchmark executable for Assignment Queues, compares the
+ *   performance of the different Queue implementations.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Timing benchmarks of the queue implementations.  Each suite of
+ * benchmarks is selected by name on the command line, and the
+ * largest problem size to run can be given to keep runs short:
+ *
+ *   $ make bench
+ *   $ ./bench                 # run all suites at full size
+ *   $ ./bench heap 100000     # run only the heap suite, up to 100000 items
+ */
+#include "AHeapPriorityQueue.hpp"
+#include "APriorityQueue.hpp"
+#include "AQueue.hpp"
+#include "CalendarQueue.hpp"
+#include "ConcurrentPriorityQueue.hpp"
+#include "Job.hpp"
+#include "JobPriorityQueue.hpp"
+#include "JobSchedulerSimulator.hpp"
+#include "LatencyHistogram.hpp"
+#include "LatencyQueue.hpp"
+#include "LPriorityQueue.hpp"
+#include "LQueue.hpp"
+#include "MPMCQueue.hpp"
+#include "Node.hpp"
+#include "NodePool.hpp"
+#include "QueueSimd.hpp"
+#include "SPSCQueue.hpp"
+#include "ULQueue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <fstream>
+#include <iostream>
+#include <linux/perf_event.h>
+#include <malloc.h>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Elapsed time
+ *
+ * Compute the time in seconds that has elapsed since the given start
+ * time point.
+ *
+ * @param start The time point when the timed operation began.
+ *
+ * @returns double The number of seconds elapsed since start.
+ */
+static double secondsSince(chrono::steady_clock::time_point start)
+{
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+/// @brief true while the memory benchmarks are counting the bytes
+///   allocated with global new
+static atomic<bool> countingAllocations(false);
+
+/// @brief the bytes allocated with global new and not yet deleted since
+///   counting started
+static atomic<long> bytesInUse(0);
+
+/// @brief the most bytes in use at once since counting started
+static atomic<long> peakBytesInUse(0);
+
+/**
+ * @brief Counting global new
+ *
+ * Replace the global operator new, so that the memory benchmarks can
+ * measure the peak memory an operation allocates.  Blocks come from
+ * malloc(), whose usable size of the block is counted while counting
+ * is turned on.  The array forms of new and delete use these as well.
+ *
+ * @param size The number of bytes asked for.
+ *
+ * @returns void* Returns the allocated block.
+ */
+void* operator new(size_t size)
+{
+  void* block = malloc(size == 0 ? 1 : size);
+  if (block == nullptr)
+  {
+    throw bad_alloc();
+  }
+
+  if (countingAllocations.load(memory_order_relaxed))
+  {
+    long inUse = bytesInUse.fetch_add(malloc_usable_size(block), memory_order_relaxed) + malloc_usable_size(block);
+    long peak = peakBytesInUse.load(memory_order_relaxed);
+    while ((inUse > peak) and not peakBytesInUse.compare_exchange_weak(peak, inUse, memory_order_relaxed))
+    {
+    }
+  }
+  return block;
+}
+
+/**
+ * @brief Counting global delete
+ *
+ * Replace the global operator delete to match the counting global new.
+ *
+ * @param block The block to free, may be nullptr.
+ */
+void operator delete(void* block) noexcept
+{
+  if ((block != nullptr) and countingAllocations.load(memory_order_relaxed))
+  {
+    bytesInUse.fetch_sub(malloc_usable_size(block), memory_order_relaxed);
+  }
+  free(block);
+}
+
+/**
+ * @brief Counting sized global delete
+ *
+ * The sized form of delete, which the counting delete can ignore the
+ * size of.
+ *
+ * @param block The block to free, may be nullptr.
+ */
+void operator delete(void* block, size_t) noexcept
+{
+  operator delete(block);
+}
+
+/**
+ * @brief Start counting allocations
+ *
+ * Start counting the bytes allocated with global new from zero.
+ */
+static void startCountingAllocations()
+{
+  bytesInUse = 0;
+  peakBytesInUse = 0;
+  countingAllocations = true;
+}
+
+/**
+ * @brief Stop counting allocations
+ *
+ * Stop counting the bytes allocated with global new.
+ *
+ * @returns long Returns the most bytes that were in use at once while
+ *   counting.
+ */
+static long stopCountingAllocations()
+{
+  countingAllocations = false;
+  return peakBytesInUse;
+}
+
+/**
+ * @brief Display a benchmark result
+ *
+ * Display one row of a benchmark results table, the total time of the
+ * operations and the average time per operation.
+ *
+ * @param name The name of the queue or operation that was timed.
+ * @param count The number of items / operations that were timed.
+ * @param seconds The total time the operations took.
+ */
+static void report(const string& name, long count, double seconds)
+{
+  cout << "  " << left << setw(40) << name << right << setw(12) << count << setw(12) << fixed << setprecision(2) << seconds * 1000.0
+       << " ms" << setw(12) << setprecision(1) << seconds * 1.0e9 / count << " ns/op" << endl;
+}
+
+/**
+ * @brief Random priorities
+ *
+ * Generate a repeatable sequence of random integer priorities to
+ * enqueue into the priority queues being timed.
+ *
+ * @param count The number of values to generate.
+ *
+ * @returns vector<int> The generated priorities.
+ */
+static vector<int> randomPriorities(long count)
+{
+  mt19937 generator(42);
+  uniform_int_distribution<int> priority(0, 1000000);
+
+  vector<int> values(count);
+  for (long index = 0; index < count; index++)
+  {
+    values[index] = priority(generator);
+  }
+  return values;
+}
+
+/**
+ * @brief Time priority queue enqueue and dequeue
+ *
+ * Enqueue all of the values into the given priority queue, then
+ * dequeue them all again, reporting the time of both phases.
+ *
+ * @param name The name of the queue implementation being timed.
+ * @param queue The (empty) priority queue to time.
+ * @param values The values to enqueue.
+ */
+template<class PriorityQueue>
+static void timePriorityQueue(const string& name, PriorityQueue& queue, const vector<int>& values)
+{
+  long count = values.size();
+
+  auto start = chrono::steady_clock::now();
+  for (long index = 0; index < count; index++)
+  {
+    queue.enqueue(values[index]);
+  }
+  report(name + " enqueue", count, secondsSince(start));
+
+  start = chrono::steady_clock::now();
+  long checksum = 0;
+  while (not queue.isEmpty())
+  {
+    checksum += queue.front();
+    queue.dequeue();
+  }
+  report(name + " front+dequeue", count, secondsSince(start));
+
+  // use the checksum so the dequeue loop can not be optimized away
+  if (checksum == -1)
+  {
+    cout << checksum << endl;
+  }
+}
+
+/**
+ * @brief Benchmark binary heap against sorted insertion
+ *
+ * Compare the APriorityQueue, which shifts each new item into sorted
+ * position in its circular buffer, with the AHeapPriorityQueue binary
+ * heap, and with the LPriorityQueue, whose sorted linked list is
+ * indexed by a skip list.  Sorted insertion into the array is O(n^2) to
+ * fill the queue, so it is only run up to a size that finishes in a
+ * reasonable amount of time.
+ *
+ * @param maxSize The largest number of items to enqueue.
+ */
+static void benchPriorityQueues(long maxSize)
+{
+  const long SIZES[] = {1000, 100000, 10000000};
+  const long MAX_INSERTION_SIZE = 100000;
+
+  cout << "priority queue: sorted insertion vs binary heap, random int priorities" << endl;
+  for (long count : SIZES)
+  {
+    if (count > maxSize)
+    {
+      continue;
+    }
+    vector<int> values = randomPriorities(count);
+
+    if (count <= MAX_INSERTION_SIZE)
+    {
+      APriorityQueue<int> sorted;
+      timePriorityQueue("APriorityQueue<int>", sorted, values);
+    }
+    else
+    {
+      cout << "  " << left << setw(40) << "APriorityQueue<int>" << right << setw(12) << count << "  skipped, O(n^2) enqueue" << endl;
+    }
+
+    AHeapPriorityQueue<int> heap;
+    timePriorityQueue("AHeapPriorityQueue<int>", heap, values);
+
+    LPriorityQueue<int> linked;
+    timePriorityQueue("LPriorityQueue<int>", linked, values);
+  }
+  cout << endl;
+}
+
+/**
+ * @brief Node churn through global new and delete
+ *
+ * Repeat the enqueue/dequeue churn of timeNodePoolChurn(), but
+ * allocating every node with new and freeing it with delete, the way
+ * the linked list queues did before they used a NodePool.
+ *
+ * @param queueLength The number of items kept on the queue.
+ * @param operations The number of dequeue/enqueue pairs to perform.
+ * @param value The value to enqueue.
+ *
+ * @returns double The number of seconds the churn took.
+ */
+template<class T>
+static double timeGlobalNewChurn(long queueLength, long operations, const T& value)
+{
+  Node<T>* frontNode = nullptr;
+  Node<T>* backNode = nullptr;
+  auto enqueue = [&](const T& newValue) {
+    Node<T>* newNode = new Node<T>;
+    newNode->value = newValue;
+    newNode->next = nullptr;
+    if (frontNode == nullptr)
+    {
+      frontNode = newNode;
+    }
+    else
+    {
+      backNode->next = newNode;
+    }
+    backNode = newNode;
+  };
+
+  for (long index = 0; index < queueLength; index++)
+  {
+    enqueue(value);
+  }
+
+  auto start = chrono::steady_clock::now();
+  for (long index = 0; index < operations; index++)
+  {
+    Node<T>* nodeToDelete = frontNode;
+    frontNode = frontNode->next;
+    delete nodeToDelete;
+    enqueue(value);
+  }
+  double seconds = secondsSince(start);
+
+  while (frontNode != nullptr)
+  {
+    Node<T>* nodeToDelete = frontNode;
+    frontNode = frontNode->next;
+    delete nodeToDelete;
+  }
+  return seconds;
+}
+
+/**
+ * @brief Node churn through a NodePool
+ *
+ * Keep a queue at a steady length, dequeuing one item and enqueuing
+ * another, the producer/consumer pattern where every operation used to
+ * go to the heap.
+ *
+ * @param queue The (empty) linked list queue to churn.
+ * @param queueLength The number of items kept on the queue.
+ * @param operations The number of dequeue/enqueue pairs to perform.
+ * @param value The value to enqueue.
+ *
+ * @returns double The number of seconds the churn took.
+ */
+template<class T>
+static double timeNodePoolChurn(LQueue<T>& queue, long queueLength, long operations, const T& value)
+{
+  for (long index = 0; index < queueLength; index++)
+  {
+    queue.enqueue(value);
+  }
+
+  auto start = chrono::steady_clock::now();
+  for (long index = 0; index < operations; index++)
+  {
+    queue.dequeue();
+    queue.enqueue(value);
+  }
+  return secondsSince(start);
+}
+
+/**
+ * @brief Benchmark pooled node allocation
+ *
+ * Compare steady state enqueue/dequeue churn on the linked list queue
+ * when nodes come from a NodePool against allocating every node with
+ * global new and delete.  A second pass interleaves two queues that
+ * share one pool.
+ *
+ * @param maxSize The largest number of operations to perform.
+ */
+static void benchNodePool(long maxSize)
+{
+  const long QUEUE_LENGTHS[] = {16, 100000};
+  long operations = min(maxSize, 10000000L);
+  string payload = "a job payload long enough to need its own heap block";
+
+  cout << "node pool: steady state dequeue+enqueue churn, " << operations << " operations" << endl;
+  for (long queueLength : QUEUE_LENGTHS)
+  {
+    cout << " queue length " << queueLength << endl;
+    report("global new Node<int>", operations, timeGlobalNewChurn(queueLength, operations, 42));
+    {
+      LQueue<int> queue;
+      report("NodePool LQueue<int>", operations, timeNodePoolChurn(queue, queueLength, operations, 42));
+    }
+    report("global new Node<string>", operations, timeGlobalNewChurn(queueLength, operations, payload));
+    {
+      LQueue<string> queue;
+      report("NodePool LQueue<string>", operations, timeNodePoolChurn(queue, queueLength, operations, payload));
+    }
+  }
+
+  // two queues sharing a pool, values move from one to the other
+  NodePool<int> pool;
+  LQueue<int> producer(pool);
+  LQueue<int> consumer(pool);
+  auto start = chrono::steady_clock::now();
+  for (long index = 0; index < operations; index++)
+  {
+    producer.enqueue(index);
+    if (producer.getSize() > 1000)
+    {
+      consumer.enqueue(producer.front());
+      producer.dequeue();
+      consumer.dequeue();
+    }
+  }
+  report("shared NodePool producer->consumer", operations, secondsSince(start));
+  cout << "  shared pool chunks allocated: " << pool.getChunksAllocated() << " nodes recycled: " << pool.getNodesRecycled() << endl;
+  cout << endl;
+}
+
+/**
+ * @brief Time circular buffer index wrapping
+ *
+ * Time steady state dequeue+enqueue churn, which wraps the front and
+ * back index around the circular buffer, and then sweeps of indexed
+ * access over the whole queue with operator[].
+ *
+ * @param name The name of the capacity policy being timed.
+ * @param capacityPolicy The capacity policy of the queue to time.
+ * @param queueLength The number of items kept on the queue.
+ * @param operations The number of operations of each kind to time.
+ */
+static void timeCapacityPolicy(const string& name, CapacityPolicy capacityPolicy, long queueLength, long operations)
+{
+  AQueue<int> queue(capacityPolicy);
+  for (long index = 0; index < queueLength; index++)
+  {
+    queue.enqueue(index);
+  }
+
+  auto start = chrono::steady_clock::now();
+  for (long index = 0; index < operations; index++)
+  {
+    queue.dequeue();
+    queue.enqueue(index);
+  }
+  report(name + " dequeue+enqueue", operations, secondsSince(start));
+
+  start = chrono::steady_clock::now();
+  long checksum = 0;
+  long accesses = 0;
+  while (accesses < operations)
+  {
+    for (int index = 0; index < queueLength; index++)
+    {
+      checksum += queue[index];
+    }
+    accesses += queueLength;
+  }
+  report(name + " operator[]", accesses, secondsSince(start));
+
+  // use the checksum so the indexing loop can not be optimized away
+  if (checksum == -1)
+  {
+    cout << checksum << endl;
+  }
+}
+
+/**
+ * @brief Benchmark power of two capacity
+ *
+ * Compare an AQueue that wraps its indexes with modulo against one
+ * whose allocation is kept to a power of two so that indexes are
+ * wrapped with a bit mask.
+ *
+ * @param maxSize The largest number of operations to perform.
+ */
+static void benchCapacityPolicy(long maxSize)
+{
+  const long QUEUE_LENGTHS[] = {1000, 1000000};
+  long operations = min(maxSize, 50000000L);
+
+  cout << "AQueue<int> index wrapping: modulo vs power of two mask, " << operations << " operations" << endl;
+  for (long queueLength : QUEUE_LENGTHS)
+  {
+    cout << " queue length " << queueLength << endl;
+    timeCapacityPolicy("DOUBLING_CAPACITY", DOUBLING_CAPACITY, queueLength, operations);
+    timeCapacityPolicy("POWER_OF_TWO_CAPACITY", POWER_OF_TWO_CAPACITY, queueLength, operations);
+  }
+  cout << endl;
+}
+
+/**
+ * @brief Time a producer and consumer thread
+ *
+ * Pass the given number of messages from a producer thread to a
+ * consumer thread through the given enqueue and dequeue functions.
+ * The consumer checks that the messages arrive in order.
+ *
+ * @param name The name of the queue being timed.
+ * @param messages The number of messages to pass between the threads.
+ * @param enqueue Called by the producer to send one message.
+ * @param tryDequeue Called by the consumer to receive one message,
+ *   returns false when no message was waiting.
+ */
+template<class Enqueue, class TryDequeue>
+static void timeProducerConsumer(const string& name, long messages, Enqueue enqueue, TryDequeue tryDequeue)
+{
+  bool inOrder = true;
+  auto start = chrono::steady_clock::now();
+
+  thread consumer([&]() {
+    int message;
+    for (long expected = 0; expected < messages; expected++)
+    {
+      while (not tryDequeue(message))
+      {
+        this_thread::yield();
+      }
+      inOrder = inOrder and (message == static_cast<int>(expected));
+    }
+  });
+
+  for (long index = 0; index < messages; index++)
+  {
+    enqueue(static_cast<int>(index));
+  }
+  consumer.join();
+
+  double seconds = secondsSince(start);
+  report(name, messages, seconds);
+  cout << "  " << fixed << setprecision(1) << messages / seconds / 1.0e6 << " million msgs/sec" << (inOrder ? "" : " OUT OF ORDER") << endl;
+}
+
+/**
+ * @brief Benchmark single producer single consumer queues
+ *
+ * Compare passing messages between two threads through the lock-free
+ * SPSCQueue against an AQueue guarded by a mutex.
+ *
+ * @param maxSize The largest number of messages to pass.
+ */
+static void benchSPSCQueue(long maxSize)
+{
+  long messages = min(maxSize, 10000000L);
+  int capacity = SPSCQueue<int>::DEFAULT_CAPACITY;
+
+  cout << "producer -> consumer threads, " << messages << " messages, capacity " << capacity << endl;
+
+  SPSCQueue<int> spscQueue(capacity);
+  timeProducerConsumer(
+    "SPSCQueue", messages,
+    [&](int message) {
+      spscQueue.enqueue(message);
+    },
+    [&](int& message) {
+      return spscQueue.tryDequeue(message);
+    });
+
+  // the locked queue is bounded to the same capacity so the producer
+  // can not simply run ahead and fill memory
+  AQueue<int> lockedQueue;
+  mutex queueMutex;
+  timeProducerConsumer(
+    "mutex + AQueue", messages,
+    [&](int message) {
+      while (true)
+      {
+        {
+          lock_guard<mutex> lock(queueMutex);
+          if (lockedQueue.getSize() < capacity)
+          {
+            lockedQueue.enqueue(message);
+            return;
+          }
+        }
+        this_thread::yield();
+      }
+    },
+    [&](int& message) {
+      lock_guard<mutex> lock(queueMutex);
+      if (lockedQueue.isEmpty())
+      {
+        return false;
+      }
+      message = lockedQueue.dequeueValue();
+      return true;
+    });
+  cout << endl;
+}
+
+/**
+ * @brief Time several producer and consumer threads
+ *
+ * Pass the given number of messages from the producer threads to the
+ * consumer threads through the given enqueue and dequeue functions.
+ * The messages are split evenly among the producers, and the
+ * consumers share out the work of receiving them all.
+ *
+ * @param name The name of the queue being timed.
+ * @param threadCount The number of producer threads, and also the
+ *   number of consumer threads.
+ * @param messages The number of messages to pass between the threads.
+ * @param enqueue Called by a producer to send one message.
+ * @param tryDequeue Called by a consumer to receive one message,
+ *   returns false when no message was waiting.
+ */
+template<class Enqueue, class TryDequeue>
+static void timeThreadScaling(const string& name, int threadCount, long messages, Enqueue enqueue, TryDequeue tryDequeue)
+{
+  long messagesPerProducer = messages / threadCount;
+  atomic<long> remaining(messagesPerProducer * threadCount);
+  auto start = chrono::steady_clock::now();
+
+  vector<thread> threads;
+  for (int producer = 0; producer < threadCount; producer++)
+  {
+    threads.push_back(thread([&]() {
+      for (long index = 0; index < messagesPerProducer; index++)
+      {
+        enqueue(static_cast<int>(index));
+      }
+    }));
+  }
+  for (int consumer = 0; consumer < threadCount; consumer++)
+  {
+    threads.push_back(thread([&]() {
+      int message;
+      while (remaining.fetch_sub(1) > 0)
+      {
+        while (not tryDequeue(message))
+        {
+          this_thread::yield();
+        }
+      }
+    }));
+  }
+  for (thread& worker : threads)
+  {
+    worker.join();
+  }
+
+  double seconds = secondsSince(start);
+  long total = messagesPerProducer * threadCount;
+  report(name + " " + to_string(threadCount) + "P/" + to_string(threadCount) + "C", total, seconds);
+  cout << "  " << fixed << setprecision(1) << total / seconds / 1.0e6 << " million msgs/sec" << endl;
+}
+
+/**
+ * @brief Benchmark multi producer multi consumer queues
+ *
+ * Compare how the lock-free MPMCQueue and an AQueue guarded by a mutex
+ * scale as the number of producer and consumer threads doubles, from
+ * 1 of each up to the number of hardware threads of this machine.
+ *
+ * @param maxSize The largest number of messages to pass.
+ */
+static void benchMPMCQueue(long maxSize)
+{
+  long messages = min(maxSize, 4000000L);
+  int capacity = MPMCQueue<int>::DEFAULT_CAPACITY;
+  int maxThreads = max(2, static_cast<int>(thread::hardware_concurrency()));
+
+  cout << "producers -> consumers threads, " << messages << " messages, capacity " << capacity << ", " << thread::hardware_concurrency()
+       << " hardware threads" << endl;
+  for (int threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+  {
+    MPMCQueue<int> mpmcQueue(capacity);
+    timeThreadScaling(
+      "MPMCQueue", threadCount, messages,
+      [&](int message) {
+        mpmcQueue.enqueue(message);
+      },
+      [&](int& message) {
+        return mpmcQueue.tryDequeue(message);
+      });
+
+    AQueue<int> lockedQueue;
+    mutex queueMutex;
+    timeThreadScaling(
+      "mutex + AQueue", threadCount, messages,
+      [&](int message) {
+        while (true)
+        {
+          {
+            lock_guard<mutex> lock(queueMutex);
+            if (lockedQueue.getSize() < capacity)
+            {
+              lockedQueue.enqueue(message);
+              return;
+            }
+          }
+          this_thread::yield();
+        }
+      },
+      [&](int& message) {
+        lock_guard<mutex> lock(queueMutex);
+        if (lockedQueue.isEmpty())
+        {
+          return false;
+        }
+        message = lockedQueue.dequeueValue();
+        return true;
+      });
+  }
+  cout << endl;
+}
+
+/** @brief an APriorityQueue guarded by a single mutex, with the same
+ *    tryDequeue() interface as the ConcurrentPriorityQueue
+ */
+struct LockedPriorityQueue
+{
+  /// @brief the lock that must be held to use the queue
+  mutex lock;
+
+  /// @brief the items in priority order
+  APriorityQueue<Job> queue;
+
+  /// @brief enqueue an item while holding the lock
+  void enqueue(Job&& job)
+  {
+    lock_guard<mutex> guard(lock);
+    queue.enqueue(std::move(job));
+  }
+
+  /// @brief dequeue the highest priority item while holding the lock,
+  ///   returns false if the queue was empty
+  bool tryDequeue(Job& job)
+  {
+    lock_guard<mutex> guard(lock);
+    if (queue.isEmpty())
+    {
+      return false;
+    }
+    job = queue.dequeueValue();
+    return true;
+  }
+};
+
+/**
+ * @brief Time concurrent priority queue workers
+ *
+ * Fill the queue with jobs of random priority, then time worker
+ * threads that each alternate enqueuing a new job and dequeuing the
+ * best job they can, the steady state of a pool of schedulers.
+ *
+ * @param name The name of the queue configuration being timed.
+ * @param queue The (empty) priority queue to time.
+ * @param threadCount The number of worker threads.
+ * @param queueLength The number of jobs kept on the queue.
+ * @param operations The total number of enqueue+dequeue pairs.
+ */
+template<class PriorityQueue>
+static void timeConcurrentWorkers(const string& name, PriorityQueue& queue, int threadCount, long queueLength, long operations)
+{
+  vector<int> priorities = randomPriorities(queueLength + operations);
+  for (long index = 0; index < queueLength; index++)
+  {
+    queue.enqueue(Job(priorities[index], 0, 0, index));
+  }
+
+  // jobs to dequeue into are made here, default Job construction is
+  // not safe from several threads at once
+  vector<Job> received(threadCount);
+  long operationsPerThread = operations / threadCount;
+  auto start = chrono::steady_clock::now();
+
+  vector<thread> workers;
+  for (int worker = 0; worker < threadCount; worker++)
+  {
+    workers.push_back(thread([&, worker]() {
+      long first = queueLength + worker * operationsPerThread;
+      for (long index = first; index < first + operationsPerThread; index++)
+      {
+        queue.enqueue(Job(priorities[index], 0, 0, index));
+        queue.tryDequeue(received[worker]);
+      }
+    }));
+  }
+  for (thread& worker : workers)
+  {
+    worker.join();
+  }
+
+  report(name + " enqueue+dequeue", operationsPerThread * threadCount, secondsSince(start));
+}
+
+/**
+ * @brief Measure priority inversions
+ *
+ * Fill the queue with jobs of random priority, then have worker
+ * threads dequeue all of them.  A strict priority queue gives every
+ * thread its jobs in order of decreasing priority, so each time a
+ * thread dequeues a job of higher priority than its last one, a
+ * higher priority job was passed over, a priority inversion.
+ *
+ * @param name The name of the queue configuration being measured.
+ * @param queue The (empty) priority queue to measure.
+ * @param threadCount The number of worker threads.
+ * @param queueLength The number of jobs to fill the queue with.
+ */
+template<class PriorityQueue>
+static void measureInversions(const string& name, PriorityQueue& queue, int threadCount, long queueLength)
+{
+  vector<int> priorities = randomPriorities(queueLength);
+  for (long index = 0; index < queueLength; index++)
+  {
+    queue.enqueue(Job(priorities[index], 0, 0, index));
+  }
+
+  vector<Job> received(threadCount);
+  vector<long> dequeues(threadCount, 0);
+  vector<long> inversions(threadCount, 0);
+
+  vector<thread> workers;
+  for (int worker = 0; worker < threadCount; worker++)
+  {
+    workers.push_back(thread([&, worker]() {
+      int lastPriority = INT32_MAX;
+      while (queue.tryDequeue(received[worker]))
+      {
+        if (received[worker].getPriority() > lastPriority)
+        {
+          inversions[worker]++;
+        }
+        lastPriority = received[worker].getPriority();
+        dequeues[worker]++;
+      }
+    }));
+  }
+  for (thread& worker : workers)
+  {
+    worker.join();
+  }
+
+  long totalDequeues = 0;
+  long totalInversions = 0;
+  for (int worker = 0; worker < threadCount; worker++)
+  {
+    totalDequeues += dequeues[worker];
+    totalInversions += inversions[worker];
+  }
+  cout << "  " << left << setw(40) << (name + " inversions") << right << setw(12) << totalInversions << setw(11) << fixed << setprecision(2)
+       << 100.0 * totalInversions / totalDequeues << "%" << endl;
+}
+
+/**
+ * @brief Benchmark concurrent priority queues
+ *
+ * Compare the throughput and priority inversion rate of the sharded
+ * ConcurrentPriorityQueue, over a range of sample counts, against an
+ * APriorityQueue guarded by a single mutex, as the number of worker
+ * threads doubles.  The sorted insertion of the APriorityQueue is
+ * O(n), so the queue lengths are kept moderate.
+ *
+ * @param maxSize The largest number of operations to perform.
+ */
+static void benchConcurrentPriorityQueue(long maxSize)
+{
+  const int SAMPLE_COUNTS[] = {1, 2, 4, ConcurrentPriorityQueue<Job>::DEFAULT_SHARD_COUNT};
+  long queueLength = min(maxSize, 10000L);
+  long operations = min(maxSize, 50000L);
+  int maxThreads = max(4, static_cast<int>(thread::hardware_concurrency()));
+
+  cout << "concurrent priority queue workers, queue length " << queueLength << ", " << operations << " operations, " << thread::hardware_concurrency()
+       << " hardware threads" << endl;
+  for (int threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+  {
+    cout << " " << threadCount << " worker threads" << endl;
+    for (int sampleCount : SAMPLE_COUNTS)
+    {
+      string name = "sharded sample " + to_string(sampleCount);
+      ConcurrentPriorityQueue<Job> timedQueue(ConcurrentPriorityQueue<Job>::DEFAULT_SHARD_COUNT, sampleCount);
+      timeConcurrentWorkers(name, timedQueue, threadCount, queueLength, operations);
+      ConcurrentPriorityQueue<Job> measuredQueue(ConcurrentPriorityQueue<Job>::DEFAULT_SHARD_COUNT, sampleCount);
+      measureInversions(name, measuredQueue, threadCount, queueLength);
+    }
+
+    LockedPriorityQueue timedQueue;
+    timeConcurrentWorkers("mutex + APriorityQueue", timedQueue, threadCount, queueLength, operations);
+    LockedPriorityQueue measuredQueue;
+    measureInversions("mutex + APriorityQueue", measuredQueue, threadCount, queueLength);
+  }
+  cout << endl;
+}
+
+/**
+ * @brief Time single and batch enqueue and dequeue
+ *
+ * Fill the given queue with all of the values and then empty it
+ * again, first one value at a time, and then in batches of the given
+ * size, reporting the time of each.
+ *
+ * @param name The name of the queue implementation being timed.
+ * @param queue The (empty) queue to time.
+ * @param values The values to enqueue.
+ * @param batchSize The number of values in each batch.
+ */
+template<class T>
+static void timeBatches(const string& name, Queue<T>& queue, const vector<T>& values, int batchSize)
+{
+  long count = values.size();
+  vector<T> out(batchSize);
+
+  auto start = chrono::steady_clock::now();
+  for (long index = 0; index < count; index++)
+  {
+    queue.enqueue(values[index]);
+  }
+  while (not queue.isEmpty())
+  {
+    out[0] = queue.dequeueValue();
+  }
+  report(name + " single", count, secondsSince(start));
+
+  // start the batches from an empty allocation as well
+  queue.clear();
+  start = chrono::steady_clock::now();
+  for (long index = 0; index < count; index += batchSize)
+  {
+    queue.enqueueArray(values.data() + index, min(static_cast<long>(batchSize), count - index));
+  }
+  while (queue.dequeueInto(out.data(), batchSize) > 0)
+  {
+  }
+  report(name + " batch " + to_string(batchSize), count, secondsSince(start));
+}
+
+/**
+ * @brief Benchmark batch enqueue and dequeue
+ *
+ * Compare enqueuing and dequeuing one value at a time against the
+ * enqueueArray() and dequeueInto() batch methods for each of the
+ * queue implementations that specialize them.
+ *
+ * @param maxSize The largest number of items to enqueue.
+ */
+static void benchBatches(long maxSize)
+{
+  const int BATCH_SIZE = 64;
+  long count = min(maxSize, 10000000L);
+  vector<int> values = randomPriorities(count);
+
+  cout << "single vs batch enqueue+dequeue, " << count << " items" << endl;
+  AQueue<int> arrayQueue;
+  timeBatches("AQueue<int>", arrayQueue, values, BATCH_SIZE);
+  LQueue<int> linkedQueue;
+  timeBatches("LQueue<int>", linkedQueue, values, BATCH_SIZE);
+  ULQueue<int> unrolledQueue;
+  timeBatches("ULQueue<int>", unrolledQueue, values, BATCH_SIZE);
+  AHeapPriorityQueue<int> heap;
+  timeBatches("AHeapPriorityQueue<int>", heap, values, BATCH_SIZE);
+
+  // sorted insertion is O(n) per item, so keep the priority queues short
+  vector<int> shortValues = randomPriorities(min(count, 20000L));
+  APriorityQueue<int> sortedQueue;
+  timeBatches("APriorityQueue<int>", sortedQueue, shortValues, BATCH_SIZE);
+  LPriorityQueue<int> linkedSortedQueue;
+  timeBatches("LPriorityQueue<int>", linkedSortedQueue, shortValues, BATCH_SIZE);
+  cout << endl;
+}
+
+/**
+ * @brief Time linked queue storage
+ *
+ * Time steady state dequeue+enqueue churn, a sweep of indexed access
+ * over the whole queue, and copying and comparing the queue.
+ *
+ * @param name The name of the queue being timed.
+ * @param queueLength The number of items kept on the queue.
+ * @param operations The number of churn operations to time.
+ */
+template<class LinkedQueue>
+static void timeLinkedStorage(const string& name, long queueLength, long operations)
+{
+  LinkedQueue queue;
+  for (long index = 0; index < queueLength; index++)
+  {
+    queue.enqueue(index);
+  }
+
+  auto start = chrono::steady_clock::now();
+  for (long index = 0; index < operations; index++)
+  {
+    queue.dequeue();
+    queue.enqueue(index);
+  }
+  report(name + " churn", operations, secondsSince(start));
+
+  // indexing the linked list is linear, so only sweep a short prefix of it
+  long sweepLength = min(queueLength, 10000L);
+  long sum = 0;
+  start = chrono::steady_clock::now();
+  for (long index = 0; index < sweepLength; index++)
+  {
+    sum += queue[index];
+  }
+  report(name + " index sweep", sweepLength, secondsSince(start));
+
+  start = chrono::steady_clock::now();
+  LinkedQueue copy = queue;
+  bool equal = (copy == queue);
+  report(name + " copy+compare", queueLength, secondsSince(start));
+  if (not equal or (sum < 0))
+  {
+    cout << "  copy does not match" << endl;
+  }
+}
+
+/**
+ * @brief Benchmark unrolled linked list storage
+ *
+ * Compare the linked list queue with a node per value against the
+ * unrolled linked list queue with a block of values per node.
+ *
+ * @param maxSize The largest queue length to use.
+ */
+static void benchUnrolledList(long maxSize)
+{
+  long queueLength = min(maxSize, 1000000L);
+  long operations = min(maxSize, 10000000L);
+
+  cout << "linked vs unrolled linked list storage, queue length " << queueLength << endl;
+  timeLinkedStorage<LQueue<int>>("LQueue<int>", queueLength, operations);
+  timeLinkedStorage<ULQueue<int>>("ULQueue<int>", queueLength, operations);
+  cout << endl;
+}
+
+/**
+ * @brief Time a traversal
+ *
+ * Time summing every value of the queue, first by indexing the queue
+ * and then with a range based for loop over its iterators.  Indexing a
+ * linked list is linear time, so only a short prefix of it is indexed.
+ *
+ * @param name The name of the queue being timed.
+ * @param queue The queue to traverse.
+ * @param indexLength The number of values to index.
+ */
+template<class IterableQueue>
+static void timeTraversal(const string& name, IterableQueue& queue, long indexLength)
+{
+  long sum = 0;
+  auto start = chrono::steady_clock::now();
+  for (long index = 0; index < indexLength; index++)
+  {
+    sum += queue[index];
+  }
+  report(name + " operator[]", indexLength, secondsSince(start));
+
+  start = chrono::steady_clock::now();
+  for (int value : queue)
+  {
+    sum += value;
+  }
+  report(name + " iterator", queue.getSize(), secondsSince(start));
+  if (sum == 42)
+  {
+    cout << "  unlikely sum" << endl;
+  }
+}
+
+/**
+ * @brief Benchmark traversals
+ *
+ * Compare walking a queue by index against walking it with iterators,
+ * with the values of the array based queue wrapped around the end of
+ * its circular buffer.
+ *
+ * @param maxSize The largest queue length to use.
+ */
+static void benchTraversal(long maxSize)
+{
+  long queueLength = min(maxSize, 10000000L);
+
+  cout << "index vs iterator traversal, queue length " << queueLength << endl;
+  AQueue<int> arrayQueue;
+  LQueue<int> linkedQueue;
+  ULQueue<int> unrolledQueue;
+  for (long index = 0; index < queueLength; index++)
+  {
+    arrayQueue.enqueue(index);
+    linkedQueue.enqueue(index);
+    unrolledQueue.enqueue(index);
+  }
+  for (long index = 0; index < queueLength / 2; index++)
+  {
+    arrayQueue.dequeue();
+    arrayQueue.enqueue(index);
+  }
+  timeTraversal("AQueue<int>", arrayQueue, queueLength);
+  timeTraversal("LQueue<int>", linkedQueue, min(queueLength, 10000L));
+  timeTraversal("ULQueue<int>", unrolledQueue, queueLength);
+  cout << endl;
+}
+
+/**
+ * @brief Time queue equality
+ *
+ * Time comparing two queues that hold the same values, which has to
+ * look at every value.
+ *
+ * @param name The name of the pair of queues being compared.
+ * @param lhs The queue on the left hand side of the comparison.
+ * @param rhs The queue on the right hand side of the comparison.
+ */
+static void timeEquality(const string& name, const Queue<int>& lhs, const Queue<int>& rhs)
+{
+  auto start = chrono::steady_clock::now();
+  bool equal = (lhs == rhs);
+  report(name, lhs.getSize(), secondsSince(start));
+  if (not equal)
+  {
+    cout << "  queues are not equal" << endl;
+  }
+}
+
+/**
+ * @brief Benchmark equality across queue implementations
+ *
+ * Compare queues of the same and of different implementations, each
+ * walking its own values while visiting the segments of the other.
+ * Comparing by indexing the right hand side, as operator== used to,
+ * is timed on a short linked queue for reference, since it is
+ * quadratic time.
+ *
+ * @param maxSize The largest queue length to use.
+ */
+static void benchEquality(long maxSize)
+{
+  long queueLength = min(maxSize, 1000000L);
+
+  AQueue<int> arrayQueue;
+  AQueue<int> otherArrayQueue;
+  LQueue<int> linkedQueue;
+  LQueue<int> otherLinkedQueue;
+  ULQueue<int> unrolledQueue;
+  for (long index = 0; index < queueLength; index++)
+  {
+    arrayQueue.enqueue(index);
+    otherArrayQueue.enqueue(index);
+    linkedQueue.enqueue(index);
+    otherLinkedQueue.enqueue(index);
+    unrolledQueue.enqueue(index);
+  }
+
+  cout << "operator== across implementations, queue length " << queueLength << endl;
+  timeEquality("AQueue == AQueue", arrayQueue, otherArrayQueue);
+  timeEquality("AQueue == LQueue", arrayQueue, linkedQueue);
+  timeEquality("LQueue == AQueue", linkedQueue, arrayQueue);
+  timeEquality("LQueue == LQueue", linkedQueue, otherLinkedQueue);
+  timeEquality("ULQueue == LQueue", unrolledQueue, linkedQueue);
+  timeEquality("AQueue == ULQueue", arrayQueue, unrolledQueue);
+
+  // the old element by element comparison through rhs[index]
+  long indexedLength = min(queueLength, 10000L);
+  LQueue<int> shortLinkedQueue;
+  for (long index = 0; index < indexedLength; index++)
+  {
+    shortLinkedQueue.enqueue(index);
+  }
+  auto start = chrono::steady_clock::now();
+  bool equal = true;
+  for (long index = 0; index < indexedLength; index++)
+  {
+    equal = equal and (arrayQueue[index] == shortLinkedQueue[index]);
+  }
+  report("AQueue == LQueue by rhs[index]", indexedLength, secondsSince(start));
+  if (not equal)
+  {
+    cout << "  queues are not equal" << endl;
+  }
+  cout << endl;
+}
+
+/**
+ * @brief Time dumping a queue
+ *
+ * Time dumping the queue to the output stream, by building the string
+ * with str() and streaming it, by streaming the queue directly with
+ * the output stream operator, and by writing only its first values,
+ * and report the peak memory allocated by each.
+ *
+ * @param name The name of the queue being dumped.
+ * @param queue The queue to dump.
+ * @param out The output stream to dump the queue to.
+ */
+static void timeDump(const string& name, const Queue<int>& queue, ostream& out)
+{
+  const int TRUNCATED_ELEMENTS = 100;
+
+  startCountingAllocations();
+  auto start = chrono::steady_clock::now();
+  out << queue.str() << endl;
+  double seconds = secondsSince(start);
+  long peakBytes = stopCountingAllocations();
+  report(name + " str()", queue.getSize(), seconds);
+  cout << "    peak allocated: " << peakBytes << " bytes" << endl;
+
+  startCountingAllocations();
+  start = chrono::steady_clock::now();
+  out << queue << endl;
+  seconds = secondsSince(start);
+  peakBytes = stopCountingAllocations();
+  report(name + " operator<<", queue.getSize(), seconds);
+  cout << "    peak allocated: " << peakBytes << " bytes" << endl;
+
+  startCountingAllocations();
+  start = chrono::steady_clock::now();
+  queue.write(out, TRUNCATED_ELEMENTS);
+  out << endl;
+  seconds = secondsSince(start);
+  peakBytes = stopCountingAllocations();
+  report(name + " write() first " + to_string(TRUNCATED_ELEMENTS), TRUNCATED_ELEMENTS, seconds);
+  cout << "    peak allocated: " << peakBytes << " bytes" << endl;
+}
+
+/**
+ * @brief Benchmark dumping queues
+ *
+ * Compare the time and peak memory of dumping large queues to a file
+ * through str() against streaming them directly.
+ *
+ * @param maxSize The largest queue length to use.
+ */
+static void benchDump(long maxSize)
+{
+  long queueLength = min(maxSize, 1000000L);
+
+  AQueue<int> arrayQueue;
+  LQueue<int> linkedQueue;
+  for (long index = 0; index < queueLength; index++)
+  {
+    arrayQueue.enqueue(index);
+    linkedQueue.enqueue(index);
+  }
+
+  ofstream out("/dev/null");
+  cout << "dumping queues to a stream, queue length " << queueLength << endl;
+  timeDump("AQueue<int>", arrayQueue, out);
+  timeDump("LQueue<int>", linkedQueue, out);
+  cout << endl;
+}
+
+/**
+ * @brief Time saving and restoring a queue
+ *
+ * Time saving the jobs of the queue as text, one line of fields for
+ * each job read with the indexing operator, and restoring them by
+ * parsing the lines and enqueuing the jobs one at a time, against
+ * saving and restoring a binary snapshot of the queue.
+ *
+ * @param name The name of the queue being saved.
+ * @param queue The queue of jobs to save and restore.
+ */
+template<class JobQueue>
+static void timeSnapshot(const string& name, JobQueue& queue)
+{
+  long count = queue.getSize();
+
+  stringstream text;
+  auto start = chrono::steady_clock::now();
+  for (int index = 0; index < count; index++)
+  {
+    const Job& job = queue[index];
+    text << job.getId() << ' ' << job.getPriority() << ' ' << job.getServiceTime() << ' ' << job.getStartTime() << ' '
+         << job.getEndTime() << '\n';
+  }
+  report(name + " save text", count, secondsSince(start));
+
+  JobQueue textRestored;
+  start = chrono::steady_clock::now();
+  int id, priority, serviceTime, startTime, endTime;
+  while (text >> id >> priority >> serviceTime >> startTime >> endTime)
+  {
+    Job job(priority, serviceTime, startTime, id);
+    job.setEndTime(endTime);
+    textRestored.enqueue(job);
+  }
+  report(name + " restore text", count, secondsSince(start));
+
+  stringstream snapshot;
+  start = chrono::steady_clock::now();
+  queue.saveSnapshot(snapshot);
+  report(name + " save snapshot", count, secondsSince(start));
+
+  JobQueue snapshotRestored;
+  start = chrono::steady_clock::now();
+  snapshotRestored.loadSnapshot(snapshot);
+  report(name + " restore snapshot", count, secondsSince(start));
+
+  if ((textRestored.getSize() != count) or (snapshotRestored.getSize() != count) or
+      (snapshotRestored.front().getId() != queue.front().getId()))
+  {
+    cout << "  restored queues do not match" << endl;
+  }
+}
+
+/**
+ * @brief Benchmark queue snapshots
+ *
+ * Compare saving and restoring large queues of jobs as text against
+ * binary snapshots, for a plain queue whose values wrap around the
+ * buffer and for a binary heap.
+ *
+ * @param maxSize The largest queue length to use.
+ */
+static void benchSnapshot(long maxSize)
+{
+  long queueLength = min(maxSize, 1000000L);
+  vector<int> priorities = randomPriorities(queueLength);
+
+  AQueue<Job> arrayQueue;
+  AHeapPriorityQueue<Job> heap;
+  for (long index = 0; index < queueLength; index++)
+  {
+    Job job(priorities[index], index % 10, index, index + 1);
+    arrayQueue.enqueue(job);
+    heap.enqueue(job);
+  }
+  // wrap the values around the end of the circular buffer
+  for (long index = 0; index < queueLength / 2; index++)
+  {
+    arrayQueue.enqueue(arrayQueue.dequeueValue());
+  }
+
+  cout << "saving and restoring queues of jobs, queue length " << queueLength << endl;
+  timeSnapshot("AQueue<Job>", arrayQueue);
+  timeSnapshot("AHeapPriorityQueue<Job>", heap);
+  cout << endl;
+}
+
+/**
+ * @brief Open cache miss counter
+ *
+ * Open a hardware performance counter of the last level cache misses
+ * of this thread, using the Linux perf events interface.  The counter
+ * starts disabled.  Counters are often not available, for example in
+ * containers or virtual machines, in which case no cache misses are
+ * reported.
+ *
+ * @returns int The file descriptor of the counter, or -1 if it could
+ *   not be opened.
+ */
+static int openCacheMissCounter()
+{
+  perf_event_attr attributes = {};
+  attributes.type = PERF_TYPE_HARDWARE;
+  attributes.size = sizeof(attributes);
+  attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+  attributes.disabled = 1;
+  attributes.exclude_kernel = 1;
+  attributes.exclude_hv = 1;
+  return syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+}
+
+/**
+ * @brief Time priority queue of jobs
+ *
+ * Enqueue all of the jobs into the given priority queue, then dequeue
+ * them all again, reporting the time and the cache misses of both
+ * phases.
+ *
+ * @param name The name of the queue implementation being timed.
+ * @param queue The (empty) priority queue to time.
+ * @param jobs The jobs to enqueue.
+ */
+template<class PriorityQueue>
+static void timeJobPriorityQueue(const string& name, PriorityQueue& queue, const vector<Job>& jobs)
+{
+  long count = jobs.size();
+  int counter = openCacheMissCounter();
+  long long misses = 0;
+
+  ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+  ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+  auto start = chrono::steady_clock::now();
+  for (const Job& job : jobs)
+  {
+    queue.enqueue(job);
+  }
+  double seconds = secondsSince(start);
+  ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+  report(name + " enqueue", count, seconds);
+  if ((counter >= 0) and (read(counter, &misses, sizeof(misses)) == sizeof(misses)))
+  {
+    cout << "    cache misses: " << misses << ", " << setprecision(2) << double(misses) / count << " per job" << endl;
+  }
+
+  ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+  ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+  start = chrono::steady_clock::now();
+  long checksum = 0;
+  while (not queue.isEmpty())
+  {
+    checksum += queue.dequeueValue().getId();
+  }
+  seconds = secondsSince(start);
+  ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+  report(name + " dequeueValue", count, seconds);
+  if ((counter >= 0) and (read(counter, &misses, sizeof(misses)) == sizeof(misses)))
+  {
+    cout << "    cache misses: " << misses << ", " << setprecision(2) << double(misses) / count << " per job" << endl;
+  }
+
+  if (counter >= 0)
+  {
+    close(counter);
+  }
+
+  // use the checksum so the dequeue loop can not be optimized away
+  if (checksum == -1)
+  {
+    cout << checksum << endl;
+  }
+}
+
+/**
+ * @brief Benchmark structure of arrays job heap
+ *
+ * Compare the APriorityQueue<Job> and AHeapPriorityQueue<Job>, which
+ * compare and move whole jobs, with the JobPriorityQueue, which only
+ * compares and moves packed keys.  Sorted insertion is O(n^2) to fill
+ * the queue, so it is only run up to a modest size.
+ *
+ * @param maxSize The largest number of jobs to enqueue.
+ */
+static void benchJobPriorityQueue(long maxSize)
+{
+  const long SIZES[] = {1000, 10000, 1000000, 10000000};
+  const long MAX_INSERTION_SIZE = 10000;
+
+  if (openCacheMissCounter() < 0)
+  {
+    cout << "(hardware cache miss counters not available, only reporting times)" << endl;
+  }
+  cout << "priority queue of jobs: whole jobs vs structure of arrays keys, random priorities" << endl;
+  for (long count : SIZES)
+  {
+    if (count > maxSize)
+    {
+      continue;
+    }
+    vector<int> priorities = randomPriorities(count);
+    vector<Job> jobs;
+    jobs.reserve(count);
+    for (long index = 0; index < count; index++)
+    {
+      jobs.push_back(Job(priorities[index], index % 100, index, index + 1));
+    }
+
+    if (count <= MAX_INSERTION_SIZE)
+    {
+      APriorityQueue<Job> sorted;
+      timeJobPriorityQueue("APriorityQueue<Job>", sorted, jobs);
+    }
+    else
+    {
+      cout << "  " << left << setw(40) << "APriorityQueue<Job>" << right << setw(12) << count << "  skipped, O(n^2) enqueue" << endl;
+    }
+
+    AHeapPriorityQueue<Job> heap;
+    timeJobPriorityQueue("AHeapPriorityQueue<Job>", heap, jobs);
+    JobPriorityQueue keyHeap;
+    timeJobPriorityQueue("JobPriorityQueue", keyHeap, jobs);
+  }
+  cout << endl;
+}
+
+/**
+ * @brief Time a queue scan
+ *
+ * Time repeating a scan of a queue, and report the time per value
+ * scanned.
+ *
+ * @param name The name of the scan being timed.
+ * @param queueLength The number of values each scan looks at.
+ * @param repeats The number of times to repeat the scan.
+ * @param scan The scan, which returns a result of 0 or more to add to
+ *   a checksum.
+ */
+template<class Scan>
+static void timeScan(const string& name, long queueLength, int repeats, Scan scan)
+{
+  long checksum = 0;
+  auto start = chrono::steady_clock::now();
+  for (int repeat = 0; repeat < repeats; repeat++)
+  {
+    checksum += scan();
+
+    // hide the checksum and memory from the optimizer, so that it can
+    // neither drop an inlined scan whose result it can bound nor hoist
+    // a scan of an unchanged queue out of the loop
+    asm volatile("" : "+r"(checksum) : : "memory");
+  }
+  report(name, queueLength * repeats, secondsSince(start));
+
+  // use the checksum so the scans can not be optimized away
+  if (checksum == -1)
+  {
+    cout << checksum << endl;
+  }
+}
+
+/**
+ * @brief Benchmark searching and comparing queues
+ *
+ * Compare scanning a wrapped AQueue<int> by indexing every value, as
+ * a search or comparison written with the indexing operator does,
+ * and with std::find on the iterators, against find(), count() and
+ * operator==, which scan each segment of the circular buffer as a
+ * block with SIMD instructions.  The value searched for is not in the
+ * queue, so every scan looks at every value.  Small queues are
+ * scanned repeatedly so each row scans about as many values.
+ *
+ * @param maxSize The largest queue length to use.
+ */
+static void benchSearch(long maxSize)
+{
+  const long SIZES[] = {1000000, 10000000, 100000000};
+  const long VALUES_PER_ROW = 100000000;
+  const int MISSING = -1;
+
+  cout << "searching and comparing AQueue<int>, SIMD instruction set: " << simdInstructionSet() << endl;
+  for (long queueLength : SIZES)
+  {
+    if (queueLength > maxSize)
+    {
+      continue;
+    }
+    int repeats = max(1L, VALUES_PER_ROW / queueLength);
+
+    // wrap the values half way around the circular buffer
+    AQueue<int> queue;
+    AQueue<int> other;
+    queue.reserve(queueLength);
+    for (long index = 0; index < queueLength; index++)
+    {
+      queue.enqueue(index);
+    }
+    for (long index = 0; index < queueLength / 2; index++)
+    {
+      queue.enqueue(queue.dequeueValue());
+    }
+    other.reserve(queueLength);
+    for (long index = 0; index < queueLength; index++)
+    {
+      other.enqueue(queue[index]);
+    }
+
+    cout << "  queue length " << queueLength << ", " << repeats << " scans per row" << endl;
+    timeScan("indexed find", queueLength, repeats, [&queue, MISSING]() {
+      int size = queue.getSize();
+      for (int index = 0; index < size; index++)
+      {
+        if (queue[index] == MISSING)
+        {
+          return index + 1;
+        }
+      }
+      return 0;
+    });
+    timeScan("std::find on iterators", queueLength, repeats, [&queue, MISSING]() {
+      return std::find(queue.cbegin(), queue.cend(), MISSING) == queue.cend() ? 0 : 1;
+    });
+    timeScan("find()", queueLength, repeats, [&queue, MISSING]() {
+      return queue.find(MISSING) + 1;
+    });
+    timeScan("count()", queueLength, repeats, [&queue, MISSING]() {
+      return queue.count(MISSING);
+    });
+    timeScan("contains()", queueLength, repeats, [&queue, MISSING]() {
+      return int(queue.contains(MISSING));
+    });
+    timeScan("indexed equality", queueLength, repeats, [&queue, &other]() {
+      int size = queue.getSize();
+      for (int index = 0; index < size; index++)
+      {
+        if (queue[index] != other[index])
+        {
+          return 0;
+        }
+      }
+      return 1;
+    });
+    timeScan("operator==", queueLength, repeats, [&queue, &other]() {
+      return int(queue == other);
+    });
+  }
+  cout << endl;
+}
+
+/**
+ * @brief Benchmark sorted insertion
+ *
+ * Time enqueueing values one at a time into an APriorityQueue<int>,
+ * which keeps its values sorted, for several distributions of the
+ * priorities: random priorities, which land anywhere in the queue,
+ * a few distinct priorities, with many ties, rising priorities, which
+ * always go to the front of the queue, and falling priorities, which
+ * always go to the back.  The AHeapPriorityQueue<int> is timed on the
+ * random priorities for comparison.
+ *
+ * @param maxSize The largest number of values to enqueue.
+ */
+static void benchSortedInsertion(long maxSize)
+{
+  const long SIZES[] = {10000, 100000};
+
+  cout << "sorted insertion into APriorityQueue<int> vs AHeapPriorityQueue<int>, by priority distribution" << endl;
+  for (long count : SIZES)
+  {
+    if (count > maxSize)
+    {
+      continue;
+    }
+
+    vector<int> randomValues = randomPriorities(count);
+    vector<int> fewValues(count);
+    vector<int> risingValues(count);
+    vector<int> fallingValues(count);
+    for (long index = 0; index < count; index++)
+    {
+      fewValues[index] = randomValues[index] % 8;
+      risingValues[index] = index;
+      fallingValues[index] = count - index;
+    }
+
+    const pair<string, const vector<int>*> DISTRIBUTIONS[] = {
+      {"random", &randomValues},
+      {"8 distinct", &fewValues},
+      {"rising", &risingValues},
+      {"falling", &fallingValues},
+    };
+    for (const auto& distribution : DISTRIBUTIONS)
+    {
+      APriorityQueue<int> sorted;
+      timePriorityQueue("sorted " + distribution.first, sorted, *distribution.second);
+    }
+    AHeapPriorityQueue<int> heap;
+    timePriorityQueue("heap random", heap, randomValues);
+  }
+  cout << endl;
+}
+
+/** @brief a named suite of benchmarks that can be selected on the
+ *    command line
+ */
+struct BenchmarkSuite
+{
+  /// @brief the name used to select the suite on the command line
+  string name;
+
+  /// @brief the function that runs the suite up to a maximum size
+  void (*run)(long maxSize);
+};
+
+/**
+ * @brief Benchmark aging jobs
+ *
+ * Raise the priority of randomly chosen waiting jobs, the way a
+ * scheduler ages jobs that have waited too long, and remove randomly
+ * chosen jobs.  The JobPriorityQueue does each in place by job id,
+ * which is compared with rebuilding an AHeapPriorityQueue<Job> around
+ * each changed job, the only way to change a queued job before, so
+ * the rebuild is only run for a few jobs.
+ *
+ * @param maxSize The largest number of jobs to queue.
+ */
+static void benchAging(long maxSize)
+{
+  const long SIZES[] = {1000, 10000, 100000, 1000000};
+  const long REBUILD_COUNT = 10;
+
+  cout << "aging queued jobs: JobPriorityQueue by id vs rebuilding AHeapPriorityQueue<Job>" << endl;
+  for (long count : SIZES)
+  {
+    if (count > maxSize)
+    {
+      continue;
+    }
+    vector<int> priorities = randomPriorities(count);
+    vector<Job> jobs;
+    jobs.reserve(count);
+    for (long index = 0; index < count; index++)
+    {
+      jobs.push_back(Job(priorities[index], index % 100, index, index + 1));
+    }
+    mt19937 generator(7);
+    uniform_int_distribution<int> pickId(1, count);
+
+    JobPriorityQueue keyHeap;
+    keyHeap.enqueueArray(jobs.data(), count);
+    auto start = chrono::steady_clock::now();
+    for (long bump = 0; bump < count; bump++)
+    {
+      int id = pickId(generator);
+      keyHeap.updatePriority(id, jobs[id - 1].getPriority() + 1 + int(bump));
+    }
+    report("JobPriorityQueue updatePriority", count, secondsSince(start));
+
+    start = chrono::steady_clock::now();
+    for (long index = 0; index < count / 2; index++)
+    {
+      keyHeap.erase(jobs[(index * 7919) % count].getId());
+    }
+    report("JobPriorityQueue erase", count / 2, secondsSince(start));
+
+    AHeapPriorityQueue<Job> heap;
+    heap.enqueueArray(jobs.data(), count);
+    long rebuilds = min(count, REBUILD_COUNT);
+    start = chrono::steady_clock::now();
+    for (long bump = 0; bump < rebuilds; bump++)
+    {
+      int id = pickId(generator);
+      vector<Job> waiting;
+      waiting.reserve(count);
+      while (not heap.isEmpty())
+      {
+        Job job = heap.dequeueValue();
+        if (job.getId() == id)
+        {
+          job.setPriority(job.getPriority() + 1);
+        }
+        waiting.push_back(job);
+      }
+      heap.enqueueArray(waiting.data(), waiting.size());
+    }
+    report("AHeapPriorityQueue<Job> rebuild", rebuilds, secondsSince(start));
+  }
+  cout << endl;
+}
+
+/**
+ * @brief Benchmark parallel simulation
+ *
+ * Run the same set of independent simulation replications on thread
+ * pools of increasing size, and report the speedup and parallel
+ * efficiency over a single thread.  The replications share nothing,
+ * so the speedup should be close to the number of threads, up to the
+ * number of processor cores.
+ *
+ * @param maxSize The largest number of jobs in each replication.
+ */
+static void benchParallelSimulation(long maxSize)
+{
+  int cores = max(1u, thread::hardware_concurrency());
+  SimulationConfig config;
+  config.numJobs = min(maxSize, 200000L);
+  JobSchedulerSimulator simulator(config);
+  int replications = max(8, 2 * cores);
+
+  vector<int> threadCounts;
+  for (int threads = 1; threads < cores; threads *= 2)
+  {
+    threadCounts.push_back(threads);
+  }
+  threadCounts.push_back(cores);
+
+  cout << "parallel simulation replications, " << replications << " x " << config.numJobs << " jobs on JobPriorityQueue, "
+       << cores << " core(s)" << endl;
+  double singleThreadSeconds = 0.0;
+  for (int threads : threadCounts)
+  {
+    auto start = chrono::steady_clock::now();
+    vector<SimulationResult> results = simulator.simulateReplications<JobPriorityQueue>(replications, threads);
+    double seconds = secondsSince(start);
+    SimulationSummary summary = JobSchedulerSimulator::summarize(results);
+    if (threads == 1)
+    {
+      singleThreadSeconds = seconds;
+    }
+
+    double speedup = singleThreadSeconds / seconds;
+    ostringstream name;
+    name << threads << " thread(s)";
+    report(name.str(), summary.events, seconds);
+    cout << "    speedup " << setprecision(2) << speedup << ", efficiency " << setprecision(0) << 100.0 * speedup / threads
+         << "%, mean cost " << setprecision(1) << summary.meanCost << " +/- " << summary.meanCostHalfWidth << endl;
+  }
+  cout << endl;
+}
+
+/**
+ * @brief Time hold operations on an event queue
+ *
+ * Fill the queue with pending events, then repeatedly dequeue the next
+ * event and schedule a new one a random increment later, the classic
+ * hold model of a discrete event simulation's event list, which keeps
+ * the number of pending events constant.
+ *
+ * @param name The name to report the timing under.
+ * @param pending The number of pending events to hold.
+ * @param operations The number of hold operations to time.
+ * @param next A callable returning and removing the next event time.
+ * @param schedule A callable scheduling an event at a time.
+ */
+template<class Next, class Schedule>
+static void timeHold(const string& name, long pending, long operations, Next next, Schedule schedule)
+{
+  mt19937 generator(2336);
+  exponential_distribution<double> increment(1.0 / 1000.0);
+  for (long count = 0; count < pending; count++)
+  {
+    schedule(int(increment(generator)));
+  }
+
+  // the increments are drawn up front so only the queue is timed
+  vector<int> increments(operations);
+  for (int& time : increments)
+  {
+    time = int(increment(generator));
+  }
+
+  auto start = chrono::steady_clock::now();
+  for (long operation = 0; operation < operations; operation++)
+  {
+    schedule(next() + increments[operation]);
+  }
+  report(name, operations, secondsSince(start));
+}
+
+/**
+ * @brief Benchmark event scheduling
+ *
+ * Compare the CalendarQueue with binary heaps as the event list of a
+ * simulation, using hold operations on up to 1M pending events.  The
+ * AHeapPriorityQueue is a max heap, so it holds negated event times.
+ *
+ * @param maxSize The largest number of pending events.
+ */
+static void benchCalendarQueue(long maxSize)
+{
+  const long SIZES[] = {1000, 10000, 100000, 1000000};
+  const long OPERATIONS = 2000000;
+
+  cout << "event scheduling hold model: CalendarQueue<int> vs binary heaps" << endl;
+  for (long pending : SIZES)
+  {
+    if (pending > maxSize)
+    {
+      continue;
+    }
+    cout << "  " << pending << " pending events" << endl;
+
+    CalendarQueue<int> calendar;
+    timeHold(
+      "CalendarQueue<int>", pending, OPERATIONS, [&calendar]() { return calendar.dequeueValue(); },
+      [&calendar](int time) { calendar.enqueue(time); });
+
+    AHeapPriorityQueue<int> heap;
+    timeHold(
+      "AHeapPriorityQueue<int>", pending, OPERATIONS, [&heap]() { return -heap.dequeueValue(); },
+      [&heap](int time) { heap.enqueue(-time); });
+
+    priority_queue<int, vector<int>, greater<int>> standard;
+    timeHold(
+      "std::priority_queue<int>", pending, OPERATIONS,
+      [&standard]()
+      {
+        int time = standard.top();
+        standard.pop();
+        return time;
+      },
+      [&standard](int time) { standard.push(time); });
+  }
+  cout << endl;
+}
+
+/**
+ * @brief Time latencies of a queue
+ *
+ * Fill the queue with the values through a LatencyQueue, and then
+ * drain it, and report the percentiles of the enqueue and dequeue
+ * latencies.
+ *
+ * @param name The name of the queue to report.
+ * @param queue The queue to time, empty.
+ * @param values The values to enqueue.
+ */
+static void timeLatencies(const string& name, Queue<int>& queue, const vector<int>& values)
+{
+  LatencyQueue<int> timed(queue);
+  for (int value : values)
+  {
+    timed.enqueue(value);
+  }
+  while (not timed.isEmpty())
+  {
+    timed.dequeue();
+  }
+
+  cout << "  " << left << setw(34) << name + " enqueue" << right << timed.getEnqueueLatency() << endl;
+  cout << "  " << left << setw(34) << name + " dequeue" << right << timed.getDequeueLatency() << endl;
+}
+
+/**
+ * @brief Benchmark operation latencies
+ *
+ * Report the percentiles of the latencies of the enqueues and dequeues
+ * of the queues, to show the tail of slow operations that the mean
+ * time per operation hides, such as the enqueues that grow an array
+ * queue.  The cost of reading the clock, which is included in every
+ * latency, is reported first.
+ *
+ * @param maxSize The largest number of items to queue.
+ */
+static void benchLatency(long maxSize)
+{
+  const long SIZES[] = {10000, 100000};
+
+  LatencyHistogram clock;
+  for (int sample = 0; sample < 100000; sample++)
+  {
+    auto start = chrono::steady_clock::now();
+    clock.record(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+  }
+  cout << "operation latencies in ns, through LatencyQueue" << endl;
+  cout << "  " << left << setw(34) << "steady_clock overhead" << right << clock << endl;
+
+  for (long count : SIZES)
+  {
+    if (count > maxSize)
+    {
+      continue;
+    }
+    cout << "  " << count << " random values" << endl;
+    vector<int> values = randomPriorities(count);
+
+    AQueue<int> array;
+    timeLatencies("AQueue<int>", array, values);
+    LQueue<int> linked;
+    timeLatencies("LQueue<int>", linked, values);
+    APriorityQueue<int> sorted;
+    timeLatencies("APriorityQueue<int>", sorted, values);
+    AHeapPriorityQueue<int> heap;
+    timeLatencies("AHeapPriorityQueue<int>", heap, values);
+    CalendarQueue<int> calendar;
+    timeLatencies("CalendarQueue<int>", calendar, values);
+  }
+  cout << endl;
+}
+
+/**
+ * @brief Main entry point
+ *
+ * Run the selected benchmark suites.
+ *
+ * @param argc The command line argument count, the number of arguments
+ *   provided by user on the command line.
+ * @param argv An array of char* old style c-strings.  The optional
+ *   argv[1] selects the suite to run, or "all", and the optional
+ *   argv[2] is the maximum number of items to use in the benchmarks.
+ *
+ * @returns int Returns 0 to indicate successfull completion of program,
+ *   and a non-zero value to indicate an unknown suite was asked for.
+ */
+int main(int argc, char** argv)
+{
+  const BenchmarkSuite SUITES[] = {
+    {"heap", benchPriorityQueues},
+    {"pool", benchNodePool},
+    {"capacity", benchCapacityPolicy},
+    {"spsc", benchSPSCQueue},
+    {"mpmc", benchMPMCQueue},
+    {"cpq", benchConcurrentPriorityQueue},
+    {"batch", benchBatches},
+    {"unrolled", benchUnrolledList},
+    {"traversal", benchTraversal},
+    {"equality", benchEquality},
+    {"dump", benchDump},
+    {"snapshot", benchSnapshot},
+    {"jobheap", benchJobPriorityQueue},
+    {"search", benchSearch},
+    {"insertion", benchSortedInsertion},
+    {"aging", benchAging},
+    {"simulation", benchParallelSimulation},
+    {"calendar", benchCalendarQueue},
+    {"latency", benchLatency},
+  };
+
+  string suiteName = (argc > 1) ? argv[1] : "all";
+  long maxSize = (argc > 2) ? atol(argv[2]) : 100000000;
+
+  bool found = false;
+  for (const BenchmarkSuite& suite : SUITES)
+  {
+    if ((suiteName == "all") or (suiteName == suite.name))
+    {
+      suite.run(maxSize);
+      found = true;
+    }
+  }
+
+  if (not found)
+  {
+    cerr << "Unknown benchmark suite: " << suiteName << endl << "Available suites: all";
+    for (const BenchmarkSuite& suite : SUITES)
+    {
+      cerr << " " << suite.name;
+    }
+    cerr << endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,311 @@
+/** @file sim.cpp
+ * @brief Job scheduling simulator driver, runs the same simulation on
+ *   each of the kinds of job queues.
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Run a job scheduling simulation with the queue implementations as
+ * the job queue, and report the throughput of the simulation and the
+ * costs and wait times of the jobs for each.  The simulation
+ * parameters are given on the command line as name=value pairs, for
+ * example
+ *
+ *   ./sim jobs=1000000 rate=0.095 servers=1 service=exponential mean=10
+ *
+ * With replications=n, n independent replications of the simulation
+ * are run in parallel for each queue, and the averages of their results
+ * are reported with 95% confidence intervals.  Run with help as the
+ * only argument to list the parameters.
+ */
+#include "AHeapPriorityQueue.hpp"
+#include "APriorityQueue.hpp"
+#include "AQueue.hpp"
+#include "Job.hpp"
+#include "JobPriorityQueue.hpp"
+#include "JobSchedulerSimulator.hpp"
+#include "LPriorityQueue.hpp"
+#include "LQueue.hpp"
+#include "QueueStatistics.hpp"
+#include <cstdlib>
+#include <iomanip>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Show usage
+ *
+ * Display the simulation parameters that can be given on the command
+ * line, and their defaults.
+ */
+static void usage()
+{
+  SimulationConfig defaults;
+  cerr << "usage: sim [name=value ...]" << endl
+       << "  queue=all        queue to simulate: all, aqueue, lqueue, apriority, lpriority, heap or jobheap" << endl
+       << "  jobs=" << setw(12) << left << defaults.numJobs << "number of jobs to run" << endl
+       << "  rate=" << setw(12) << defaults.arrivalRate << "mean job arrivals per time unit" << endl
+       << "  servers=" << setw(9) << defaults.numServers << "number of servers running jobs" << endl
+       << "  service=exponential  service time distribution: constant, uniform or exponential" << endl
+       << "  mean=" << setw(12) << defaults.meanServiceTime << "mean service time, constant and exponential" << endl
+       << "  min=" << setw(13) << defaults.minServiceTime << "shortest service time, uniform" << endl
+       << "  max=" << setw(13) << defaults.maxServiceTime << "longest service time, uniform" << endl
+       << "  priorities=1,1,... relative weights of priorities 1, 2, ..., default 10 equal weights" << endl
+       << "  seed=" << setw(12) << defaults.seed << "random number seed" << endl
+       << "  replications=1   number of independent replications to average" << endl
+       << "  threads=0        threads to run replications on, 0 for one per core" << endl;
+}
+
+/**
+ * @brief Parse priority mix
+ *
+ * Parse a comma separated list of priority weights.
+ *
+ * @param value The list of weights.
+ *
+ * @returns vector<double> The weights, in priority order.
+ */
+static vector<double> parsePriorityMix(const string& value)
+{
+  vector<double> weights;
+  istringstream in(value);
+  string weight;
+  while (getline(in, weight, ','))
+  {
+    weights.push_back(stod(weight));
+  }
+  return weights;
+}
+
+/**
+ * @brief Report simulation
+ *
+ * Display one row of the results table for a simulation.
+ *
+ * @param name The name of the queue simulated.
+ * @param result The measurements of the simulation.
+ */
+static void report(const string& name, const SimulationResult& result)
+{
+  cout << "  " << left << setw(26) << name << right << setw(12) << fixed << setprecision(0) << result.eventsPerSecond
+       << setw(10) << setprecision(1) << result.meanWaitTime << setw(8) << result.medianWaitTime << setw(8) << result.p90WaitTime
+       << setw(8) << result.p99WaitTime << setw(9) << result.maxWaitTime << setw(10) << result.maxQueueSize << setw(12)
+       << setprecision(1) << result.meanCost << setw(16) << result.totalCost << endl;
+}
+
+/**
+ * @brief Report replications
+ *
+ * Display one row of the results table for a set of replications, the
+ * averages of their results, and their confidence intervals below it.
+ *
+ * @param name The name of the queue simulated.
+ * @param summary The aggregated measurements of the replications.
+ * @param seconds The wall clock time the replications took.
+ */
+static void report(const string& name, const SimulationSummary& summary, double seconds)
+{
+  cout << "  " << left << setw(26) << name << right << setw(12) << fixed << setprecision(0) << summary.events / seconds
+       << setw(10) << setprecision(1) << summary.meanWaitTime << setw(8) << setprecision(0) << summary.medianWaitTime << setw(8)
+       << summary.p90WaitTime << setw(8) << summary.p99WaitTime << setw(9) << summary.maxWaitTime << setw(10) << summary.maxQueueSize
+       << setw(12) << setprecision(1) << summary.meanCost << setw(16) << summary.totalCost << endl
+       << "    " << summary.runs << " replications, 95% confidence: wait +/- " << summary.meanWaitTimeHalfWidth
+       << ", mean cost +/- " << summary.meanCostHalfWidth << endl;
+}
+
+/**
+ * @brief Simulate queue
+ *
+ * Run the simulation with the given kind of queue, and report it, if it
+ * is the queue asked for.  A single replication is run on this thread,
+ * more are run in parallel.  When the program is built with
+ * QUEUE_STATISTICS defined, the statistics of the job queue of a single
+ * replication are shown as well.
+ *
+ * @param simulator The simulator to run.
+ * @param queueName The queue asked for on the command line, or all.
+ * @param key The short name of the queue, as given on the command line.
+ * @param name The name of the queue to report.
+ * @param replications The number of replications to run.
+ * @param threads The number of threads to run replications on.
+ *
+ * @returns bool true if the queue was simulated.
+ */
+template<class JobQueue>
+static bool simulateQueue(const JobSchedulerSimulator& simulator, const string& queueName, const string& key, const string& name,
+                          int replications, int threads)
+{
+  if ((queueName != "all") and (queueName != key))
+  {
+    return false;
+  }
+
+  if (replications <= 1)
+  {
+    JobQueue jobQueue;
+    report(name, simulator.simulate(jobQueue));
+    if (QueueStatistics::ENABLED)
+    {
+      cout << "    " << jobQueue.getStatistics() << endl;
+    }
+  }
+  else
+  {
+    auto start = chrono::steady_clock::now();
+    vector<SimulationResult> results = simulator.simulateReplications<JobQueue>(replications, threads);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    report(name, JobSchedulerSimulator::summarize(results), seconds);
+  }
+  return true;
+}
+
+/**
+ * @brief Main entry point
+ *
+ * Parse the simulation parameters, run the simulation with each queue
+ * asked for, and display a table of the results.
+ *
+ * @param argc The command line argument count, the number of arguments
+ *   provided by user on the command line.
+ * @param argv An array of char* old style c-strings, the name=value
+ *   simulation parameters.
+ *
+ * @returns int Returns 0 to indicate successfull completion of program,
+ *   and a non-zero value to indicate bad parameters.
+ */
+int main(int argc, char** argv)
+{
+  SimulationConfig config;
+  string queueName = "all";
+  int replications = 1;
+  int threads = 0;
+
+  try
+  {
+    for (int index = 1; index < argc; index++)
+    {
+      string argument = argv[index];
+      size_t equals = argument.find('=');
+      string name = argument.substr(0, equals);
+      string value = (equals == string::npos) ? "" : argument.substr(equals + 1);
+
+      if (name == "queue")
+      {
+        queueName = value;
+      }
+      else if (name == "jobs")
+      {
+        config.numJobs = stol(value);
+      }
+      else if (name == "rate")
+      {
+        config.arrivalRate = stod(value);
+      }
+      else if (name == "servers")
+      {
+        config.numServers = stoi(value);
+      }
+      else if ((name == "service") and (value == "constant"))
+      {
+        config.serviceDistribution = CONSTANT_SERVICE;
+      }
+      else if ((name == "service") and (value == "uniform"))
+      {
+        config.serviceDistribution = UNIFORM_SERVICE;
+      }
+      else if ((name == "service") and (value == "exponential"))
+      {
+        config.serviceDistribution = EXPONENTIAL_SERVICE;
+      }
+      else if (name == "mean")
+      {
+        config.meanServiceTime = stod(value);
+      }
+      else if (name == "min")
+      {
+        config.minServiceTime = stoi(value);
+      }
+      else if (name == "max")
+      {
+        config.maxServiceTime = stoi(value);
+      }
+      else if (name == "priorities")
+      {
+        config.priorityMix = parsePriorityMix(value);
+      }
+      else if (name == "seed")
+      {
+        config.seed = stoul(value);
+      }
+      else if (name == "replications")
+      {
+        replications = stoi(value);
+      }
+      else if (name == "threads")
+      {
+        threads = stoi(value);
+      }
+      else
+      {
+        usage();
+        return (name == "help") ? 0 : 1;
+      }
+    }
+  }
+  catch (const logic_error& error)
+  {
+    cerr << "Error: bad simulation parameter value, " << error.what() << endl;
+    usage();
+    return 1;
+  }
+
+  try
+  {
+    JobSchedulerSimulator simulator(config);
+
+    cout << "job scheduling simulation: " << config.numJobs << " jobs, arrival rate " << config.arrivalRate << ", "
+         << config.numServers << " server(s), offered load "
+         << fixed << setprecision(2)
+         << config.arrivalRate *
+              ((config.serviceDistribution == UNIFORM_SERVICE) ? (config.minServiceTime + config.maxServiceTime) / 2.0
+                                                               : config.meanServiceTime) /
+              config.numServers
+         << endl
+         << "  " << left << setw(26) << "queue" << right << setw(12) << "events/s" << setw(10) << "wait" << setw(8) << "p50"
+         << setw(8) << "p90" << setw(8) << "p99" << setw(9) << "max" << setw(10) << "queued" << setw(12) << "mean cost" << setw(16) << "total cost"
+         << endl;
+
+    bool found = false;
+    found = simulateQueue<AQueue<Job>>(simulator, queueName, "aqueue", "AQueue<Job>", replications, threads) or found;
+    found = simulateQueue<LQueue<Job>>(simulator, queueName, "lqueue", "LQueue<Job>", replications, threads) or found;
+    found = simulateQueue<APriorityQueue<Job>>(simulator, queueName, "apriority", "APriorityQueue<Job>", replications, threads) or
+            found;
+    found = simulateQueue<LPriorityQueue<Job>>(simulator, queueName, "lpriority", "LPriorityQueue<Job>", replications, threads) or
+            found;
+    found =
+      simulateQueue<AHeapPriorityQueue<Job>>(simulator, queueName, "heap", "AHeapPriorityQueue<Job>", replications, threads) or found;
+    found = simulateQueue<JobPriorityQueue>(simulator, queueName, "jobheap", "JobPriorityQueue", replications, threads) or found;
+
+    if (not found)
+    {
+      cerr << "Unknown queue: " << queueName << endl;
+      usage();
+      return 1;
+    }
+  }
+  catch (const invalid_argument& error)
+  {
+    cerr << error.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
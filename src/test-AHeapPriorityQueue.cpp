@@ -0,0 +1,347 @@
+/** @file test-AHeapPriorityQueue.cpp
+ * @brief Unit tests for Assignment Queues
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Tests of the array based binary heap implementation of the Priority
+ * Queue API.
+ */
+#include "AHeapPriorityQueue.hpp"
+#include "APriorityQueue.hpp"
+#include "Job.hpp"
+#include "QueueException.hpp"
+#include "catch.hpp"
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <vector>
+using namespace std;
+
+/** Test AHeapPriorityQueue<int> concrete binary heap implementation of
+ * priority queue of integers
+ */
+TEST_CASE("AHeapPriorityQueue<int> test integer priority queue binary heap implementation", "[heap]")
+{
+  SECTION("test basic priority queue functions for queue of integers")
+  {
+    AHeapPriorityQueue<int> priorityQueue;
+
+    // priority queue is initially empty
+    CHECK(priorityQueue.isEmpty());
+    CHECK(priorityQueue.getSize() == 0);
+    CHECK(priorityQueue.str() == "<queue> size: 0 front:[ ]:back");
+    CHECK_THROWS_AS(priorityQueue.front(), QueueEmptyException);
+    CHECK_THROWS_AS(priorityQueue.dequeue(), QueueEmptyException);
+
+    // front is always the highest priority item enqueued so far
+    priorityQueue.enqueue(5);
+    CHECK(priorityQueue.getSize() == 1);
+    CHECK(priorityQueue.front() == 5);
+    priorityQueue.enqueue(10);
+    CHECK(priorityQueue.getSize() == 2);
+    CHECK(priorityQueue.front() == 10);
+    priorityQueue.enqueue(7);
+    CHECK(priorityQueue.front() == 10);
+    priorityQueue.enqueue(3);
+    CHECK(priorityQueue.front() == 10);
+    priorityQueue.enqueue(1);
+    priorityQueue.enqueue(5);
+    CHECK_FALSE(priorityQueue.isEmpty());
+    CHECK(priorityQueue.getSize() == 6);
+    CHECK(priorityQueue.front() == 10);
+
+    // dequeue gives back items in priority order
+    int expected[] = {10, 7, 5, 5, 3, 1};
+    for (int index = 0; index < 6; index++)
+    {
+      CHECK(priorityQueue.front() == expected[index]);
+      priorityQueue.dequeue();
+    }
+    CHECK(priorityQueue.isEmpty());
+    CHECK(priorityQueue.getSize() == 0);
+    CHECK(priorityQueue.str() == "<queue> size: 0 front:[ ]:back");
+    CHECK_THROWS_AS(priorityQueue.front(), QueueEmptyException);
+    CHECK_THROWS_AS(priorityQueue.dequeue(), QueueEmptyException);
+
+    // clear still works
+    priorityQueue.enqueue(42);
+    priorityQueue.clear();
+    CHECK(priorityQueue.isEmpty());
+    CHECK(priorityQueue.getAllocationSize() == 0);
+  }
+
+  SECTION("test array based constructor builds a heap")
+  {
+    int values[] = {10, 50, 20, 40, 30};
+    AHeapPriorityQueue<int> priorityQueue(5, values);
+    CHECK(priorityQueue.getSize() == 5);
+    CHECK(priorityQueue.getAllocationSize() == 5);
+    CHECK(priorityQueue.front() == 50);
+
+    // growing the heap must keep all of the values
+    priorityQueue.enqueue(45);
+    CHECK(priorityQueue.getSize() == 6);
+    CHECK(priorityQueue.getAllocationSize() == 10);
+
+    int expected[] = {50, 45, 40, 30, 20, 10};
+    for (int index = 0; index < 6; index++)
+    {
+      CHECK(priorityQueue.front() == expected[index]);
+      priorityQueue.dequeue();
+    }
+    CHECK(priorityQueue.isEmpty());
+  }
+
+  SECTION("test copy constructor")
+  {
+    int values[] = {3, 1, 4, 2};
+    AHeapPriorityQueue<int> priorityQueue(4, values);
+    AHeapPriorityQueue<int> copy = priorityQueue;
+    CHECK(copy == priorityQueue);
+
+    copy.dequeue();
+    CHECK(copy.front() == 3);
+    CHECK(priorityQueue.front() == 4);
+    CHECK(copy.getSize() == 3);
+    CHECK(priorityQueue.getSize() == 4);
+  }
+
+  SECTION("test dequeue order matches APriorityQueue for many values")
+  {
+    AHeapPriorityQueue<int> heap;
+    APriorityQueue<int> sorted;
+
+    srand(42);
+    for (int index = 0; index < 1000; index++)
+    {
+      int value = rand() % 100;
+      heap.enqueue(value);
+      sorted.enqueue(value);
+
+      // interleave some dequeues to exercise sift down on a partial heap
+      if (index % 7 == 0)
+      {
+        heap.dequeue();
+        sorted.dequeue();
+      }
+    }
+
+    CHECK(heap.getSize() == sorted.getSize());
+    while (not sorted.isEmpty())
+    {
+      REQUIRE(heap.front() == sorted.front());
+      heap.dequeue();
+      sorted.dequeue();
+    }
+    CHECK(heap.isEmpty());
+  }
+}
+
+/** Test AHeapPriorityQueue using Job objects, items of equal priority
+ * must be dequeued in the order they were enqueued.
+ */
+TEST_CASE("AHeapPriorityQueue<Job> test equal priorities are first in first out", "[heap]")
+{
+  AHeapPriorityQueue<Job> priorityQueue;
+  int nextId = 1;
+
+  priorityQueue.enqueue(Job(5, 0, 0, nextId++));
+  priorityQueue.enqueue(Job(10, 5, 5, nextId++));
+  priorityQueue.enqueue(Job(7, 1, 1, nextId++));
+  priorityQueue.enqueue(Job(3, 4, 5, nextId++));
+  priorityQueue.enqueue(Job(1, 2, 3, nextId++));
+  priorityQueue.enqueue(Job(5, 9, 9, nextId++));
+  priorityQueue.enqueue(Job(5, 9, 9, nextId++));
+  priorityQueue.enqueue(Job(10, 9, 9, nextId++));
+  CHECK(priorityQueue.getSize() == 8);
+
+  int expectedIds[] = {2, 8, 3, 1, 6, 7, 4, 5};
+  for (int index = 0; index < 8; index++)
+  {
+    CHECK(priorityQueue.front().getId() == expectedIds[index]);
+    priorityQueue.dequeue();
+  }
+  CHECK(priorityQueue.isEmpty());
+}
+
+/** Test dequeueValue on the heap restores the heap after moving the
+ * front item out
+ */
+TEST_CASE("AHeapPriorityQueue<string> test emplace and dequeueValue", "[heap]")
+{
+  AHeapPriorityQueue<string> priorityQueue;
+  priorityQueue.emplace("charlie");
+  priorityQueue.emplace("alpha");
+  priorityQueue.emplace(3, 'z');
+  priorityQueue.emplace("bravo");
+
+  CHECK(priorityQueue.dequeueValue() == "zzz");
+  CHECK(priorityQueue.dequeueValue() == "charlie");
+  CHECK(priorityQueue.dequeueValue() == "bravo");
+  CHECK(priorityQueue.dequeueValue() == "alpha");
+  CHECK(priorityQueue.isEmpty());
+}
+
+/** Test small and large batches of Jobs enqueued on the heap come out
+ * in the same order as from the APriorityQueue
+ */
+TEST_CASE("AHeapPriorityQueue<Job> test batch enqueueArray and dequeueInto", "[batch]")
+{
+  AHeapPriorityQueue<Job> heap;
+  APriorityQueue<Job> sorted;
+  int nextId = 1;
+
+  // a batch larger than the heap rebuilds the heap, a smaller batch is
+  // sifted up item by item
+  const int BATCH_SIZES[] = {10, 3, 40, 1, 5};
+  for (int batchSize : BATCH_SIZES)
+  {
+    vector<Job> batch;
+    for (int index = 0; index < batchSize; index++)
+    {
+      batch.push_back(Job((nextId * 7) % 5, 0, 0, nextId));
+      nextId++;
+    }
+    heap.enqueueArray(batch.data(), batchSize);
+    sorted.enqueueArray(batch.data(), batchSize);
+  }
+  CHECK(heap.getSize() == 59);
+
+  Job out[10];
+  while (not sorted.isEmpty())
+  {
+    int dequeued = heap.dequeueInto(out, 10);
+    for (int index = 0; index < dequeued; index++)
+    {
+      REQUIRE(out[index].getId() == sorted.front().getId());
+      sorted.dequeue();
+    }
+  }
+  CHECK(heap.isEmpty());
+  CHECK(heap.dequeueInto(out, 10) == 0);
+}
+
+TEST_CASE("AHeapPriorityQueue<int> test allocation shrinks as the heap drains", "[capacity]")
+{
+  AHeapPriorityQueue<int> heap;
+  srand(42);
+  for (int index = 0; index < 1000; index++)
+  {
+    heap.enqueue(rand() % 100);
+  }
+  CHECK(heap.getAllocationSize() == 1280);
+
+  // the heap order must survive each reallocation while draining
+  int previous = heap.dequeueValue();
+  while (not heap.isEmpty())
+  {
+    CHECK(heap.getAllocationSize() >= heap.getSize());
+    int next = heap.dequeueValue();
+    REQUIRE(next <= previous);
+    previous = next;
+  }
+  CHECK(heap.getAllocationSize() == 10);
+}
+
+/** Test AHeapPriorityQueue iterators visit every item in heap order
+ */
+TEST_CASE("AHeapPriorityQueue<int> test iterators", "[iterator]")
+{
+  AHeapPriorityQueue<int> heap;
+  int values[] = {5, 1, 9, 3, 7, 2, 8};
+  heap.enqueueArray(values, 7);
+
+  // the items are in heap order, not sorted, but every item is there
+  CHECK(*heap.begin() == 9);
+  CHECK(distance(heap.begin(), heap.end()) == 7);
+  vector<int> items(heap.cbegin(), heap.cend());
+  CHECK(is_heap(items.begin(), items.end()));
+  sort(items.begin(), items.end());
+  CHECK(items == vector<int>({1, 2, 3, 5, 7, 8, 9}));
+}
+
+/** Test a heap restored from a binary snapshot dequeues in priority
+ * order
+ */
+TEST_CASE("AHeapPriorityQueue<Job> test binary snapshots", "[snapshot]")
+{
+  AHeapPriorityQueue<Job> priorityQueue;
+  srand(42);
+  for (int id = 1; id <= 1000; id++)
+  {
+    priorityQueue.enqueue(Job(rand() % 50, 0, 0, id));
+  }
+
+  stringstream snapshot;
+  priorityQueue.saveSnapshot(snapshot);
+  AHeapPriorityQueue<Job> restored;
+  restored.loadSnapshot(snapshot);
+  CHECK(restored.getSize() == 1000);
+
+  // the restored heap is still a heap, and new items go into it in order
+  restored.enqueue(Job(100, 0, 0, 1001));
+  restored.enqueue(Job(-1, 0, 0, 1002));
+  CHECK(restored.front().getId() == 1001);
+  restored.dequeue();
+
+  bool inOrder = true;
+  int lastPriority = restored.front().getPriority();
+  int count = 0;
+  while (not restored.isEmpty())
+  {
+    inOrder = inOrder and (restored.front().getPriority() <= lastPriority);
+    lastPriority = restored.front().getPriority();
+    restored.dequeue();
+    count++;
+  }
+  CHECK(inOrder);
+  CHECK(count == 1001);
+  CHECK(lastPriority == -1);
+
+  // items of equal priority keep the order they were first enqueued
+  // in through a snapshot, and items enqueued after it go behind them
+  AHeapPriorityQueue<Job> ties;
+  for (int id = 1; id <= 100; id++)
+  {
+    ties.enqueue(Job(id % 3, 0, 0, id));
+  }
+  stringstream tiesSnapshot;
+  ties.saveSnapshot(tiesSnapshot);
+  AHeapPriorityQueue<Job> restoredTies;
+  restoredTies.loadSnapshot(tiesSnapshot);
+  restoredTies.enqueue(Job(2, 0, 0, 101));
+
+  // the 33 jobs of priority 2 come first, then job 101
+  bool sameOrder = true;
+  for (int count = 0; count < 100; count++)
+  {
+    if (count == 33)
+    {
+      sameOrder = sameOrder and (restoredTies.dequeueValue().getId() == 101);
+    }
+    sameOrder = sameOrder and (restoredTies.dequeueValue().getId() == ties.dequeueValue().getId());
+  }
+  CHECK(sameOrder);
+  CHECK(restoredTies.isEmpty());
+
+  // a snapshot of an ordinary queue is built into a heap
+  AQueue<int> queue;
+  for (int value : {3, 9, 1, 7, 5})
+  {
+    queue.enqueue(value);
+  }
+  stringstream unorderedSnapshot;
+  queue.saveSnapshot(unorderedSnapshot);
+  AHeapPriorityQueue<int> heap;
+  heap.loadSnapshot(unorderedSnapshot);
+  for (int expected : {9, 7, 5, 3, 1})
+  {
+    CHECK(heap.front() == expected);
+    heap.dequeue();
+  }
+}
@@ -13,7 +13,10 @@
 #include "Job.hpp"
 #include "QueueException.hpp"
 #include "catch.hpp"
+#include <algorithm>
 #include <iostream>
+#include <sstream>
+#include <vector>
 using namespace std;
 
 /** Task 4: Test APriorityQueue<int> concrete array implementation of
@@ -339,3 +342,214 @@ TEST_CASE("APriorityQueue enqueue<Job> Test APriorityQueue using Job items", "[t
   CHECK(priorityQueue[3].getId() == 6);
 }
 
+/** Test priority queues construct Jobs in place with emplace and give
+ * them back in priority order with dequeueValue
+ */
+TEST_CASE("APriorityQueue<Job> test emplace and dequeueValue", "[move]")
+{
+  APriorityQueue<Job> priorityQueue;
+
+  // Job(priority, serviceTime, startTime, id)
+  priorityQueue.emplace(5, 0, 0, 1);
+  priorityQueue.emplace(10, 0, 0, 2);
+  priorityQueue.emplace(5, 0, 0, 3);
+  priorityQueue.emplace(7, 0, 0, 4);
+  CHECK(priorityQueue.getSize() == 4);
+
+  CHECK(priorityQueue.dequeueValue().getId() == 2);
+  CHECK(priorityQueue.dequeueValue().getId() == 4);
+  CHECK(priorityQueue.dequeueValue().getId() == 1);
+  CHECK(priorityQueue.dequeueValue().getId() == 3);
+  CHECK(priorityQueue.isEmpty());
+}
+
+/** Test a batch of Jobs merged into a wrapped priority queue comes out
+ * in the same order as enqueuing the Jobs one at a time
+ */
+TEST_CASE("APriorityQueue<Job> test batch enqueueArray merge", "[batch]")
+{
+  APriorityQueue<Job> batchQueue;
+  APriorityQueue<Job> singleQueue;
+
+  // wrap the circular buffer before the batch is merged in
+  for (int id = 1; id <= 8; id++)
+  {
+    batchQueue.enqueue(Job(id % 3, 0, 0, id));
+    singleQueue.enqueue(Job(id % 3, 0, 0, id));
+  }
+  for (int index = 0; index < 5; index++)
+  {
+    batchQueue.dequeue();
+    singleQueue.dequeue();
+  }
+
+  vector<Job> batch;
+  for (int id = 9; id <= 30; id++)
+  {
+    batch.push_back(Job((id * 7) % 5, 0, 0, id));
+    singleQueue.enqueue(batch.back());
+  }
+  batchQueue.enqueueRange(batch.begin(), batch.end());
+  CHECK(batchQueue.getSize() == singleQueue.getSize());
+  CHECK(batchQueue.str() == singleQueue.str());
+
+  Job out[30];
+  CHECK(batchQueue.dequeueInto(out, 30) == 25);
+  for (int index = 0; index < 25; index++)
+  {
+    REQUIRE(out[index].getId() == singleQueue.front().getId());
+    singleQueue.dequeue();
+  }
+  CHECK(batchQueue.isEmpty());
+}
+
+/** Test APriorityQueue iterators visit items in priority order
+ */
+TEST_CASE("APriorityQueue<int> test iterators", "[iterator]")
+{
+  APriorityQueue<int> queue;
+  int values[] = {5, 1, 9, 3, 7};
+  queue.enqueueArray(values, 5);
+
+  vector<int> inOrder(queue.begin(), queue.end());
+  CHECK(inOrder == vector<int>({9, 7, 5, 3, 1}));
+  CHECK(is_sorted(queue.begin(), queue.end(), [](int lhs, int rhs) { return lhs > rhs; }));
+}
+
+/** Test restoring a priority queue from a binary snapshot keeps it in
+ * priority order
+ */
+TEST_CASE("APriorityQueue<Job> test binary snapshots", "[snapshot]")
+{
+  int nextId = 1;
+  APriorityQueue<Job> priorityQueue;
+  priorityQueue.enqueue(Job(5, 0, 0, nextId++));
+  priorityQueue.enqueue(Job(10, 5, 5, nextId++));
+  priorityQueue.enqueue(Job(7, 1, 1, nextId++));
+  priorityQueue.enqueue(Job(5, 9, 9, nextId++));
+  priorityQueue.enqueue(Job(1, 2, 3, nextId++));
+
+  // a snapshot of a priority queue restores in the same order
+  stringstream snapshot;
+  priorityQueue.saveSnapshot(snapshot);
+  APriorityQueue<Job> restored;
+  restored.loadSnapshot(snapshot);
+  CHECK(restored == priorityQueue);
+
+  // a snapshot of an ordinary queue is put into priority order, equal
+  // priorities in the order they were saved
+  AQueue<Job> queue;
+  queue.enqueue(Job(5, 0, 0, 1));
+  queue.enqueue(Job(1, 0, 0, 2));
+  queue.enqueue(Job(10, 0, 0, 3));
+  queue.enqueue(Job(5, 0, 0, 4));
+  queue.enqueue(Job(7, 0, 0, 5));
+  stringstream unorderedSnapshot;
+  queue.saveSnapshot(unorderedSnapshot);
+  restored.loadSnapshot(unorderedSnapshot);
+
+  int expectedIds[] = {3, 5, 1, 4, 2};
+  for (int index = 0; index < 5; index++)
+  {
+    CHECK(restored.front().getId() == expectedIds[index]);
+    restored.dequeue();
+  }
+  CHECK(restored.isEmpty());
+}
+
+/** Test sorted insertion at the front, middle and back of queues whose
+ * circular buffer wraps around, compared to a stable sort of the
+ * values enqueued
+ */
+TEST_CASE("APriorityQueue<int> test sorted insertion into wrapped buffers", "[insertion]")
+{
+  // a queue wrapped around the end of its buffer, values 50 down to 20
+  APriorityQueue<int> priorityQueue;
+  for (int value = 60; value >= 20; value -= 2)
+  {
+    priorityQueue.enqueue(value);
+  }
+  for (int count = 0; count < 5; count++)
+  {
+    priorityQueue.dequeue();
+  }
+  for (int value = 18; value >= 10; value -= 2)
+  {
+    priorityQueue.enqueue(value);
+  }
+  int allocationSize = priorityQueue.getAllocationSize();
+
+  // insert at the back, the front, and either side of the middle
+  priorityQueue.enqueue(5);
+  priorityQueue.enqueue(99);
+  priorityQueue.enqueue(41);
+  priorityQueue.enqueue(19);
+  priorityQueue.enqueue(30);
+  CHECK(priorityQueue.getAllocationSize() >= allocationSize);
+  CHECK(priorityQueue.getSize() == 26);
+  CHECK(priorityQueue.front() == 99);
+
+  int previous = priorityQueue.dequeueValue();
+  while (not priorityQueue.isEmpty())
+  {
+    int next = priorityQueue.dequeueValue();
+    CHECK(next <= previous);
+    previous = next;
+  }
+
+  // random values inserted while the front moves around the buffer
+  vector<int> inserted;
+  unsigned int seed = 12345;
+  for (int round = 0; round < 2000; round++)
+  {
+    seed = seed * 1103515245 + 12345;
+    int value = (seed >> 16) % 50;
+    priorityQueue.enqueue(value);
+    inserted.push_back(value);
+    if (round % 3 == 2)
+    {
+      // removes the largest value inserted so far
+      auto largest = max_element(inserted.begin(), inserted.end());
+      CHECK(priorityQueue.dequeueValue() == *largest);
+      inserted.erase(largest);
+    }
+  }
+  sort(inserted.begin(), inserted.end(), greater<int>());
+  CHECK(priorityQueue.getSize() == static_cast<int>(inserted.size()));
+  for (int index = 0; index < priorityQueue.getSize(); index++)
+  {
+    CHECK(priorityQueue[index] == inserted[index]);
+  }
+}
+
+/** Test jobs of equal priority inserted at both ends and in the middle
+ * of a wrapped buffer stay in first-in-first-out order
+ */
+TEST_CASE("APriorityQueue<Job> test sorted insertion keeps ties in order", "[insertion]")
+{
+  vector<Job> inserted;
+  APriorityQueue<Job> priorityQueue;
+  int nextId = 1;
+  unsigned int seed = 777;
+  for (int round = 0; round < 600; round++)
+  {
+    seed = seed * 1103515245 + 12345;
+    Job job((seed >> 16) % 6, 0, 0, nextId++);
+    priorityQueue.enqueue(job);
+    inserted.push_back(job);
+    if (round % 4 == 3)
+    {
+      priorityQueue.dequeue();
+      stable_sort(inserted.begin(), inserted.end(), [](const Job& lhs, const Job& rhs) { return lhs > rhs; });
+      inserted.erase(inserted.begin());
+    }
+  }
+
+  stable_sort(inserted.begin(), inserted.end(), [](const Job& lhs, const Job& rhs) { return lhs > rhs; });
+  for (const Job& job : inserted)
+  {
+    CHECK(priorityQueue.front().getId() == job.getId());
+    priorityQueue.dequeue();
+  }
+  CHECK(priorityQueue.isEmpty());
+}
@@ -10,10 +10,20 @@
  * Tests of the array based implementation of the Queue API.
  */
 #include "AQueue.hpp"
+#include "Job.hpp"
 #include "QueueException.hpp"
+#include "QueueSnapshot.hpp"
 #include "catch.hpp"
+#include <algorithm>
+#include <climits>
 #include <cmath>
+#include <cstring>
 #include <iostream>
+#include <list>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
 using namespace std;
 
 /** Task 1: Test AQueue front() member method basic functionality.
@@ -632,3 +642,831 @@ TEST_CASE("AQueue<string> test string queue concrete array implementation", "[ta
   }
 }
 
+/** Test AQueue move aware enqueue, emplace and dequeueValue
+ */
+TEST_CASE("AQueue<string> test move enqueue, emplace and dequeueValue", "[move]")
+{
+  AQueue<string> queue;
+
+  // moving a value into the queue leaves the original moved from
+  string alpha = "alpha";
+  queue.enqueue(std::move(alpha));
+  CHECK(alpha.empty());
+
+  // copying a value into the queue leaves the original alone
+  string bravo = "bravo";
+  queue.enqueue(bravo);
+  CHECK(bravo == "bravo");
+
+  // emplace constructs the value from the constructor arguments
+  queue.emplace(3, 'c');
+  queue.emplace("delta");
+  CHECK(queue.getSize() == 4);
+  CHECK(queue.str() == "<queue> size: 4 front:[ alpha, bravo, ccc, delta ]:back");
+
+  // growing the queue moves the values into the new allocation, make sure
+  // they survive the move when the buffer is wrapped around
+  CHECK(queue.dequeueValue() == "alpha");
+  CHECK(queue.dequeueValue() == "bravo");
+  for (int index = 0; index < 10; index++)
+  {
+    queue.emplace(1, 'a' + index);
+  }
+  CHECK(queue.getSize() == 12);
+  CHECK(queue.getAllocationSize() == 20);
+  CHECK(queue.str() == "<queue> size: 12 front:[ ccc, delta, a, b, c, d, e, f, g, h, i, j ]:back");
+
+  // dequeueValue returns the front and removes it
+  CHECK(queue.dequeueValue() == "ccc");
+  CHECK(queue.dequeueValue() == "delta");
+  CHECK(queue.getSize() == 10);
+  CHECK(queue.front() == "a");
+
+  queue.clear();
+  CHECK_THROWS_AS(queue.dequeueValue(), QueueEmptyException);
+}
+
+/** Test AQueue with power of two capacity wraps indexes with a mask
+ */
+TEST_CASE("AQueue<int> test power of two capacity policy", "[capacity]")
+{
+  AQueue<int> queue(POWER_OF_TWO_CAPACITY);
+  CHECK(queue.getCapacityPolicy() == POWER_OF_TWO_CAPACITY);
+  CHECK(queue.getAllocationSize() == 0);
+
+  // initial allocation of 10 is rounded up to 16
+  queue.enqueue(1);
+  CHECK(queue.getAllocationSize() == 16);
+
+  // wrap the buffer around its end several times, values must still come
+  // back in first in first out order
+  for (int index = 2; index <= 16; index++)
+  {
+    queue.enqueue(index);
+  }
+  for (int round = 0; round < 40; round++)
+  {
+    CHECK(queue.front() == round + 1);
+    queue.dequeue();
+    queue.enqueue(round + 17);
+  }
+  CHECK(queue.getSize() == 16);
+  CHECK(queue.getAllocationSize() == 16);
+  CHECK(queue[0] == 41);
+  CHECK(queue[15] == 56);
+  CHECK_THROWS_AS(queue[16], QueueMemoryBoundsException);
+
+  // growing a wrapped queue doubles and stays a power of two
+  queue.enqueue(57);
+  CHECK(queue.getAllocationSize() == 32);
+  CHECK(queue.getSize() == 17);
+  CHECK(queue.front() == 41);
+  CHECK(queue.str() == "<queue> size: 17 front:[ 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57 ]:back");
+
+  // copies keep the policy and round their allocation
+  AQueue<int> copy = queue;
+  CHECK(copy.getCapacityPolicy() == POWER_OF_TWO_CAPACITY);
+  CHECK(copy.getAllocationSize() == 64);
+  CHECK(copy == queue);
+
+  // default policy is unchanged
+  AQueue<int> doubling;
+  CHECK(doubling.getCapacityPolicy() == DOUBLING_CAPACITY);
+
+  // sizes that can not be rounded up to a power of two
+  CHECK_THROWS_AS(queue.reserve((1 << 30) + 1), QueueMemoryBoundsException);
+  CHECK_THROWS_AS(queue.reserve(INT_MAX), QueueMemoryBoundsException);
+  CHECK_THROWS_AS(queue.enqueueArray(&queue[0], INT_MAX - queue.getSize()), QueueMemoryBoundsException);
+  CHECK(queue.getSize() == 17);
+  CHECK(queue.getAllocationSize() == 32);
+  CHECK(queue.getReservedSize() == 0);
+}
+
+/** Test AQueue batch enqueue and dequeue of arrays and ranges
+ */
+TEST_CASE("AQueue<int> test batch enqueueArray, enqueueRange and dequeueInto", "[batch]")
+{
+  SECTION("test batches that wrap around the circular buffer")
+  {
+    AQueue<int> queue;
+    int first[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    queue.enqueueArray(first, 10);
+    CHECK(queue.getSize() == 10);
+    CHECK(queue.getAllocationSize() == 10);
+
+    // make room at the start of the buffer, the next batch wraps into it
+    queue.dequeue();
+    queue.dequeue();
+    queue.dequeue();
+    int second[] = {11, 12, 13};
+    queue.enqueueArray(second, 3);
+    CHECK(queue.getAllocationSize() == 10);
+    CHECK(queue.str() == "<queue> size: 10 front:[ 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 ]:back");
+
+    // dequeue a batch that wraps around the end of the buffer
+    int out[20];
+    CHECK(queue.dequeueInto(out, 9) == 9);
+    for (int index = 0; index < 9; index++)
+    {
+      CHECK(out[index] == index + 4);
+    }
+    CHECK(queue.getSize() == 1);
+    CHECK(queue.front() == 13);
+
+    // asking for more items than there are only dequeues what is there
+    queue.enqueue(14);
+    CHECK(queue.dequeueInto(out, 20) == 2);
+    CHECK(out[0] == 13);
+    CHECK(out[1] == 14);
+    CHECK(queue.isEmpty());
+    CHECK(queue.dequeueInto(out, 20) == 0);
+
+    // the queue still works normally after batches
+    queue.enqueue(15);
+    CHECK(queue.front() == 15);
+    CHECK(queue.str() == "<queue> size: 1 front:[ 15 ]:back");
+  }
+
+  SECTION("test a large batch only grows the allocation once")
+  {
+    vector<int> values;
+    for (int index = 0; index < 25; index++)
+    {
+      values.push_back(index);
+    }
+
+    AQueue<int> doubling;
+    doubling.enqueueRange(values.begin(), values.end());
+    CHECK(doubling.getSize() == 25);
+    CHECK(doubling.getAllocationSize() == 25);
+    CHECK(doubling[24] == 24);
+
+    // a small batch still doubles, so single enqueues stay amortized O(1)
+    doubling.enqueueArray(values.data(), 1);
+    CHECK(doubling.getAllocationSize() == 50);
+
+    AQueue<int> powerOfTwo(POWER_OF_TWO_CAPACITY);
+    powerOfTwo.enqueueArray(values.data(), 25);
+    CHECK(powerOfTwo.getAllocationSize() == 32);
+    CHECK(powerOfTwo[24] == 24);
+  }
+
+  SECTION("test enqueueRange of a vector is not copied")
+  {
+    // a queue that remembers the block handed to enqueueArray()
+    class RecordingQueue : public AQueue<int>
+    {
+    public:
+      const int* lastItems = nullptr;
+
+      void enqueueArray(const int* items, int count)
+      {
+        lastItems = items;
+        AQueue<int>::enqueueArray(items, count);
+      }
+    };
+
+    vector<int> values = {1, 2, 3};
+    const vector<int>& constValues = values;
+    RecordingQueue queue;
+    queue.enqueueRange(values.begin(), values.end());
+    CHECK(queue.lastItems == values.data());
+    queue.enqueueRange(constValues.begin() + 1, constValues.end());
+    CHECK(queue.lastItems == values.data() + 1);
+    queue.enqueueRange(values.end(), values.end());
+    CHECK(queue.str() == "<queue> size: 5 front:[ 1, 2, 3, 2, 3 ]:back");
+  }
+
+  SECTION("test enqueueRange from a range that is not contiguous")
+  {
+    list<string> words = {"alpha", "bravo", "charlie"};
+    AQueue<string> queue;
+    queue.enqueue("zero");
+    queue.enqueueRange(words.begin(), words.end());
+    CHECK(queue.str() == "<queue> size: 4 front:[ zero, alpha, bravo, charlie ]:back");
+
+    string out[4];
+    CHECK(queue.dequeueInto(out, 4) == 4);
+    CHECK(out[0] == "zero");
+    CHECK(out[3] == "charlie");
+    CHECK(queue.isEmpty());
+  }
+}
+
+TEST_CASE("AQueue<int> test shrinking the allocation after a burst", "[capacity]")
+{
+  SECTION("test burst and drain shrinks back to the initial allocation")
+  {
+    AQueue<int> queue;
+    for (int cycle = 0; cycle < 3; cycle++)
+    {
+      // burst of 1000 items doubles up from 10 to 1280
+      for (int value = 0; value < 1000; value++)
+      {
+        queue.enqueue(value);
+      }
+      CHECK(queue.getAllocationSize() == 1280);
+
+      // allocation is halved only once less than a quarter full
+      while (queue.getSize() > 320)
+      {
+        queue.dequeue();
+      }
+      CHECK(queue.getAllocationSize() == 1280);
+      queue.dequeue();
+      CHECK(queue.getSize() == 319);
+      CHECK(queue.getAllocationSize() == 640);
+      CHECK(queue.front() == 681);
+
+      // drain the rest, values come back in order and the allocation
+      // never falls below the initial size
+      int expected = 681;
+      while (not queue.isEmpty())
+      {
+        CHECK(queue.getAllocationSize() >= queue.getSize());
+        CHECK(queue.dequeueValue() == expected);
+        expected++;
+      }
+      CHECK(expected == 1000);
+      CHECK(queue.getAllocationSize() == 10);
+    }
+  }
+
+  SECTION("test size hovering around a threshold does not thrash")
+  {
+    AQueue<int> queue;
+    for (int value = 0; value < 641; value++)
+    {
+      queue.enqueue(value);
+    }
+    CHECK(queue.getAllocationSize() == 1280);
+    while (queue.getSize() > 319)
+    {
+      queue.dequeue();
+    }
+    CHECK(queue.getAllocationSize() == 640);
+
+    // going back above the shrink threshold does not grow again, and
+    // dropping back below it does not shrink again
+    for (int round = 0; round < 100; round++)
+    {
+      queue.enqueue(round);
+      queue.enqueue(round);
+      queue.dequeue();
+      queue.dequeue();
+    }
+    CHECK(queue.getAllocationSize() == 640);
+
+    // must fill the halved allocation before growing again
+    while (queue.getSize() < 640)
+    {
+      queue.enqueue(0);
+    }
+    CHECK(queue.getAllocationSize() == 640);
+    queue.enqueue(0);
+    CHECK(queue.getAllocationSize() == 1280);
+  }
+
+  SECTION("test dequeueInto shrinks the allocation")
+  {
+    AQueue<int> queue;
+    vector<int> values(1000);
+    for (int index = 0; index < 1000; index++)
+    {
+      values[index] = index;
+    }
+    queue.enqueueArray(values.data(), 1000);
+    CHECK(queue.getAllocationSize() == 1000);
+
+    vector<int> out(1000);
+    CHECK(queue.dequeueInto(out.data(), 900) == 900);
+    CHECK(queue.getAllocationSize() == 500);
+    CHECK(queue.front() == 900);
+    CHECK(queue[99] == 999);
+  }
+
+  SECTION("test reserve sets a floor on the allocation")
+  {
+    AQueue<int> queue;
+    queue.reserve(500);
+    CHECK(queue.getReservedSize() == 500);
+    CHECK(queue.getAllocationSize() == 500);
+
+    for (int value = 0; value < 1000; value++)
+    {
+      queue.enqueue(value);
+    }
+    CHECK(queue.getAllocationSize() == 1000);
+    while (not queue.isEmpty())
+    {
+      queue.dequeue();
+    }
+    CHECK(queue.getAllocationSize() == 500);
+
+    // reserving less than the allocation does not shrink it
+    queue.reserve(100);
+    CHECK(queue.getAllocationSize() == 500);
+
+    // clear frees the memory, but the queue grows straight back to
+    // the reserved size
+    queue.clear();
+    CHECK(queue.getAllocationSize() == 0);
+    queue.enqueue(1);
+    CHECK(queue.getAllocationSize() == 100);
+    CHECK(queue.front() == 1);
+  }
+
+  SECTION("test shrinkToFit")
+  {
+    AQueue<int> queue;
+    for (int value = 0; value < 100; value++)
+    {
+      queue.enqueue(value);
+    }
+    queue.dequeue();
+    CHECK(queue.getAllocationSize() == 160);
+
+    queue.shrinkToFit();
+    CHECK(queue.getAllocationSize() == 99);
+    CHECK(queue.getSize() == 99);
+    CHECK(queue.front() == 1);
+    CHECK(queue[98] == 99);
+    queue.enqueue(100);
+    CHECK(queue.getAllocationSize() == 198);
+
+    // shrinking to fit drops the reservation, and an empty queue gives
+    // back all of its memory
+    queue.reserve(1000);
+    queue.shrinkToFit();
+    CHECK(queue.getReservedSize() == 0);
+    CHECK(queue.getAllocationSize() == 100);
+    queue.clear();
+    queue.enqueue(1);
+    queue.dequeue();
+    queue.shrinkToFit();
+    CHECK(queue.getAllocationSize() == 0);
+    CHECK(queue.isEmpty());
+    queue.enqueue(2);
+    CHECK(queue.getAllocationSize() == 10);
+    CHECK(queue.front() == 2);
+  }
+
+  SECTION("test shrinking keeps allocations a power of two")
+  {
+    AQueue<int> queue(POWER_OF_TWO_CAPACITY);
+    queue.reserve(100);
+    CHECK(queue.getAllocationSize() == 128);
+    for (int value = 0; value < 1000; value++)
+    {
+      queue.enqueue(value);
+    }
+    CHECK(queue.getAllocationSize() == 1024);
+    while (queue.getSize() > 10)
+    {
+      queue.dequeue();
+    }
+    CHECK(queue.getAllocationSize() == 128);
+    CHECK(queue.front() == 990);
+
+    queue.shrinkToFit();
+    CHECK(queue.getAllocationSize() == 16);
+    CHECK(queue.str() == "<queue> size: 10 front:[ 990, 991, 992, 993, 994, 995, 996, 997, 998, 999 ]:back");
+  }
+}
+
+/** Test AQueue iterators walk the circular buffer in two segments
+ */
+TEST_CASE("AQueue<int> test iterators", "[iterator]")
+{
+  SECTION("test empty queue has begin equal to end")
+  {
+    AQueue<int> queue;
+    CHECK(queue.begin() == queue.end());
+    CHECK(queue.cbegin() == queue.cend());
+    queue.enqueue(1);
+    queue.dequeue();
+    CHECK(queue.begin() == queue.end());
+  }
+
+  SECTION("test iterating values that wrap around the buffer")
+  {
+    AQueue<int> queue;
+    for (int value = 1; value <= 8; value++)
+    {
+      queue.enqueue(value);
+    }
+    for (int count = 0; count < 5; count++)
+    {
+      queue.dequeue();
+    }
+    for (int value = 9; value <= 14; value++)
+    {
+      queue.enqueue(value);
+    }
+    CHECK(queue.getAllocationSize() == 10);
+    CHECK(queue.getSize() == 9);
+
+    int expected = 6;
+    for (int value : queue)
+    {
+      CHECK(value == expected);
+      expected++;
+    }
+    CHECK(expected == 15);
+    CHECK(distance(queue.begin(), queue.end()) == 9);
+  }
+
+  SECTION("test iterating a full buffer that wraps around")
+  {
+    AQueue<int> queue;
+    for (int value = 1; value <= 10; value++)
+    {
+      queue.enqueue(value);
+    }
+    for (int count = 0; count < 3; count++)
+    {
+      queue.dequeue();
+    }
+    for (int value = 11; value <= 13; value++)
+    {
+      queue.enqueue(value);
+    }
+    CHECK(queue.getAllocationSize() == 10);
+    CHECK(queue.getSize() == 10);
+
+    vector<int> values(queue.begin(), queue.end());
+    CHECK(values == vector<int>({4, 5, 6, 7, 8, 9, 10, 11, 12, 13}));
+  }
+
+  SECTION("test STL algorithms and changing values through iterators")
+  {
+    AQueue<int> queue(POWER_OF_TWO_CAPACITY);
+    for (int value = 0; value < 16; value++)
+    {
+      queue.enqueue(value);
+    }
+    for (int count = 0; count < 10; count++)
+    {
+      queue.dequeue();
+      queue.enqueue(16 + count);
+    }
+
+    CHECK(*queue.begin() == 10);
+    CHECK(find(queue.begin(), queue.end(), 20) != queue.end());
+    CHECK(find(queue.begin(), queue.end(), 9) == queue.end());
+    CHECK(count_if(queue.begin(), queue.end(), [](int value) { return value % 2 == 0; }) == 8);
+    CHECK(*max_element(queue.cbegin(), queue.cend()) == 25);
+
+    for (int& value : queue)
+    {
+      value *= 10;
+    }
+    CHECK(queue.front() == 100);
+    CHECK(queue[15] == 250);
+
+    // iterators convert to const iterators
+    const AQueue<int>& constQueue = queue;
+    AQueue<int>::const_iterator iter = queue.begin();
+    CHECK(iter == constQueue.begin());
+    iter++;
+    CHECK(*iter == 110);
+  }
+}
+
+/** Test writing AQueue to a stream, in full and truncated
+ */
+TEST_CASE("AQueue<int> test write and output stream operator", "[write]")
+{
+  AQueue<int> queue;
+  ostringstream out;
+  queue.write(out);
+  CHECK(out.str() == "<queue> size: 0 front:[ ]:back");
+
+  // values wrapping around the circular buffer
+  for (int value = 1; value <= 10; value++)
+  {
+    queue.enqueue(value);
+  }
+  for (int value = 11; value <= 14; value++)
+  {
+    queue.dequeue();
+    queue.enqueue(value);
+  }
+
+  out.str("");
+  queue.write(out);
+  CHECK(out.str() == queue.str());
+  CHECK(out.str() == "<queue> size: 10 front:[ 5, 6, 7, 8, 9, 10, 11, 12, 13, 14 ]:back");
+
+  out.str("");
+  out << queue;
+  CHECK(out.str() == queue.str());
+
+  // truncated, including in the middle of the second segment
+  out.str("");
+  queue.write(out, 3);
+  CHECK(out.str() == "<queue> size: 10 front:[ 5, 6, 7, ... ]:back");
+  out.str("");
+  queue.write(out, 8);
+  CHECK(out.str() == "<queue> size: 10 front:[ 5, 6, 7, 8, 9, 10, 11, 12, ... ]:back");
+  out.str("");
+  queue.write(out, 0);
+  CHECK(out.str() == "<queue> size: 10 front:[ ... ]:back");
+
+  // asking for as many values or more than the queue has shows them all
+  out.str("");
+  queue.write(out, 10);
+  CHECK(out.str() == queue.str());
+  out.str("");
+  queue.write(out, 1000);
+  CHECK(out.str() == queue.str());
+}
+
+/** @brief A stream buffer over a string that can not seek, like a pipe,
+ *    to test loading snapshots from streams whose length is unknown
+ */
+class UnseekableBuffer : public streambuf
+{
+public:
+  /// @brief read the characters of the given string
+  explicit UnseekableBuffer(const string& contents)
+    : contents(contents)
+  {
+    setg(&this->contents[0], &this->contents[0], &this->contents[0] + this->contents.size());
+  }
+
+private:
+  /// @brief the characters read from the buffer
+  string contents;
+};
+
+/** @brief Write a snapshot of the given queue whose header claims the
+ *    given number of items, whatever the queue holds
+ */
+static string snapshotClaiming(const AQueue<int>& queue, uint64_t count)
+{
+  stringstream snapshot;
+  queue.saveSnapshot(snapshot);
+  string contents = snapshot.str();
+  memcpy(&contents[offsetof(QueueSnapshotHeader, count)], &count, sizeof(count));
+  return contents;
+}
+
+/** Test saving and restoring binary snapshots of array queues
+ */
+TEST_CASE("AQueue test binary snapshots", "[snapshot]")
+{
+  SECTION("test snapshot of values wrapping around the buffer")
+  {
+    AQueue<int> queue;
+    for (int value = 1; value <= 10; value++)
+    {
+      queue.enqueue(value);
+    }
+    for (int value = 11; value <= 16; value++)
+    {
+      queue.dequeue();
+      queue.enqueue(value);
+    }
+
+    stringstream snapshot;
+    queue.saveSnapshot(snapshot);
+
+    // a restored queue starts at index 0, so compare values not layout
+    AQueue<int> restored;
+    restored.enqueue(42);
+    restored.loadSnapshot(snapshot);
+    CHECK(restored.getSize() == 10);
+    CHECK(restored == queue);
+    CHECK(restored.str() == "<queue> size: 10 front:[ 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 ]:back");
+
+    // the restored queue is a working queue
+    restored.enqueue(17);
+    CHECK(restored.front() == 7);
+    restored.dequeue();
+    CHECK(restored.front() == 8);
+    CHECK(restored[9] == 17);
+  }
+
+  SECTION("test snapshot of an empty queue")
+  {
+    AQueue<int> queue;
+    stringstream snapshot;
+    queue.saveSnapshot(snapshot);
+
+    AQueue<int> restored;
+    restored.enqueue(1);
+    restored.loadSnapshot(snapshot);
+    CHECK(restored.isEmpty());
+    CHECK(restored.str() == "<queue> size: 0 front:[ ]:back");
+  }
+
+  SECTION("test snapshot of jobs keeps every field")
+  {
+    AQueue<Job> queue;
+    for (int id = 1; id <= 2000; id++)
+    {
+      Job job(id % 7, id % 11, id, id);
+      job.setEndTime(id + id % 13);
+      queue.enqueue(job);
+    }
+
+    stringstream snapshot;
+    queue.saveSnapshot(snapshot);
+
+    AQueue<Job> restored;
+    restored.loadSnapshot(snapshot);
+    CHECK(restored.getSize() == 2000);
+    bool allEqual = true;
+    for (int index = 0; index < 2000; index++)
+    {
+      const Job& expected = queue[index];
+      const Job& actual = restored[index];
+      allEqual = allEqual and (actual.getId() == expected.getId()) and (actual.getPriority() == expected.getPriority()) and
+                 (actual.getServiceTime() == expected.getServiceTime()) and
+                 (actual.getStartTime() == expected.getStartTime()) and (actual.getEndTime() == expected.getEndTime());
+    }
+    CHECK(allEqual);
+  }
+
+  SECTION("test invalid and truncated snapshots throw")
+  {
+    AQueue<int> queue;
+    for (int value = 1; value <= 5; value++)
+    {
+      queue.enqueue(value);
+    }
+
+    // not a snapshot at all
+    stringstream garbage("this is not a queue snapshot at all");
+    AQueue<int> restored;
+    CHECK_THROWS_AS(restored.loadSnapshot(garbage), QueueSnapshotException);
+
+    // a snapshot of a different item type
+    AQueue<Job> jobs;
+    jobs.enqueue(Job(1, 2, 3, 4));
+    stringstream jobSnapshot;
+    jobs.saveSnapshot(jobSnapshot);
+    CHECK_THROWS_AS(restored.loadSnapshot(jobSnapshot), QueueSnapshotException);
+
+    // a snapshot that ends early is rejected before the queue is
+    // changed, when the stream can seek to check its length
+    stringstream snapshot;
+    queue.saveSnapshot(snapshot);
+    string truncated = snapshot.str();
+    truncated.resize(truncated.size() - 1);
+    stringstream truncatedSnapshot(truncated);
+    restored.enqueue(42);
+    CHECK_THROWS_AS(restored.loadSnapshot(truncatedSnapshot), QueueSnapshotException);
+    CHECK(restored.getSize() == 1);
+    CHECK(restored.front() == 42);
+
+    // the same for a header claiming far more items than the stream
+    // holds, nothing is allocated for them
+    stringstream lyingSnapshot(snapshotClaiming(queue, 1 << 30));
+    CHECK_THROWS_AS(restored.loadSnapshot(lyingSnapshot), QueueSnapshotException);
+    CHECK(restored.getSize() == 1);
+    CHECK(restored.front() == 42);
+    CHECK(restored.getAllocationSize() == 10);
+
+    // a stream that can not seek is read in blocks, so the allocation
+    // only grows to fit the records that are actually there, and the
+    // queue is left empty when the stream ends early
+    UnseekableBuffer lyingBuffer(snapshotClaiming(queue, 1 << 30));
+    istream lyingStream(&lyingBuffer);
+    CHECK_THROWS_AS(restored.loadSnapshot(lyingStream), QueueSnapshotException);
+    CHECK(restored.isEmpty());
+    CHECK(restored.getAllocationSize() == 0);
+  }
+
+  SECTION("test snapshot loaded from a stream that can not seek")
+  {
+    AQueue<int> queue;
+    for (int value = 0; value < 200000; value++)
+    {
+      queue.enqueue(value);
+    }
+    stringstream snapshot;
+    queue.saveSnapshot(snapshot);
+
+    UnseekableBuffer buffer(snapshot.str());
+    istream unseekable(&buffer);
+    AQueue<int> restored;
+    restored.loadSnapshot(unseekable);
+    CHECK(restored.getSize() == 200000);
+    CHECK(restored == queue);
+  }
+
+  SECTION("test queues of strings can not be saved")
+  {
+    AQueue<string> queue;
+    queue.enqueue("alpha");
+    stringstream snapshot;
+    CHECK_THROWS_AS(queue.saveSnapshot(snapshot), QueueSnapshotException);
+    CHECK_THROWS_AS(queue.loadSnapshot(snapshot), QueueSnapshotException);
+    CHECK(queue.front() == "alpha");
+  }
+}
+
+/** Test searching queues and comparing them segment by segment
+ */
+TEST_CASE("AQueue test find, count, contains and equality", "[search]")
+{
+  SECTION("test empty queue")
+  {
+    AQueue<int> queue;
+    CHECK(queue.find(1) == -1);
+    CHECK(queue.count(1) == 0);
+    CHECK_FALSE(queue.contains(1));
+  }
+
+  SECTION("test values wrapping around the buffer")
+  {
+    // 37 values, wrapped so that neither segment is a whole number of
+    // SIMD blocks
+    AQueue<int> queue;
+    for (int value = 0; value < 40; value++)
+    {
+      queue.enqueue(value % 7);
+    }
+    for (int value = 40; value < 77; value++)
+    {
+      queue.dequeue();
+      queue.enqueue(value % 7);
+    }
+    for (int count = 0; count < 3; count++)
+    {
+      queue.dequeue();
+    }
+    CHECK(queue.getSize() == 37);
+
+    bool allFound = true;
+    for (int value = 0; value < 7; value++)
+    {
+      int expectedIndex = -1;
+      int expectedCount = 0;
+      for (int index = queue.getSize() - 1; index >= 0; index--)
+      {
+        if (queue[index] == value)
+        {
+          expectedIndex = index;
+          expectedCount++;
+        }
+      }
+      allFound = allFound and (queue.find(value) == expectedIndex) and (queue.count(value) == expectedCount) and
+                 queue.contains(value);
+    }
+    CHECK(allFound);
+    CHECK(queue.find(7) == -1);
+    CHECK(queue.count(7) == 0);
+    CHECK_FALSE(queue.contains(7));
+
+    // a value only in the second segment, at the back of the queue
+    queue.enqueue(100);
+    CHECK(queue.find(100) == 37);
+    CHECK(queue.count(100) == 1);
+  }
+
+  SECTION("test equality with queues wrapped differently")
+  {
+    AQueue<int> wrapped;
+    AQueue<int> unwrapped;
+    for (int value = 0; value < 50; value++)
+    {
+      wrapped.enqueue(value);
+    }
+    for (int value = 50; value < 95; value++)
+    {
+      wrapped.dequeue();
+      wrapped.enqueue(value);
+    }
+    for (int value = 45; value < 95; value++)
+    {
+      unwrapped.enqueue(value);
+    }
+    CHECK(wrapped == unwrapped);
+    CHECK(unwrapped == wrapped);
+
+    // a difference in each segment, and at the very back
+    for (int index : {0, 3, 20, 49})
+    {
+      int original = wrapped[index];
+      wrapped[index] = -1;
+      CHECK_FALSE(wrapped == unwrapped);
+      CHECK_FALSE(unwrapped == wrapped);
+      wrapped[index] = original;
+    }
+    CHECK(wrapped == unwrapped);
+  }
+
+  SECTION("test queues of strings")
+  {
+    AQueue<string> queue;
+    queue.enqueue("alpha");
+    queue.enqueue("beta");
+    queue.enqueue("alpha");
+    CHECK(queue.find("beta") == 1);
+    CHECK(queue.count("alpha") == 2);
+    CHECK_FALSE(queue.contains("gamma"));
+  }
+}
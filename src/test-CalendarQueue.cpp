@@ -0,0 +1,203 @@
+/** @file test-CalendarQueue.cpp
+ * @brief Unit tests for Assignment Queues
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Tests of the calendar queue implementation of the Queue API, which
+ * dequeues items in order of their integer timestamps.
+ */
+#include "CalendarQueue.hpp"
+#include "Job.hpp"
+#include "QueueException.hpp"
+#include "catch.hpp"
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+using namespace std;
+
+/** Test CalendarQueue basic queue functions
+ */
+TEST_CASE("CalendarQueue<int> test calendar queue of timestamps", "[calendar]")
+{
+  SECTION("test empty queue")
+  {
+    CalendarQueue<int> calendar;
+    CHECK(calendar.isEmpty());
+    CHECK(calendar.getSize() == 0);
+    CHECK(calendar.str() == "<queue> size: 0 front:[ ]:back");
+    CHECK_THROWS_AS(calendar.front(), QueueEmptyException);
+    CHECK_THROWS_AS(calendar.dequeue(), QueueEmptyException);
+    CHECK_THROWS_AS(calendar.dequeueValue(), QueueEmptyException);
+    CHECK_THROWS_AS(calendar[0], QueueMemoryBoundsException);
+  }
+
+  SECTION("test timestamps dequeue earliest first, including negative times")
+  {
+    int times[] = {50, 7, 7, -3, 1000000, 12, 0, -100, 49, 51};
+    CalendarQueue<int> calendar(10, times);
+    CHECK(calendar.getSize() == 10);
+    CHECK(calendar.front() == -100);
+
+    // an earlier time enqueued later becomes the front
+    calendar.enqueue(-200);
+    CHECK(calendar.front() == -200);
+
+    int expected[] = {-200, -100, -3, 0, 7, 7, 12, 49, 50, 51, 1000000};
+    for (int index = 0; index < 11; index++)
+    {
+      CHECK(calendar.dequeueValue() == expected[index]);
+    }
+    CHECK(calendar.isEmpty());
+    CHECK_THROWS_AS(calendar.front(), QueueEmptyException);
+  }
+
+  SECTION("test copy, equality, indexing and clear")
+  {
+    CalendarQueue<int> calendar;
+    for (int time = 0; time < 100; time += 3)
+    {
+      calendar.enqueue(time);
+    }
+    CalendarQueue<int> copy(calendar);
+    CHECK(copy == calendar);
+    CHECK(copy.getBucketCount() == calendar.getBucketCount());
+
+    // every index is in the queue once, in bucket order
+    vector<int> indexed;
+    for (int index = 0; index < calendar.getSize(); index++)
+    {
+      indexed.push_back(calendar[index]);
+    }
+    sort(indexed.begin(), indexed.end());
+    for (int index = 0; index < calendar.getSize(); index++)
+    {
+      CHECK(indexed[index] == 3 * index);
+    }
+    CHECK_THROWS_AS(calendar[calendar.getSize()], QueueMemoryBoundsException);
+
+    copy.dequeue();
+    CHECK_FALSE(copy == calendar);
+    CHECK(calendar.front() == 0);
+    CHECK(copy.front() == 3);
+
+    calendar.clear();
+    CHECK(calendar.isEmpty());
+    calendar.enqueue(5);
+    CHECK(calendar.front() == 5);
+  }
+
+  SECTION("test the calendar resizes as the queue grows and shrinks")
+  {
+    CalendarQueue<int> calendar;
+    for (int time = 0; time < 10000; time++)
+    {
+      calendar.enqueue(time * 10);
+    }
+    CHECK(calendar.getBucketCount() >= 2048);
+    CHECK(calendar.getBucketWidth() > 1);
+
+    for (int time = 0; time < 9990; time++)
+    {
+      CHECK(calendar.dequeueValue() == time * 10);
+    }
+    CHECK(calendar.getBucketCount() <= 32);
+  }
+
+  SECTION("test the calendar resizes while holding the extreme timestamps")
+  {
+    CalendarQueue<int> calendar;
+    calendar.enqueue(INT_MIN);
+    calendar.enqueue(INT_MAX);
+    for (int time = 0; time < 100; time++)
+    {
+      calendar.enqueue(time);
+    }
+    CHECK(calendar.getSize() == 102);
+    CHECK(calendar.getBucketCount() > 2);
+
+    CHECK(calendar.dequeueValue() == INT_MIN);
+    for (int time = 0; time < 100; time++)
+    {
+      CHECK(calendar.dequeueValue() == time);
+    }
+    CHECK(calendar.dequeueValue() == INT_MAX);
+    CHECK(calendar.isEmpty());
+  }
+}
+
+/** Test a calendar queue used as the event list of a simulation, with
+ * random hold operations, against a sorted reference
+ */
+TEST_CASE("CalendarQueue<int> test random hold operations", "[calendar]")
+{
+  mt19937 generator(2336);
+  exponential_distribution<double> increment(0.01);
+  uniform_int_distribution<int> coin(0, 3);
+
+  CalendarQueue<int> calendar;
+  multiset<int> reference;
+  for (int count = 0; count < 1000; count++)
+  {
+    int time = int(increment(generator));
+    calendar.enqueue(time);
+    reference.insert(time);
+  }
+
+  // dequeue the next event and schedule one or two later events, or
+  // none, so the queue grows and shrinks through several resizes
+  bool sameOrder = true;
+  for (int step = 0; step < 50000; step++)
+  {
+    int now = calendar.dequeueValue();
+    sameOrder = sameOrder and (now == *reference.begin());
+    reference.erase(reference.begin());
+
+    int scheduled = (step < 25000) ? (coin(generator) == 0 ? 2 : 1) : (coin(generator) == 0 ? 1 : 0);
+    for (int count = 0; count < scheduled; count++)
+    {
+      int time = now + int(increment(generator));
+      calendar.enqueue(time);
+      reference.insert(time);
+    }
+    if (reference.empty())
+    {
+      break;
+    }
+  }
+  CHECK(sameOrder);
+  CHECK(calendar.getSize() == int(reference.size()));
+}
+
+/** Test jobs are dequeued in order of their start times, and jobs
+ * with equal start times in the order they were enqueued
+ */
+TEST_CASE("CalendarQueue<Job> test jobs are scheduled by start time", "[calendar]")
+{
+  CalendarQueue<Job> calendar;
+  vector<Job> jobs;
+  int nextId = 1;
+  for (int count = 0; count < 3000; count++)
+  {
+    // many jobs share each start time, spread over far apart times so
+    // some are more than a year of the calendar away
+    int startTime = (count * 7919) % 50 * ((count % 3 == 0) ? 100000 : 10);
+    jobs.push_back(Job(1, 1, startTime, nextId++));
+    calendar.enqueue(jobs.back());
+  }
+  stable_sort(jobs.begin(), jobs.end(), [](const Job& lhs, const Job& rhs) { return lhs.getStartTime() < rhs.getStartTime(); });
+
+  bool sameOrder = true;
+  for (const Job& job : jobs)
+  {
+    sameOrder = sameOrder and (calendar.dequeueValue().getId() == job.getId());
+  }
+  CHECK(sameOrder);
+  CHECK(calendar.isEmpty());
+}
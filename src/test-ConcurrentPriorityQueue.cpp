@@ -0,0 +1,199 @@
+/** @file test-ConcurrentPriorityQueue.cpp
+ * @brief Unit tests for Assignment Queues
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Tests of the thread safe sharded implementation of the Priority
+ * Queue API.
+ */
+#include "APriorityQueue.hpp"
+#include "AQueue.hpp"
+#include "ConcurrentPriorityQueue.hpp"
+#include "QueueException.hpp"
+#include "catch.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/** Test ConcurrentPriorityQueue<int> from a single thread
+ */
+TEST_CASE("ConcurrentPriorityQueue<int> test sharded priority queue of integers", "[concurrent]")
+{
+  SECTION("test the strictness knob is kept within the shard count")
+  {
+    ConcurrentPriorityQueue<int> relaxed;
+    CHECK(relaxed.getShardCount() == 8);
+    CHECK(relaxed.getSampleCount() == 2);
+    CHECK_FALSE(relaxed.isStrict());
+
+    ConcurrentPriorityQueue<int> strict(4, 10);
+    CHECK(strict.getSampleCount() == 4);
+    CHECK(strict.isStrict());
+
+    ConcurrentPriorityQueue<int> single(4, 0);
+    CHECK(single.getSampleCount() == 1);
+  }
+
+  SECTION("test basic queue functions")
+  {
+    ConcurrentPriorityQueue<int> priorityQueue(4, 4);
+    CHECK(priorityQueue.isEmpty());
+    CHECK(priorityQueue.getSize() == 0);
+    CHECK(priorityQueue.str() == "<queue> size: 0 front:[ ]:back");
+    CHECK_THROWS_AS(priorityQueue.front(), QueueEmptyException);
+    CHECK_THROWS_AS(priorityQueue.dequeue(), QueueEmptyException);
+    CHECK_THROWS_AS(priorityQueue[0], QueueMemoryBoundsException);
+
+    priorityQueue.enqueue(5);
+    priorityQueue.enqueue(10);
+    priorityQueue.emplace(7);
+    CHECK(priorityQueue.getSize() == 3);
+    CHECK(priorityQueue.front() == 10);
+
+    CHECK(priorityQueue.dequeueValue() == 10);
+    CHECK(priorityQueue.front() == 7);
+    priorityQueue.dequeue();
+    int item;
+    CHECK(priorityQueue.tryDequeue(item));
+    CHECK(item == 5);
+    CHECK_FALSE(priorityQueue.tryDequeue(item));
+    CHECK(priorityQueue.isEmpty());
+
+    priorityQueue.enqueue(42);
+    priorityQueue.enqueue(43);
+    priorityQueue.clear();
+    CHECK(priorityQueue.isEmpty());
+    CHECK_THROWS_AS(priorityQueue.front(), QueueEmptyException);
+  }
+
+  SECTION("test queues are equal shard by shard")
+  {
+    ConcurrentPriorityQueue<int> priorityQueue(8, 2);
+    AQueue<int> layout;
+    CHECK(priorityQueue == layout);
+
+    // with a few items some of the shards are left empty
+    for (int value = 1; value <= 5; value++)
+    {
+      priorityQueue.enqueue(value);
+    }
+    priorityQueue.visitSegments([&layout](const int* segment, int count) {
+      layout.enqueueArray(segment, count);
+      return true;
+    });
+    CHECK(layout.getSize() == 5);
+    CHECK(priorityQueue == layout);
+
+    layout.dequeue();
+    layout.enqueue(42);
+    CHECK_FALSE(priorityQueue == layout);
+  }
+
+  SECTION("test strict queue dequeues in the same order as APriorityQueue")
+  {
+    ConcurrentPriorityQueue<int> strict(8, 8);
+    APriorityQueue<int> sorted;
+
+    srand(42);
+    for (int index = 0; index < 1000; index++)
+    {
+      int value = rand() % 100;
+      strict.enqueue(value);
+      sorted.enqueue(value);
+    }
+
+    CHECK(strict.getSize() == sorted.getSize());
+    while (not sorted.isEmpty())
+    {
+      REQUIRE(strict.dequeueValue() == sorted.front());
+      sorted.dequeue();
+    }
+    CHECK(strict.isEmpty());
+  }
+
+  SECTION("test relaxed queue dequeues every item exactly once")
+  {
+    ConcurrentPriorityQueue<int> relaxed(8, 1);
+    for (int index = 0; index < 1000; index++)
+    {
+      relaxed.enqueue(index);
+    }
+
+    vector<int> seen(1000, 0);
+    int item;
+    while (relaxed.tryDequeue(item))
+    {
+      seen[item]++;
+    }
+    for (int index = 0; index < 1000; index++)
+    {
+      REQUIRE(seen[index] == 1);
+    }
+    CHECK(relaxed.isEmpty());
+  }
+}
+
+/** Test ConcurrentPriorityQueue<int> with several threads enqueuing
+ * and dequeuing at once, every item must be dequeued exactly once.
+ */
+TEST_CASE("ConcurrentPriorityQueue<int> test several worker threads", "[concurrent]")
+{
+  const int NUM_THREADS = 4;
+  const int ITEMS_PER_THREAD = 20000;
+  ConcurrentPriorityQueue<int> priorityQueue(8, 2);
+
+  vector<vector<int>> dequeued(NUM_THREADS);
+  vector<thread> workers;
+  for (int worker = 0; worker < NUM_THREADS; worker++)
+  {
+    workers.push_back(thread([&, worker]() {
+      // each worker enqueues its own range of values, and dequeues
+      // an item for every other item it enqueues
+      int item;
+      for (int index = 0; index < ITEMS_PER_THREAD; index++)
+      {
+        priorityQueue.enqueue(worker * ITEMS_PER_THREAD + index);
+        if ((index % 2 == 1) and priorityQueue.tryDequeue(item))
+        {
+          dequeued[worker].push_back(item);
+        }
+      }
+    }));
+  }
+  for (thread& worker : workers)
+  {
+    worker.join();
+  }
+
+  // drain what is left from the main thread
+  int item;
+  while (priorityQueue.tryDequeue(item))
+  {
+    dequeued[0].push_back(item);
+  }
+  CHECK(priorityQueue.isEmpty());
+
+  vector<int> seen(NUM_THREADS * ITEMS_PER_THREAD, 0);
+  for (const vector<int>& items : dequeued)
+  {
+    for (int value : items)
+    {
+      seen[value]++;
+    }
+  }
+  int exactlyOnce = 0;
+  for (int count : seen)
+  {
+    if (count == 1)
+    {
+      exactlyOnce++;
+    }
+  }
+  CHECK(exactlyOnce == NUM_THREADS * ITEMS_PER_THREAD);
+}
@@ -0,0 +1,369 @@
+/** @file test-JobPriorityQueue.cpp
+ * @brief Unit tests for Assignment Queues
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Tests of the structure of arrays binary heap implementation of the
+ * Queue API for Job items.
+ */
+#include "APriorityQueue.hpp"
+#include "JobPriorityQueue.hpp"
+#include "Job.hpp"
+#include "QueueException.hpp"
+#include "catch.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+/** Test JobPriorityQueue basic priority queue functions
+ */
+TEST_CASE("JobPriorityQueue test structure of arrays job heap", "[jobheap]")
+{
+  SECTION("test empty queue")
+  {
+    JobPriorityQueue priorityQueue;
+    CHECK(priorityQueue.isEmpty());
+    CHECK(priorityQueue.getSize() == 0);
+    CHECK(priorityQueue.getAllocationSize() == 0);
+    CHECK(priorityQueue.str() == "<queue> size: 0 front:[ ]:back");
+    CHECK_THROWS_AS(priorityQueue.front(), QueueEmptyException);
+    CHECK_THROWS_AS(priorityQueue.dequeue(), QueueEmptyException);
+    CHECK_THROWS_AS(priorityQueue.dequeueValue(), QueueEmptyException);
+    CHECK_THROWS_AS(priorityQueue[0], QueueMemoryBoundsException);
+  }
+
+  SECTION("test equal priorities are first in first out")
+  {
+    JobPriorityQueue priorityQueue;
+    int nextId = 1;
+    priorityQueue.enqueue(Job(5, 0, 0, nextId++));
+    priorityQueue.enqueue(Job(10, 5, 5, nextId++));
+    priorityQueue.enqueue(Job(7, 1, 1, nextId++));
+    priorityQueue.enqueue(Job(3, 4, 5, nextId++));
+    priorityQueue.enqueue(Job(1, 2, 3, nextId++));
+    priorityQueue.enqueue(Job(5, 9, 9, nextId++));
+    priorityQueue.enqueue(Job(5, 9, 9, nextId++));
+    priorityQueue.enqueue(Job(10, 9, 9, nextId++));
+    CHECK(priorityQueue.getSize() == 8);
+    CHECK_THROWS_AS(priorityQueue[8], QueueMemoryBoundsException);
+
+    int expectedIds[] = {2, 8, 3, 1, 6, 7, 4, 5};
+    for (int index = 0; index < 8; index++)
+    {
+      CHECK(priorityQueue.front().getId() == expectedIds[index]);
+      priorityQueue.dequeue();
+    }
+    CHECK(priorityQueue.isEmpty());
+  }
+
+  SECTION("test negative priorities come after positive ones")
+  {
+    JobPriorityQueue priorityQueue;
+    priorityQueue.enqueue(Job(-5, 0, 0, 1));
+    priorityQueue.enqueue(Job(0, 0, 0, 2));
+    priorityQueue.enqueue(Job(-1, 0, 0, 3));
+    priorityQueue.enqueue(Job(2147483647, 0, 0, 4));
+    priorityQueue.enqueue(Job(-2147483647 - 1, 0, 0, 5));
+
+    int expectedIds[] = {4, 2, 3, 1, 5};
+    for (int index = 0; index < 5; index++)
+    {
+      CHECK(priorityQueue.dequeueValue().getId() == expectedIds[index]);
+    }
+  }
+
+  SECTION("test jobs keep their fields while slots are reused")
+  {
+    JobPriorityQueue priorityQueue;
+    for (int id = 1; id <= 100; id++)
+    {
+      Job job(id % 10, id, id + 1, id);
+      job.setEndTime(id + 2);
+      priorityQueue.enqueue(job);
+      if (id % 3 == 0)
+      {
+        priorityQueue.dequeue();
+      }
+    }
+    CHECK(priorityQueue.getSize() == 67);
+    CHECK(priorityQueue.getAllocationSize() == 128);
+
+    bool allKept = true;
+    for (int index = 0; index < priorityQueue.getSize(); index++)
+    {
+      const Job& job = priorityQueue[index];
+      allKept = allKept and (job.getServiceTime() == job.getId()) and (job.getStartTime() == job.getId() + 1) and
+                (job.getEndTime() == job.getId() + 2) and (job.getPriority() == job.getId() % 10);
+    }
+    CHECK(allKept);
+  }
+
+  SECTION("test copy constructor and clear")
+  {
+    JobPriorityQueue priorityQueue;
+    for (int id = 1; id <= 20; id++)
+    {
+      priorityQueue.enqueue(Job(id % 4, 0, 0, id));
+    }
+    priorityQueue.dequeue();
+
+    JobPriorityQueue copy = priorityQueue;
+    CHECK(copy == priorityQueue);
+    CHECK(copy.str() == priorityQueue.str());
+
+    // the copy and the original are separate queues
+    copy.enqueue(Job(100, 0, 0, 21));
+    CHECK(copy.front().getId() == 21);
+    CHECK(priorityQueue.front().getId() == 7);
+    while (not priorityQueue.isEmpty())
+    {
+      copy.dequeue();
+      CHECK(copy.front().getId() == priorityQueue.front().getId());
+      priorityQueue.dequeue();
+    }
+
+    copy.clear();
+    CHECK(copy.isEmpty());
+    CHECK(copy.getAllocationSize() == 0);
+    copy.enqueue(Job(1, 0, 0, 1));
+    CHECK(copy.front().getId() == 1);
+  }
+}
+
+/** Test JobPriorityQueue dequeues in the same order as the
+ * APriorityQueue<Job>, for single enqueues and for batches
+ */
+TEST_CASE("JobPriorityQueue test dequeue order matches APriorityQueue<Job>", "[jobheap]")
+{
+  srand(42);
+  vector<Job> jobs;
+  for (int id = 1; id <= 2000; id++)
+  {
+    jobs.push_back(Job(rand() % 20 - 10, rand() % 100, id, id));
+  }
+
+  SECTION("test single enqueues and dequeues")
+  {
+    APriorityQueue<Job> expected;
+    JobPriorityQueue priorityQueue;
+    bool sameOrder = true;
+    for (int index = 0; index < 2000; index++)
+    {
+      expected.enqueue(jobs[index]);
+      priorityQueue.enqueue(jobs[index]);
+      if (index % 5 == 4)
+      {
+        sameOrder = sameOrder and (expected.dequeueValue().getId() == priorityQueue.dequeueValue().getId());
+      }
+    }
+    while (not expected.isEmpty())
+    {
+      sameOrder = sameOrder and (expected.dequeueValue().getId() == priorityQueue.dequeueValue().getId());
+    }
+    CHECK(sameOrder);
+    CHECK(priorityQueue.isEmpty());
+  }
+
+  SECTION("test batches rebuilding the heap and sifting up")
+  {
+    APriorityQueue<Job> expected;
+    JobPriorityQueue priorityQueue;
+
+    // first batch builds the heap bottom up, later smaller ones sift up
+    expected.enqueueArray(jobs.data(), 1000);
+    priorityQueue.enqueueArray(jobs.data(), 1000);
+    for (int start = 1000; start < 2000; start += 100)
+    {
+      expected.enqueueArray(jobs.data() + start, 100);
+      priorityQueue.enqueueArray(jobs.data() + start, 100);
+    }
+    CHECK(priorityQueue.getSize() == 2000);
+
+    bool sameOrder = true;
+    while (not expected.isEmpty())
+    {
+      sameOrder = sameOrder and (expected.dequeueValue().getId() == priorityQueue.dequeueValue().getId());
+    }
+    CHECK(sameOrder);
+  }
+
+  SECTION("test array based constructor")
+  {
+    APriorityQueue<Job> expected;
+    expected.enqueueArray(jobs.data(), 2000);
+    JobPriorityQueue priorityQueue(2000, jobs.data());
+
+    bool sameOrder = true;
+    while (not expected.isEmpty())
+    {
+      sameOrder = sameOrder and (expected.dequeueValue().getId() == priorityQueue.dequeueValue().getId());
+    }
+    CHECK(sameOrder);
+  }
+}
+
+/** Test changing the priority of and removing jobs by their id
+ */
+TEST_CASE("JobPriorityQueue test indexed updatePriority, erase and contains", "[indexed]")
+{
+  SECTION("test looking up ids")
+  {
+    JobPriorityQueue priorityQueue;
+    CHECK_FALSE(priorityQueue.contains(1));
+    CHECK_THROWS_AS(priorityQueue.updatePriority(1, 5), QueueKeyException);
+    CHECK_THROWS_AS(priorityQueue.erase(1), QueueKeyException);
+
+    priorityQueue.enqueue(Job(5, 0, 0, 1));
+    priorityQueue.enqueue(Job(7, 0, 0, 2));
+    CHECK(priorityQueue.contains(1));
+    CHECK(priorityQueue.contains(2));
+    CHECK_FALSE(priorityQueue.contains(3));
+    CHECK_THROWS_AS(priorityQueue.enqueue(Job(9, 0, 0, 2)), QueueKeyException);
+    CHECK(priorityQueue.getSize() == 2);
+
+    priorityQueue.dequeue();
+    CHECK_FALSE(priorityQueue.contains(2));
+    priorityQueue.enqueue(Job(9, 0, 0, 2));
+    CHECK(priorityQueue.front().getId() == 2);
+
+    priorityQueue.clear();
+    CHECK_FALSE(priorityQueue.contains(1));
+  }
+
+  SECTION("test raised priority keeps enqueue order among equal priorities")
+  {
+    JobPriorityQueue priorityQueue;
+    priorityQueue.enqueue(Job(10, 0, 0, 1));
+    priorityQueue.enqueue(Job(5, 0, 0, 2));
+    priorityQueue.enqueue(Job(1, 0, 0, 3));
+    priorityQueue.enqueue(Job(10, 0, 0, 4));
+
+    // job 3 was enqueued before job 4, so comes before it once aged
+    priorityQueue.updatePriority(3, 10);
+    priorityQueue.updatePriority(1, 0);
+    CHECK(priorityQueue.front().getPriority() == 10);
+
+    int expectedIds[] = {3, 4, 2, 1};
+    int expectedPriorities[] = {10, 10, 5, 0};
+    for (int index = 0; index < 4; index++)
+    {
+      Job job = priorityQueue.dequeueValue();
+      CHECK(job.getId() == expectedIds[index]);
+      CHECK(job.getPriority() == expectedPriorities[index]);
+    }
+  }
+
+  SECTION("test erase from the front, middle and back of the heap")
+  {
+    JobPriorityQueue priorityQueue;
+    for (int id = 1; id <= 10; id++)
+    {
+      priorityQueue.enqueue(Job(id, 0, 0, id));
+    }
+    priorityQueue.erase(10);
+    priorityQueue.erase(5);
+    priorityQueue.erase(1);
+    CHECK(priorityQueue.getSize() == 7);
+    CHECK_FALSE(priorityQueue.contains(5));
+
+    int expectedIds[] = {9, 8, 7, 6, 4, 3, 2};
+    for (int index = 0; index < 7; index++)
+    {
+      CHECK(priorityQueue.dequeueValue().getId() == expectedIds[index]);
+    }
+  }
+
+  SECTION("test duplicate id in a batch keeps the jobs before it")
+  {
+    JobPriorityQueue priorityQueue;
+    priorityQueue.enqueue(Job(1, 0, 0, 3));
+    Job batch[] = {Job(5, 0, 0, 1), Job(9, 0, 0, 2), Job(7, 0, 0, 3), Job(8, 0, 0, 4)};
+    CHECK_THROWS_AS(priorityQueue.enqueueArray(batch, 4), QueueKeyException);
+    CHECK(priorityQueue.getSize() == 3);
+    CHECK_FALSE(priorityQueue.contains(4));
+
+    int expectedIds[] = {2, 1, 3};
+    for (int index = 0; index < 3; index++)
+    {
+      CHECK(priorityQueue.dequeueValue().getId() == expectedIds[index]);
+    }
+  }
+
+  SECTION("test random updates and erases through growth match a sorted reference")
+  {
+    srand(2021);
+    JobPriorityQueue priorityQueue;
+    vector<Job> reference;
+    int nextId = 1;
+    for (int round = 0; round < 3000; round++)
+    {
+      int action = rand() % 4;
+      if ((action <= 1) or reference.empty())
+      {
+        Job job(rand() % 50, 0, 0, nextId++);
+        priorityQueue.enqueue(job);
+        reference.push_back(job);
+      }
+      else if (action == 2)
+      {
+        int index = rand() % reference.size();
+        int priority = rand() % 50;
+        priorityQueue.updatePriority(reference[index].getId(), priority);
+        reference[index].setPriority(priority);
+      }
+      else
+      {
+        int index = rand() % reference.size();
+        priorityQueue.erase(reference[index].getId());
+        reference.erase(reference.begin() + index);
+      }
+    }
+
+    // reference is in enqueue order, so a stable sort by priority gives
+    // the dequeue order
+    stable_sort(reference.begin(), reference.end(), [](const Job& lhs, const Job& rhs) { return lhs > rhs; });
+    CHECK(priorityQueue.getSize() == static_cast<int>(reference.size()));
+    JobPriorityQueue copy(priorityQueue);
+    bool sameOrder = true;
+    for (const Job& job : reference)
+    {
+      Job dequeued = priorityQueue.dequeueValue();
+      sameOrder = sameOrder and (dequeued.getId() == job.getId()) and (dequeued.getPriority() == job.getPriority());
+      sameOrder = sameOrder and copy.contains(job.getId());
+      copy.erase(job.getId());
+    }
+    CHECK(sameOrder);
+    CHECK(copy.isEmpty());
+  }
+}
+
+/** Test growing and copying the job heap does not construct jobs of
+ * its own, which would use up job ids
+ */
+TEST_CASE("JobPriorityQueue test growing does not advance job ids", "[jobheap]")
+{
+  Job before;
+
+  JobPriorityQueue queue;
+  for (int id = 1; id <= 1000; id++)
+  {
+    queue.enqueue(Job(id % 5, 1, id, id));
+  }
+  CHECK(queue.getAllocationSize() >= 1000);
+  JobPriorityQueue copy = queue;
+  CHECK(copy == queue);
+  for (int count = 0; count < 500; count++)
+  {
+    queue.dequeue();
+  }
+  queue.clear();
+
+  Job after;
+  CHECK(after.getId() == before.getId() + 1);
+}
@@ -0,0 +1,219 @@
+/** @file test-JobSchedulerSimulator.cpp
+ * @brief Unit tests for Assignment Queues
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Tests of the discrete event job scheduling simulator.
+ */
+#include "AHeapPriorityQueue.hpp"
+#include "APriorityQueue.hpp"
+#include "AQueue.hpp"
+#include "Job.hpp"
+#include "JobPriorityQueue.hpp"
+#include "JobSchedulerSimulator.hpp"
+#include "LPriorityQueue.hpp"
+#include "LQueue.hpp"
+#include "catch.hpp"
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/** Test the simulator rejects parameters it can not simulate
+ */
+TEST_CASE("JobSchedulerSimulator test invalid configurations", "[simulator]")
+{
+  SimulationConfig config;
+  CHECK_NOTHROW(JobSchedulerSimulator(config));
+
+  config.arrivalRate = 0.0;
+  CHECK_THROWS_AS(JobSchedulerSimulator(config), invalid_argument);
+
+  config = SimulationConfig();
+  config.numServers = 0;
+  CHECK_THROWS_AS(JobSchedulerSimulator(config), invalid_argument);
+
+  config = SimulationConfig();
+  config.serviceDistribution = UNIFORM_SERVICE;
+  config.minServiceTime = 5;
+  config.maxServiceTime = 4;
+  CHECK_THROWS_AS(JobSchedulerSimulator(config), invalid_argument);
+
+  config = SimulationConfig();
+  config.priorityMix = {0.0, 0.0};
+  CHECK_THROWS_AS(JobSchedulerSimulator(config), invalid_argument);
+}
+
+/** Test simulations of an idle system, where no job ever has to wait
+ */
+TEST_CASE("JobSchedulerSimulator test jobs never wait on an idle system", "[simulator]")
+{
+  SimulationConfig config;
+  config.numJobs = 1000;
+  config.arrivalRate = 0.0001;
+  config.serviceDistribution = CONSTANT_SERVICE;
+  config.meanServiceTime = 1.0;
+  JobSchedulerSimulator simulator(config);
+
+  AQueue<Job> jobQueue;
+  SimulationResult result = simulator.simulate(jobQueue);
+  CHECK(jobQueue.isEmpty());
+  CHECK(result.jobs == 1000);
+  CHECK(result.events == 3000);
+  CHECK(result.totalCost == 0);
+  CHECK(result.maxWaitTime == 0);
+  CHECK(result.maxQueueSize == 1);
+  CHECK(result.utilization < 0.01);
+}
+
+/** Test queues with the same scheduling policy give the same results,
+ * and a priority policy lowers the cost of a busy system
+ */
+TEST_CASE("JobSchedulerSimulator test scheduling policies of the queues", "[simulator]")
+{
+  SimulationConfig config;
+  config.numJobs = 20000;
+  config.arrivalRate = 0.19;
+  config.numServers = 2;
+  config.serviceDistribution = CONSTANT_SERVICE;
+  JobSchedulerSimulator simulator(config);
+
+  AQueue<Job> aQueue;
+  LQueue<Job> lQueue;
+  SimulationResult fifo = simulator.simulate(aQueue);
+  SimulationResult linkedFifo = simulator.simulate(lQueue);
+  CHECK(fifo.jobs == 20000);
+  CHECK(fifo.events == 60000);
+  CHECK(fifo.totalCost == linkedFifo.totalCost);
+  CHECK(fifo.maxWaitTime == linkedFifo.maxWaitTime);
+  CHECK(fifo.maxQueueSize == linkedFifo.maxQueueSize);
+  CHECK(fifo.utilization > 0.8);
+  CHECK(fifo.utilization < 1.0);
+  CHECK(fifo.medianWaitTime <= fifo.p90WaitTime);
+  CHECK(fifo.p90WaitTime <= fifo.p99WaitTime);
+  CHECK(fifo.p99WaitTime <= fifo.maxWaitTime);
+
+  APriorityQueue<Job> aPriorityQueue;
+  LPriorityQueue<Job> lPriorityQueue;
+  AHeapPriorityQueue<Job> heap;
+  JobPriorityQueue jobHeap;
+  SimulationResult priority = simulator.simulate(aPriorityQueue);
+  CHECK(simulator.simulate(lPriorityQueue).totalCost == priority.totalCost);
+  CHECK(simulator.simulate(heap).totalCost == priority.totalCost);
+  CHECK(simulator.simulate(jobHeap).totalCost == priority.totalCost);
+
+  // with equal service times the jobs wait as long on average, but high
+  // priority jobs wait less, so the cost is lower and the longest waits
+  // are longer
+  CHECK(priority.meanWaitTime == Approx(fifo.meanWaitTime));
+  CHECK(priority.totalCost < fifo.totalCost);
+  CHECK(priority.maxWaitTime > fifo.maxWaitTime);
+}
+
+/** Test parallel replications give the same results as running each
+ * replication on its own, whatever the number of threads
+ */
+TEST_CASE("JobSchedulerSimulator test parallel replications", "[simulator]")
+{
+  SimulationConfig config;
+  config.numJobs = 5000;
+  JobSchedulerSimulator simulator(config);
+
+  vector<SimulationResult> parallel = simulator.simulateReplications<JobPriorityQueue>(6, 4);
+  vector<SimulationResult> serial = simulator.simulateReplications<AHeapPriorityQueue<Job>>(6, 1);
+  REQUIRE(parallel.size() == 6);
+  REQUIRE(serial.size() == 6);
+  for (int replication = 0; replication < 6; replication++)
+  {
+    JobSchedulerSimulator replicationSimulator(simulator.replicationConfig(replication));
+    JobPriorityQueue jobQueue;
+    SimulationResult expected = replicationSimulator.simulate(jobQueue);
+    CHECK(parallel[replication].totalCost == expected.totalCost);
+    CHECK(parallel[replication].maxWaitTime == expected.maxWaitTime);
+    CHECK(serial[replication].totalCost == expected.totalCost);
+  }
+
+  // each replication draws its own stream of jobs
+  CHECK(simulator.replicationConfig(0).seed != simulator.replicationConfig(1).seed);
+  CHECK(parallel[0].totalCost != parallel[1].totalCost);
+
+  SimulationSummary summary = JobSchedulerSimulator::summarize(parallel);
+  CHECK(summary.runs == 6);
+  CHECK(summary.jobs == 30000);
+  long long totalCost = 0;
+  int maxWaitTime = 0;
+  for (const SimulationResult& result : parallel)
+  {
+    totalCost += result.totalCost;
+    maxWaitTime = max(maxWaitTime, result.maxWaitTime);
+  }
+  CHECK(summary.totalCost == totalCost);
+  CHECK(summary.maxWaitTime == maxWaitTime);
+  CHECK(summary.meanCostHalfWidth > 0.0);
+  CHECK(summary.meanWaitTimeHalfWidth > 0.0);
+}
+
+/** Test parallel sweeps keep the results in configuration order, and
+ * reject bad configurations before running
+ */
+TEST_CASE("JobSchedulerSimulator test parallel parameter sweep", "[simulator]")
+{
+  vector<SimulationConfig> configs;
+  for (int servers = 1; servers <= 4; servers++)
+  {
+    SimulationConfig config;
+    config.numJobs = 4000;
+    config.arrivalRate = 0.09 * servers;
+    config.numServers = servers;
+    configs.push_back(config);
+  }
+
+  vector<SimulationResult> results = JobSchedulerSimulator::simulateSweep<AQueue<Job>>(configs, 3);
+  REQUIRE(results.size() == 4);
+  for (int index = 0; index < 4; index++)
+  {
+    AQueue<Job> jobQueue;
+    CHECK(results[index].totalCost == JobSchedulerSimulator(configs[index]).simulate(jobQueue).totalCost);
+  }
+
+  // more servers sharing the same load keep jobs waiting less
+  CHECK(results[3].meanWaitTime < results[0].meanWaitTime);
+
+  configs[2].numServers = 0;
+  CHECK_THROWS_AS(JobSchedulerSimulator::simulateSweep<AQueue<Job>>(configs, 3), invalid_argument);
+}
+
+/** Test jobs created on several threads at once still get unique ids
+ */
+TEST_CASE("Job test default ids are unique across threads", "[simulator]")
+{
+  const int JOBS_PER_THREAD = 10000;
+  vector<vector<int>> ids(4);
+  vector<thread> threads;
+  for (int threadNumber = 0; threadNumber < 4; threadNumber++)
+  {
+    threads.emplace_back([&ids, threadNumber]() {
+      for (int count = 0; count < JOBS_PER_THREAD; count++)
+      {
+        ids[threadNumber].push_back(Job().getId());
+      }
+    });
+  }
+  for (thread& worker : threads)
+  {
+    worker.join();
+  }
+
+  set<int> uniqueIds;
+  for (const vector<int>& threadIds : ids)
+  {
+    uniqueIds.insert(threadIds.begin(), threadIds.end());
+  }
+  CHECK(uniqueIds.size() == 4 * JOBS_PER_THREAD);
+}
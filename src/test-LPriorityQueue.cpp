@@ -9,11 +9,14 @@
  *
  * Tests of the array based implementation of the Priority Queue API.
  */
+#include "APriorityQueue.hpp"
 #include "Job.hpp"
 #include "LPriorityQueue.hpp"
 #include "QueueException.hpp"
 #include "catch.hpp"
+#include <algorithm>
 #include <iostream>
+#include <vector>
 using namespace std;
 
 /** Task 5: Test LPriorityQueue<int> concrete array implementation of
@@ -241,3 +244,149 @@ TEST_CASE("LPriorityQueue enqueue<Job> Test LPriorityQueue using Job items", "[t
   CHECK(priorityQueue[3].getId() == 12);
 }
 
+/** Test LPriorityQueue sorted insertion keeps the same order as the
+ * array based APriorityQueue, including for equal priority Jobs
+ */
+TEST_CASE("LPriorityQueue<Job> test sorted insertion matches APriorityQueue", "[task5]")
+{
+  LPriorityQueue<Job> linkedQueue;
+  APriorityQueue<Job> arrayQueue;
+
+  // priorities cycle through a small range so many items have equal
+  // priority, and some land on the front, back and middle of the queue
+  for (int id = 1; id <= 200; id++)
+  {
+    int priority = (id * 7) % 11;
+    linkedQueue.enqueue(Job(priority, 0, 0, id));
+    arrayQueue.enqueue(Job(priority, 0, 0, id));
+  }
+  CHECK(linkedQueue.getSize() == 200);
+  CHECK(linkedQueue.str() == arrayQueue.str());
+
+  while (not arrayQueue.isEmpty())
+  {
+    REQUIRE(linkedQueue.front().getId() == arrayQueue.front().getId());
+    linkedQueue.dequeue();
+    arrayQueue.dequeue();
+  }
+  CHECK(linkedQueue.isEmpty());
+}
+
+/** Test a batch of Jobs merged into the linked priority queue comes out
+ * in the same order as enqueuing the Jobs one at a time
+ */
+TEST_CASE("LPriorityQueue<Job> test batch enqueueArray merge", "[batch]")
+{
+  LPriorityQueue<Job> batchQueue;
+  LPriorityQueue<Job> singleQueue;
+
+  // merging into an empty queue, and then into a non empty one
+  for (int round = 0; round < 2; round++)
+  {
+    vector<Job> batch;
+    for (int id = 1; id <= 30; id++)
+    {
+      batch.push_back(Job((id * 7) % 5, 0, 0, round * 100 + id));
+      singleQueue.enqueue(batch.back());
+    }
+    batchQueue.enqueueArray(batch.data(), 30);
+    CHECK(batchQueue.str() == singleQueue.str());
+  }
+
+  // the back node must be right after the merge for later enqueues
+  batchQueue.enqueue(Job(0, 0, 0, 999));
+  singleQueue.enqueue(Job(0, 0, 0, 999));
+  CHECK(batchQueue.str() == singleQueue.str());
+
+  Job out[61];
+  CHECK(batchQueue.dequeueInto(out, 61) == 61);
+  for (int index = 0; index < 61; index++)
+  {
+    REQUIRE(out[index].getId() == singleQueue.front().getId());
+    singleQueue.dequeue();
+  }
+  CHECK(batchQueue.isEmpty());
+}
+
+/** Test the skip list index of the linked priority queue stays in step
+ * with the list through long runs of mixed operations, by checking the
+ * order against the array based APriorityQueue
+ */
+TEST_CASE("LPriorityQueue<Job> test indexed insertion through mixed operations", "[task5]")
+{
+  LPriorityQueue<Job> linkedQueue;
+  APriorityQueue<Job> arrayQueue;
+
+  // the queue grows to a few thousand items, so the index has several
+  // levels, while dequeues keep removing the front entries of the index
+  int id = 1;
+  for (int round = 0; round < 40; round++)
+  {
+    for (int count = 0; count < 100; count++, id++)
+    {
+      int priority = (id * 7919) % 53;
+      linkedQueue.enqueue(Job(priority, 0, 0, id));
+      arrayQueue.enqueue(Job(priority, 0, 0, id));
+    }
+
+    vector<Job> batch;
+    for (int count = 0; count < 20; count++, id++)
+    {
+      batch.push_back(Job((id * 104729) % 53, 0, 0, id));
+      arrayQueue.enqueue(batch.back());
+    }
+    linkedQueue.enqueueArray(batch.data(), batch.size());
+
+    for (int count = 0; count < 30; count++)
+    {
+      REQUIRE(linkedQueue.front().getId() == arrayQueue.front().getId());
+      linkedQueue.dequeue();
+      arrayQueue.dequeue();
+    }
+
+    Job out[15];
+    REQUIRE(linkedQueue.dequeueInto(out, 15) == 15);
+    for (int index = 0; index < 15; index++)
+    {
+      REQUIRE(out[index].getId() == arrayQueue.front().getId());
+      arrayQueue.dequeue();
+    }
+  }
+  CHECK(linkedQueue.getSize() == 3000);
+  CHECK(linkedQueue.str() == arrayQueue.str());
+
+  // a copy gets its own index of the copied list
+  LPriorityQueue<Job> copyQueue = linkedQueue;
+  copyQueue.enqueue(Job(26, 0, 0, id));
+  arrayQueue.enqueue(Job(26, 0, 0, id));
+  while (not arrayQueue.isEmpty())
+  {
+    REQUIRE(copyQueue.front().getId() == arrayQueue.front().getId());
+    copyQueue.dequeue();
+    arrayQueue.dequeue();
+  }
+  CHECK(copyQueue.isEmpty());
+  CHECK(linkedQueue.getSize() == 3000);
+
+  // a cleared queue starts over with an empty index
+  linkedQueue.clear();
+  linkedQueue.enqueue(Job(1, 0, 0, 1));
+  linkedQueue.enqueue(Job(3, 0, 0, 2));
+  linkedQueue.enqueue(Job(2, 0, 0, 3));
+  CHECK(linkedQueue.front().getId() == 2);
+  CHECK(linkedQueue[1].getId() == 3);
+  CHECK(linkedQueue[2].getId() == 1);
+}
+
+/** Test LPriorityQueue iterators visit items in priority order
+ */
+TEST_CASE("LPriorityQueue<int> test iterators", "[iterator]")
+{
+  LPriorityQueue<int> queue;
+  int values[] = {5, 1, 9, 3, 7};
+  queue.enqueueArray(values, 5);
+
+  vector<int> inOrder(queue.begin(), queue.end());
+  CHECK(inOrder == vector<int>({9, 7, 5, 3, 1}));
+  CHECK(is_sorted(queue.cbegin(), queue.cend(), [](int lhs, int rhs) { return lhs > rhs; }));
+}
@@ -9,10 +9,15 @@
  *
  * Tests of the linked list based implementation of the Queue API.
  */
+#include "AQueue.hpp"
 #include "LQueue.hpp"
 #include "QueueException.hpp"
+#include "ULQueue.hpp"
 #include "catch.hpp"
+#include <algorithm>
 #include <iostream>
+#include <sstream>
+#include <vector>
 using namespace std;
 
 /** Test LQueue<int> concrete linked list implementation of queue of integers
@@ -409,3 +414,205 @@ TEST_CASE("LQueue<string> test string queue concrete linked list implementation"
     CHECK_FALSE(queue == copy);
   }
 }
+
+/** Test LQueue move aware enqueue, emplace and dequeueValue
+ */
+TEST_CASE("LQueue<string> test move enqueue, emplace and dequeueValue", "[move]")
+{
+  LQueue<string> queue;
+
+  string alpha = "alpha";
+  queue.enqueue(std::move(alpha));
+  CHECK(alpha.empty());
+
+  string bravo = "bravo";
+  queue.enqueue(bravo);
+  CHECK(bravo == "bravo");
+
+  queue.emplace(3, 'c');
+  CHECK(queue.getSize() == 3);
+  CHECK(queue.str() == "<queue> size: 3 front:[ alpha, bravo, ccc ]:back");
+
+  CHECK(queue.dequeueValue() == "alpha");
+  CHECK(queue.dequeueValue() == "bravo");
+  CHECK(queue.dequeueValue() == "ccc");
+  CHECK(queue.isEmpty());
+  CHECK_THROWS_AS(queue.dequeueValue(), QueueEmptyException);
+}
+
+/** Test LQueue batch enqueue and dequeue link and unlink whole chains
+ */
+TEST_CASE("LQueue<int> test batch enqueueArray, enqueueRange and dequeueInto", "[batch]")
+{
+  LQueue<int> queue;
+  int first[] = {1, 2, 3, 4, 5};
+  queue.enqueueArray(first, 5);
+  CHECK(queue.getSize() == 5);
+  CHECK(queue.front() == 1);
+
+  vector<int> second = {6, 7, 8};
+  queue.enqueueRange(second.begin(), second.end());
+  queue.enqueue(9);
+  CHECK(queue.str() == "<queue> size: 9 front:[ 1, 2, 3, 4, 5, 6, 7, 8, 9 ]:back");
+
+  int out[20];
+  CHECK(queue.dequeueInto(out, 4) == 4);
+  CHECK(out[0] == 1);
+  CHECK(out[3] == 4);
+  CHECK(queue.getSize() == 5);
+  CHECK(queue.front() == 5);
+
+  // the dequeued nodes were given back to the pool for the next batch
+  long recycled = queue.getNodePool().getNodesRecycled();
+  queue.enqueueArray(first, 4);
+  CHECK(queue.getNodePool().getNodesRecycled() == recycled + 4);
+  CHECK(queue.str() == "<queue> size: 9 front:[ 5, 6, 7, 8, 9, 1, 2, 3, 4 ]:back");
+
+  // dequeuing everything leaves a usable empty queue
+  CHECK(queue.dequeueInto(out, 20) == 9);
+  CHECK(out[8] == 4);
+  CHECK(queue.isEmpty());
+  CHECK(queue.dequeueInto(out, 20) == 0);
+  queue.enqueueArray(first, 0);
+  CHECK(queue.isEmpty());
+  queue.enqueue(42);
+  CHECK(queue.front() == 42);
+  CHECK(queue.str() == "<queue> size: 1 front:[ 42 ]:back");
+}
+
+/** Test LQueue iterators follow the links from front to back
+ */
+TEST_CASE("LQueue<string> test iterators", "[iterator]")
+{
+  LQueue<string> queue;
+  CHECK(queue.begin() == queue.end());
+
+  string values[] = {"alpha", "bravo", "charlie", "delta"};
+  queue.enqueueArray(values, 4);
+  queue.dequeue();
+  queue.enqueue("echo");
+
+  vector<string> expected = {"bravo", "charlie", "delta", "echo"};
+  CHECK(vector<string>(queue.begin(), queue.end()) == expected);
+  CHECK(queue.begin()->size() == 5);
+
+  for (string& value : queue)
+  {
+    value += "!";
+  }
+  CHECK(queue.str() == "<queue> size: 4 front:[ bravo!, charlie!, delta!, echo! ]:back");
+
+  const LQueue<string>& constQueue = queue;
+  CHECK(find(constQueue.begin(), constQueue.end(), "delta!") != constQueue.end());
+  CHECK(count(queue.cbegin(), queue.cend(), "alpha!") == 0);
+}
+
+/** Test operator== between the different kinds of queue
+ */
+TEST_CASE("Queue<int> test equality across queue implementations", "[equality]")
+{
+  // the array queue wraps around its circular buffer, and the unrolled
+  // queue starts part way through a block
+  AQueue<int> arrayQueue;
+  LQueue<int> linkedQueue;
+  ULQueue<int> unrolledQueue;
+  for (int value = 0; value < 5; value++)
+  {
+    arrayQueue.enqueue(-1);
+    unrolledQueue.enqueue(-1);
+  }
+  for (int value = 0; value < 100; value++)
+  {
+    arrayQueue.enqueue(value);
+    linkedQueue.enqueue(value);
+    unrolledQueue.enqueue(value);
+    if (value < 5)
+    {
+      arrayQueue.dequeue();
+      unrolledQueue.dequeue();
+    }
+  }
+
+  CHECK(arrayQueue == linkedQueue);
+  CHECK(arrayQueue == unrolledQueue);
+  CHECK(linkedQueue == arrayQueue);
+  CHECK(linkedQueue == unrolledQueue);
+  CHECK(unrolledQueue == arrayQueue);
+  CHECK(unrolledQueue == linkedQueue);
+
+  // a difference anywhere is found, including the first and last value
+  for (int index : {0, 37, 99})
+  {
+    linkedQueue[index] = -2;
+    CHECK_FALSE(arrayQueue == linkedQueue);
+    CHECK_FALSE(linkedQueue == arrayQueue);
+    CHECK_FALSE(unrolledQueue == linkedQueue);
+    CHECK_FALSE(linkedQueue == unrolledQueue);
+    linkedQueue[index] = index;
+    CHECK(linkedQueue == unrolledQueue);
+  }
+
+  // different sizes are never equal
+  linkedQueue.dequeue();
+  CHECK_FALSE(arrayQueue == linkedQueue);
+  CHECK_FALSE(linkedQueue == arrayQueue);
+  LQueue<int> emptyLinked;
+  AQueue<int> emptyArray;
+  CHECK(emptyLinked == emptyArray);
+  CHECK(emptyArray == emptyLinked);
+}
+
+/** Test visitSegments hands over every value in order and can stop early
+ */
+TEST_CASE("Queue<int> test visitSegments", "[equality]")
+{
+  AQueue<int> arrayQueue;
+  for (int value = 0; value < 10; value++)
+  {
+    arrayQueue.enqueue(value);
+  }
+  for (int value = 10; value < 14; value++)
+  {
+    arrayQueue.dequeue();
+    arrayQueue.enqueue(value);
+  }
+
+  // wrapped array queue has two segments
+  vector<int> visited;
+  int segments = 0;
+  CHECK(arrayQueue.visitSegments([&](const int* segment, int count) {
+    visited.insert(visited.end(), segment, segment + count);
+    segments++;
+    return true;
+  }));
+  CHECK(segments == 2);
+  CHECK(visited == vector<int>({4, 5, 6, 7, 8, 9, 10, 11, 12, 13}));
+
+  // stopping early
+  LQueue<int> linkedQueue;
+  linkedQueue.enqueueArray(visited.data(), 10);
+  int seen = 0;
+  CHECK_FALSE(linkedQueue.visitSegments([&](const int* segment, int count) {
+    seen += count;
+    return *segment < 6;
+  }));
+  CHECK(seen == 3);
+}
+
+/** Test writing LQueue to a stream, in full and truncated
+ */
+TEST_CASE("LQueue<string> test write and output stream operator", "[write]")
+{
+  LQueue<string> queue;
+  string values[] = {"alpha", "bravo", "charlie", "delta"};
+  queue.enqueueArray(values, 4);
+
+  ostringstream out;
+  out << queue;
+  CHECK(out.str() == "<queue> size: 4 front:[ alpha, bravo, charlie, delta ]:back");
+  CHECK(out.str() == queue.str());
+
+  out.str("");
+  queue.write(out, 2);
+  CHECK(out.str() == "<queue> size: 4 front:[ alpha, bravo, ... ]:back");
+}
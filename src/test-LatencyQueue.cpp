@@ -0,0 +1,203 @@
+/** @file test-LatencyQueue.cpp
+ * @brief Unit tests for Assignment Queues
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Tests of the latency histogram, and of the LatencyQueue wrapper that
+ * records the latencies of the operations of any queue.
+ */
+#include "AHeapPriorityQueue.hpp"
+#include "AQueue.hpp"
+#include "Job.hpp"
+#include "LatencyHistogram.hpp"
+#include "LatencyQueue.hpp"
+#include "QueueException.hpp"
+#include "catch.hpp"
+#include <iostream>
+#include <string>
+using namespace std;
+
+/** Test the LatencyHistogram percentiles
+ */
+TEST_CASE("LatencyHistogram test latency percentiles", "[latency]")
+{
+  SECTION("test empty histogram")
+  {
+    LatencyHistogram histogram;
+    CHECK(histogram.getCount() == 0);
+    CHECK(histogram.getMinimum() == 0);
+    CHECK(histogram.getMaximum() == 0);
+    CHECK(histogram.getMean() == Approx(0.0));
+    CHECK(histogram.percentile(50.0) == 0);
+    CHECK(histogram.str() == "<latency> count: 0 mean: 0.0 p50: 0 p99: 0 p999: 0 max: 0");
+  }
+
+  SECTION("test small latencies are counted exactly")
+  {
+    LatencyHistogram histogram;
+    for (int latency = 1; latency <= 50; latency++)
+    {
+      histogram.record(latency);
+    }
+    CHECK(histogram.getCount() == 50);
+    CHECK(histogram.getMinimum() == 1);
+    CHECK(histogram.getMaximum() == 50);
+    CHECK(histogram.getMean() == Approx(25.5));
+    CHECK(histogram.percentile(0.0) == 1);
+    CHECK(histogram.percentile(50.0) == 25);
+    CHECK(histogram.percentile(90.0) == 45);
+    CHECK(histogram.percentile(100.0) == 50);
+    CHECK(histogram.str() == "<latency> count: 50 mean: 25.5 p50: 25 p99: 50 p999: 50 max: 50");
+  }
+
+  SECTION("test large latencies are within the relative precision")
+  {
+    // one million latencies from 1 microsecond to 1 millisecond
+    LatencyHistogram histogram;
+    for (long long latency = 1000; latency <= 1000000; latency++)
+    {
+      histogram.record(latency);
+    }
+
+    double percents[] = {10.0, 50.0, 99.0, 99.9};
+    for (double percent : percents)
+    {
+      long long exact = 1000 + (long long)(percent / 100.0 * (1000000 - 1000 + 1)) - 1;
+      long long found = histogram.percentile(percent);
+      CHECK(found >= exact);
+      CHECK(found <= exact + exact / 64 + 1);
+    }
+    CHECK(histogram.percentile(100.0) == 1000000);
+  }
+
+  SECTION("test tail latencies show in the high percentiles")
+  {
+    // 998 fast operations and 2 slow ones, like a queue that grows
+    // twice while being filled
+    LatencyHistogram histogram;
+    for (int operation = 0; operation < 998; operation++)
+    {
+      histogram.record(20);
+    }
+    histogram.record(50000);
+    histogram.record(1000000);
+    CHECK(histogram.percentile(50.0) == 20);
+    CHECK(histogram.percentile(99.0) == 20);
+    CHECK(histogram.percentile(99.9) >= 50000);
+    CHECK(histogram.percentile(99.9) <= 50000 + 50000 / 64);
+    CHECK(histogram.getMaximum() == 1000000);
+  }
+
+  SECTION("test out of range latencies and adding histograms")
+  {
+    LatencyHistogram histogram;
+    histogram.record(-5);
+    histogram.record(1LL << 50);
+    CHECK(histogram.getMinimum() == 0);
+    CHECK(histogram.percentile(100.0) == (1LL << 50));
+
+    LatencyHistogram other;
+    other.record(100);
+    histogram += other;
+    CHECK(histogram.getCount() == 3);
+    CHECK(histogram.percentile(50.0) == 100);
+
+    histogram.reset();
+    CHECK(histogram.getCount() == 0);
+    CHECK(histogram.getMaximum() == 0);
+  }
+}
+
+/** Test the LatencyQueue passes on and times queue operations
+ */
+TEST_CASE("LatencyQueue<int> test timing the operations of a queue", "[latency]")
+{
+  SECTION("test operations are passed on to the wrapped queue")
+  {
+    AQueue<int> fifo;
+    LatencyQueue<int> queue(fifo);
+    CHECK(queue.isEmpty());
+    CHECK_THROWS_AS(queue.front(), QueueEmptyException);
+    CHECK_THROWS_AS(queue.dequeue(), QueueEmptyException);
+    CHECK(queue.getDequeueLatency().getCount() == 0);
+
+    for (int value = 1; value <= 5; value++)
+    {
+      queue.enqueue(value);
+    }
+    int values[] = {6, 7, 8};
+    queue.enqueueArray(values, 3);
+
+    CHECK(queue.getSize() == 8);
+    CHECK(fifo.getSize() == 8);
+    CHECK(queue.front() == 1);
+    CHECK(queue[7] == 8);
+    CHECK(queue == fifo);
+    CHECK(queue.str() == "<queue> size: 8 front:[ 1, 2, 3, 4, 5, 6, 7, 8 ]:back");
+
+    CHECK(queue.dequeueValue() == 1);
+    queue.dequeue();
+    int out[3];
+    CHECK(queue.dequeueInto(out, 3) == 3);
+    CHECK(out[0] == 3);
+    CHECK(out[2] == 5);
+    CHECK(fifo.front() == 6);
+
+    // a batch is timed as a single operation
+    CHECK(queue.getEnqueueLatency().getCount() == 6);
+    CHECK(queue.getDequeueLatency().getCount() == 3);
+
+    queue.clear();
+    CHECK(fifo.isEmpty());
+  }
+
+  SECTION("test recording can be turned on and off")
+  {
+    AHeapPriorityQueue<int> heap;
+    LatencyQueue<int> queue(heap, false);
+    CHECK_FALSE(queue.isRecording());
+    for (int value = 0; value < 100; value++)
+    {
+      queue.enqueue(value);
+    }
+    CHECK(queue.getEnqueueLatency().getCount() == 0);
+
+    queue.setRecording(true);
+    for (int value = 0; value < 100; value++)
+    {
+      queue.enqueue(value);
+    }
+    while (not queue.isEmpty())
+    {
+      queue.dequeue();
+    }
+    CHECK(queue.getEnqueueLatency().getCount() == 100);
+    CHECK(queue.getDequeueLatency().getCount() == 200);
+    CHECK(queue.getDequeueLatency().percentile(50.0) <= queue.getDequeueLatency().getMaximum());
+
+    queue.resetLatency();
+    CHECK(queue.getEnqueueLatency().getCount() == 0);
+    CHECK(queue.getDequeueLatency().getCount() == 0);
+  }
+}
+
+/** Test the LatencyQueue with a priority queue of jobs
+ */
+TEST_CASE("LatencyQueue<Job> test timing a priority queue of jobs", "[latency]")
+{
+  AHeapPriorityQueue<Job> heap;
+  LatencyQueue<Job> queue(heap);
+  queue.enqueue(Job(1, 10, 0, 1));
+  queue.enqueue(Job(5, 10, 1, 2));
+  queue.emplace(3, 10, 2, 3);
+
+  CHECK(queue.dequeueValue().getId() == 2);
+  CHECK(queue.dequeueValue().getId() == 3);
+  CHECK(queue.dequeueValue().getId() == 1);
+  CHECK(queue.getEnqueueLatency().getCount() == 3);
+  CHECK(queue.getDequeueLatency().getCount() == 3);
+}
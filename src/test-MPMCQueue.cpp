@@ -0,0 +1,178 @@
+/** @file test-MPMCQueue.cpp
+ * @brief Unit tests for Assignment Queues
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Tests of the lock-free multi producer multi consumer bounded
+ * implementation of the Queue API.
+ */
+#include "AQueue.hpp"
+#include "Job.hpp"
+#include "MPMCQueue.hpp"
+#include "QueueException.hpp"
+#include "catch.hpp"
+#include <climits>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/** Test MPMCQueue<int> basic queue functions from a single thread
+ */
+TEST_CASE("MPMCQueue<int> test bounded lock-free queue of integers", "[mpmc]")
+{
+  SECTION("test capacity is rounded up to a power of two")
+  {
+    CHECK(MPMCQueue<int>(5).getCapacity() == 8);
+    CHECK(MPMCQueue<int>(1).getCapacity() == 2);
+    CHECK(MPMCQueue<int>().getCapacity() == 1024);
+
+    // capacities that can not be rounded up to a power of two
+    CHECK_THROWS_AS(MPMCQueue<int>((1 << 30) + 1), QueueMemoryBoundsException);
+    CHECK_THROWS_AS(MPMCQueue<int>(INT_MAX), QueueMemoryBoundsException);
+  }
+
+  SECTION("test basic queue functions")
+  {
+    MPMCQueue<int> queue(4);
+    CHECK(queue.isEmpty());
+    CHECK(queue.getSize() == 0);
+    CHECK(queue.str() == "<queue> size: 0 front:[ ]:back");
+    CHECK_THROWS_AS(queue.front(), QueueEmptyException);
+    CHECK_THROWS_AS(queue.dequeue(), QueueEmptyException);
+    CHECK_THROWS_AS(queue.dequeueValue(), QueueEmptyException);
+    CHECK_THROWS_AS(queue[0], QueueMemoryBoundsException);
+
+    queue.enqueue(1);
+    queue.enqueue(2);
+    queue.emplace(3);
+    CHECK(queue.getSize() == 3);
+    CHECK(queue.front() == 1);
+    CHECK(queue[2] == 3);
+    CHECK(queue.str() == "<queue> size: 3 front:[ 1, 2, 3 ]:back");
+
+    int values[] = {1, 2, 3};
+    AQueue<int> expected(3, values);
+    CHECK(queue == expected);
+
+    queue.dequeue();
+    CHECK(queue.front() == 2);
+    CHECK(queue.dequeueValue() == 2);
+    int item;
+    queue.waitDequeue(item);
+    CHECK(item == 3);
+    CHECK(queue.isEmpty());
+
+    queue.enqueue(4);
+    queue.clear();
+    CHECK(queue.isEmpty());
+    CHECK_FALSE(queue.tryDequeue(item));
+  }
+
+  SECTION("test try enqueue fails when full and wraps around the buffer")
+  {
+    MPMCQueue<int> queue(4);
+    for (int index = 0; index < 4; index++)
+    {
+      CHECK(queue.tryEnqueue(index));
+    }
+    CHECK(queue.getSize() == 4);
+    CHECK_FALSE(queue.tryEnqueue(99));
+
+    int item;
+    for (int index = 4; index < 100; index++)
+    {
+      CHECK(queue.tryDequeue(item));
+      CHECK(item == index - 4);
+      CHECK(queue.tryEnqueue(index));
+    }
+    CHECK(queue.str() == "<queue> size: 4 front:[ 96, 97, 98, 99 ]:back");
+  }
+}
+
+/** Test MPMCQueue<Job> passes every item exactly once between several
+ * producer and consumer threads, and that each consumer sees the items
+ * of any one producer in the order they were enqueued.
+ */
+TEST_CASE("MPMCQueue<Job> test several producer and consumer threads", "[mpmc]")
+{
+  const int NUM_THREADS = 4;
+  const int JOBS_PER_PRODUCER = 20000;
+  MPMCQueue<Job> queue(64);
+
+  vector<thread> threads;
+  for (int producer = 0; producer < NUM_THREADS; producer++)
+  {
+    threads.push_back(thread([&queue, producer]() {
+      for (int index = 0; index < JOBS_PER_PRODUCER; index++)
+      {
+        // the priority records which producer enqueued the job
+        queue.enqueue(Job(producer, index, index, index));
+      }
+    }));
+  }
+
+  atomic<int> remaining(NUM_THREADS * JOBS_PER_PRODUCER);
+  vector<long> idSums(NUM_THREADS, 0);
+  vector<int> outOfOrder(NUM_THREADS, 0);
+
+  // the jobs the consumers dequeue into are constructed up front, since
+  // constructing a default Job is not safe from several threads at once
+  vector<Job> received(NUM_THREADS);
+  for (int consumer = 0; consumer < NUM_THREADS; consumer++)
+  {
+    threads.push_back(thread([&, consumer]() {
+      vector<int> lastId(NUM_THREADS, -1);
+      Job& job = received[consumer];
+      while (remaining.fetch_sub(1) > 0)
+      {
+        queue.waitDequeue(job);
+        int producer = job.getPriority();
+        if (job.getId() <= lastId[producer])
+        {
+          outOfOrder[consumer]++;
+        }
+        lastId[producer] = job.getId();
+        idSums[consumer] += job.getId();
+      }
+    }));
+  }
+
+  for (thread& worker : threads)
+  {
+    worker.join();
+  }
+
+  long totalIds = 0;
+  for (int consumer = 0; consumer < NUM_THREADS; consumer++)
+  {
+    CHECK(outOfOrder[consumer] == 0);
+    totalIds += idSums[consumer];
+  }
+  long expectedIds = static_cast<long>(NUM_THREADS) * JOBS_PER_PRODUCER * (JOBS_PER_PRODUCER - 1) / 2;
+  CHECK(totalIds == expectedIds);
+  CHECK(queue.isEmpty());
+}
+
+/** Test MPMCQueue<Job> dequeueValue() moves the job out of the buffer
+ * without default constructing one, which would use up a job id
+ */
+TEST_CASE("MPMCQueue<Job> test dequeueValue does not advance job ids", "[mpmc]")
+{
+  MPMCQueue<Job> queue(8);
+  queue.enqueue(Job(1, 2, 3, 101));
+  queue.enqueue(Job(4, 5, 6, 102));
+  Job before;
+
+  CHECK(queue.dequeueValue().getId() == 101);
+  CHECK(queue.dequeueValue().getId() == 102);
+  CHECK_THROWS_WITH(queue.dequeueValue(), Catch::Contains("<MPMCQueue>::dequeueValue()"));
+
+  Job after;
+  CHECK(after.getId() == before.getId() + 1);
+}
@@ -0,0 +1,208 @@
+/** @file test-NodePool.cpp
+ * @brief Unit tests for Assignment Queues
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Tests of the pooled node allocator used by the linked list based
+ * queues.
+ */
+#include "Job.hpp"
+#include "LPriorityQueue.hpp"
+#include "LQueue.hpp"
+#include "NodePool.hpp"
+#include "catch.hpp"
+#include <iostream>
+#include <string>
+using namespace std;
+
+/** Test NodePool allocates nodes in chunks and recycles released nodes
+ */
+TEST_CASE("NodePool<int> test chunked allocation and recycling", "[pool]")
+{
+  NodePool<int> pool(4);
+  CHECK(pool.getChunkSize() == 4);
+  CHECK(pool.getChunksAllocated() == 0);
+  CHECK(pool.getNodesRecycled() == 0);
+
+  // the first 4 nodes all come from the first chunk, one after another
+  Node<int>* nodes[5];
+  for (int index = 0; index < 4; index++)
+  {
+    nodes[index] = pool.allocate(index);
+  }
+  CHECK(pool.getChunksAllocated() == 1);
+  CHECK(nodes[1] == nodes[0] + 1);
+  CHECK(nodes[3] == nodes[0] + 3);
+
+  // the next node needs a new chunk
+  nodes[4] = pool.allocate(4);
+  CHECK(pool.getChunksAllocated() == 2);
+  CHECK(pool.getNodesRecycled() == 0);
+
+  // released nodes are handed back out, most recently released first
+  pool.release(nodes[2]);
+  pool.release(nodes[0]);
+  CHECK(pool.allocate(10) == nodes[0]);
+  CHECK(pool.allocate(12) == nodes[2]);
+  CHECK(nodes[0]->value == 10);
+  CHECK(nodes[2]->value == 12);
+  CHECK(pool.getNodesRecycled() == 2);
+  CHECK(pool.getChunksAllocated() == 2);
+
+  // a whole list of nodes can be released at once
+  nodes[0]->next = nodes[1];
+  nodes[1]->next = nodes[2];
+  pool.release(nodes[0], nodes[2], 3);
+  CHECK(pool.allocate(0) == nodes[0]);
+  CHECK(pool.allocate(1) == nodes[1]);
+  CHECK(pool.allocate(2) == nodes[2]);
+  CHECK(pool.getNodesRecycled() == 5);
+  CHECK(pool.getNodesInUse() == 5);
+
+  // chunks are only freed once none of their nodes are in use
+  pool.freeChunks();
+  CHECK(pool.getChunksAllocated() == 2);
+  for (int index = 0; index < 5; index++)
+  {
+    pool.release(nodes[index]);
+  }
+  CHECK(pool.getNodesInUse() == 0);
+  pool.freeChunks();
+  CHECK(pool.getChunksAllocated() == 0);
+  pool.release(pool.allocate(0));
+  CHECK(pool.getChunksAllocated() == 1);
+  CHECK(pool.getNodesRecycled() == 5);
+}
+
+/** Test NodePool chunk size and values of released nodes
+ */
+TEST_CASE("NodePool<string> test chunk size and released values", "[pool]")
+{
+  // a chunk holds at least one node
+  NodePool<string> pool(0);
+  CHECK(pool.getChunkSize() == 1);
+
+  // values are constructed in the nodes as they are allocated
+  string moved(100, 'b');
+  Node<string>* first = pool.allocate(string(100, 'a'));
+  Node<string>* second = pool.allocate(std::move(moved));
+  CHECK(pool.getChunksAllocated() == 2);
+  CHECK(first->value == string(100, 'a'));
+  CHECK(second->value == string(100, 'b'));
+  CHECK(moved.empty());
+
+  // released nodes are recycled with new values constructed in them
+  first->next = second;
+  pool.release(first, second, 2);
+  CHECK(pool.getNodesInUse() == 0);
+  Node<string>* third = pool.allocate("third");
+  CHECK(third == first);
+  CHECK(third->value == "third");
+  pool.release(third);
+  CHECK(pool.getChunksAllocated() == 2);
+  CHECK(pool.getNodesRecycled() == 1);
+}
+
+/** Test the node pool does not construct Jobs of its own, which would
+ * use up job ids
+ */
+TEST_CASE("LQueue<Job> test node pool does not advance job ids", "[pool]")
+{
+  Job out[4];
+  Job before;
+
+  // allocating chunks of nodes, enqueueing, dequeueing and clearing
+  // construct no jobs other than the ones enqueued
+  LQueue<Job> jobs;
+  LPriorityQueue<Job> priorityJobs;
+  for (int index = 0; index < 8; index++)
+  {
+    jobs.enqueue(Job(index, 1, index, 100 + index));
+    priorityJobs.enqueue(Job(index, 1, index, 200 + index));
+  }
+  CHECK(jobs.dequeueInto(out, 4) == 4);
+  CHECK(out[0].getId() == 100);
+  jobs.dequeue();
+  while (not priorityJobs.isEmpty())
+  {
+    priorityJobs.dequeue();
+  }
+  jobs.clear();
+
+  Job after;
+  CHECK(after.getId() == before.getId() + 1);
+}
+
+/** Test LQueue and LPriorityQueue recycle their nodes through the pool
+ */
+TEST_CASE("LQueue<int> test nodes are recycled by the node pool", "[pool]")
+{
+  SECTION("test private pool of a queue")
+  {
+    LQueue<int> queue;
+    for (int index = 0; index < 10; index++)
+    {
+      queue.enqueue(index);
+    }
+    CHECK(queue.getNodePool().getChunksAllocated() == 1);
+    CHECK(queue.getNodePool().getNodesRecycled() == 0);
+
+    // steady enqueue and dequeue churn only ever reuses the same nodes
+    for (int index = 0; index < 10000; index++)
+    {
+      queue.dequeue();
+      queue.enqueue(index);
+    }
+    CHECK(queue.getSize() == 10);
+    CHECK(queue.front() == 9990);
+    CHECK(queue.str() == "<queue> size: 10 front:[ 9990, 9991, 9992, 9993, 9994, 9995, 9996, 9997, 9998, 9999 ]:back");
+    CHECK(queue.getNodePool().getChunksAllocated() == 1);
+    CHECK(queue.getNodePool().getNodesRecycled() == 10000);
+
+    // clearing the queue returns the chunks of its pool to the heap
+    queue.clear();
+    CHECK(queue.getNodePool().getNodesInUse() == 0);
+    CHECK(queue.getNodePool().getChunksAllocated() == 0);
+    queue.enqueue(42);
+    CHECK(queue.getNodePool().getChunksAllocated() == 1);
+    CHECK(queue.front() == 42);
+  }
+
+  SECTION("test pool shared by several queues")
+  {
+    NodePool<int> pool(16);
+    LQueue<int> producer(pool);
+    LPriorityQueue<int> consumer(pool);
+    CHECK(&producer.getNodePool() == &pool);
+    CHECK(&consumer.getNodePool() == &pool);
+
+    for (int index = 0; index < 16; index++)
+    {
+      producer.enqueue(index);
+    }
+    CHECK(pool.getChunksAllocated() == 1);
+
+    // moving values from one queue to the other reuses the nodes freed
+    // by the dequeue from the producer
+    while (not producer.isEmpty())
+    {
+      int value = producer.front();
+      producer.dequeue();
+      consumer.enqueue(value);
+    }
+    CHECK(pool.getChunksAllocated() == 1);
+    CHECK(pool.getNodesRecycled() == 16);
+    CHECK(consumer.getSize() == 16);
+    CHECK(consumer.front() == 15);
+
+    // the chunks are kept while another queue is using the pool
+    producer.clear();
+    CHECK(pool.getChunksAllocated() == 1);
+    consumer.clear();
+    CHECK(pool.getChunksAllocated() == 0);
+  }
+}
@@ -0,0 +1,228 @@
+/** @file test-QueueStatistics.cpp
+ * @brief Unit tests for Assignment Queues
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Tests of the statistics queues keep of the work done by their
+ * operations.  The counts are only checked when the tests are built
+ * with QUEUE_STATISTICS defined, otherwise the tests check that the
+ * statistics are all 0.
+ */
+#include "AHeapPriorityQueue.hpp"
+#include "APriorityQueue.hpp"
+#include "AQueue.hpp"
+#include "CalendarQueue.hpp"
+#include "Job.hpp"
+#include "JobPriorityQueue.hpp"
+#include "LPriorityQueue.hpp"
+#include "LQueue.hpp"
+#include "QueueStatistics.hpp"
+#include "ULQueue.hpp"
+#include "catch.hpp"
+#include <iostream>
+#include <string>
+using namespace std;
+
+/** Test the QueueStatistics counters themselves
+ */
+TEST_CASE("QueueStatistics test counters", "[statistics]")
+{
+  QueueStatistics statistics;
+  statistics.enqueues = 3;
+  statistics.dequeues = 1;
+  statistics.grows = 1;
+  statistics.bytesCopied = 40;
+  statistics.comparisons = 2;
+  statistics.swaps = 1;
+
+  SECTION("test adding up statistics")
+  {
+    QueueStatistics total;
+    total += statistics;
+    total += statistics;
+    CHECK(total.enqueues == 6);
+    CHECK(total.dequeues == 2);
+    CHECK(total.grows == 2);
+    CHECK(total.shrinks == 0);
+    CHECK(total.bytesCopied == 80);
+    CHECK(total.comparisons == 4);
+    CHECK(total.swaps == 2);
+
+    total.reset();
+    CHECK(total.enqueues == 0);
+    CHECK(total.bytesCopied == 0);
+    CHECK(total.swaps == 0);
+  }
+
+  SECTION("test writing statistics")
+  {
+    if (QueueStatistics::ENABLED)
+    {
+      CHECK(statistics.str() ==
+            "<statistics> enqueues: 3 dequeues: 1 grows: 1 shrinks: 0 bytesCopied: 40 comparisons: 2 swaps: 1");
+    }
+    else
+    {
+      CHECK(statistics.str() == "<statistics> disabled");
+    }
+  }
+}
+
+/** Test the queues count the work done by their operations
+ */
+TEST_CASE("QueueStatistics test queues count their operations", "[statistics]")
+{
+  SECTION("test array queue counts reallocations")
+  {
+    AQueue<int> queue;
+    for (int value = 0; value < 20; value++)
+    {
+      queue.enqueue(value);
+    }
+    while (not queue.isEmpty())
+    {
+      queue.dequeue();
+    }
+
+    QueueStatistics statistics = queue.getStatistics();
+    if (QueueStatistics::ENABLED)
+    {
+      // grown from 0 to 10 and 10 to 20 items, then shrunk back to
+      // 10 once drained to 4 items
+      CHECK(statistics.enqueues == 20);
+      CHECK(statistics.dequeues == 20);
+      CHECK(statistics.grows == 2);
+      CHECK(statistics.shrinks == 1);
+      CHECK(statistics.bytesCopied == (10 + 4) * sizeof(int));
+      CHECK(statistics.comparisons == 0);
+      CHECK(statistics.swaps == 0);
+    }
+    else
+    {
+      CHECK(statistics.enqueues == 0);
+      CHECK(statistics.grows == 0);
+    }
+
+    // statistics can be reset, and a copy starts counting from 0
+    queue.enqueue(1);
+    AQueue<int> copy(queue);
+    CHECK(copy.getStatistics().enqueues == 0);
+    queue.resetStatistics();
+    CHECK(queue.getStatistics().enqueues == 0);
+  }
+
+  SECTION("test batch operations count every item")
+  {
+    int values[] = {5, 3, 8, 1, 9, 2};
+    AQueue<int> array;
+    LQueue<int> linked;
+    ULQueue<int> unrolled;
+    array.enqueueArray(values, 6);
+    linked.enqueueArray(values, 6);
+    unrolled.enqueueArray(values, 6);
+
+    int out[6];
+    array.dequeueInto(out, 4);
+    linked.dequeueInto(out, 4);
+    unrolled.dequeueInto(out, 4);
+    linked.dequeue();
+    unrolled.dequeueValue();
+
+    long expectedEnqueues = QueueStatistics::ENABLED ? 6 : 0;
+    CHECK(array.getStatistics().enqueues == expectedEnqueues);
+    CHECK(linked.getStatistics().enqueues == expectedEnqueues);
+    CHECK(unrolled.getStatistics().enqueues == expectedEnqueues);
+    CHECK(array.getStatistics().dequeues == (QueueStatistics::ENABLED ? 4 : 0));
+    CHECK(linked.getStatistics().dequeues == (QueueStatistics::ENABLED ? 5 : 0));
+    CHECK(unrolled.getStatistics().dequeues == (QueueStatistics::ENABLED ? 5 : 0));
+  }
+
+  SECTION("test heap counts a comparison and a swap for each level sifted")
+  {
+    // every new item is the highest priority, so it sifts up to the
+    // root, 0 + 1 + 1 + 2 + 2 + 2 + 2 levels
+    AHeapPriorityQueue<int> heap;
+    for (int value = 1; value <= 7; value++)
+    {
+      heap.enqueue(value);
+    }
+    heap.dequeueValue();
+
+    QueueStatistics statistics = heap.getStatistics();
+    if (QueueStatistics::ENABLED)
+    {
+      CHECK(statistics.enqueues == 7);
+      CHECK(statistics.dequeues == 1);
+      CHECK(statistics.grows == 1);
+      CHECK(statistics.swaps >= 10);
+      CHECK(statistics.comparisons >= 10);
+    }
+    else
+    {
+      CHECK(statistics.swaps == 0);
+      CHECK(statistics.comparisons == 0);
+    }
+  }
+
+  SECTION("test sorted queues count comparisons and shifts")
+  {
+    // items that belong at the back of the queue take a single
+    // comparison and are not shifted
+    APriorityQueue<int> sorted;
+    for (int value = 5; value >= 1; value--)
+    {
+      sorted.enqueue(value);
+    }
+    CHECK(sorted.getStatistics().comparisons == (QueueStatistics::ENABLED ? 4 : 0));
+    CHECK(sorted.getStatistics().swaps == 0);
+
+    // an item in the middle has to shift the items on one side of it
+    sorted.enqueue(3);
+    CHECK(sorted.getStatistics().swaps == (QueueStatistics::ENABLED ? 2 : 0));
+
+    // the linked list compares with the back, the front, and then each
+    // index entry and node it walks past, a short list is not indexed
+    LPriorityQueue<int> linked;
+    linked.enqueue(5);
+    linked.enqueue(1);
+    linked.enqueue(3);
+    CHECK(linked.getStatistics().comparisons == (QueueStatistics::ENABLED ? 4 : 0));
+  }
+
+  SECTION("test job heap and calendar queue count their resizes")
+  {
+    JobPriorityQueue jobs;
+    CalendarQueue<int> calendar;
+    for (int id = 1; id <= 100; id++)
+    {
+      jobs.enqueue(Job(id % 7, 1, id, id));
+      calendar.enqueue(id * 3);
+    }
+    for (int count = 0; count < 90; count++)
+    {
+      jobs.dequeue();
+      calendar.dequeue();
+    }
+
+    if (QueueStatistics::ENABLED)
+    {
+      CHECK(jobs.getStatistics().enqueues == 100);
+      CHECK(jobs.getStatistics().dequeues == 90);
+      CHECK(jobs.getStatistics().grows == 4);
+      CHECK(jobs.getStatistics().bytesCopied > 0);
+      CHECK(calendar.getStatistics().enqueues == 100);
+      CHECK(calendar.getStatistics().dequeues == 90);
+      CHECK(calendar.getStatistics().grows == 5);
+      CHECK(calendar.getStatistics().shrinks >= 2);
+    }
+    else
+    {
+      CHECK(jobs.getStatistics().grows == 0);
+      CHECK(calendar.getStatistics().grows == 0);
+    }
+  }
+}
@@ -0,0 +1,198 @@
+/** @file test-SPSCQueue.cpp
+ * @brief Unit tests for Assignment Queues
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Tests of the lock-free single producer single consumer bounded
+ * implementation of the Queue API.
+ */
+#include "AQueue.hpp"
+#include "Job.hpp"
+#include "QueueException.hpp"
+#include "SPSCQueue.hpp"
+#include "catch.hpp"
+#include <climits>
+#include <iostream>
+#include <thread>
+using namespace std;
+
+/** Test SPSCQueue<int> basic queue functions from a single thread
+ */
+TEST_CASE("SPSCQueue<int> test bounded lock-free queue of integers", "[spsc]")
+{
+  SECTION("test capacity is rounded up to a power of two")
+  {
+    SPSCQueue<int> queue(5);
+    CHECK(queue.getCapacity() == 8);
+    CHECK(SPSCQueue<int>(8).getCapacity() == 8);
+    CHECK(SPSCQueue<int>().getCapacity() == 1024);
+
+    // capacities that can not be rounded up to a power of two
+    CHECK_THROWS_AS(SPSCQueue<int>((1 << 30) + 1), QueueMemoryBoundsException);
+    CHECK_THROWS_AS(SPSCQueue<int>(INT_MAX), QueueMemoryBoundsException);
+  }
+
+  SECTION("test basic queue functions")
+  {
+    SPSCQueue<int> queue(4);
+    CHECK(queue.isEmpty());
+    CHECK(queue.getSize() == 0);
+    CHECK(queue.str() == "<queue> size: 0 front:[ ]:back");
+    CHECK_THROWS_AS(queue.front(), QueueEmptyException);
+    CHECK_THROWS_AS(queue.dequeue(), QueueEmptyException);
+    CHECK_THROWS_AS(queue.dequeueValue(), QueueEmptyException);
+    CHECK_THROWS_AS(queue[0], QueueMemoryBoundsException);
+
+    queue.enqueue(1);
+    queue.enqueue(2);
+    queue.enqueue(3);
+    CHECK(queue.getSize() == 3);
+    CHECK(queue.front() == 1);
+    CHECK(queue[2] == 3);
+    CHECK(queue.str() == "<queue> size: 3 front:[ 1, 2, 3 ]:back");
+
+    int values[] = {1, 2, 3};
+    AQueue<int> expected(3, values);
+    CHECK(queue == expected);
+
+    queue.dequeue();
+    CHECK(queue.front() == 2);
+    CHECK(queue.dequeueValue() == 2);
+    CHECK(queue.getSize() == 1);
+    CHECK_FALSE(queue == expected);
+
+    queue.clear();
+    CHECK(queue.isEmpty());
+    CHECK_THROWS_AS(queue.front(), QueueEmptyException);
+  }
+
+  SECTION("test try enqueue fails when full and wraps around the buffer")
+  {
+    SPSCQueue<int> queue(4);
+    for (int index = 0; index < 4; index++)
+    {
+      CHECK(queue.tryEnqueue(index));
+    }
+    CHECK(queue.getSize() == 4);
+    CHECK_FALSE(queue.tryEnqueue(99));
+    CHECK(queue.getSize() == 4);
+
+    // keep the buffer full while the indexes wrap around it many times
+    int item;
+    for (int index = 4; index < 100; index++)
+    {
+      CHECK(queue.tryDequeue(item));
+      CHECK(item == index - 4);
+      CHECK(queue.tryEnqueue(index));
+    }
+    CHECK(queue.str() == "<queue> size: 4 front:[ 96, 97, 98, 99 ]:back");
+
+    while (queue.tryDequeue(item))
+    {
+    }
+    CHECK(item == 99);
+    CHECK(queue.isEmpty());
+    CHECK_FALSE(queue.tryDequeue(item));
+    CHECK(item == 99);
+  }
+}
+
+/** Test SPSCQueue<string> moves values in and out of the buffer
+ */
+TEST_CASE("SPSCQueue<int> test equality with other kinds of queue", "[spsc]")
+{
+  // the values wrap around the end of the ring buffer
+  SPSCQueue<int> queue(4);
+  int item;
+  for (int index = 0; index < 5; index++)
+  {
+    CHECK(queue.tryEnqueue(index));
+    if (index >= 2)
+    {
+      CHECK(queue.tryDequeue(item));
+    }
+  }
+  CHECK(queue.str() == "<queue> size: 2 front:[ 3, 4 ]:back");
+  CHECK(queue.tryEnqueue(5));
+  CHECK(queue.tryEnqueue(6));
+
+  int wrapped[] = {3, 4, 5, 6};
+  AQueue<int> expected(4, wrapped);
+  CHECK(queue == expected);
+  CHECK(expected == queue);
+  expected[3] = 7;
+  CHECK_FALSE(queue == expected);
+  CHECK_FALSE(expected == queue);
+}
+
+TEST_CASE("SPSCQueue<string> test move enqueue and emplace", "[spsc]")
+{
+  SPSCQueue<string> queue(4);
+  string value = "alpha";
+  queue.enqueue(std::move(value));
+  queue.emplace(3, 'z');
+  CHECK(queue.tryEnqueue(string("bravo")));
+
+  CHECK(queue.dequeueValue() == "alpha");
+  CHECK(queue.dequeueValue() == "zzz");
+  string item;
+  CHECK(queue.tryDequeue(item));
+  CHECK(item == "bravo");
+  CHECK(queue.isEmpty());
+}
+
+/** Test SPSCQueue<Job> passes items between a producer and a consumer
+ * thread in order, with the producer often blocked on a full buffer.
+ */
+TEST_CASE("SPSCQueue<Job> test producer and consumer threads", "[spsc]")
+{
+  const int NUM_JOBS = 100000;
+  SPSCQueue<Job> queue(16);
+
+  thread producer([&]() {
+    for (int index = 0; index < NUM_JOBS; index++)
+    {
+      queue.enqueue(Job(index % 10, index, index, index));
+    }
+  });
+
+  int inOrder = 0;
+  Job job;
+  for (int index = 0; index < NUM_JOBS; index++)
+  {
+    while (not queue.tryDequeue(job))
+    {
+      this_thread::yield();
+    }
+    if (job.getId() == index)
+    {
+      inOrder++;
+    }
+  }
+  producer.join();
+
+  CHECK(inOrder == NUM_JOBS);
+  CHECK(queue.isEmpty());
+}
+
+/** Test SPSCQueue<Job> dequeueValue() moves the job out of the buffer
+ * without default constructing one, which would use up a job id
+ */
+TEST_CASE("SPSCQueue<Job> test dequeueValue does not advance job ids", "[spsc]")
+{
+  SPSCQueue<Job> queue(8);
+  queue.enqueue(Job(1, 2, 3, 101));
+  queue.enqueue(Job(4, 5, 6, 102));
+  Job before;
+
+  CHECK(queue.dequeueValue().getId() == 101);
+  CHECK(queue.dequeueValue().getId() == 102);
+  CHECK_THROWS_WITH(queue.dequeueValue(), Catch::Contains("<SPSCQueue>::dequeueValue()"));
+
+  Job after;
+  CHECK(after.getId() == before.getId() + 1);
+}
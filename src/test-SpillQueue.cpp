@@ -0,0 +1,280 @@
+/** @file test-SpillQueue.cpp
+ * @brief Unit tests for Assignment Queues
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Tests of the disk spilling implementation of the Queue API.  The
+ * tests use small memory budgets so that the queues spill to disk
+ * after only a few items.
+ */
+#include "AQueue.hpp"
+#include "Job.hpp"
+#include "QueueException.hpp"
+#include "SpillQueue.hpp"
+#include "catch.hpp"
+#include <filesystem>
+#include <iostream>
+#include <string>
+using namespace std;
+
+/// @brief the directory the tests spill their queues into
+static const string SPILL_DIRECTORY = (filesystem::temp_directory_path() / "test-SpillQueue").string();
+
+/**
+ * @brief Count segment files
+ *
+ * Count the files in the test spill directory, to check that the
+ * queues clean up their segment files.
+ *
+ * @returns int The number of files in the spill directory.
+ */
+static int countSpillFiles()
+{
+  int count = 0;
+  for (const auto& entry : filesystem::directory_iterator(SPILL_DIRECTORY))
+  {
+    (void)entry;
+    count++;
+  }
+  return count;
+}
+
+/** Test SpillQueue<int> basic queue functions
+ */
+TEST_CASE("SpillQueue<int> test disk spilling queue of integers", "[spill]")
+{
+  SECTION("test basic queue functions in memory")
+  {
+    SpillQueue<int> queue(SPILL_DIRECTORY);
+    CHECK(queue.isEmpty());
+    CHECK(queue.getSize() == 0);
+    CHECK(queue.getMemoryBudget() == 64 * 1024 * 1024);
+    CHECK(queue.str() == "<queue> size: 0 front:[ ]:back");
+    CHECK_THROWS_AS(queue.front(), QueueEmptyException);
+    CHECK_THROWS_AS(queue.dequeue(), QueueEmptyException);
+    CHECK_THROWS_AS(queue.dequeueValue(), QueueEmptyException);
+    CHECK_THROWS_AS(queue[0], QueueMemoryBoundsException);
+
+    for (int value = 1; value <= 5; value++)
+    {
+      queue.enqueue(value);
+    }
+    CHECK(queue.getSize() == 5);
+    CHECK(queue.getSpilledSize() == 0);
+    CHECK(queue.front() == 1);
+    CHECK(queue[4] == 5);
+    CHECK(queue.str() == "<queue> size: 5 front:[ 1, 2, 3, 4, 5 ]:back");
+
+    queue.dequeue();
+    CHECK(queue.dequeueValue() == 2);
+    CHECK(queue.front() == 3);
+    CHECK(queue.getSize() == 3);
+  }
+
+  SECTION("test items spill to disk and come back in order")
+  {
+    // room for 8 items at the front and 8 at the back of the queue
+    SpillQueue<int> queue(SPILL_DIRECTORY, 16 * sizeof(int));
+    for (int value = 1; value <= 100; value++)
+    {
+      queue.enqueue(value);
+      CHECK(queue.getInMemorySize() <= 16);
+    }
+    CHECK(queue.getSize() == 100);
+    CHECK(queue.getInMemorySize() == 12);
+    CHECK(queue.getSpilledSize() == 88);
+    CHECK(queue.getSegmentCount() == 1);
+    CHECK(countSpillFiles() == 1);
+
+    // indexing reads items from the front, disk and back of the queue
+    CHECK(queue[0] == 1);
+    CHECK(queue[7] == 8);
+    CHECK(queue[8] == 9);
+    CHECK(queue[50] == 51);
+    CHECK(queue[95] == 96);
+    CHECK(queue[99] == 100);
+    CHECK_THROWS_AS(queue[100], QueueMemoryBoundsException);
+
+    // queues are equal to queues of the same items in memory
+    AQueue<int> expected;
+    for (int value = 1; value <= 100; value++)
+    {
+      expected.enqueue(value);
+    }
+    CHECK(queue == expected);
+    CHECK(queue.str() == expected.str());
+    expected.enqueue(101);
+    CHECK_FALSE(queue == expected);
+
+    bool inOrder = true;
+    for (int value = 1; value <= 100; value++)
+    {
+      inOrder = inOrder and (queue.front() == value);
+      CHECK(queue.getInMemorySize() <= 16);
+      queue.dequeue();
+    }
+    CHECK(inOrder);
+    CHECK(queue.isEmpty());
+    CHECK(queue.getSpilledSize() == 0);
+    CHECK(countSpillFiles() == 0);
+  }
+
+  SECTION("test enqueue while reading back from disk")
+  {
+    SpillQueue<int> queue(SPILL_DIRECTORY, 4 * sizeof(int));
+    int nextIn = 1;
+    int nextOut = 1;
+    bool inOrder = true;
+    for (int round = 0; round < 50; round++)
+    {
+      for (int count = 0; count < 7; count++)
+      {
+        queue.enqueue(nextIn++);
+      }
+      for (int count = 0; count < 5; count++)
+      {
+        inOrder = inOrder and (queue.dequeueValue() == nextOut++);
+      }
+    }
+    CHECK(inOrder);
+    CHECK(queue.getSize() == 100);
+    CHECK(queue.front() == nextOut);
+    CHECK(queue[99] == nextIn - 1);
+
+    // comparing skips the items already read from the oldest segment
+    AQueue<int> expected;
+    for (int value = nextOut; value < nextIn; value++)
+    {
+      expected.enqueue(value);
+    }
+    CHECK(queue == expected);
+
+    queue.clear();
+    CHECK(queue.isEmpty());
+    CHECK(queue.getSegmentCount() == 0);
+    CHECK(countSpillFiles() == 0);
+
+    // the queue still works after being cleared
+    queue.enqueue(42);
+    CHECK(queue.front() == 42);
+  }
+
+  SECTION("test failed spill keeps the items in memory")
+  {
+    SpillQueue<int> queue(SPILL_DIRECTORY, 4 * sizeof(int));
+    filesystem::remove_all(SPILL_DIRECTORY);
+    for (int value = 1; value <= 3; value++)
+    {
+      queue.enqueue(value);
+    }
+    CHECK_THROWS_AS(queue.enqueue(4), QueueSpillException);
+    CHECK(queue.getSize() == 4);
+    CHECK(queue.getSpilledSize() == 0);
+    CHECK(queue.getSegmentCount() == 0);
+
+    // the next enqueue spills once the directory is back
+    filesystem::create_directories(SPILL_DIRECTORY);
+    queue.enqueue(5);
+    CHECK(queue.getSize() == 5);
+    CHECK(queue.getSpilledSize() == 3);
+    CHECK(queue.str() == "<queue> size: 5 front:[ 1, 2, 3, 4, 5 ]:back");
+
+    bool inOrder = true;
+    for (int value = 1; value <= 5; value++)
+    {
+      inOrder = inOrder and (queue.dequeueValue() == value);
+    }
+    CHECK(inOrder);
+    CHECK(countSpillFiles() == 0);
+  }
+
+  SECTION("test destructor removes segment files")
+  {
+    {
+      SpillQueue<int> queue(SPILL_DIRECTORY, 4 * sizeof(int));
+      for (int value = 1; value <= 100; value++)
+      {
+        queue.enqueue(value);
+      }
+      CHECK(countSpillFiles() > 0);
+    }
+    CHECK(countSpillFiles() == 0);
+  }
+}
+
+/** Test SpillQueue<Job> keeps every field of the jobs that are spilled
+ */
+TEST_CASE("SpillQueue<Job> test disk spilling queue of jobs", "[spill]")
+{
+  SpillQueue<Job> queue(SPILL_DIRECTORY, 10 * sizeof(Job));
+  for (int id = 1; id <= 50; id++)
+  {
+    Job job(id % 7, id % 11, id, id);
+    job.setEndTime(id + id % 13);
+    queue.enqueue(job);
+  }
+  CHECK(queue.getSpilledSize() > 0);
+  CHECK(queue[20].getId() == 21);
+
+  bool allEqual = true;
+  for (int id = 1; id <= 50; id++)
+  {
+    Job job = queue.dequeueValue();
+    allEqual = allEqual and (job.getId() == id) and (job.getPriority() == id % 7) and (job.getServiceTime() == id % 11) and
+               (job.getStartTime() == id) and (job.getEndTime() == id + id % 13);
+  }
+  CHECK(allEqual);
+  CHECK(queue.isEmpty());
+}
+
+/** Stress test pushing ten times the memory budget of jobs through a
+ * SpillQueue, with the queue growing and draining in waves
+ */
+TEST_CASE("SpillQueue<Job> stress test ten times the memory budget", "[spill]")
+{
+  const int BUDGET_ITEMS = 1000;
+  const int TOTAL_ITEMS = 10 * BUDGET_ITEMS;
+  SpillQueue<Job> queue(SPILL_DIRECTORY, BUDGET_ITEMS * sizeof(Job));
+
+  int nextIn = 1;
+  int nextOut = 1;
+  int largestSize = 0;
+  int largestInMemory = 0;
+  bool inOrder = true;
+  while (nextOut <= TOTAL_ITEMS)
+  {
+    // enqueue a wave of up to 3 budgets of jobs, then drain most of it
+    for (int count = 0; (count < 3 * BUDGET_ITEMS) and (nextIn <= TOTAL_ITEMS); count++)
+    {
+      queue.enqueue(Job(nextIn % 10, 1, nextIn, nextIn));
+      nextIn++;
+      largestSize = max(largestSize, queue.getSize());
+      largestInMemory = max(largestInMemory, queue.getInMemorySize());
+    }
+    for (int count = 0; (count < 2 * BUDGET_ITEMS) and not queue.isEmpty(); count++)
+    {
+      inOrder = inOrder and (queue.dequeueValue().getId() == nextOut);
+      nextOut++;
+      largestInMemory = max(largestInMemory, queue.getInMemorySize());
+    }
+    if (nextIn > TOTAL_ITEMS)
+    {
+      while (not queue.isEmpty())
+      {
+        inOrder = inOrder and (queue.dequeueValue().getId() == nextOut);
+        nextOut++;
+      }
+    }
+  }
+
+  CHECK(inOrder);
+  CHECK(nextOut == TOTAL_ITEMS + 1);
+  CHECK(largestSize >= 5 * BUDGET_ITEMS);
+  CHECK(largestInMemory <= BUDGET_ITEMS);
+  CHECK(queue.isEmpty());
+  CHECK(countSpillFiles() == 0);
+}
@@ -0,0 +1,603 @@
+/** @file test-ULQueue.cpp
+ * @brief Unit tests for Assignment Queues
+ *
+ * @author Derek Harter
+ * @note   class: COSC 2336, Summer 2021
+ * @note   ide  : VSCode Server 3.9.3, Gnu Development Tools
+ * @note   assg : Assignment Queues
+ * @date   June 1, 2021
+ *
+ * Tests of the unrolled linked list based implementation of the Queue API.
+ */
+#include "ULQueue.hpp"
+#include "QueueException.hpp"
+#include "catch.hpp"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+/** Test ULQueue<int> concrete unrolled linked list implementation of queue of integers
+ */
+TEST_CASE("ULQueue<int> test integer queue concrete unrolled linked list implementation", "[unrolled]")
+{
+  SECTION("test empty queue is empty")
+  {
+    // empty queues should be empty
+    ULQueue<int> empty;
+    CHECK(empty.getSize() == 0);
+    CHECK(empty.isEmpty());
+    CHECK(empty.str() == "<queue> size: 0 front:[ ]:back");
+
+    // empty queues should compare as being equal
+    ULQueue<int> otherEmpty;
+    CHECK(otherEmpty == empty);
+    CHECK(empty == otherEmpty);
+
+    // empty queues should complain if asked to get a value from them
+    CHECK_THROWS_AS(empty.front(), QueueEmptyException);
+    CHECK_THROWS_AS(empty[0], QueueMemoryBoundsException);
+
+    // empty queue can be cleared and is still empty
+    empty.clear();
+    CHECK(empty.getSize() == 0);
+    CHECK(empty.isEmpty());
+    CHECK(empty.str() == "<queue> size: 0 front:[ ]:back");
+  }
+
+  SECTION("test enqueue, dequeue and front general functionality")
+  {
+    // start with emtpy queue
+    ULQueue<int> queue;
+    CHECK(queue.getSize() == 0);
+    CHECK(queue.isEmpty());
+    CHECK(queue.str() == "<queue> size: 0 front:[ ]:back");
+
+    // enqueue an item on empty queue
+    queue.enqueue(5);
+    CHECK(queue.getSize() == 1);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.front() == 5);
+    CHECK(queue.str() == "<queue> size: 1 front:[ 5 ]:back");
+
+    // enqueue a second  item on queue
+    queue.enqueue(8);
+    CHECK(queue.getSize() == 2);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.front() == 5);
+    CHECK(queue.str() == "<queue> size: 2 front:[ 5, 8 ]:back");
+
+    // enqueue a third item on queue
+    queue.enqueue(15);
+    CHECK(queue.getSize() == 3);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.front() == 5);
+    CHECK(queue.str() == "<queue> size: 3 front:[ 5, 8, 15 ]:back");
+
+    // test dequeue of queue with more than 1 item
+    queue.dequeue();
+    CHECK(queue.getSize() == 2);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.front() == 8);
+    CHECK(queue.str() == "<queue> size: 2 front:[ 8, 15 ]:back");
+
+    // enqueue 2 itmes on
+    queue.enqueue(1);
+    CHECK(queue.front() == 8);
+    queue.enqueue(3);
+    CHECK(queue.getSize() == 4);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.front() == 8);
+    CHECK(queue.str() == "<queue> size: 4 front:[ 8, 15, 1, 3 ]:back");
+
+    // dequeue back to 1 item
+    queue.dequeue();
+    queue.dequeue();
+    queue.dequeue();
+    CHECK(queue.getSize() == 1);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.front() == 3);
+    CHECK(queue.str() == "<queue> size: 1 front:[ 3 ]:back");
+
+    // make queue empty again
+    queue.dequeue();
+    CHECK(queue.getSize() == 0);
+    CHECK(queue.isEmpty());
+    CHECK(queue.str() == "<queue> size: 0 front:[ ]:back");
+
+    // should complain if we try and dequeue an empty queue
+    CHECK_THROWS_AS(queue.dequeue(), QueueEmptyException);
+
+    // enqueue on 10 items
+    for (int index = 1; index <= 10; index++)
+    {
+      queue.enqueue(pow(index, 3));
+    }
+    CHECK(queue.getSize() == 10);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.str() == "<queue> size: 10 front:[ 1, 8, 27, 64, 125, 216, 343, 512, 729, 1000 ]:back");
+
+    // Array based queue should double in size, only for ULQueue tests
+    queue.enqueue(pow(11, 3));
+    CHECK(queue.getSize() == 11);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.str() == "<queue> size: 11 front:[ 1, 8, 27, 64, 125, 216, 343, 512, 729, 1000, 1331 ]:back");
+  }
+
+  SECTION("test clear of queue")
+  {
+    // create queue of 11 values
+    ULQueue<int> queue;
+    for (int index = 1; index <= 11; index++)
+    {
+      queue.enqueue(pow(index, 3));
+    }
+    CHECK(queue.getSize() == 11);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.str() == "<queue> size: 11 front:[ 1, 8, 27, 64, 125, 216, 343, 512, 729, 1000, 1331 ]:back");
+
+    // clear the queue
+    queue.clear();
+    CHECK(queue.getSize() == 0);
+    CHECK(queue.isEmpty());
+    CHECK(queue.str() == "<queue> size: 0 front:[ ]:back");
+
+    // should be equal to an empty queue
+    ULQueue<int> empty;
+    CHECK(empty == queue);
+    CHECK(queue == empty);
+  }
+
+  SECTION("test array based constructor")
+  {
+    int values[] = {1, 3, -2, -4, 7};
+    ULQueue<int> queue(5, values);
+
+    // nonempty queue should not be empty
+    CHECK(queue.getSize() == 5);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.str() == "<queue> size: 5 front:[ 1, 3, -2, -4, 7 ]:back");
+
+    // test access to front and back
+    CHECK(queue.front() == 1);
+
+    // test indexing access
+    CHECK(queue[0] == 1);
+    CHECK(queue[1] == 3);
+    CHECK(queue[2] == -2);
+    CHECK(queue[3] == -4);
+    CHECK(queue[4] == 7);
+    CHECK_THROWS_AS(queue[-1], QueueMemoryBoundsException);
+    CHECK_THROWS_AS(queue[5], QueueMemoryBoundsException);
+    queue[2] = 42;
+    CHECK(queue[2] == 42);
+    CHECK(queue.str() == "<queue> size: 5 front:[ 1, 3, 42, -4, 7 ]:back");
+
+    // test inserting on queue, and that queue allocation grows as expected
+    queue.enqueue(22);
+    CHECK(queue.getSize() == 6);
+    CHECK(queue.front() == 1);
+    CHECK(queue.str() == "<queue> size: 6 front:[ 1, 3, 42, -4, 7, 22 ]:back");
+
+    queue.enqueue(38);
+    CHECK(queue.getSize() == 7);
+    CHECK(queue.front() == 1);
+    CHECK(queue.str() == "<queue> size: 7 front:[ 1, 3, 42, -4, 7, 22, 38 ]:back");
+  }
+
+  SECTION("test copy constructor")
+  {
+    int values[] = {3, 1, 4, 2};
+    ULQueue<int> queue(4, values);
+    ULQueue<int> copy = queue;
+
+    // copy should be equal to the queue
+    CHECK(copy == queue);
+    CHECK(queue == copy);
+
+    // copy is no longer equal
+    queue.enqueue(5);
+    CHECK_FALSE(copy == queue);
+    CHECK_FALSE(queue == copy);
+
+    // now they are the same again
+    copy.enqueue(5);
+    CHECK(copy == queue);
+    CHECK(queue == copy);
+
+    // now they are no longer equal, copy is 2 shorter
+    copy.dequeue();
+    copy.dequeue();
+    CHECK_FALSE(copy == queue);
+    CHECK_FALSE(queue == copy);
+  }
+}
+
+/** Test ULQueue<string> concrete unrolled linked list implementation of queue of strings
+ */
+TEST_CASE("ULQueue<string> test string queue concrete unrolled linked list implementation", "[unrolled]")
+{
+  SECTION("test empty queue is empty")
+  {
+    // empty queues should be empty
+    ULQueue<string> empty;
+    CHECK(empty.getSize() == 0);
+    CHECK(empty.isEmpty());
+    CHECK(empty.str() == "<queue> size: 0 front:[ ]:back");
+
+    // empty queues should compare as being equal
+    ULQueue<string> otherEmpty;
+    CHECK(otherEmpty == empty);
+    CHECK(empty == otherEmpty);
+
+    // empty queues should complain if asked to get a value from them
+    CHECK_THROWS_AS(empty.front(), QueueEmptyException);
+    CHECK_THROWS_AS(empty[0], QueueMemoryBoundsException);
+
+    // empty queue can be cleared and is still empty
+    empty.clear();
+    CHECK(empty.getSize() == 0);
+    CHECK(empty.isEmpty());
+    CHECK(empty.str() == "<queue> size: 0 front:[ ]:back");
+  }
+
+  SECTION("test enqueue, dequeue and front general functionality")
+  {
+    // start with empty queue
+    ULQueue<string> queue;
+    CHECK(queue.getSize() == 0);
+    CHECK(queue.isEmpty());
+    CHECK(queue.str() == "<queue> size: 0 front:[ ]:back");
+
+    // enqueue an item on empty queue
+    queue.enqueue("echo");
+    CHECK(queue.getSize() == 1);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.front() == "echo");
+    CHECK(queue.str() == "<queue> size: 1 front:[ echo ]:back");
+
+    // enqueue a second  item on queue
+    queue.enqueue("hotel");
+    CHECK(queue.getSize() == 2);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.front() == "echo");
+    CHECK(queue.str() == "<queue> size: 2 front:[ echo, hotel ]:back");
+
+    // enqueue a third item on queue
+    queue.enqueue("oscar");
+    CHECK(queue.getSize() == 3);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.front() == "echo");
+    CHECK(queue.str() == "<queue> size: 3 front:[ echo, hotel, oscar ]:back");
+
+    // test dequeue of queue with more than 1 item
+    queue.dequeue();
+    CHECK(queue.getSize() == 2);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.front() == "hotel");
+    CHECK(queue.str() == "<queue> size: 2 front:[ hotel, oscar ]:back");
+
+    // enqueue 2 itmes on
+    queue.enqueue("alpha");
+    CHECK(queue.front() == "hotel");
+    queue.enqueue("charlie");
+    CHECK(queue.getSize() == 4);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.front() == "hotel");
+    CHECK(queue.str() == "<queue> size: 4 front:[ hotel, oscar, alpha, charlie ]:back");
+
+    // dequeue back to 1 item
+    queue.dequeue();
+    queue.dequeue();
+    queue.dequeue();
+    CHECK(queue.getSize() == 1);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.front() == "charlie");
+    CHECK(queue.str() == "<queue> size: 1 front:[ charlie ]:back");
+
+    // make queue empty again
+    queue.dequeue();
+    CHECK(queue.getSize() == 0);
+    CHECK(queue.isEmpty());
+    CHECK(queue.str() == "<queue> size: 0 front:[ ]:back");
+
+    // should complain if we try and dequeue an empty queue
+    CHECK_THROWS_AS(queue.dequeue(), QueueEmptyException);
+
+    // enqueue on 10 items
+    for (int index = 1; index <= 10; index++)
+    {
+      queue.enqueue("string-" + to_string(int(pow(index, 3))));
+    }
+    CHECK(queue.getSize() == 10);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.str() == "<queue> size: 10 front:[ string-1, string-8, string-27, string-64, string-125, string-216, string-343, "
+                         "string-512, string-729, string-1000 ]:back");
+
+    // Array based queue should double in size, only for ULQueue tests
+    queue.enqueue("string-" + to_string(int(pow(11, 3))));
+    CHECK(queue.getSize() == 11);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.str() == "<queue> size: 11 front:[ string-1, string-8, string-27, string-64, string-125, string-216, string-343, "
+                         "string-512, string-729, string-1000, string-1331 ]:back");
+  }
+
+  SECTION("test clear of queue")
+  {
+    // create queue of 11 values
+    ULQueue<string> queue;
+    for (int index = 1; index <= 11; index++)
+    {
+      queue.enqueue("string-" + to_string(int(pow(index, 3))));
+    }
+    CHECK(queue.getSize() == 11);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.str() == "<queue> size: 11 front:[ string-1, string-8, string-27, string-64, string-125, string-216, string-343, "
+                         "string-512, string-729, string-1000, string-1331 ]:back");
+
+    // clear the queue
+    queue.clear();
+    CHECK(queue.getSize() == 0);
+    CHECK(queue.isEmpty());
+    CHECK(queue.str() == "<queue> size: 0 front:[ ]:back");
+
+    // should be equal to an empty queue
+    ULQueue<string> empty;
+    CHECK(empty == queue);
+    CHECK(queue == empty);
+  }
+
+  SECTION("test array based constructor")
+  {
+    string values[] = {"alpha", "charlie", "neg-bravo", "neg-delta", "golf"};
+    ULQueue<string> queue(5, values);
+
+    // nonempty queue should not be empty
+    CHECK(queue.getSize() == 5);
+    CHECK_FALSE(queue.isEmpty());
+    CHECK(queue.str() == "<queue> size: 5 front:[ alpha, charlie, neg-bravo, neg-delta, golf ]:back");
+
+    // test access to front and back
+    CHECK(queue.front() == "alpha");
+
+    // test indexing access
+    CHECK(queue[0] == "alpha");
+    CHECK(queue[1] == "charlie");
+    CHECK(queue[2] == "neg-bravo");
+    CHECK(queue[3] == "neg-delta");
+    CHECK(queue[4] == "golf");
+    CHECK_THROWS_AS(queue[-1], QueueMemoryBoundsException);
+    CHECK_THROWS_AS(queue[5], QueueMemoryBoundsException);
+    queue[2] = "life-universe-everything";
+    CHECK(queue[2] == "life-universe-everything");
+    CHECK(queue.str() == "<queue> size: 5 front:[ alpha, charlie, life-universe-everything, neg-delta, golf ]:back");
+
+    // test inserting on queue, and that queue allocation grows as expected
+    queue.enqueue("victor");
+    CHECK(queue.getSize() == 6);
+    CHECK(queue.front() == "alpha");
+    CHECK(queue.str() == "<queue> size: 6 front:[ alpha, charlie, life-universe-everything, neg-delta, golf, victor ]:back");
+
+    queue.enqueue("zulu");
+    CHECK(queue.getSize() == 7);
+    CHECK(queue.front() == "alpha");
+    CHECK(queue.str() == "<queue> size: 7 front:[ alpha, charlie, life-universe-everything, neg-delta, golf, victor, zulu ]:back");
+  }
+
+  SECTION("test copy constructor")
+  {
+    string values[] = {"charlie", "alpha", "delta", "bravo"};
+    ULQueue<string> queue(4, values);
+    ULQueue<string> copy = queue;
+
+    // copy should be equal to the queue
+    CHECK(copy == queue);
+    CHECK(queue == copy);
+
+    // copy is no longer equal
+    queue.enqueue("echo");
+    CHECK_FALSE(copy == queue);
+    CHECK_FALSE(queue == copy);
+
+    // now they are the same again
+    copy.enqueue("echo");
+    CHECK(copy == queue);
+    CHECK(queue == copy);
+
+    // now they are no longer equal, copy is 2 shorter
+    copy.dequeue();
+    copy.dequeue();
+    CHECK_FALSE(copy == queue);
+    CHECK_FALSE(queue == copy);
+  }
+}
+
+/** Test ULQueue move aware enqueue, emplace and dequeueValue
+ */
+TEST_CASE("ULQueue<string> test move enqueue, emplace and dequeueValue", "[move]")
+{
+  ULQueue<string> queue;
+
+  string alpha = "alpha";
+  queue.enqueue(std::move(alpha));
+  CHECK(alpha.empty());
+
+  string bravo = "bravo";
+  queue.enqueue(bravo);
+  CHECK(bravo == "bravo");
+
+  queue.emplace(3, 'c');
+  CHECK(queue.getSize() == 3);
+  CHECK(queue.str() == "<queue> size: 3 front:[ alpha, bravo, ccc ]:back");
+
+  CHECK(queue.dequeueValue() == "alpha");
+  CHECK(queue.dequeueValue() == "bravo");
+  CHECK(queue.dequeueValue() == "ccc");
+  CHECK(queue.isEmpty());
+  CHECK_THROWS_AS(queue.dequeueValue(), QueueEmptyException);
+}
+
+/** Test ULQueue batch enqueue and dequeue across block boundaries
+ */
+TEST_CASE("ULQueue<int> test batch enqueueArray, enqueueRange and dequeueInto", "[batch]")
+{
+  ULQueue<int> queue;
+  int first[] = {1, 2, 3, 4, 5};
+  queue.enqueueArray(first, 5);
+  CHECK(queue.getSize() == 5);
+  CHECK(queue.front() == 1);
+
+  vector<int> second = {6, 7, 8};
+  queue.enqueueRange(second.begin(), second.end());
+  queue.enqueue(9);
+  CHECK(queue.str() == "<queue> size: 9 front:[ 1, 2, 3, 4, 5, 6, 7, 8, 9 ]:back");
+
+  int out[100];
+  CHECK(queue.dequeueInto(out, 4) == 4);
+  CHECK(out[0] == 1);
+  CHECK(out[3] == 4);
+  CHECK(queue.getSize() == 5);
+  CHECK(queue.front() == 5);
+
+  // a batch spanning several blocks
+  vector<int> many(50);
+  for (int index = 0; index < 50; index++)
+  {
+    many[index] = 100 + index;
+  }
+  queue.enqueueArray(many.data(), 50);
+  CHECK(queue.getSize() == 55);
+  CHECK(queue[4] == 9);
+  CHECK(queue[5] == 100);
+  CHECK(queue[54] == 149);
+
+  CHECK(queue.dequeueInto(out, 100) == 55);
+  CHECK(out[0] == 5);
+  CHECK(out[54] == 149);
+  CHECK(queue.isEmpty());
+  CHECK(queue.getBlockCount() == 0);
+  CHECK(queue.dequeueInto(out, 20) == 0);
+  queue.enqueueArray(first, 0);
+  CHECK(queue.isEmpty());
+  queue.enqueue(42);
+  CHECK(queue.front() == 42);
+  CHECK(queue.str() == "<queue> size: 1 front:[ 42 ]:back");
+}
+
+/** Test ULQueue blocks fill and empty as values pass through the queue
+ */
+TEST_CASE("ULQueue<int> test block storage", "[unrolled]")
+{
+  const int BLOCK = ULQueue<int>::BLOCK_CAPACITY;
+  CHECK(BLOCK == 16);
+  CHECK(ULQueue<string>::BLOCK_CAPACITY >= 4);
+
+  SECTION("test blocks are linked and unlinked at block boundaries")
+  {
+    ULQueue<int> queue;
+    CHECK(queue.getBlockCount() == 0);
+    for (int value = 0; value < BLOCK; value++)
+    {
+      queue.enqueue(value);
+    }
+    CHECK(queue.getBlockCount() == 1);
+    queue.enqueue(BLOCK);
+    CHECK(queue.getBlockCount() == 2);
+
+    for (int value = 0; value < BLOCK - 1; value++)
+    {
+      CHECK(queue.dequeueValue() == value);
+    }
+    CHECK(queue.getBlockCount() == 2);
+    queue.dequeue();
+    CHECK(queue.getBlockCount() == 1);
+    CHECK(queue.front() == BLOCK);
+    queue.dequeue();
+    CHECK(queue.getBlockCount() == 0);
+    CHECK(queue.isEmpty());
+    CHECK_THROWS_AS(queue.front(), QueueEmptyException);
+  }
+
+  SECTION("test indexing while the queue moves through many blocks")
+  {
+    ULQueue<int> queue;
+    int nextValue = 0;
+    int frontValue = 0;
+    for (int round = 0; round < 50; round++)
+    {
+      for (int count = 0; count < 37; count++)
+      {
+        queue.enqueue(nextValue++);
+      }
+      for (int count = 0; count < 23; count++)
+      {
+        REQUIRE(queue.dequeueValue() == frontValue++);
+      }
+
+      // index forwards, backwards and jumping around
+      for (int index = 0; index < queue.getSize(); index++)
+      {
+        REQUIRE(queue[index] == frontValue + index);
+      }
+      for (int index = queue.getSize() - 1; index >= 0; index -= 7)
+      {
+        REQUIRE(queue[index] == frontValue + index);
+      }
+      REQUIRE(queue[0] == frontValue);
+    }
+    CHECK(queue.getSize() == 50 * 14);
+    CHECK(queue.getBlockCount() <= 50 * 14 / BLOCK + 2);
+
+    // indexes give references into the blocks
+    queue[3] = -1;
+    CHECK(queue[3] == -1);
+    CHECK_THROWS_AS(queue[queue.getSize()], QueueMemoryBoundsException);
+    CHECK_THROWS_AS(queue[-1], QueueMemoryBoundsException);
+
+    // copy and compare a queue spanning many blocks
+    ULQueue<int> copy = queue;
+    CHECK(copy.getSize() == queue.getSize());
+    CHECK(copy == queue);
+    copy[copy.getSize() - 1] = -2;
+    CHECK_FALSE(copy == queue);
+  }
+}
+
+/** Test ULQueue iterators step through the blocks from front to back
+ */
+TEST_CASE("ULQueue<int> test iterators", "[iterator]")
+{
+  const int BLOCK = ULQueue<int>::BLOCK_CAPACITY;
+  ULQueue<int> queue;
+  CHECK(queue.begin() == queue.end());
+
+  // end of a full back block, and end part way through a block
+  for (int length : {BLOCK, 3 * BLOCK, 3 * BLOCK + 5})
+  {
+    queue.clear();
+    for (int value = 0; value < length + 7; value++)
+    {
+      queue.enqueue(value);
+    }
+    for (int count = 0; count < 7; count++)
+    {
+      queue.dequeue();
+    }
+
+    int expected = 7;
+    for (int value : queue)
+    {
+      REQUIRE(value == expected);
+      expected++;
+    }
+    CHECK(expected == length + 7);
+    CHECK(distance(queue.cbegin(), queue.cend()) == length);
+  }
+
+  for (int& value : queue)
+  {
+    value = -value;
+  }
+  CHECK(queue.front() == -7);
+  CHECK(*min_element(queue.begin(), queue.end()) == -(3 * BLOCK + 11));
+}